@@ -61,6 +61,9 @@
                                            // 45.5/60=0.7583 ticks/min; 0.7583/60 = .00126 ticks/sec
                                            // or 1/0.7583 = 1.32 arc-min/tick;  1.32*60 sec = 79.2 arc sec per encoder tick
 #define ODRIVE_UPDATE_MS              200  // 5 HZ position update rate
+#define ODRIVE_STREAM_MS              OFF  // OFF or 10 to 50 ms, stream position + velocity feed-forward over CAN (OD_CAN only)
+                                           // e.g. 20 = 50 HZ. To opt in set the ODrive input mode to PASSTHROUGH so the
+                                           // feed-forward applies, OFF sends a position every ODRIVE_UPDATE_MS as before
 
 // =================================================================================================================================
 // MOUNT ===========================================================================================================================
@@ -25,6 +25,8 @@
 #define DEBUG_ECHO_COMMANDS   ERRORS_ONLY //    OFF, Use ON or ERRORS_ONLY to log commands to the debug serial port.          Option
 #define SERIAL_DEBUG               Serial // Serial, Use any available h/w serial port. Serial1 or Serial2, etc.              Option
 #define SERIAL_DEBUG_BAUD          460800 //   9600, n. Where n=9600,19200,57600,115200 (common baud rates.)                  Option
+#define TASKS_HISTOGRAM               OFF //    OFF, ON keeps per task timing histograms (:GXJ# and the Extended Status       Option
+                                          //         screen), always on with DEBUG PROFILER. Adds overhead to every task.
 
 // NON-VOLATILE STORAGE ------------------------------------------------------------------------------------------------------------
 #define NV_WIPE                       OFF //         OFF, Causes the defaults to be written back into NV (FLASH,EEPROM,etc.)  Infreq
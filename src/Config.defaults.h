@@ -19,6 +19,11 @@
 #endif
 
 // debug
+#ifdef PROFILER_BUILD
+  // set by the teensy41_profiler environment, overrides the configured DEBUG mode
+  #undef DEBUG
+  #define DEBUG                       PROFILER
+#endif
 #ifndef DEBUG
 #define DEBUG                         OFF
 #endif
@@ -31,6 +36,9 @@
 #ifndef SERIAL_DEBUG_BAUD
 #define SERIAL_DEBUG_BAUD             9600
 #endif
+#ifndef TASKS_HISTOGRAM
+#define TASKS_HISTOGRAM               OFF
+#endif
 
 // serial ports
 #ifndef SERIAL_A_BAUD_DEFAULT
@@ -1801,6 +1809,9 @@
   #ifndef ODRIVE_UPDATE_MS
   #define ODRIVE_UPDATE_MS              100                       // 10 HZ update rate
   #endif
+  #ifndef ODRIVE_STREAM_MS
+  #define ODRIVE_STREAM_MS              OFF                       // OFF or n=10 to 50 (ms) to stream position and velocity feed-forward (OD_CAN)
+  #endif
   #ifndef ODRIVE_SWAP_AXES
   #define ODRIVE_SWAP_AXES              ON                        // ODrive axis 0 = OnStep Axis2 = DEC or ALT
   #endif                                                          // ODrive axis 1 = OnStep Axis1 = RA or AZM
@@ -134,10 +134,13 @@
 // task manager
 #define TASKS_MAX                   72     // up to 48 tasks
 #define TASKS_SKIP_MISSED
+//#define TASKS_SCHEDULER_HEAP               // yield() works from a due time ordered heap rather than scanning all tasks
 #define TASKS_HWTIMER1_ENABLE
 #define TASKS_HWTIMER2_ENABLE
 #define TASKS_HWTIMER3_ENABLE
 #define TASKS_HWTIMER4_ENABLE
+//#define TASKS_HISTOGRAM_ENABLE             // per task arrival/runtime/yield depth histograms, read with :GXJ[c][n]#
+                                           // also enabled by DEBUG PROFILER or TASKS_HISTOGRAM ON
 
 // default start of axis class hardware timers
 #define AXIS_HARDWARE_TIMER_BASE    2      // in the OnStepX timer#1 is the sidereal clock
@@ -88,6 +88,11 @@
   #define MCU_STR "ESP32"
   #include "HAL_ESP32.h"
 
+#elif defined(NATIVE_BUILD)
+  // Host build for tests and benchmarks
+  #define MCU_STR "Native"
+  #include "HAL_Native.h"
+
 #elif defined(__SAM3X8E__)
   // Arduino Due
   #define MCU_STR "SAM3X8E (Arduino DUE)"
@@ -0,0 +1,46 @@
+// Platform setup ------------------------------------------------------------------------------------
+#pragma once
+
+// Host (Linux, etc.) build for tests and benchmarks, see the native environments in platformio.ini
+// the Arduino core and libraries are stand-ins from test/native
+
+// Same timing as the Teensy 4.1 this firmware targets
+#define HAL_FRACTIONAL_SEC 5000.0F
+#define HAL_FAST_PROCESSOR
+
+#ifndef ANALOG_WRITE_PWM_BITS
+  #define ANALOG_WRITE_PWM_BITS 8
+#endif
+#ifndef ANALOG_WRITE_PWM_RANGE
+  #define ANALOG_WRITE_PWM_RANGE 255
+#endif
+
+// Lower limit (fastest) step rate in uS for this platform (in SQW mode) and width of step pulse
+#define HAL_MAXRATE_LOWER_LIMIT 1.5
+#define HAL_PULSE_WIDTH 0
+
+// New symbol for the default I2C port -------------------------------------------------------------
+#include <Wire.h>
+#define HAL_Wire Wire
+#define HAL_WIRE_CLOCK 100000
+
+// Non-volatile storage ----------------------------------------------------------------------------
+#if NV_DRIVER == NV_DEFAULT
+  #include "EEPROM.h"
+  #include "../lib/nv/NV_EEPROM.h"
+  #define HAL_NV_INIT() nv.init(E2END + 1, true, 0, false);
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// General purpose initialize for HAL
+#define HAL_INIT() { ; }
+
+//--------------------------------------------------------------------------------------------------
+// Internal MCU temperature (in degrees C)
+#define HAL_TEMP() ( NAN )
+
+// stand-in for delayNanoseconds()
+#define delayNanoseconds(ns) delayMicroseconds(ceilf(ns/1000.0F))
+
+// a really short fixed delay
+#define HAL_DELAY_25NS() { ; }
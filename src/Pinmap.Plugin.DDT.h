@@ -9,7 +9,7 @@
 #include "src/HAL/HAL.h"
 #include "src/lib/Macros.h"
 
-#if defined(ARDUINO_TEENSY41)
+#if defined(ARDUINO_TEENSY41) || defined(NATIVE_BUILD)
 
 // ODrive Pins
 #define ODRIVE_RST_PIN          3     // ODrive Reset Pin
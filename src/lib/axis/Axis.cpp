@@ -326,6 +326,9 @@ CommandError Axis::autoGoto(float distance, float frequency) {
   motor->setSlewing(true);
   autoRate = AR_RATE_BY_DISTANCE;
   rampFreq = 0.0F;
+  #if AXIS_JERK_PERCENT != OFF
+    profileCreate(getTargetDistance());
+  #endif
 
   #if DEBUG == VERBOSE
     if (unitsRadians) V(radToDeg(slewFreq)); else V(slewFreq);
@@ -337,6 +340,129 @@ CommandError Axis::autoGoto(float distance, float frequency) {
   return CE_NONE;
 }
 
+float Axis::getAutoGotoTime() {
+  if (autoRate != AR_RATE_BY_DISTANCE || !profileActive) return 0.0F;
+  return (2.0F*(2.0F*profile.tj + profile.ta) + profile.tv)*profileScale;
+}
+
+void Axis::setAutoGotoTime(float seconds) {
+  float t = getAutoGotoTime();
+  if (t <= 0.0F || seconds <= t) return;
+  profileScale *= seconds/t;
+  V(axisPrefix); VF("autoGoto profile stretched to "); V(seconds); VLF("s");
+}
+
+float Axis::getSlewTime(float distance) {
+  #if AXIS_JERK_PERCENT != OFF
+    SlewProfile p;
+    if (!profileSolve(distance, &p)) return 0.0F;
+    return 2.0F*(2.0F*p.tj + p.ta) + p.tv;
+  #else
+    float a = slewAccelRateFs*FRACTIONAL_SEC;
+    if (distance <= 0.0F || a <= 0.0F || slewFreq <= 0.0F) return 0.0F;
+    if (distance < slewFreq*slewFreq/a) return 2.0F*sqrtf(distance/a);
+    return distance/slewFreq + slewFreq/a;
+  #endif
+}
+
+float Axis::getSlewDistance(float distance, float seconds, float t) {
+  if (distance <= 0.0F || t <= 0.0F) return 0.0F;
+  #if AXIS_JERK_PERCENT != OFF
+    SlewProfile p;
+    if (!profileSolve(distance, &p)) return 0.0F;
+    float total = 2.0F*(2.0F*p.tj + p.ta) + p.tv;
+    if (seconds > total) t *= total/seconds;
+    if (t >= total) return distance;
+    return profilePosition(&p, t);
+  #else
+    UNUSED(seconds);
+    float a = slewAccelRateFs*FRACTIONAL_SEC;
+    if (a <= 0.0F || slewFreq <= 0.0F) return 0.0F;
+    float v = slewFreq;
+    if (distance < v*v/a) v = sqrtf(distance*a);
+    float accelTime = v/a;
+    float total = 2.0F*accelTime + (distance - v*accelTime)/v;
+    if (t >= total) return distance;
+    if (t > total - accelTime) { float r = total - t; return distance - a*r*r/2.0F; }
+    if (t > accelTime) return v*(t - accelTime/2.0F);
+    return a*t*t/2.0F;
+  #endif
+}
+
+bool Axis::profileSolve(float distance, SlewProfile *p) {
+  float a = slewAccelRateFs*FRACTIONAL_SEC;
+  float v = slewFreq;
+  if (distance <= 0.0F || a <= 0.0F || v <= 0.0F) return false;
+
+  // the jerk is set so the jerk segments take AXIS_JERK_PERCENT of the time a constant acceleration ramp would
+  float tj = (v/a)*(AXIS_JERK_PERCENT/100.0F);
+  if (tj <= 0.0F) return false;
+  p->jerk = a/tj;
+
+  // accelerating to v covers v*(2tj + ta)/2 and decelerating the same again
+  float ta = v/a - tj;
+  if (v*(2.0F*tj + ta) > distance) {
+    // too short to reach slew rate, solve v*(v/a + a/j) = distance for the peak frequency
+    float aj = a/p->jerk;
+    v = a*(sqrtf(aj*aj + 4.0F*distance/a) - aj)/2.0F;
+    ta = v/a - aj;
+    if (ta < 0.0F) {
+      // too short to reach peak acceleration either, solve 2v*sqrt(v/j) = distance
+      v = powf(distance*sqrtf(p->jerk)/2.0F, 2.0F/3.0F);
+      ta = 0.0F;
+      tj = sqrtf(v/p->jerk);
+    } else tj = aj;
+  }
+
+  p->freq = v;
+  p->accel = p->jerk*tj;
+  p->tj = tj;
+  p->ta = ta;
+  p->tv = (distance - v*(2.0F*tj + ta))/v;
+  if (p->tv < 0.0F) p->tv = 0.0F;
+  return true;
+}
+
+void Axis::profileCreate(float distance) {
+  profileActive = profileSolve(distance, &profile);
+  profileScale = 1.0F;
+  profileStartUs = micros();
+}
+
+float Axis::profileVelocity(float t) {
+  float accelTime = 2.0F*profile.tj + profile.ta;
+  float total = 2.0F*accelTime + profile.tv;
+  if (t >= total) return 0.0F;
+
+  // the deceleration phase mirrors the acceleration phase in time
+  if (t >= accelTime + profile.tv) t = total - t; else if (t >= accelTime) return profile.freq;
+
+  if (t < profile.tj) return profile.jerk*t*t/2.0F;
+  if (t < profile.tj + profile.ta) return profile.accel*(t - profile.tj/2.0F);
+  float r = accelTime - t;
+  return profile.freq - profile.jerk*r*r/2.0F;
+}
+
+float Axis::profilePosition(const SlewProfile *p, float t) {
+  float accelTime = 2.0F*p->tj + p->ta;
+  float total = 2.0F*accelTime + p->tv;
+  float distance = p->freq*(accelTime + p->tv);
+  if (t <= 0.0F) return 0.0F;
+  if (t >= total) return distance;
+
+  // the deceleration phase is the acceleration phase run backwards from the end
+  if (t > accelTime + p->tv) return distance - profilePosition(p, total - t);
+  if (t > accelTime) return p->freq*(t - accelTime/2.0F);
+
+  if (t < p->tj) return p->jerk*t*t*t/6.0F;
+  if (t < p->tj + p->ta) {
+    float u = t - p->tj;
+    return p->jerk*p->tj*p->tj*(p->tj/6.0F + u/2.0F) + p->accel*u*u/2.0F;
+  }
+  float r = accelTime - t;
+  return p->freq*(accelTime/2.0F - r) + p->jerk*r*r*r/6.0F;
+}
+
 // auto slew
 // \param direction: direction of motion, DIR_FORWARD or DIR_REVERSE
 // \param frequency: optional frequency of slew in "measures" (radians, microns, etc.) per second
@@ -496,6 +622,7 @@ void Axis::poll() {
       if (motor->getTargetDistanceSteps() == 0) {
         motor->setSlewing(false);
         autoRate = AR_NONE;
+        profileActive = false;
         freq = 0.0F;
         motor->setSynchronized(true);
         V(axisPrefix); VLF("slew stopped");
@@ -514,8 +641,27 @@ void Axis::poll() {
           rampFreq = freq;
         }
 */
-        freq = sqrtf(2.0F*(slewAccelRateFs*FRACTIONAL_SEC)*getOriginOrTargetDistance());
-        if (freq < backlashFreq/2.0F) freq = backlashFreq/2.0F;
+        if (profileActive) {
+          // follow the S-curve but never faster than we can stop in the remaining distance, the frequency
+          // is held until the next poll so take it from halfway there to cover the profile's distance
+          float t = (micros() - profileStartUs + FRACTIONAL_SEC_US/2)/1000000.0F/profileScale;
+          // if the axis fell behind and the profile ran out short of the target, plan another for the rest
+          // at the same stretch so it still finishes with any coordinated axes
+          if (t >= 2.0F*(2.0F*profile.tj + profile.ta) + profile.tv) {
+            float scale = profileScale;
+            profileCreate(getTargetDistance());
+            profileScale = scale;
+            t = 0.0F;
+          }
+          freq = profileVelocity(t)/profileScale;
+          float freqStop = sqrtf(2.0F*(profile.accel/(profileScale*profileScale))*getTargetDistance());
+          if (freq > freqStop) freq = freqStop;
+          // a stretched profile crawls in slower too so it finishes with the axis it was stretched to
+          if (freq < backlashFreq/2.0F/profileScale) freq = backlashFreq/2.0F/profileScale;
+        } else {
+          freq = sqrtf(2.0F*(slewAccelRateFs*FRACTIONAL_SEC)*getOriginOrTargetDistance());
+          if (freq < backlashFreq/2.0F) freq = backlashFreq/2.0F;
+        }
         if (freq > slewFreq) freq = slewFreq;
         if (motor->getTargetDistanceSteps() < 0) freq = -freq;
         rampFreq = freq;
@@ -25,6 +25,12 @@
 #endif
 #define FRACTIONAL_SEC_US           (lround(1000000.0F/FRACTIONAL_SEC))
 
+// jerk limited (S-curve) autoGoto, percentage of the time to reach slew rate spent ramping the acceleration
+// in and out, OFF uses the original constant acceleration ramp
+#ifndef AXIS_JERK_PERCENT
+#define AXIS_JERK_PERCENT           50
+#endif
+
 // time limit in seconds for slew home refine phases
 #ifndef SLEW_HOME_REFINE_TIME_LIMIT
 #define SLEW_HOME_REFINE_TIME_LIMIT 30
@@ -101,6 +107,17 @@ enum AutoRate: uint8_t {AR_NONE, AR_RATE_BY_TIME_ABORT, AR_RATE_BY_TIME_END, AR_
 enum HomingStage: uint8_t {HOME_NONE, HOME_FINE, HOME_SLOW, HOME_FAST};
 enum AxisMeasure: uint8_t {AXIS_MEASURE_UNKNOWN, AXIS_MEASURE_MICRONS, AXIS_MEASURE_DEGREES, AXIS_MEASURE_RADIANS};
 
+// autoGoto S-curve, the acceleration phase is jerk (tj) + constant acceleration (ta) + jerk (tj), then
+// constant frequency (tv) and the acceleration phase mirrored
+typedef struct SlewProfile {
+  float jerk;                          // in measures per second per second per second
+  float accel;                         // peak acceleration in measures per second per second
+  float freq;                          // peak frequency in measures per second
+  float tj;                            // jerk segment time in seconds
+  float ta;                            // constant acceleration segment time in seconds
+  float tv;                            // constant frequency segment time in seconds
+} SlewProfile;
+
 class Axis {
   public:
     // constructor
@@ -244,6 +261,19 @@ class Axis {
     // \param frequency: optional frequency of slew in "measures" (radians, microns, etc.) per second
     CommandError autoGoto(float distance, float frequency = NAN);
 
+    // time in seconds the current autoGoto profile takes (0 if none)
+    float getAutoGotoTime();
+
+    // stretch the current autoGoto profile to take this many seconds, so coordinated axes finish together
+    void setAutoGotoTime(float seconds);
+
+    // estimated time in seconds an autoGoto over this distance in "measures" would take
+    float getSlewTime(float distance);
+
+    // distance in "measures" an autoGoto over this distance covers t seconds in, with the profile stretched
+    // to take seconds if that's longer (the constant acceleration ramp isn't stretched)
+    float getSlewDistance(float distance, float seconds, float t);
+
     // auto slew
     // \param direction: direction of motion, DIR_FORWARD or DIR_REVERSE
     // \param frequency: optional frequency of slew in "measures" (radians, microns, etc.) per second
@@ -311,6 +341,18 @@ class Axis {
     // returns true if traveling through backlash
     bool inBacklash();
 
+    // finds the S-curve segment times to cover this distance, returns false if there is no motion
+    bool profileSolve(float distance, SlewProfile *p);
+
+    // starts the S-curve to cover this distance
+    void profileCreate(float distance);
+
+    // S-curve velocity at this time in seconds from the start of the profile
+    float profileVelocity(float t);
+
+    // S-curve distance covered at this time in seconds from the start of the profile
+    float profilePosition(const SlewProfile *p, float t);
+
     // convert from unwrapped (full range) to normal (+/- wrapAmount) coordinate
     double wrap(double value);
 
@@ -377,6 +419,12 @@ class Axis {
     float slewAccelTime = NAN;         // auto slew acceleration time in seconds
     float abortAccelTime = NAN;        // abort slew acceleration time in seconds
 
+    // autoGoto S-curve
+    bool profileActive = false;
+    SlewProfile profile;
+    float profileScale = 1.0F;         // time stretch factor
+    unsigned long profileStartUs = 0;
+
     HomingStage homingStage = HOME_NONE;
 
     const AxisPins *pins;
@@ -211,7 +211,8 @@ void ODriveMotor::setFrequencySteps(float frequency) {
   if (inBacklash)
     frequency = backlashFrequency;
 
-  if (frequency != currentFrequency) {
+  // currentFrequency is per step of stepSize, compare the request with the last request
+  if (frequency != lastFrequency) {
     lastFrequency = frequency;
 
     // if slewing has a larger step size divide the frequency to account for it
@@ -258,20 +259,51 @@ void ODriveMotor::setSlewing(bool state) {
 
 // updates PID and sets odrive position
 void ODriveMotor::poll() {
-  if ((long)(millis() - lastSetPositionTime) < ODRIVE_UPDATE_MS) return;
-  lastSetPositionTime = millis();
+  #if ODRIVE_STREAM_MS != OFF
+    if ((long)(millis() - lastSetPositionTime) < (long)streamPeriodMs) return;
+    lastSetPositionTime = millis();
 
-  noInterrupts();
-  #if ODRIVE_SLEW_DIRECT == ON
-    long target = targetSteps + backlashSteps;
+    // if this axis' last setpoint is still waiting for the bus back off, otherwise recover a millisecond at a time
+    if (_oDriveDriver->streamPending(axisNumber - 1)) {
+      streamPeriodMs *= 2;
+      if (streamPeriodMs > ODRIVE_UPDATE_MS) streamPeriodMs = ODRIVE_UPDATE_MS;
+    } else if (streamPeriodMs > ODRIVE_STREAM_MS) streamPeriodMs--;
+
+    noInterrupts();
+    #if ODRIVE_SLEW_DIRECT == ON
+      long target = targetSteps + backlashSteps;
+    #else
+      long target = motorSteps + backlashSteps;
+    #endif
+    int direction = step;
+    interrupts();
+
+    // velocity feed-forward from the rate move() is stepping at, except while the target is a fixed
+    // destination (an autoGoto with direct slewing) where the ODrive plans the move to it itself
+    float velocity = 0.0F;
+    #if ODRIVE_SLEW_DIRECT == ON
+      if (!synchronized) direction = 0;
+    #endif
+    if (direction > 0) velocity = getFrequencySteps(); else if (direction < 0) velocity = -getFrequencySteps();
+
+    float stepsPerTurn = TWO_PI*stepsPerMeasure;
+    _oDriveDriver->stream(axisNumber - 1, target/stepsPerTurn, velocity/stepsPerTurn);
   #else
-    long target = motorSteps + backlashSteps;
-  #endif
-  interrupts();
-  #if ODRIVE_COMM_MODE == OD_UART
-    setPosition(axisNumber -1, target/(TWO_PI*stepsPerMeasure));
-  #elif ODRIVE_COMM_MODE == OD_CAN
-    _oDriveDriver->setPosition(axisNumber -1, target/(TWO_PI*stepsPerMeasure));
+    if ((long)(millis() - lastSetPositionTime) < ODRIVE_UPDATE_MS) return;
+    lastSetPositionTime = millis();
+
+    noInterrupts();
+    #if ODRIVE_SLEW_DIRECT == ON
+      long target = targetSteps + backlashSteps;
+    #else
+      long target = motorSteps + backlashSteps;
+    #endif
+    interrupts();
+    #if ODRIVE_COMM_MODE == OD_UART
+      setPosition(axisNumber -1, target/(TWO_PI*stepsPerMeasure));
+    #elif ODRIVE_COMM_MODE == OD_CAN
+      _oDriveDriver->setPosition(axisNumber -1, target/(TWO_PI*stepsPerMeasure));
+    #endif
   #endif
 }
 
@@ -32,6 +32,15 @@
   #define ODRIVE_UPDATE_MS   3000
 #endif
 
+// odrive trajectory streaming OFF or n, position and velocity feed-forward sent every n (10 to 50) ms
+// over CAN, the period stretches toward ODRIVE_UPDATE_MS while the bus can't keep up
+#ifndef ODRIVE_STREAM_MS
+  #define ODRIVE_STREAM_MS   OFF
+#endif
+#if ODRIVE_STREAM_MS != OFF && ODRIVE_COMM_MODE != OD_CAN
+  #error "Configuration (Config.h): ODRIVE_STREAM_MS requires ODRIVE_COMM_MODE OD_CAN"
+#endif
+
 // odrive direct slewing ON or OFF (ODrive handles acceleration)
 #ifndef ODRIVE_SLEW_DIRECT
   #define ODRIVE_SLEW_DIRECT OFF
@@ -133,6 +142,9 @@ class ODriveMotor : public Motor {
     #endif
 
     unsigned long lastSetPositionTime = 0;
+    #if ODRIVE_STREAM_MS != OFF
+      unsigned long streamPeriodMs = ODRIVE_STREAM_MS;
+    #endif
     uint8_t oDriveMonitorHandle = 0;
     uint8_t taskHandle = 0;
 
@@ -130,7 +130,8 @@ void ServoMotor::setFrequencySteps(float frequency) {
   if (inBacklash)
     frequency = backlashFrequency;
 
-  if (frequency != currentFrequency) {
+  // currentFrequency is per step of stepSize, compare the request with the last request
+  if (frequency != lastFrequency) {
     lastFrequency = frequency;
 
     // if slewing has a larger step size divide the frequency to account for it
@@ -8,6 +8,10 @@
   #define TASKS_PROFILER_ENABLE
 #endif
 
+#if (DEBUG == PROFILER || TASKS_HISTOGRAM == ON) && !defined(TASKS_HISTOGRAM_ENABLE)
+  #define TASKS_HISTOGRAM_ENABLE
+#endif
+
 #if defined(DEBUG) && DEBUG != OFF && DEBUG != PROFILER
   #if defined(REMOTE) && DEBUG == REMOTE
     // echo strings to OnStep debug interface (supports embedded spaces and cr/lf)
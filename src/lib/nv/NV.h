@@ -126,10 +126,10 @@ class NonVolatileStorage {
     virtual bool busy();
 
     // read byte at position i from storage
-    virtual uint8_t readFromStorage(uint16_t i);
+    virtual uint8_t readFromStorage(uint16_t i) = 0;
 
     // write value j to position i in storage 
-    virtual void writeToStorage(uint16_t i, uint8_t j);
+    virtual void writeToStorage(uint16_t i, uint8_t j) = 0;
 
     // write value j of count bytes to position starting at i in storage
     // these writes must be aligned with the page size!
@@ -42,6 +42,29 @@
   #include "HAL_TEENSY_HWTIMER.h"
 #elif defined(ESP32)
   #include "HAL_ESP32_HWTIMER.h"
+#elif defined(NATIVE_BUILD)
+  // host build, nothing to interrupt so a task asking for a hardware timer keeps running from tasks.yield()
+  void HAL_HWTIMER_PREPARE_PERIOD(uint8_t num, unsigned long period) { (void)(num); (void)(period); }
+  #ifdef TASKS_HWTIMER1_ENABLE
+    void (*HAL_HWTIMER1_FUN)() = NULL;
+    bool HAL_HWTIMER1_INIT(uint8_t priority) { (void)(priority); HAL_HWTIMER1_FUN = NULL; return false; }
+    void HAL_HWTIMER1_DONE() { HAL_HWTIMER1_FUN = NULL; }
+  #endif
+  #ifdef TASKS_HWTIMER2_ENABLE
+    void (*HAL_HWTIMER2_FUN)() = NULL;
+    bool HAL_HWTIMER2_INIT(uint8_t priority) { (void)(priority); HAL_HWTIMER2_FUN = NULL; return false; }
+    void HAL_HWTIMER2_DONE() { HAL_HWTIMER2_FUN = NULL; }
+  #endif
+  #ifdef TASKS_HWTIMER3_ENABLE
+    void (*HAL_HWTIMER3_FUN)() = NULL;
+    bool HAL_HWTIMER3_INIT(uint8_t priority) { (void)(priority); HAL_HWTIMER3_FUN = NULL; return false; }
+    void HAL_HWTIMER3_DONE() { HAL_HWTIMER3_FUN = NULL; }
+  #endif
+  #ifdef TASKS_HWTIMER4_ENABLE
+    void (*HAL_HWTIMER4_FUN)() = NULL;
+    bool HAL_HWTIMER4_INIT(uint8_t priority) { (void)(priority); HAL_HWTIMER4_FUN = NULL; return false; }
+    void HAL_HWTIMER4_DONE() { HAL_HWTIMER4_FUN = NULL; }
+  #endif
 #else
   #include "HAL_EMPTY_HWTIMER.h"
 #endif
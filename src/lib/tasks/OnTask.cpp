@@ -43,7 +43,26 @@
 #define roundPeriod(x) ((unsigned long)((x)+(double)0.5L))
 
 unsigned char _task_postpone = false;
+#ifdef TASKS_HISTOGRAM_ENABLE
+  uint8_t _task_depth = 0; // software tasks currently running, nested by yield()
+
+  // bin for a value in microseconds, each bin 4x wider than the last
+  static inline uint8_t histogramBin(unsigned long value) {
+    uint8_t bin = 0;
+    while (value >= 4 && bin < TASKS_HISTOGRAM_BINS - 1) { value >>= 2; bin++; }
+    return bin;
+  }
+
+  // count a sample, halving the whole histogram rather than saturating so it keeps its shape
+  static inline void histogramCount(uint16_t *bins, uint8_t bin) {
+    if (++bins[bin] == 0xFFFF) for (uint8_t i = 0; i < TASKS_HISTOGRAM_BINS; i++) bins[i] >>= 1;
+  }
+#endif
 unsigned long _taskMasterFrequencyRatio = 16000000UL;
+#ifdef TASKS_SCHEDULER_HEAP
+  unsigned long _taskMillisLast = 0;
+  unsigned long _taskMillisEdge = 0; // micros() when millis() was last seen to change
+#endif
 
 // Task object
 Task::Task(uint32_t period, uint32_t duration, bool repeat, uint8_t priority, void (*volatile callback)()) {
@@ -160,9 +179,24 @@ bool Task::poll() {
     if ((long)time_to_next_task < 0) {
       running = true;
 
+      #ifdef TASKS_HISTOGRAM_ENABLE
+        // the task is due when time_to_next_task first goes negative, so -1 is on time
+        unsigned long late = -(long)time_to_next_task - 1;
+        if (period_units != PU_MICROS) late *= 1000UL;
+        histogramCount(histogram.arrival, histogramBin(late));
+        histogramCount(histogram.depth, _task_depth < TASKS_HISTOGRAM_BINS ? _task_depth : TASKS_HISTOGRAM_BINS - 1);
+        _task_depth++;
+        unsigned long histogram_t0 = micros();
+      #endif
+
       TASKS_PROFILER_PREFIX;
       callback();
       TASKS_PROFILER_SUFFIX;
+
+      #ifdef TASKS_HISTOGRAM_ENABLE
+        histogramCount(histogram.runtime, histogramBin(micros() - histogram_t0));
+        _task_depth--;
+      #endif
     
       running = false;
 
@@ -193,12 +227,37 @@ bool Task::poll() {
       #endif
       next_task_time = t + (long)(period + time_to_next_task);
       if (!repeat) period = 0;
+      return true;
     }
   } else immediate = true;
 
   return false;
 }
 
+#ifdef TASKS_SCHEDULER_HEAP
+long Task::timeToNext() {
+  // hardware timed tasks are never polled, running tasks are rescheduled when they exit
+  if (hardwareTimer || running) return TASKS_SCHEDULER_HORIZON;
+
+  long t = TASKS_SCHEDULER_HORIZON;
+  if (period != 0) {
+    if (immediate) t = 0; else
+    if (period_units == PU_MICROS) t = (long)(next_task_time - micros()); else {
+      // a millisecond task is due when millis() passes next_task_time, so wait for that tick
+      long ms = (long)(next_task_time - millis());
+      if (ms < TASKS_SCHEDULER_HORIZON/1000L) t = ms*1000L + 1000L - (long)((micros() - _taskMillisEdge) % 1000UL);
+    }
+  }
+
+  if (duration > 0) {
+    long ms = (long)((start_time + duration) - millis());
+    if (ms < t/1000L) t = ms*1000L;
+  }
+
+  return t;
+}
+#endif
+
 void Task::refreshPeriod() {
   if (hardwareTimer) setHardwareTimerPeriod();
 }
@@ -264,7 +323,7 @@ void Task::setRepeat(bool repeat) {
   this->repeat = repeat;
 }
 
-void Task::setPriority(bool priority) {
+void Task::setPriority(uint8_t priority) {
   if (hardwareTimer) return;
   this->priority = priority;
 }
@@ -286,7 +345,7 @@ char* Task::getNameStr() {
 float Task::getArrivalAvg() {
   if (hardwareTimer) return 0;
   if (average_arrival_time_count == 0) return 0;
-  float value = -average_arrival_time/average_arrival_time_count;
+  float value = -(float)average_arrival_time/average_arrival_time_count;
   average_arrival_time = 0;
   average_arrival_time_count = 0;
   return value;
@@ -299,7 +358,7 @@ float Task::getArrivalMax() {
 }
 float Task::getRuntimeTotal() {
   if (hardwareTimer) { noInterrupts(); total_runtime = _task_total_runtime[hardwareTimer-1]; _task_total_runtime[hardwareTimer-1] = 0; total_runtime_count=_task_total_runtime_count[hardwareTimer-1]; interrupts(); };
-  float value = total_runtime;
+  float value = (float)total_runtime;
   total_runtime = 0;
   return value;
 }
@@ -317,6 +376,13 @@ float Task::getRuntimeMax() {
 }
 #endif
 
+#ifdef TASKS_HISTOGRAM_ENABLE
+void Task::getHistogram(TaskHistogram *h, bool reset) {
+  *h = histogram;
+  if (reset) memset(&histogram, 0, sizeof(TaskHistogram));
+}
+#endif
+
 void Task::setHardwareTimerPeriod() {
   // adopt next period
   if (next_period_units != PU_NONE) {
@@ -349,6 +415,9 @@ Tasks::Tasks() {
   for (uint8_t c = 0; c < TASKS_MAX; c++) {
     task[c] = NULL;
     allocated[c] = false;
+    #ifdef TASKS_SCHEDULER_HEAP
+      heapPos[c] = 255;
+    #endif
   }
 
   // start the task monitor
@@ -368,7 +437,7 @@ uint8_t Tasks::add(uint32_t period, uint32_t duration, bool repeat, uint8_t prio
   if (priority > highest_priority) highest_priority = priority;
 
   // find the next free task
-  int8_t e = -1;
+  int16_t e = -1;
   for (uint8_t c = 0; c < TASKS_MAX; c++) {
     if (!allocated[c]) { e = c; break; }
   }
@@ -380,6 +449,9 @@ uint8_t Tasks::add(uint32_t period, uint32_t duration, bool repeat, uint8_t prio
   if (task[e] != NULL) allocated[e] = true; else return false;
 
   updateEventRange();
+  #ifdef TASKS_SCHEDULER_HEAP
+    heapUpdate(e);
+  #endif
   return e + 1;
 }
 
@@ -395,7 +467,11 @@ bool Tasks::requestHardwareTimer(uint8_t handle, uint8_t num) {
 
 bool Tasks::requestHardwareTimer(uint8_t handle, uint8_t num, uint8_t hwPriority) {
   if (handle != 0 && allocated[handle - 1]) {
-    return task[handle - 1]->requestHardwareTimer(num, hwPriority);
+    bool success = task[handle - 1]->requestHardwareTimer(num, hwPriority);
+    #ifdef TASKS_SCHEDULER_HEAP
+      if (success) heapRemove(handle - 1);
+    #endif
+    return success;
   } else return false;
 }
 
@@ -415,6 +491,9 @@ bool Tasks::setTimingMode(uint8_t handle, TimingMode mode) {
 
 void Tasks::remove(uint8_t handle) {
   if (handle != 0 && allocated[handle - 1]) {
+    #ifdef TASKS_SCHEDULER_HEAP
+      heapRemove(handle - 1);
+    #endif
     delete task[handle - 1];
     allocated[handle - 1] = false;
     updateEventRange();
@@ -431,24 +510,36 @@ void Tasks::refreshPeriod(uint8_t handle) {
 void Tasks::setPeriod(uint8_t handle, unsigned long period) {
   if (handle != 0 && allocated[handle - 1]) {
     task[handle - 1]->setPeriod(period);
+    #ifdef TASKS_SCHEDULER_HEAP
+      heapUpdate(handle - 1);
+    #endif
   }
 }
 
 void Tasks::setPeriodMicros(uint8_t handle, unsigned long period) {
   if (handle != 0 && allocated[handle - 1]) {
     task[handle - 1]->setPeriod(period, PU_MICROS);
+    #ifdef TASKS_SCHEDULER_HEAP
+      heapUpdate(handle - 1);
+    #endif
   }
 }
 
 void Tasks::setPeriodSubMicros(uint8_t handle, unsigned long period) {
   if (handle != 0 && allocated[handle - 1]) {
     task[handle - 1]->setPeriod(period, PU_SUB_MICROS);
+    #ifdef TASKS_SCHEDULER_HEAP
+      heapUpdate(handle - 1);
+    #endif
   }
 }
 
 void Tasks::setFrequency(uint8_t handle, double freq) {
   if (handle != 0 && allocated[handle - 1]) {
     task[handle - 1]->setFrequency(freq);
+    #ifdef TASKS_SCHEDULER_HEAP
+      heapUpdate(handle - 1);
+    #endif
   }
 }
 
@@ -459,18 +550,27 @@ IRAM_ATTR void Tasks::setPeriodRatioSubMicros(unsigned long value) {
 void Tasks::setDuration(uint8_t handle, unsigned long duration) {
   if (handle != 0 && allocated[handle - 1]) {
     task[handle - 1]->setDuration(duration);
+    #ifdef TASKS_SCHEDULER_HEAP
+      heapUpdate(handle - 1);
+    #endif
   }
 }
 
 void Tasks::setDurationComplete(uint8_t handle) {
   if (handle != 0 && allocated[handle - 1]) {
     task[handle - 1]->setDurationComplete();
+    #ifdef TASKS_SCHEDULER_HEAP
+      heapUpdate(handle - 1);
+    #endif
   }
 }
 
 void Tasks::setRepeat(uint8_t handle, bool repeat) {
   if (handle != 0 && allocated[handle - 1]) {
     task[handle - 1]->setRepeat(repeat);
+    #ifdef TASKS_SCHEDULER_HEAP
+      heapUpdate(handle - 1);
+    #endif
   }
 }
 
@@ -480,6 +580,9 @@ void Tasks::setPriority(uint8_t handle, uint8_t priority) {
     task[handle - 1]->setPriority(priority);
     updateEventRange();
     updatePriorityRange();
+    #ifdef TASKS_SCHEDULER_HEAP
+      heapUpdate(handle - 1);
+    #endif
   }
 }
 
@@ -552,7 +655,122 @@ uint8_t Tasks::getHandleByName(const char name[]) {
   }
 #endif
 
-#ifdef TASKS_HIGHER_PRIORITY_ONLY
+#ifdef TASKS_HISTOGRAM_ENABLE
+  bool Tasks::getHistogram(uint8_t handle, TaskHistogram *h, bool reset) {
+    if (handle != 0 && allocated[handle - 1]) {
+      task[handle - 1]->getHistogram(h, reset);
+      return true;
+    } else return false;
+  }
+#endif
+
+#if defined(TASKS_SCHEDULER_HEAP)
+  void Tasks::yield() {
+    #ifdef TASKS_HIGHER_PRIORITY_ONLY
+      ::yield();
+    #endif
+
+    unsigned long ms = millis();
+    if (ms != _taskMillisLast) { _taskMillisLast = ms; _taskMillisEdge = micros(); }
+
+    // tasks flagged to run immediately (possibly from an ISR) need their place in the heap updated
+    if (immediatePending) {
+      immediatePending = false;
+      for (uint8_t e = 0; e <= highest_task; e++) if (allocated[e] && task[e]->immediate) heapUpdate(e);
+    }
+
+    for (uint8_t priority = 0; priority <= highest_priority; priority++) {
+      #ifdef TASKS_HIGHER_PRIORITY_ONLY
+        if (priority >= highest_active_priority) break;
+        uint8_t last_priority = highest_active_priority;
+        highest_active_priority = priority;
+      #endif
+
+      // visit each task at most once, in order of due time, and return after the first that runs as the scan does
+      for (uint8_t visits = heapSize[priority]; visits > 0 && heapSize[priority] > 0; visits--) {
+        uint8_t e = heapTask[priority][0];
+        if ((long)(heapDue[e] - micros()) > 0) break;
+        if (task[e]->isDurationComplete()) {
+          remove(e + 1);
+          #ifdef TASKS_HIGHER_PRIORITY_ONLY
+            highest_active_priority = last_priority;
+          #endif
+          return;
+        }
+        bool ran = task[e]->poll();
+        if (allocated[e]) heapUpdate(e);
+        if (ran) {
+          #ifdef TASKS_HIGHER_PRIORITY_ONLY
+            highest_active_priority = last_priority;
+          #endif
+          return;
+        }
+      }
+
+      #ifdef TASKS_HIGHER_PRIORITY_ONLY
+        highest_active_priority = last_priority;
+      #endif
+    }
+  }
+
+  void Tasks::heapUpdate(uint8_t e) {
+    heapRemove(e);
+    if (!allocated[e]) return;
+
+    // add() and setPriority() only accept priorities 0 to 7 so there is a heap for every level
+    unsigned long due = micros() + task[e]->timeToNext();
+    uint8_t level = task[e]->getPriority();
+
+    uint8_t i = heapSize[level]++;
+    heapTask[level][i] = e;
+    heapLevel[e] = level;
+    heapPos[e] = i;
+    heapDue[e] = due;
+    heapSiftUp(level, i);
+  }
+
+  void Tasks::heapRemove(uint8_t e) {
+    uint8_t i = heapPos[e];
+    if (i == 255) return;
+    uint8_t level = heapLevel[e];
+    heapPos[e] = 255;
+
+    uint8_t last = --heapSize[level];
+    if (i == last) return;
+    uint8_t moved = heapTask[level][last];
+    heapTask[level][i] = moved;
+    heapPos[moved] = i;
+    heapSiftUp(level, i);
+    if (heapPos[moved] == i) heapSiftDown(level, i);
+  }
+
+  void Tasks::heapSiftUp(uint8_t level, uint8_t i) {
+    uint8_t *h = heapTask[level];
+    while (i > 0) {
+      uint8_t parent = (i - 1)/2;
+      if ((long)(heapDue[h[i]] - heapDue[h[parent]]) >= 0) break;
+      uint8_t t = h[i]; h[i] = h[parent]; h[parent] = t;
+      heapPos[h[i]] = i;
+      heapPos[h[parent]] = parent;
+      i = parent;
+    }
+  }
+
+  void Tasks::heapSiftDown(uint8_t level, uint8_t i) {
+    uint8_t *h = heapTask[level];
+    uint8_t size = heapSize[level];
+    for (;;) {
+      uint16_t child = 2*i + 1;
+      if (child >= size) break;
+      if (child + 1 < size && (long)(heapDue[h[child + 1]] - heapDue[h[child]]) < 0) child++;
+      if ((long)(heapDue[h[child]] - heapDue[h[i]]) >= 0) break;
+      uint8_t t = h[i]; h[i] = h[child]; h[child] = t;
+      heapPos[h[i]] = i;
+      heapPos[h[child]] = child;
+      i = child;
+    }
+  }
+#elif defined(TASKS_HIGHER_PRIORITY_ONLY)
   void Tasks::yield() {
     ::yield();
     for (uint8_t priority = 0; priority <= highest_priority; priority++) {
@@ -610,7 +828,7 @@ void Tasks::updatePriorityRange() {
 void Tasks::updateEventRange() {
   // scan for highest task handle
   highest_task = 0;
-  for (int8_t e = TASKS_MAX - 1; e >= 0 ; e--) {
+  for (int16_t e = TASKS_MAX - 1; e >= 0 ; e--) {
     if (allocated[e]) {
       highest_task = e;
       break;
@@ -65,6 +65,16 @@
 // comment out and any task can run except the task that yields
 #define TASKS_HIGHER_PRIORITY_ONLY
 
+// default is for yield() to scan all tasks in each priority level, to instead keep a min-heap of tasks ordered
+// by next due time in each priority level (so yield() only looks at the tasks that are due) use:
+// #define TASKS_SCHEDULER_HEAP
+#ifdef TASKS_SCHEDULER_HEAP
+  // tasks due further out than this (in microseconds) are checked again at this interval
+  #ifndef TASKS_SCHEDULER_HORIZON
+    #define TASKS_SCHEDULER_HORIZON 60000000L
+  #endif
+#endif
+
 // ESP32 override cli/sei and use muxes to block the h/w timer ISR's instead
 #ifdef ESP32
   // on the ESP32 noInterrupts()/interrupts() are #defined to be cli()/sei()
@@ -83,6 +93,20 @@
   extern void timerAlarmsEnable();
 #endif
 
+// low overhead fixed-point histograms of arrival lateness, runtime, and yield depth for each software task
+// the histograms use TASKS_HISTOGRAM_BINS bins each 4x wider than the last (<4us, <16us, ... >=16ms)
+// to enable use:
+// #define TASKS_HISTOGRAM_ENABLE
+#define TASKS_HISTOGRAM_BINS 8
+
+#ifdef TASKS_HISTOGRAM_ENABLE
+  typedef struct TaskHistogram {
+    uint16_t arrival[TASKS_HISTOGRAM_BINS]; // how late the task started, in microseconds
+    uint16_t runtime[TASKS_HISTOGRAM_BINS]; // how long the task ran, in microseconds
+    uint16_t depth[TASKS_HISTOGRAM_BINS];   // number of tasks already running (yielding) when it started
+  } TaskHistogram;
+#endif
+
 // short Y macro to embed yield()
 #define Y tasks.yield()
 
@@ -113,8 +137,14 @@ class Task {
     // run task at the prescribed interval
     // note: tasks are timed in such a way as to achieve an accurate average frequency, if
     //       the task occurs late the next call is scheduled earlier to make up the difference
+    // returns true if the task ran
     bool poll();
 
+    #ifdef TASKS_SCHEDULER_HEAP
+      // microseconds until this task next needs to be polled or removed, negative if overdue
+      long timeToNext();
+    #endif
+
     void refreshPeriod();
     void setPeriod(unsigned long period, PeriodUnits units = PU_MILLIS);
     void setFrequency(float freq);
@@ -125,7 +155,7 @@ class Task {
 
     void setRepeat(bool repeat);
 
-    void setPriority(bool priority);
+    void setPriority(uint8_t priority);
     uint8_t getPriority();
 
     void setNameStr(const char name[]);
@@ -139,6 +169,11 @@ class Task {
       float getRuntimeMax();
     #endif
 
+    #ifdef TASKS_HISTOGRAM_ENABLE
+      // copy the histograms, optionally clearing them
+      void getHistogram(TaskHistogram *h, bool reset);
+    #endif
+
     volatile bool immediate = true;
 
   private:
@@ -163,13 +198,17 @@ class Task {
     void (*volatile callback)() = NULL;
 
     #ifdef TASKS_PROFILER_ENABLE
-      volatile double        average_arrival_time       = 0;
+      volatile int64_t       average_arrival_time       = 0;
       volatile unsigned long average_arrival_time_count = 0;
       volatile long          max_arrival_time           = 0;
-      volatile double        total_runtime              = 0;
+      volatile int64_t       total_runtime              = 0;
       volatile unsigned long total_runtime_count        = 0;
       volatile long          max_runtime                = 0;
     #endif
+
+    #ifdef TASKS_HISTOGRAM_ENABLE
+      TaskHistogram          histogram                  = {};
+    #endif
 };
 
 class Tasks {
@@ -273,7 +312,11 @@ class Tasks {
     IRAM_ATTR void setPeriodRatioSubMicros(unsigned long value);
 
     // set process to run immediately on the next pass (within its priority level)
-    IRAM_ATTR inline void immediate(uint8_t handle) { if (handle != 0 && allocated[handle - 1]) { task[handle - 1]->immediate = true; } }
+    #ifdef TASKS_SCHEDULER_HEAP
+      IRAM_ATTR inline void immediate(uint8_t handle) { if (handle != 0 && allocated[handle - 1]) { task[handle - 1]->immediate = true; immediatePending = true; } }
+    #else
+      IRAM_ATTR inline void immediate(uint8_t handle) { if (handle != 0 && allocated[handle - 1]) { task[handle - 1]->immediate = true; } }
+    #endif
 
     // change process duration (milliseconds,) use 0 for disabled
     void setDuration(uint8_t handle, unsigned long duration);
@@ -312,6 +355,11 @@ class Tasks {
       double getRuntimeMax(uint8_t handle);
     #endif
 
+    #ifdef TASKS_HISTOGRAM_ENABLE
+      // copy the histograms for this task, returns false if the handle isn't valid
+      bool getHistogram(uint8_t handle, TaskHistogram *h, bool reset = false);
+    #endif
+
     // runs tasks at their prescribed interval, each call can trigger at most a single process
     // processes that are already running are ignored so it's ok to poll() within a process
     void yield();
@@ -324,6 +372,22 @@ class Tasks {
     // keep track of the range of tasks so we don't waste cycles looking at empty ones
     void updateEventRange();
 
+    #ifdef TASKS_SCHEDULER_HEAP
+      // place task e in the heap for its priority level, or move it to reflect a change in timing or priority
+      void heapUpdate(uint8_t e);
+      // take task e out of the heap
+      void heapRemove(uint8_t e);
+      void heapSiftUp(uint8_t level, uint8_t i);
+      void heapSiftDown(uint8_t level, uint8_t i);
+
+      uint8_t       heapTask[8][TASKS_MAX];   // task# min-heap for each priority level, ordered by due time
+      uint8_t       heapSize[8]  = {0, 0, 0, 0, 0, 0, 0, 0};
+      uint8_t       heapLevel[TASKS_MAX];     // the priority level heap holding each task#
+      uint8_t       heapPos[TASKS_MAX];       // position of each task# in its heap, 255 if not present
+      unsigned long heapDue[TASKS_MAX];       // due time of each task# in microseconds
+      volatile bool immediatePending = false;
+    #endif
+
     uint8_t highest_task     = 0; // the highest task# assigned
     uint8_t highest_priority = 0; // the highest task priority
     #ifdef TASKS_HIGHER_PRIORITY_ONLY
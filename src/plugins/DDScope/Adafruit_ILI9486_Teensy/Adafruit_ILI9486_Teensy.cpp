@@ -18,7 +18,7 @@
 #include "Adafruit_ILI9486_Teensy.h"
 #include "../display/Display.h"
 #include "../display/UsbBridge.h"
-#include "../display/WiFiDisplay.h"
+#include "../display/WifiDisplay.h"
 #include "miniz.h"
 #include <Adafruit_GFX.h>
 #include <SD.h>
@@ -55,6 +55,36 @@ void WifiDisplay::captureSetAddrWindow(uint16_t x0, uint16_t y0,
 }
 #endif
 
+#ifdef ENABLE_TFT_MIRROR
+// copies a pixel written at the current mirror position into the capture buffer and advances the position
+static inline void capturePixel(uint16_t c) {
+  if (windowX0 < SCREEN_WIDTH && windowY0 < SCREEN_HEIGHT && mirror_x < SCREEN_WIDTH) {
+    int index = (mirror_y * SCREEN_WIDTH + mirror_x) * COLOR_DEPTH;
+    uint8_t high = c >> 8;
+    uint8_t low = c & 0xFF;
+
+    if (index + 1 < SCREEN_WIDTH * SCREEN_HEIGHT * COLOR_DEPTH) {
+      // only a changed pixel makes its tile part of the next delta frame
+      if (uncompressedBuffer[index] != high || uncompressedBuffer[index + 1] != low) {
+        uncompressedBuffer[index] = high;
+        uncompressedBuffer[index + 1] = low;
+        wifiDisplay.markDirty(mirror_x, mirror_y);
+      }
+    }
+  }
+
+  // Advance draw position
+  mirror_x++;
+  if (mirror_x > windowX1) {
+    mirror_x = windowX0;
+    mirror_y++;
+    if (mirror_y > windowY1) {
+      mirror_y = windowY0;
+    }
+  }
+}
+#endif
+
 void Adafruit_ILI9486_Teensy::writedata16(uint16_t c) {
   CD_DATA;
   CS_ACTIVE;
@@ -72,36 +102,13 @@ void Adafruit_ILI9486_Teensy::writedata16(uint16_t c) {
 //   }
 // #endif
 #ifdef ENABLE_TFT_MIRROR
-  //static uint16_t mirror_x = 0;
-  //static uint16_t mirror_y = 0;
-
   if (wifiDisplay.isScreenCaptureEnabled) {
-    if (windowX0 < SCREEN_WIDTH && windowY0 < SCREEN_HEIGHT) {
-      int index = (mirror_y * SCREEN_WIDTH + mirror_x) * COLOR_DEPTH;
-      uint8_t high = c >> 8;
-      uint8_t low = c & 0xFF;
-
-      if (index + 1 < SCREEN_WIDTH * SCREEN_HEIGHT * COLOR_DEPTH) {
-         delayMicroseconds(1);  // or tasks.yield(1)
-        uncompressedBuffer[index] = high;
-        uncompressedBuffer[index + 1] = low;
-      }
-    }
-
-    // Advance draw position
-    mirror_x++;
-    if (mirror_x > windowX1) {
-      mirror_x = windowX0;
-      mirror_y++;
-      if (mirror_y > windowY1) {
-        mirror_y = windowY0;
-      }
-    }
+    delayMicroseconds(1);  // or tasks.yield(1)
+    capturePixel(c);
   }
 #endif
 
-  SPI.transfer(c >> 8);
-  SPI.transfer(c & 0xFF);
+  SPI.transfer16(c);
   CS_IDLE;
 }
 
@@ -118,7 +125,7 @@ void Adafruit_ILI9486_Teensy::writedata16(uint16_t c, uint32_t num) {
   int x = windowX0;
   int y = windowY0;
 
-  while (pixelCount < num) {
+  while (wifiDisplay.isScreenCaptureEnabled && pixelCount < num) {
     if (x >= SCREEN_WIDTH) {
       x = 0;
       y++;
@@ -128,9 +135,10 @@ void Adafruit_ILI9486_Teensy::writedata16(uint16_t c, uint32_t num) {
 
     int index = (y * SCREEN_WIDTH + x) * COLOR_DEPTH;
 
-    if (wifiDisplay.isScreenCaptureEnabled) {
+    if (uncompressedBuffer[index] != highByte || uncompressedBuffer[index + 1] != lowByte) {
       uncompressedBuffer[index] = highByte;
       uncompressedBuffer[index + 1] = lowByte;
+      wifiDisplay.markDirty(x, y);
     }
 
     pixelCount++;
@@ -142,14 +150,61 @@ void Adafruit_ILI9486_Teensy::writedata16(uint16_t c, uint32_t num) {
   }
 #endif
 
-  for (uint32_t i = 0; i < num; i++) {
-    SPI.transfer(c >> 8);
-    SPI.transfer(c & 0xFF);
+  // one row of the color is built once and sent as often as needed
+  uint8_t block[SPIBLOCKMAX * 2];
+  uint32_t count = min(num, (uint32_t)SPIBLOCKMAX);
+  for (uint32_t i = 0; i < count; i++) {
+    block[i * 2] = c >> 8;
+    block[i * 2 + 1] = c & 0xFF;
+  }
+  while (num > 0) {
+    count = min(num, (uint32_t)SPIBLOCKMAX);
+    SPI.transfer(block, nullptr, count * 2);
+    num -= count;
   }
 
   CS_IDLE;
 }
 
+// write multiple pixels from a buffer
+void Adafruit_ILI9486_Teensy::writedata16(const uint16_t *colors, uint32_t num) {
+  CD_DATA;
+  CS_ACTIVE;
+
+  uint8_t block[SPIBLOCKMAX * 2];
+  while (num > 0) {
+    uint32_t count = min(num, (uint32_t)SPIBLOCKMAX);
+    for (uint32_t i = 0; i < count; i++) {
+      uint16_t c = colors[i];
+      block[i * 2] = c >> 8;
+      block[i * 2 + 1] = c & 0xFF;
+#ifdef ENABLE_TFT_MIRROR
+      if (wifiDisplay.isScreenCaptureEnabled) capturePixel(c);
+#endif
+    }
+    SPI.transfer(block, nullptr, count * 2);
+    colors += count;
+    num -= count;
+  }
+
+  CS_IDLE;
+}
+
+// write multiple pixels that are already big endian
+void Adafruit_ILI9486_Teensy::writedataRaw(const uint8_t *bytes, uint32_t num) {
+  CD_DATA;
+  CS_ACTIVE;
+
+#ifdef ENABLE_TFT_MIRROR
+  if (wifiDisplay.isScreenCaptureEnabled) {
+    for (uint32_t i = 0; i < num; i++) capturePixel((bytes[i * 2] << 8) | bytes[i * 2 + 1]);
+  }
+#endif
+  SPI.transfer(bytes, nullptr, num * 2);
+
+  CS_IDLE;
+}
+
 /*****************************************************************************/
 void Adafruit_ILI9486_Teensy::writecommand(uint8_t c) {
   CD_COMMAND;
@@ -253,25 +308,109 @@ void Adafruit_ILI9486_Teensy::begin(void) {
 void Adafruit_ILI9486_Teensy::setAddrWindow(uint16_t x0, uint16_t y0,
                                             uint16_t x1, uint16_t y1) {
   SPI.beginTransaction(SPISET);
+  writeAddrWindow(x0, y0, x1, y1);
+  SPI.endTransaction();
+}
+
+// sets the window inside the caller's SPI transaction, CS stays active for the whole sequence
+void Adafruit_ILI9486_Teensy::writeAddrWindow(uint16_t x0, uint16_t y0,
+                                              uint16_t x1, uint16_t y1) {
 #ifdef ENABLE_TFT_MIRROR
   wifiDisplay.captureSetAddrWindow(x0, y0, x1, y1); // Store window area for capture
   mirror_x = x0;
   mirror_y = y0;
 
 #endif
-  writecommand(ILI9486_CASET); // Column addr set
-  writedata(x0 >> 8);
-  writedata(x0 & 0xFF); // XSTART
-  writedata(x1 >> 8);
-  writedata(x1 & 0xFF); // XEND
-
-  writecommand(ILI9486_PASET); // Row addr set
-  writedata(y0 >> 8);
-  writedata(y0); // YSTART
-  writedata(y1 >> 8);
-  writedata(y1); // YEND
-
-  writecommand(ILI9486_RAMWR); // write to RAM
+  CS_ACTIVE;
+  CD_COMMAND;
+  SPI.transfer(ILI9486_CASET); // Column addr set
+  CD_DATA;
+  SPI.transfer16(x0); // XSTART
+  SPI.transfer16(x1); // XEND
+
+  CD_COMMAND;
+  SPI.transfer(ILI9486_PASET); // Row addr set
+  CD_DATA;
+  SPI.transfer16(y0); // YSTART
+  SPI.transfer16(y1); // YEND
+
+  CD_COMMAND;
+  SPI.transfer(ILI9486_RAMWR); // write to RAM
+  CS_IDLE;
+}
+
+/*****************************************************************************/
+// write pixels into the current window
+void Adafruit_ILI9486_Teensy::writePixels(const uint16_t *colors, uint32_t num) {
+  SPI.beginTransaction(SPISET);
+  writedata16(colors, num);
+  SPI.endTransaction();
+}
+
+/*****************************************************************************/
+// draw a w x h RGB565 image, rows are clipped to the screen
+void Adafruit_ILI9486_Teensy::pushImage(int16_t x, int16_t y, int16_t w, int16_t h,
+                                        const uint16_t *colors) {
+  int16_t x0 = max(x, (int16_t)0), y0 = max(y, (int16_t)0);
+  int16_t x1 = min((int16_t)(x + w - 1), (int16_t)(_width - 1));
+  int16_t y1 = min((int16_t)(y + h - 1), (int16_t)(_height - 1));
+  if (x0 > x1 || y0 > y1) return;
+  if (overwriteCallback != NULL) overwriteCallback(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+
+  SPI.beginTransaction(SPISET);
+  writeAddrWindow(x0, y0, x1, y1);
+  colors += (y0 - y) * w + (x0 - x);
+  if (x0 == x && x1 - x0 + 1 == w) {
+    writedata16(colors, (uint32_t)w * (y1 - y0 + 1));
+  } else {
+    for (int16_t row = y0; row <= y1; row++, colors += w) writedata16(colors, x1 - x0 + 1);
+  }
+  SPI.endTransaction();
+}
+
+/*****************************************************************************/
+// draw a w x h image whose pixels are already big endian, rows are clipped to the screen
+void Adafruit_ILI9486_Teensy::pushRawImage(int16_t x, int16_t y, int16_t w, int16_t h,
+                                           const uint8_t *bytes) {
+  int16_t x0 = max(x, (int16_t)0), y0 = max(y, (int16_t)0);
+  int16_t x1 = min((int16_t)(x + w - 1), (int16_t)(_width - 1));
+  int16_t y1 = min((int16_t)(y + h - 1), (int16_t)(_height - 1));
+  if (x0 > x1 || y0 > y1) return;
+  if (overwriteCallback != NULL) overwriteCallback(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+
+  SPI.beginTransaction(SPISET);
+  writeAddrWindow(x0, y0, x1, y1);
+  bytes += ((y0 - y) * w + (x0 - x)) * 2;
+  if (x0 == x && x1 - x0 + 1 == w) {
+    writedataRaw(bytes, (uint32_t)w * (y1 - y0 + 1));
+  } else {
+    for (int16_t row = y0; row <= y1; row++, bytes += w * 2) writedataRaw(bytes, x1 - x0 + 1);
+  }
+  SPI.endTransaction();
+}
+
+/*****************************************************************************/
+// draw a 1 bit per pixel bitmap, rows padded to whole bytes MSB first, clipped to the screen
+void Adafruit_ILI9486_Teensy::pushBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h,
+                                         uint16_t color, uint16_t bg) {
+  int16_t x0 = max(x, (int16_t)0), y0 = max(y, (int16_t)0);
+  int16_t x1 = min((int16_t)(x + w - 1), (int16_t)(_width - 1));
+  int16_t y1 = min((int16_t)(y + h - 1), (int16_t)(_height - 1));
+  if (x0 > x1 || y0 > y1) return;
+
+  uint16_t row[TFTHEIGHT]; // widest row in any rotation
+  int16_t byteWidth = (w + 7) / 8;
+
+  SPI.beginTransaction(SPISET);
+  writeAddrWindow(x0, y0, x1, y1);
+  for (int16_t r = y0; r <= y1; r++) {
+    const uint8_t *bits = bitmap + (r - y) * byteWidth;
+    for (int16_t c = x0; c <= x1; c++) {
+      int16_t i = c - x;
+      row[c - x0] = (bits[i >> 3] & (0x80 >> (i & 7))) ? color : bg;
+    }
+    writedata16(row, x1 - x0 + 1);
+  }
   SPI.endTransaction();
 }
 
@@ -281,7 +420,7 @@ void Adafruit_ILI9486_Teensy::drawPixel(int16_t x, int16_t y, uint16_t color) {
     return;
 
   SPI.beginTransaction(SPISET); // Only one transaction for the entire operation
-  setAddrWindow(x, y, x, y);    // Set window for a single pixel
+  writeAddrWindow(x, y, x, y);  // Set window for a single pixel
   writedata16(color);           // Log and write pixel data via bufferedTransfer()
   SPI.endTransaction();
 }
@@ -300,8 +439,8 @@ void Adafruit_ILI9486_Teensy::drawFastVLine(int16_t x, int16_t y, int16_t h,
     return;
   }
 
-  setAddrWindow(x, y, x, y + h - 1);
   SPI.beginTransaction(SPISET);
+  writeAddrWindow(x, y, x, y + h - 1);
   writedata16(color, h);
   SPI.endTransaction();
 }
@@ -320,16 +459,17 @@ void Adafruit_ILI9486_Teensy::drawFastHLine(int16_t x, int16_t y, int16_t w,
     return;
   }
 
-  setAddrWindow(x, y, x + w - 1, y);
   SPI.beginTransaction(SPISET);
+  writeAddrWindow(x, y, x + w - 1, y);
   writedata16(color, w);
   SPI.endTransaction();
 }
 
 /*****************************************************************************/
 void Adafruit_ILI9486_Teensy::fillScreen(uint16_t color) {
-  setAddrWindow(0, 0, _width, _height);
+  screenGeneration++;
   SPI.beginTransaction(SPISET);
+  writeAddrWindow(0, 0, _width - 1, _height - 1);
   writedata16(color, (_width * _height));
   SPI.endTransaction();
 }
@@ -356,10 +496,10 @@ void Adafruit_ILI9486_Teensy::fillRect(int16_t x, int16_t y, int16_t w,
     drawPixel(x, y, color);
     return;
   }
+  if (overwriteCallback != NULL) overwriteCallback(x, y, w, h);
 
-  setAddrWindow(x, y, x + w - 1, y + h - 1);
   SPI.beginTransaction(SPISET);
-  writecommand(ILI9486_RAMWR);
+  writeAddrWindow(x, y, x + w - 1, y + h - 1);
   writedata16(color, (w * h));
   SPI.endTransaction();
 }
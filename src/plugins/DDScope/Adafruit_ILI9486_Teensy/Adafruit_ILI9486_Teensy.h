@@ -65,15 +65,32 @@ class Adafruit_ILI9486_Teensy : public Adafruit_GFX
     void setRotation(uint8_t r);
     void invertDisplay(boolean i);
     uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
-    
+    // block writes, pixels go out in SPIBLOCKMAX sized SPI buffer transfers
+    void writePixels(const uint16_t *colors, uint32_t num);
+    void pushImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *colors);
+    // pixels already in display byte order (big endian RGB565), sent without conversion
+    void pushRawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *bytes);
+    // 1 bit per pixel bitmap (GFXcanvas1 layout) expanded to color/bg a row at a time
+    void pushBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg);
+    // incremented by fillScreen(), lets cached drawing know the screen was cleared
+    inline uint32_t getScreenGeneration() { return screenGeneration; }
+    // called with the area fillRect(), pushImage() and pushRawImage() overwrite, lets cached
+    // drawing know part of the screen was cleared
+    typedef void (*OverwriteCallback)(int16_t x, int16_t y, int16_t w, int16_t h);
+    inline void setOverwriteCallback(OverwriteCallback callback) { overwriteCallback = callback; }
 
  private:
+    void writeAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
     void writecommand(uint8_t c);
     void writedata(uint8_t d);
     void writedata16(uint16_t d);
     void writedata16(uint16_t d, uint32_t num);
+    void writedata16(const uint16_t *colors, uint32_t num);
+    void writedataRaw(const uint8_t *bytes, uint32_t num);
     void commandList(uint8_t *addr);
-    
+    uint32_t screenGeneration = 0;
+    OverwriteCallback overwriteCallback = NULL;
+
 };
 
 #endif
@@ -47,6 +47,10 @@
 #endif
 
 void espWrapper() { wifiDisplay.espPoll(); }
+void espFrameWrapper() { wifiDisplay.framePoll(); }
+#if ODRIVE_COMM_MODE == OD_CAN
+  void oDriveCanWrapper() { _oDriveDriver->poll(); }
+#endif
 
 void DDScope::init() {
 
@@ -89,6 +93,14 @@ void DDScope::init() {
   // .begin is done by the constructor
   // in ODriveTeensyCAN.cpp
   VLF("MSG: ODrive, CAN channel init");
+
+  // Task to move CAN requests/replies between the bus and the telemetry cache
+  VF("MSG: Starting ODrive CAN poll task (2 ms, priority 3)... ");
+  if (tasks.add(2, 0, true, 3, oDriveCanWrapper, "ODcan")) {
+    VLF("success");
+  } else {
+    VLF("FAILED to start ODrive CAN poll task!");
+  }
 #endif
 
   // Initialize Touchscreen *NOTE: must occur before display.init() since SPI.begin() is done here
@@ -113,6 +125,14 @@ void DDScope::init() {
   } else {
     VLF("FAILED to start espPoll task!");
   }
+
+  // Task to compress and send mirror frames a slice at a time
+  VF("MSG: Starting espFrame task (1 ms, priority 3)... ");
+  if (tasks.add(1, 0, true, 3, espFrameWrapper, "espFrm")) {
+    VLF("success");
+  } else {
+    VLF("FAILED to start espFrame task!");
+  }
 #endif
 
   //=========================================================================
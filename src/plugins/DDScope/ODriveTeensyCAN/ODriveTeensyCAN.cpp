@@ -61,7 +61,6 @@ ODriveTeensyCAN::ODriveTeensyCAN(int CANBaudRate) {
 
 bool ODriveTeensyCAN::sendMessage(int axis_id, int cmd_id, bool remote_transmission_request, int length, byte *signal_bytes) {
   CAN_message_t msg;
-  CAN_message_t return_msg;
 
   msg.id = (axis_id << CommandIDLength) + cmd_id;
   msg.flags.remote = remote_transmission_request;
@@ -71,46 +70,192 @@ bool ODriveTeensyCAN::sendMessage(int axis_id, int cmd_id, bool remote_transmiss
       Can0.write(msg);
       return true;
   }
-  
+
+  // blocking request, replies are still routed through the ring so frames for other ids aren't lost
+  if (axis_id < 0 || axis_id >= ODRIVE_CAN_AXES || cmd_id < 0 || cmd_id >= ODRIVE_CAN_CMDS) return false;
+  uint8_t count = telemetry[axis_id].count[cmd_id];
   Can0.write(msg);
   unsigned long start_time = millis();
   while (millis() - start_time < TIMEOUT) {
-    if (Can0.read(return_msg) && (return_msg.id == msg.id)) {
-        memcpy(signal_bytes, return_msg.buf, sizeof(return_msg.buf));
-        return true;
+    receive();
+    dispatch();
+    if (telemetry[axis_id].count[cmd_id] != count) {
+      memcpy(signal_bytes, telemetry[axis_id].data[cmd_id], 8);
+      return true;
     }
   }
-  // Show timeout info
-  //SERIAL_DEBUG.println("CAN read Timeout");
-  //SERIAL_DEBUG.print("Axis ID: 0x"); SERIAL_DEBUG.println(axis_id, HEX);
-  //SERIAL_DEBUG.print("Cmd ID: 0x"); SERIAL_DEBUG.println(cmd_id, HEX);
-  //SERIAL_DEBUG.print("Length: "); SERIAL_DEBUG.println(length);
-  //SERIAL_DEBUG.print("msg.id: 0x"); SERIAL_DEBUG.println(msg.id, HEX);  
-  //SERIAL_DEBUG.print("msg.flags.remote: "); SERIAL_DEBUG.println(msg.flags.remote ? "True" : "False");
-  //SERIAL_DEBUG.print("msg.len: "); SERIAL_DEBUG.println(msg.len);
-  //SERIAL_DEBUG.print("signal_bytes: ");
-
-  // for (int i = 0; i < length; i++) {
-  //     SERIAL_DEBUG.print("0x");  // Add prefix
-  //     if (signal_bytes[i] < 0x10) SERIAL_DEBUG.print("0");  // Ensure leading zero for single-digit hex
-  //     SERIAL_DEBUG.print(signal_bytes[i], HEX);
-  //     SERIAL_DEBUG.print(" ");
-  // }
-  // SERIAL_DEBUG.println(); // New line after printing all bytes
-
-  // Print msg.buf
-  // if (!msg.flags.remote) {
-  //     SERIAL_DEBUG.print("msg.buf: ");
-  //     for (int i = 0; i < msg.len; i++) {
-  //         SERIAL_DEBUG.print("0x");  // Add prefix
-  //         if (msg.buf[i] < 0x10) SERIAL_DEBUG.print("0");  // Ensure leading zero
-  //         SERIAL_DEBUG.print(msg.buf[i], HEX);
-  //         SERIAL_DEBUG.print(" ");
-  //     }
-  //     SERIAL_DEBUG.println();
-  // }
+  //SERIAL_DEBUG.print("CAN read Timeout, msg.id: 0x"); SERIAL_DEBUG.println(msg.id, HEX);
   return false;
-  //tasks.yield(); // Remove this because it causes lock ups!!!!!
+}
+
+// ******Asynchronous interface******
+// Outbound remote requests wait in a small queue (one entry per CAN id) until a transmit mailbox is free,
+// received frames are moved out of the FlexCAN mailboxes into the ring and then dispatched by CAN id
+// into the per-axis telemetry. Heartbeats (0x001) are broadcast by the ODrive and cached the same way.
+
+void ODriveTeensyCAN::poll() {
+  unsigned long now = millis();
+  if (now - lastTelemetryRequest >= ODRIVE_CAN_TELEMETRY_MS) {
+    lastTelemetryRequest = now;
+    for (int axis_id = 0; axis_id < ODRIVE_CAN_AXES; axis_id++) {
+      request(axis_id, CMD_ID_GET_ENCODER_ESTIMATES);
+      request(axis_id, CMD_ID_GET_IQ);
+    }
+  }
+  if (now - lastVbusRequest >= ODRIVE_CAN_VBUS_MS) {
+    lastVbusRequest = now;
+    request(0, CMD_ID_GET_VBUS_VOLTAGE_CURRENT);
+  }
+
+  // transmit staged setpoints first, Set_Input_Pos carries the velocity feed-forward in 0.001 turn/s steps
+  // which rounds a sidereal rate (about 1.2e-5 turn/s) to nothing so Set_Input_Vel follows with it as a float,
+  // the ODrive keeps input_vel from whichever frame came last
+  // an axis that doesn't get a mailbox keeps the rest of its setpoint for the next poll
+  for (int axis_id = 0; axis_id < ODRIVE_CAN_AXES && (streamMask | streamVelocityMask); axis_id++) {
+    uint8_t bit = 1 << axis_id;
+    if (streamMask & bit) {
+      CAN_message_t msg;
+      msg.id = (axis_id << CommandIDLength) + CMD_ID_SET_INPUT_POS;
+      msg.len = 8;
+      positionFrame(msg.buf, streamPosition[axis_id], streamVelocity[axis_id], 0.0f);
+      if (Can0.write(msg) != 1) break;
+      streamMask &= ~bit;
+    }
+    if (streamVelocityMask & bit) {
+      CAN_message_t msg;
+      msg.id = (axis_id << CommandIDLength) + CMD_ID_SET_INPUT_VEL;
+      msg.len = 8;
+      velocityFrame(msg.buf, streamVelocity[axis_id], 0.0f);
+      if (Can0.write(msg) != 1) break;
+      streamVelocityMask &= ~bit;
+    }
+  }
+
+  // transmit queued requests in order until the controller runs out of mailboxes
+  uint8_t sent = 0;
+  while (sent < txCount) {
+    CAN_message_t msg;
+    msg.id = txQueue[sent];
+    msg.flags.remote = true;
+    msg.len = 8;
+    if (Can0.write(msg) != 1) break;
+    sent++;
+  }
+  if (sent > 0) {
+    txCount -= sent;
+    memmove(txQueue, txQueue + sent, txCount*sizeof(txQueue[0]));
+  }
+
+  receive();
+  dispatch();
+}
+
+bool ODriveTeensyCAN::request(int axis_id, int cmd_id) {
+  if (axis_id < 0 || axis_id >= ODRIVE_CAN_AXES || cmd_id < 0 || cmd_id >= ODRIVE_CAN_CMDS) return false;
+  uint16_t id = (axis_id << CommandIDLength) + cmd_id;
+  for (int i = 0; i < txCount; i++) if (txQueue[i] == id) return true;
+  if (txCount >= ODRIVE_CAN_TX_QUEUE) return false;
+  txQueue[txCount++] = id;
+  return true;
+}
+
+void ODriveTeensyCAN::stream(int axis_id, float position, float velocity_feedforward) {
+  if (axis_id < 0 || axis_id >= ODRIVE_CAN_AXES) return;
+  streamPosition[axis_id] = position;
+  streamVelocity[axis_id] = velocity_feedforward;
+  streamMask |= 1 << axis_id;
+  streamVelocityMask |= 1 << axis_id;
+}
+
+// moves frames from the controller into the ring, stops when the ring is full
+void ODriveTeensyCAN::receive() {
+  CAN_message_t msg;
+  while ((uint8_t)(rxHead - rxTail) < ODRIVE_CAN_RX_RING) {
+    if (Can0.read(msg) != 1) break;
+    ODriveFrame *frame = &rxRing[rxHead & (ODRIVE_CAN_RX_RING - 1)];
+    frame->id = msg.id;
+    frame->len = msg.len > 8 ? 8 : msg.len;
+    memcpy(frame->buf, msg.buf, frame->len);
+    rxHead++;
+  }
+}
+
+// stores each frame in the ring under its axis and command id
+void ODriveTeensyCAN::dispatch() {
+  unsigned long now = millis();
+  while (rxTail != rxHead) {
+    ODriveFrame *frame = &rxRing[rxTail & (ODRIVE_CAN_RX_RING - 1)];
+    int axis_id = frame->id >> CommandIDLength;
+    int cmd_id = frame->id & (ODRIVE_CAN_CMDS - 1);
+    if (axis_id < ODRIVE_CAN_AXES) {
+      ODriveTelemetry *t = &telemetry[axis_id];
+      memset(t->data[cmd_id], 0, 8);
+      memcpy(t->data[cmd_id], frame->buf, frame->len);
+      t->time[cmd_id] = now;
+      t->count[cmd_id]++;
+      if (t->count[cmd_id] == 0) t->count[cmd_id] = 1;
+      if (cmd_id == CMD_ID_ODRIVE_HEARTBEAT_MESSAGE) lastHeartbeatAxis = axis_id;
+    }
+    rxTail++;
+  }
+}
+
+bool ODriveTeensyCAN::latest(int axis_id, int cmd_id, byte *signal_bytes, unsigned long *time) {
+  if (axis_id < 0 || axis_id >= ODRIVE_CAN_AXES || cmd_id < 0 || cmd_id >= ODRIVE_CAN_CMDS) return false;
+  if (telemetry[axis_id].count[cmd_id] == 0) return false;
+  if (signal_bytes != NULL) memcpy(signal_bytes, telemetry[axis_id].data[cmd_id], 8);
+  if (time != NULL) *time = telemetry[axis_id].time[cmd_id];
+  return true;
+}
+
+unsigned long ODriveTeensyCAN::age(int axis_id, int cmd_id) {
+  unsigned long time;
+  if (!latest(axis_id, cmd_id, NULL, &time)) return 0xFFFFFFFF;
+  return millis() - time;
+}
+
+uint32_t ODriveTeensyCAN::latestBits(int axis_id, int cmd_id, int offset, unsigned long *time) {
+  byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  uint32_t output = 0;
+  if (!latest(axis_id, cmd_id, msg_data, time) && time != NULL) *time = 0;
+  memcpy(&output, msg_data + offset, 4);
+  return output;
+}
+
+float ODriveTeensyCAN::LatestPosition(int axis_id, unsigned long *time) {
+  uint32_t bits = latestBits(axis_id, CMD_ID_GET_ENCODER_ESTIMATES, 0, time);
+  float output; memcpy(&output, &bits, 4);
+  return output;
+}
+
+float ODriveTeensyCAN::LatestVelocity(int axis_id, unsigned long *time) {
+  uint32_t bits = latestBits(axis_id, CMD_ID_GET_ENCODER_ESTIMATES, 4, time);
+  float output; memcpy(&output, &bits, 4);
+  return output;
+}
+
+int32_t ODriveTeensyCAN::LatestEncoderCountInCPR(int axis_id, unsigned long *time) {
+  return (int32_t)latestBits(axis_id, CMD_ID_GET_ENCODER_COUNT, 4, time);
+}
+
+float ODriveTeensyCAN::LatestIqMeasured(int axis_id, unsigned long *time) {
+  uint32_t bits = latestBits(axis_id, CMD_ID_GET_IQ, 4, time);
+  float output; memcpy(&output, &bits, 4);
+  return output;
+}
+
+float ODriveTeensyCAN::LatestVbusVoltage(unsigned long *time) {
+  uint32_t bits = latestBits(0, CMD_ID_GET_VBUS_VOLTAGE_CURRENT, 0, time);
+  float output; memcpy(&output, &bits, 4);
+  return output;
+}
+
+uint32_t ODriveTeensyCAN::LatestMotorError(int axis_id, unsigned long *time) {
+  return latestBits(axis_id, CMD_ID_GET_MOTOR_ERROR, 0, time);
+}
+
+uint32_t ODriveTeensyCAN::LatestEncoderError(int axis_id, unsigned long *time) {
+  return latestBits(axis_id, CMD_ID_GET_ENCODER_ERROR, 0, time);
 }
 
 // # 0x001 - Heartbeat 
@@ -119,13 +264,13 @@ bool ODriveTeensyCAN::sendMessage(int axis_id, int cmd_id, bool remote_transmiss
 // motorFlags:      bits 40 - 47, byte 5
 // encoderFlags:    bits 48 - 55, byte 6
 // controllerFlags: bits 56 - 63, byte 7
+// returns the axis id of the latest heartbeat, or -1 if none since the last call
 int ODriveTeensyCAN::Heartbeat() {
-  CAN_message_t return_msg;
-	if(Can0.read(return_msg) == 1) {
-		return (int)(return_msg.id >> 5);
-	} else {
-		return -1;
-	}
+  receive();
+  dispatch();
+  int axis_id = lastHeartbeatAxis;
+  lastHeartbeatAxis = -1;
+  return axis_id;
 }
 
 void ODriveTeensyCAN::SetAxisNodeId(int axis_id, int node_id) {
@@ -164,13 +309,26 @@ void ODriveTeensyCAN::setPosition(int axis_id, float position, float velocity_fe
 }
 
 void ODriveTeensyCAN::setPosition(int axis_id, float position, float velocity_feedforward, float current_feedforward) {
-  int16_t vel_ff = (int16_t) (feedforwardFactor * velocity_feedforward);
-  int16_t curr_ff = (int16_t) (feedforwardFactor * current_feedforward);
+  byte msg_data[8];
+  positionFrame(msg_data, position, velocity_feedforward, current_feedforward);
+  sendMessage(axis_id, CMD_ID_SET_INPUT_POS, false, 8, msg_data);
+}
+
+// the feed-forwards are rounded to the nearest 0.001 and held to what an int16_t can carry
+static int16_t feedforward(float value) {
+  float scaled = roundf(feedforwardFactor * value);
+  if (scaled > 32767.0F) return 32767;
+  if (scaled < -32768.0F) return -32768;
+  return (int16_t)scaled;
+}
+
+void ODriveTeensyCAN::positionFrame(byte *msg_data, float position, float velocity_feedforward, float current_feedforward) {
+  int16_t vel_ff = feedforward(velocity_feedforward);
+  int16_t curr_ff = feedforward(current_feedforward);
 
   byte* position_b = (byte*) &position;
   byte* velocity_feedforward_b = (byte*) &vel_ff;
   byte* current_feedforward_b = (byte*) &curr_ff;
-  byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
 
   msg_data[0] = position_b[0];
   msg_data[1] = position_b[1];
@@ -180,8 +338,6 @@ void ODriveTeensyCAN::setPosition(int axis_id, float position, float velocity_fe
   msg_data[5] = velocity_feedforward_b[1];
   msg_data[6] = current_feedforward_b[0];
   msg_data[7] = current_feedforward_b[1];
-
-  sendMessage(axis_id, CMD_ID_SET_INPUT_POS, false, 8, msg_data);
 }
 
 void ODriveTeensyCAN::SetVelocity(int axis_id, float velocity) {
@@ -189,9 +345,14 @@ void ODriveTeensyCAN::SetVelocity(int axis_id, float velocity) {
 }
 
 void ODriveTeensyCAN::SetVelocity(int axis_id, float velocity, float current_feedforward) {
+  byte msg_data[8];
+  velocityFrame(msg_data, velocity, current_feedforward);
+  sendMessage(axis_id, CMD_ID_SET_INPUT_VEL, false, 8, msg_data);
+}
+
+void ODriveTeensyCAN::velocityFrame(byte *msg_data, float velocity, float current_feedforward) {
   byte* velocity_b = (byte*) &velocity;
   byte* current_feedforward_b = (byte*) &current_feedforward;
-  byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
 
   msg_data[0] = velocity_b[0];
   msg_data[1] = velocity_b[1];
@@ -201,8 +362,6 @@ void ODriveTeensyCAN::SetVelocity(int axis_id, float velocity, float current_fee
   msg_data[5] = current_feedforward_b[1];
   msg_data[6] = current_feedforward_b[2];
   msg_data[7] = current_feedforward_b[3];
-  
-  sendMessage(axis_id, CMD_ID_SET_INPUT_VEL, false, 8, msg_data);
 }
 
 void ODriveTeensyCAN::SetTorque(int axis_id, float torque) {
@@ -419,60 +578,24 @@ uint32_t ODriveTeensyCAN::GetEncoderError(int axis_id) {
   return output;
 }
 
-// NOTE: The CAN default Heartbeat is 100 msec. 
+// NOTE: The CAN default Heartbeat is 100 msec.
+// these used to wait (forever) for the next heartbeat, now they return the latest one or 0 if none yet
 uint32_t ODriveTeensyCAN::GetAxisError(int axis_id) {
-  byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-  uint32_t output;
-  CAN_message_t return_msg;
-  uint32_t msg_id = (axis_id << CommandIDLength) + CMD_ID_ODRIVE_HEARTBEAT_MESSAGE;
-
-  while(true) {
-      if (Can0.read(return_msg) && (return_msg.id == msg_id)) {
-          memcpy(msg_data, return_msg.buf, sizeof(return_msg.buf));
-          *((uint8_t *)(&output) + 0) = msg_data[0];
-          *((uint8_t *)(&output) + 1) = msg_data[1];
-          *((uint8_t *)(&output) + 2) = msg_data[2];
-          *((uint8_t *)(&output) + 3) = msg_data[3];
-          return output;  // Successfully received message
-      }
-    tasks.yield();
-  }
+  receive();
+  dispatch();
+  return latestBits(axis_id, CMD_ID_ODRIVE_HEARTBEAT_MESSAGE, 0, NULL);
 }
 
 uint8_t ODriveTeensyCAN::GetControllerFlags(int axis_id) {
-  byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-  uint8_t output;
-
-  CAN_message_t return_msg;
-
-  uint32_t msg_id = (axis_id << CommandIDLength) + CMD_ID_ODRIVE_HEARTBEAT_MESSAGE;
-
-  while (true) {
-    if (Can0.read(return_msg) && (return_msg.id == msg_id)) {
-      memcpy(msg_data, return_msg.buf, sizeof(return_msg.buf));
-      *((uint8_t *)(&output) + 0) = msg_data[7];
-      return output;
-    }
-  }
-  tasks.yield();
+  receive();
+  dispatch();
+  return (uint8_t)(latestBits(axis_id, CMD_ID_ODRIVE_HEARTBEAT_MESSAGE, 4, NULL) >> 24);
 }
 
 uint8_t ODriveTeensyCAN::GetCurrentState(int axis_id) {
-  byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-  uint8_t output;
-
-  CAN_message_t return_msg;
-
-  uint32_t msg_id = (axis_id << CommandIDLength) + CMD_ID_ODRIVE_HEARTBEAT_MESSAGE;
-
-  while (true) {
-    if (Can0.read(return_msg) && (return_msg.id == msg_id)) {
-      memcpy(msg_data, return_msg.buf, sizeof(return_msg.buf));
-      *((uint8_t *)(&output) + 0) = msg_data[4];
-      return output;
-    }
-  }
-  tasks.yield();
+  receive();
+  dispatch();
+  return (uint8_t)latestBits(axis_id, CMD_ID_ODRIVE_HEARTBEAT_MESSAGE, 4, NULL);
 }
 
 // Some Documentation indicates this returns both voltage and current but only using voltage here
@@ -488,10 +611,6 @@ float ODriveTeensyCAN::GetVbusVoltage(int axis_id) {  //message can be sent to e
     *((uint8_t *)(&output) + 1) = msg_data[1];
     *((uint8_t *)(&output) + 2) = msg_data[2];
     *((uint8_t *)(&output) + 3) = msg_data[3];
-    *((uint8_t *)(&output) + 4) = msg_data[4];
-    *((uint8_t *)(&output) + 5) = msg_data[5];
-    *((uint8_t *)(&output) + 6) = msg_data[6];
-    *((uint8_t *)(&output) + 7) = msg_data[7];
     return output;
 }
 
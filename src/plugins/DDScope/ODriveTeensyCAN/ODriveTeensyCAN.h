@@ -3,6 +3,26 @@
 
 #include "Arduino.h"
 
+#define ODRIVE_CAN_AXES          2    // node ids 0 and 1
+#define ODRIVE_CAN_CMDS          32   // CAN Simple command ids are 5 bits
+#define ODRIVE_CAN_RX_RING       32   // received frames waiting for dispatch, power of 2
+#define ODRIVE_CAN_TX_QUEUE      8    // remote requests waiting for a free transmit mailbox
+#define ODRIVE_CAN_TELEMETRY_MS  100  // encoder estimates and Iq are requested this often by poll()
+#define ODRIVE_CAN_VBUS_MS       1000 // bus voltage is requested this often by poll()
+
+typedef struct ODriveFrame {
+  uint32_t id;
+  uint8_t len;
+  uint8_t buf[8];
+} ODriveFrame;
+
+// the latest frame received for each command id on one axis
+typedef struct ODriveTelemetry {
+  uint8_t data[ODRIVE_CAN_CMDS][8];
+  unsigned long time[ODRIVE_CAN_CMDS];  // millis() when the frame arrived
+  uint8_t count[ODRIVE_CAN_CMDS];       // incremented for each frame, 0 if none yet
+} ODriveTelemetry;
+
 class ODriveTeensyCAN {
   public:
     
@@ -64,8 +84,37 @@ class ODriveTeensyCAN {
     int CANBaudRate = 250000;  //250,000 is odrive default
 
     bool sendMessage(int axis_id, int cmd_id, bool remote_transmission_request, int length, byte *signal_bytes);
+
+    // Asynchronous interface
+    // transmits queued requests, moves received frames into the ring and dispatches them to the telemetry
+    // also requests the encoder estimates, Iq and bus voltage periodically, call often (see DDScope init)
+    void poll();
+    // queue a remote request for cmd_id, the reply updates the telemetry when it arrives
+    bool request(int axis_id, int cmd_id);
+    // copies the latest frame for cmd_id, returns false if none has arrived yet
+    // time is set to millis() when it arrived
+    bool latest(int axis_id, int cmd_id, byte *signal_bytes, unsigned long *time = NULL);
+    // milliseconds since the latest frame for cmd_id arrived, or 0xFFFFFFFF if none yet
+    unsigned long age(int axis_id, int cmd_id);
+    // stage a position setpoint with velocity feed-forward (turns, turns/s), poll() sends the latest
+    // setpoint for each axis together ahead of the queued requests, as Set_Input_Pos then Set_Input_Vel
+    // so the feed-forward keeps full float resolution
+    void stream(int axis_id, float position, float velocity_feedforward);
+    // true while any of this axis' staged setpoint is still waiting for a transmit mailbox
+    inline bool streamPending(int axis_id) { return (streamMask | streamVelocityMask) & (1 << axis_id); }
+
+    // latest values, these never block and return 0 until the first frame arrives
+    float LatestPosition(int axis_id, unsigned long *time = NULL);
+    float LatestVelocity(int axis_id, unsigned long *time = NULL);
+    int32_t LatestEncoderCountInCPR(int axis_id, unsigned long *time = NULL);
+    float LatestIqMeasured(int axis_id, unsigned long *time = NULL);
+    float LatestVbusVoltage(unsigned long *time = NULL);
+    uint32_t LatestMotorError(int axis_id, unsigned long *time = NULL);
+    uint32_t LatestEncoderError(int axis_id, unsigned long *time = NULL);
     
-    // Heartbeat
+    // Heartbeat, returns the axis id of the latest heartbeat frame received since the last call or -1 if none
+    // note: this used to read whatever frame was next on the bus and return its node id, other frames now go
+    // to the telemetry and when both axes send a heartbeat between calls only the later one is reported
     int Heartbeat();
 
     // Setters
@@ -86,7 +135,8 @@ class ODriveTeensyCAN {
     void SetPositionGain(int axis_id, float position_gain);
     void SetVelocityGains(int axis_id, float velocity_gain, float velocity_integrator_gain);
 
-    // Getters
+    // Getters, these block until the reply arrives (or times out) except for the heartbeat values
+    // (axis error, controller flags, current state) which the ODrive broadcasts and are read from the telemetry
     float GetPosition(int axis_id);
     float GetVelocity(int axis_id);
     int32_t GetEncoderShadowCount(int axis_id);
@@ -112,6 +162,30 @@ class ODriveTeensyCAN {
     // State helper
     bool RunState(int axis_id, int requested_state);
 
+  private:
+    void receive();
+    void dispatch();
+    uint32_t latestBits(int axis_id, int cmd_id, int offset, unsigned long *time);
+    void positionFrame(byte *msg_data, float position, float velocity_feedforward, float current_feedforward);
+    void velocityFrame(byte *msg_data, float velocity, float current_feedforward);
+
+    ODriveTelemetry telemetry[ODRIVE_CAN_AXES];
+
+    ODriveFrame rxRing[ODRIVE_CAN_RX_RING];
+    volatile uint8_t rxHead = 0;
+    volatile uint8_t rxTail = 0;
+
+    uint16_t txQueue[ODRIVE_CAN_TX_QUEUE];  // CAN ids of pending remote requests
+    uint8_t txCount = 0;
+
+    float streamPosition[ODRIVE_CAN_AXES];
+    float streamVelocity[ODRIVE_CAN_AXES];
+    uint8_t streamMask = 0;                  // bit per axis with a staged setpoint
+    uint8_t streamVelocityMask = 0;          // bit per axis with its Set_Input_Vel follow-up still to send
+
+    unsigned long lastTelemetryRequest = 0;
+    unsigned long lastVbusRequest = 0;
+    int lastHeartbeatAxis = -1;
 };
 
 #endif
\ No newline at end of file
@@ -45,18 +45,24 @@ void CatMgr::setLat(double lat) {
     _cosLat=cos(lat/Rad);
     _sinLat=sin(lat/Rad);
   }
+  _cellMaskValid=false;
+  _matchReady=false; _matchCatalog=-1;
 }
 
 // Set Local Sidereal Time, and number of milliseconds
 void CatMgr::setLstT0(double lstT0) {
   _lstT0=lstT0;
   _lstMillisT0=millis();
+  _cellMaskValid=false;
+  _matchReady=false; _matchCatalog=-1;
 }
 
 // Set last Tele RA/Dec
 void CatMgr::setLastTeleEqu(double RA, double Dec) {
   _lastTeleRA=RA;
   _lastTeleDec=Dec;
+  _cellMaskValid=false;
+  _matchReady=false; _matchCatalog=-1;
 }
 
 bool CatMgr::isInitialized() {
@@ -94,11 +100,38 @@ dso_t*            _dsoCatalog          = NULL;
 dso_comp_t*       _dsoCompCatalog      = NULL;
 dso_vcomp_t*      _dsoVCompCatalog     = NULL;
 
+// spatial index for the selected catalog, cell number of each record and a bit per cell that can pass the position filters
+uint16_t          _cellOf[CAT_INDEX_MAX_RECORDS];
+uint8_t           _cellMask[(CAT_CELL_COUNT+7)/8];
+
+// record indexes (ascending) of the selected catalog that pass the active filters
+uint16_t          _matchList[CAT_INDEX_MAX_RECORDS];
+
+// lookup tables for the selected catalog, offsets of each element in the ';' joined name/subId/prefix strings
+// and the number of records with Has_name/Has_subId set before each block of CAT_RANK_BLOCK records
+uint16_t          _nameOffset[CAT_INDEX_MAX_RECORDS];
+uint16_t          _subIdOffset[CAT_INDEX_MAX_RECORDS];
+uint16_t          _prefixOffset[CAT_PREFIX_MAX_ELEMENTS];
+uint16_t          _nameRank[CAT_INDEX_MAX_RECORDS/CAT_RANK_BLOCK+1];
+uint16_t          _subIdRank[CAT_INDEX_MAX_RECORDS/CAT_RANK_BLOCK+1];
+
+// object name search keys, one per word of every name in all catalogs (offset into that catalog's ObjectNames)
+// sorted case-insensitively by the text from there to the end of the name
+typedef struct {
+  uint32_t offset;
+  uint16_t index;
+  uint8_t  cat;
+} cat_key_t;
+cat_key_t         _nameKeys[CAT_SEARCH_MAX_KEYS];
+
 // handle catalog selection (0..n)
 void CatMgr::select(int number) {
   _genStarCatalog      =NULL;
   _genStarVCompCatalog =NULL;
   _dblStarCatalog      =NULL;
+  _dblStarCompCatalog  =NULL;
+  _varStarCatalog      =NULL;
+  _varStarCompCatalog  =NULL;
   _dsoCatalog          =NULL;
   _dsoCompCatalog      =NULL;
   _dsoVCompCatalog     =NULL;
@@ -173,7 +206,7 @@ bool CatMgr::isDsoCatalog()  {
 const char* CatMgr::catalogTitle() {
   if (_selected<0) return "";
 
-  char *subMenu=strstr(catalog[_selected].Title,">");
+  const char *subMenu=strstr(catalog[_selected].Title,">");
   if (subMenu) {
     return &subMenu[1];
   } else return catalog[_selected].Title;
@@ -204,9 +237,9 @@ const char* CatMgr::catalogPrefix() {
     const char *s1;
     long p=primaryId();
     if (p>=0) {
-      s1=getElementFromString(s,p);
+      if (lookupTablesReady() && _prefixElements>0) s1=getElement(s,_prefixOffset,_prefixElements,p); else s1=getElementFromString(s,p);
       if (strlen(s1)>0) return s1; else {
-        s1=getElementFromString(s,0);
+        if (lookupTablesReady() && _prefixElements>0) s1=getElement(s,_prefixOffset,_prefixElements,0); else s1=getElementFromString(s,0);
         static char s2[24];
         sprintf(s2,"%s%ld",s1,p);
         return s2;
@@ -218,14 +251,20 @@ const char* CatMgr::catalogPrefix() {
 // catalog filtering
 void CatMgr::filtersClear() {
   _fm=FM_NONE;
+  _cellMaskValid=false;
+  _matchReady=false; _matchCatalog=-1;
 }
 
 void CatMgr::filterAdd(int fm) {
   _fm|=fm;
+  _cellMaskValid=false;
+  _matchReady=false; _matchCatalog=-1;
 }
 
 void CatMgr::filterAdd(int fm, int param) {
   _fm|=fm;
+  _cellMaskValid=false;
+  _matchReady=false; _matchCatalog=-1;
   if (fm&FM_CONSTELLATION) _fm_con=param;
   if (fm&FM_BY_MAG) {
     if (param==0) _fm_mag_limit=10.0; else
@@ -300,14 +339,15 @@ bool CatMgr::isFiltered() {
   if (_fm & FM_CONSTELLATION) { if (constellation()!=_fm_con) return true; }
   if (_fm & FM_OBJ_TYPE)      { if (isDsoCatalog() && (objectType()!=_fm_obj_type)) return true; }
   if (_fm & FM_BY_MAG)        { if (magnitude()>=_fm_mag_limit) return true; }
+  if (hasPositionFilter())    { if (!isCellCandidate()) return true; }
   if (_fm & FM_NEARBY)        { if (DistFromEqu(_lastTeleRA,_lastTeleDec)>=_fm_nearby_dist) return true; }
   if (_fm & FM_DBL_MAX_SEP)   { if (isDblStarCatalog() && ((separation()>_fm_dbl_max) || (separation()<0))) return true; }
   if (_fm & FM_DBL_MIN_SEP)   { if (isDblStarCatalog() && ((separation()<_fm_dbl_min) || (separation()<0))) return true; }
   if (_fm & FM_VAR_MAX_PER)   { if (isVarStarCatalog() && ((period()    >_fm_var_max) || (period()    <0))) return true; }
-  if (_fm & FM_ABOVE_HORIZON) { if (alt()<10.0) return true; } //DD Note: changed to 10.0 from the original 0.0
+  if (_fm & FM_ABOVE_HORIZON) { if ((_altCached ? _altCache : alt())<10.0) return true; } //DD Note: changed to 10.0 from the original 0.0
   if (_fm & FM_ALIGN_ALL_SKY) {
     if (magnitude()>3.0) return true; // maximum magnitude 3.0
-    if (alt()<10.0) return true;      // minimum 10 degrees altitude
+    if ((_altCached ? _altCache : alt())<10.0) return true; // minimum 10 degrees altitude
     if (abs(dec())>80.0) return true; // minimum 10 degrees from the pole (for accuracy)
   }
   return false;
@@ -330,6 +370,14 @@ long CatMgr::getMaxIndex() {
 }
 
 bool CatMgr::incIndex() {
+  if (isMatchListActive()) {
+    if (_matchCount==0) return false;
+    long n=findMatch(catalog[_selected].Index+1);
+    if (n>=_matchCount) n=0;
+    catalog[_selected].Index=_matchList[n];
+    return true;
+  }
+
   long i=getMaxIndex()+1;
   do {
     i--;
@@ -340,6 +388,14 @@ bool CatMgr::incIndex() {
 }
 
 bool CatMgr::decIndex() {
+  if (isMatchListActive()) {
+    if (_matchCount==0) return false;
+    long n=findMatch(catalog[_selected].Index)-1;
+    if (n<0) n=_matchCount-1;
+    catalog[_selected].Index=_matchList[n];
+    return true;
+  }
+
   long i=getMaxIndex()+1;
   do {
     i--;
@@ -349,6 +405,326 @@ bool CatMgr::decIndex() {
   if (isFiltered()) return false; else return true;
 }
 
+// advance the match list rebuild by up to CAT_MATCH_CHUNK records, returns true once the list is complete
+// so callers can slice a rebuild across task calls
+bool CatMgr::matchListPoll() {
+  if (_selected<0 || !isFiltering()) return true;
+  if (_matchCatalog!=_selected || (_matchReady && isMatchListStale())) {
+    _matchCatalog=_selected;
+    _matchScanned=0;
+    _matchCount=0;
+    _matchReady=false;
+    _matchLst=lstDegs();
+  }
+  if (_matchReady) return true;
+
+  long savedIndex=catalog[_selected].Index;
+  long last=_matchScanned+CAT_MATCH_CHUNK;
+  if (last>getMaxIndex()+1) last=getMaxIndex()+1;
+
+  // altitudes for the whole chunk in one pass when a horizon filter is active
+  static long indices[CAT_MATCH_CHUNK];
+  static float alts[CAT_MATCH_CHUNK];
+  int count=last-_matchScanned;
+  bool batchAlt=(_fm & (FM_ABOVE_HORIZON|FM_ALIGN_ALL_SKY));
+  if (batchAlt) {
+    for (int j=0; j<count; j++) indices[j]=_matchScanned+j;
+    EquToHorBatch(indices,count,alts,NULL);
+  }
+
+  for (long i=_matchScanned; i<last; i++) {
+    catalog[_selected].Index=i;
+    if (batchAlt) { _altCached=true; _altCache=alts[i-_matchScanned]; }
+    if (!isFiltered() && _matchCount<CAT_INDEX_MAX_RECORDS) _matchList[_matchCount++]=i;
+  }
+  _altCached=false;
+  catalog[_selected].Index=savedIndex;
+  _matchScanned=last;
+  if (_matchScanned>getMaxIndex()) _matchReady=true;
+  return _matchReady;
+}
+
+// false until matchListPoll() has built the list for the selected catalog, and again once the sidereal
+// time has moved far enough that it needs rebuilding
+bool CatMgr::matchListReady() {
+  return !isFiltering() || (_matchReady && _matchCatalog==_selected && !isMatchListStale());
+}
+
+// number of records that pass the active filters, only valid once matchListReady()
+long CatMgr::matchCount() {
+  if (_selected<0) return 0;
+  if (!isFiltering()) return getMaxIndex()+1;
+  return _matchCount;
+}
+
+// select the n'th record that passes the active filters (0..matchCount()-1)
+bool CatMgr::setMatch(long n) {
+  if (_selected<0 || n<0 || n>=matchCount()) return false;
+  if (!isFiltering()) catalog[_selected].Index=n; else
+  if (isMatchListActive()) catalog[_selected].Index=_matchList[n]; else return false;
+  return true;
+}
+
+// the match list replaces filter walks once it has been built for the selected catalog
+bool CatMgr::isMatchListActive() {
+  return _matchReady && _matchCatalog==_selected && isFiltering() && catalog[_selected].NumObjects<=CAT_INDEX_MAX_RECORDS && !isMatchListStale();
+}
+
+// altitude filtered lists are only good for CAT_CELL_LST_MARGIN of sidereal time, like the cell mask
+bool CatMgr::isMatchListStale() {
+  return (_fm & (FM_ABOVE_HORIZON|FM_ALIGN_ALL_SKY)) && fabs(lstDegs()-_matchLst)>CAT_CELL_LST_MARGIN;
+}
+
+// checks to see if isFiltered() can reject any record
+bool CatMgr::isFiltering() {
+  return isInitialized() && _fm!=FM_NONE;
+}
+
+// position in the match list of the first match at or after record index
+long CatMgr::findMatch(long index) {
+  long lo=0, hi=_matchCount;
+  while (lo<hi) {
+    long mid=(lo+hi)/2;
+    if (_matchList[mid]<index) lo=mid+1; else hi=mid;
+  }
+  return lo;
+}
+
+// object search
+
+// case-insensitive compare of ';' or null terminated names, if len>0 only the first len characters of b are compared
+static int compareNames(const char *a, const char *b, int len) {
+  for (int i=0; len<=0 || i<len; i++) {
+    int ca=(a[i]==';' || a[i]==0) ? -1 : tolower((unsigned char)a[i]);
+    int cb=(b[i]==';' || b[i]==0) ? -1 : tolower((unsigned char)b[i]);
+    if (ca!=cb) return ca<cb ? -1 : 1;
+    if (ca==-1) return 0;
+  }
+  return 0;
+}
+
+static const char *nameKeyText(const cat_key_t *key) {
+  return catalog[key->cat].ObjectNames+key->offset;
+}
+
+static int compareNameKeys(const void *a, const void *b) {
+  const cat_key_t *ka=(const cat_key_t*)a, *kb=(const cat_key_t*)b;
+  int c=compareNames(nameKeyText(ka),nameKeyText(kb),0);
+  if (c!=0) return c;
+  if (ka->cat!=kb->cat) return ka->cat<kb->cat ? -1 : 1;
+  return ka->index<kb->index ? -1 : (ka->index>kb->index);
+}
+
+// Identifiers are tried first, an optional catalog prefix or title ("M", "NGC", "IC", "Caldwell", "STF"...) followed
+// by the primary id, for example "M31", "NGC 7000" or "C 14".  The catalogs are generated in id order so each is
+// binary searched as it is.  If nothing matches that way the query is looked up in the name keys, a table of every
+// word of every object name sorted at the first search, so "andromeda", "Pleiades" or "galaxy" match any name with
+// a word starting that way (case-insensitive), words past the first CAT_SEARCH_MAX_KEYS are scanned for after that.
+// Up to maxResults matches are returned, ids in catalog order and names in name order, and the catalog selection
+// is left as it was.
+int CatMgr::findObjects(const char *query, cat_match_t *results, int maxResults) {
+  char q[CAT_SEARCH_MAX_QUERY+1];
+  int n=0;
+
+  // trim and copy the query
+  while (*query==' ') query++;
+  strncpy(q,query,CAT_SEARCH_MAX_QUERY); q[CAT_SEARCH_MAX_QUERY]=0;
+  int len=strlen(q);
+  while (len>0 && q[len-1]==' ') q[--len]=0;
+  if (len==0 || maxResults<1) return 0;
+
+  int savedSelected=_selected;
+  long savedIndex=(_selected>=0) ? catalog[_selected].Index : 0;
+
+  // split into a prefix and a trailing id number
+  int idStart=len;
+  while (idStart>0 && isdigit(q[idStart-1])) idStart--;
+  int prefixLen=idStart;
+  while (prefixLen>0 && q[prefixLen-1]==' ') prefixLen--;
+  long id=(idStart<len) ? atol(&q[idStart]) : -1;
+
+  if (id>0) {
+    for (int c=0; c<numCatalogs() && n<maxResults; c++) {
+      select(c);
+      if (strstr(catalog[c].Prefix,";")) continue; // array type prefixes can't be matched to an id
+      if (!prefixMatches(q,prefixLen)) continue;
+      long i=findPrimaryId(id);
+      if (i>=0) { results[n].cat=c; results[n].index=i; n++; }
+    }
+  }
+
+  if (n==0) {
+    if (!_nameKeysReady) buildNameKeys();
+
+    // first key at or after the query then every key that starts with it
+    long lo=0, hi=_nameKeyCount;
+    while (lo<hi) {
+      long mid=(lo+hi)/2;
+      if (compareNames(nameKeyText(&_nameKeys[mid]),q,len)<0) lo=mid+1; else hi=mid;
+    }
+    for (long k=lo; k<_nameKeyCount && n<maxResults; k++) {
+      if (compareNames(nameKeyText(&_nameKeys[k]),q,len)!=0) break;
+      // more than one word of a name can match
+      bool found=false;
+      for (int r=0; r<n; r++) { if (results[r].cat==_nameKeys[k].cat && results[r].index==_nameKeys[k].index) found=true; }
+      if (!found) { results[n].cat=_nameKeys[k].cat; results[n].index=_nameKeys[k].index; n++; }
+    }
+    if (_nameKeysDropped>0 && n<maxResults) scanNameWords(q,len,results,&n,maxResults);
+  }
+
+  select(savedSelected);
+  if (_selected>=0) catalog[_selected].Index=savedIndex;
+  return n;
+}
+
+// find the best match only, gives its RA (hours) and Dec (degrees) and leaves the catalog selection as it was
+bool CatMgr::findObject(const char *query, int *cat, long *index, double *RA, double *Dec) {
+  cat_match_t result;
+  if (findObjects(query,&result,1)==0) return false;
+
+  int savedSelected=_selected;
+  long savedIndex=(_selected>=0) ? catalog[_selected].Index : 0;
+  long savedMatchIndex=catalog[result.cat].Index;
+
+  select(result.cat);
+  catalog[_selected].Index=result.index;
+  *RA=rah();
+  *Dec=dec();
+
+  catalog[result.cat].Index=savedMatchIndex;
+  select(savedSelected);
+  if (_selected>=0) catalog[_selected].Index=savedIndex;
+
+  *cat=result.cat;
+  *index=result.index;
+  return true;
+}
+
+// number of name words that didn't fit in the name keys, these are still found but by a linear scan
+// so CAT_SEARCH_MAX_KEYS should be raised to cover the names of the catalogs in CatalogConfig.h
+long CatMgr::nameKeysDropped() {
+  if (!_nameKeysReady) buildNameKeys();
+  return _nameKeysDropped;
+}
+
+// builds the name keys, every word of every object name in all catalogs sorted by the text from there on
+// if there are more than CAT_SEARCH_MAX_KEYS words the position of the first that didn't fit is kept
+void CatMgr::buildNameKeys() {
+  int savedSelected=_selected;
+  _nameKeyCount=0;
+  _nameKeysDropped=0;
+
+  for (int c=0; c<numCatalogs(); c++) {
+    const char *names=catalog[c].ObjectNames;
+    if (names==NULL || names[0]==0) continue;
+    select(c);
+
+    // the n'th name belongs to the n'th record with Has_name set
+    const char *s=names;
+    for (long i=0; i<=getMaxIndex() && *s; i++) {
+      if (!hasName(i)) continue;
+      bool wordStart=true;
+      for (; *s && *s!=';'; s++) {
+        if (*s==' ') { wordStart=true; continue; }
+        if (wordStart) {
+          if (_nameKeyCount<CAT_SEARCH_MAX_KEYS) {
+            _nameKeys[_nameKeyCount].offset=s-names;
+            _nameKeys[_nameKeyCount].index=i;
+            _nameKeys[_nameKeyCount].cat=c;
+            _nameKeyCount++;
+          } else {
+            if (_nameKeysDropped==0) { _nameScanCat=c; _nameScanIndex=i; _nameScanOffset=s-names; }
+            _nameKeysDropped++;
+          }
+        }
+        wordStart=false;
+      }
+      if (*s==';') s++;
+    }
+  }
+  qsort(_nameKeys,_nameKeyCount,sizeof(cat_key_t),compareNameKeys);
+
+  select(savedSelected);
+  _nameKeysReady=true;
+}
+
+// looks for the query in the name words that didn't fit in the name keys, walking the names from the
+// first of those on and adding any record not already in the results
+void CatMgr::scanNameWords(const char *q, int len, cat_match_t *results, int *n, int maxResults) {
+  for (int c=_nameScanCat; c<numCatalogs() && *n<maxResults; c++) {
+    const char *names=catalog[c].ObjectNames;
+    if (names==NULL || names[0]==0) continue;
+    select(c);
+
+    bool first=(c==_nameScanCat);
+    const char *s=first ? names+_nameScanOffset : names;
+    for (long i=first ? _nameScanIndex : 0; i<=getMaxIndex() && *s && *n<maxResults; i++) {
+      if (!hasName(i)) continue;
+      bool wordStart=true, matched=false;
+      for (; *s && *s!=';'; s++) {
+        if (*s==' ') { wordStart=true; continue; }
+        if (wordStart && !matched && compareNames(s,q,len)==0) matched=true;
+        wordStart=false;
+      }
+      if (*s==';') s++;
+      if (!matched) continue;
+
+      bool found=false;
+      for (int r=0; r<*n; r++) { if (results[r].cat==c && results[r].index==i) found=true; }
+      if (!found) { results[*n].cat=c; results[*n].index=i; (*n)++; }
+    }
+  }
+}
+
+// checks to see if the first queryLen characters of query name the selected catalog
+bool CatMgr::prefixMatches(const char *query, int queryLen) {
+  const char *prefix=catalog[_selected].Prefix;
+  int prefixLen=strlen(prefix);
+  while (prefixLen>0 && prefix[prefixLen-1]==' ') prefixLen--;
+  if (queryLen==prefixLen && strncasecmp(query,prefix,queryLen)==0) return true;
+
+  // the catalog title "Messier", "NGC", "IC"...
+  const char *title=catalogTitle();
+  int titleLen=0;
+  while (isalnum(title[titleLen])) titleLen++;
+  if (queryLen>0 && queryLen==titleLen && strncasecmp(query,title,queryLen)==0) return true;
+
+  // the "N" and "I" prefixes are NGC and IC numbers
+  if (prefixLen==1 && toupper(prefix[0])=='N' && queryLen==3 && strncasecmp(query,"NGC",3)==0) return true;
+  if (prefixLen==1 && toupper(prefix[0])=='I' && queryLen==2 && strncasecmp(query,"IC",2)==0) return true;
+  return false;
+}
+
+// primary id of record index in the selected catalog
+long CatMgr::recordId(long index) {
+  if (catalogType()==CAT_GEN_STAR)       return _genStarCatalog[index].Obj_id; else
+  if (catalogType()==CAT_GEN_STAR_VCOMP) return index+1; else
+  if (catalogType()==CAT_DBL_STAR)       return _dblStarCatalog[index].Obj_id; else
+  if (catalogType()==CAT_DBL_STAR_COMP)  return _dblStarCompCatalog[index].Obj_id; else
+  if (catalogType()==CAT_VAR_STAR)       return _varStarCatalog[index].Obj_id; else
+  if (catalogType()==CAT_VAR_STAR_COMP)  return _varStarCompCatalog[index].Obj_id; else
+  if (catalogType()==CAT_DSO)            return _dsoCatalog[index].Obj_id; else
+  if (catalogType()==CAT_DSO_COMP)       return _dsoCompCatalog[index].Obj_id; else
+  if (catalogType()==CAT_DSO_VCOMP)      return index+1; else return -1;
+}
+
+// record index with the given primary id in the selected catalog, -1 if not found
+// the catalogs are generated in id order so a binary search is used, with a linear scan if that misses
+long CatMgr::findPrimaryId(long id) {
+  long lo=0, hi=getMaxIndex();
+  while (lo<=hi) {
+    long mid=(lo+hi)/2;
+    long midId=recordId(mid);
+    if (midId==id) {
+      while (mid>0 && recordId(mid-1)==id) mid--;
+      return mid;
+    }
+    if (midId<id) lo=mid+1; else hi=mid-1;
+  }
+  for (long i=0; i<=getMaxIndex(); i++) { if (recordId(i)==id) return i; }
+  return -1;
+}
+
 // get catalog contents
 
 // RA, converted from hours to degrees
@@ -632,19 +1008,12 @@ long CatMgr::objectName() {
   if (catalogType()==CAT_DSO_VCOMP)      { if (!_dsoVCompCatalog[catalog[_selected].Index].Has_name) return -1; } else return -1;
 
   // find the code
-  long result=-1;
   long j=catalog[_selected].Index;
   if (j>getMaxIndex()) j=-1;
   if (j<0) return -1;
-  if (catalogType()==CAT_GEN_STAR)       { for (long i=0; i<=j; i++) { if (_genStarCatalog[i].Has_name) result++; } } else
-  if (catalogType()==CAT_GEN_STAR_VCOMP) { for (long i=0; i<=j; i++) { if (_genStarVCompCatalog[i].Has_name) result++; } } else
-  if (catalogType()==CAT_DBL_STAR)       { for (long i=0; i<=j; i++) { if (_dblStarCatalog[i].Has_name) result++; } } else
-  if (catalogType()==CAT_DBL_STAR_COMP)  { for (long i=0; i<=j; i++) { if (_dblStarCompCatalog[i].Has_name) result++; } } else
-  if (catalogType()==CAT_VAR_STAR)       { for (long i=0; i<=j; i++) { if (_varStarCatalog[i].Has_name) result++; } } else
-  if (catalogType()==CAT_VAR_STAR_COMP)  { for (long i=0; i<=j; i++) { if (_varStarCompCatalog[i].Has_name) result++; } } else
-  if (catalogType()==CAT_DSO)            { for (long i=0; i<=j; i++) { if (_dsoCatalog[i].Has_name) result++; } } else
-  if (catalogType()==CAT_DSO_COMP)       { for (long i=0; i<=j; i++) { if (_dsoCompCatalog[i].Has_name) result++; } } else
-  if (catalogType()==CAT_DSO_VCOMP)      { for (long i=0; i<=j; i++) { if (_dsoVCompCatalog[i].Has_name) result++; } } else return -1;
+  long i=0, result=-1;
+  if (lookupTablesReady()) { i=j-(j%CAT_RANK_BLOCK); result=_nameRank[j/CAT_RANK_BLOCK]-1; }
+  for (; i<=j; i++) { if (hasName(i)) result++; }
 
   return result;
 }
@@ -653,7 +1022,9 @@ long CatMgr::objectName() {
 const char* CatMgr::objectNameStr() {
   if (_selected<0) return "";
   long elementNum=objectName();
-  if (elementNum>=0) return getElementFromString(catalog[_selected].ObjectNames,elementNum); else return "";
+  if (elementNum<0) return "";
+  if (lookupTablesReady()) return getElement(catalog[_selected].ObjectNames,_nameOffset,_nameElements,elementNum);
+  return getElementFromString(catalog[_selected].ObjectNames,elementNum);
 }
 
 // Object Id
@@ -689,19 +1060,12 @@ long CatMgr::subId() {
   if (catalogType()==CAT_DSO_VCOMP)      { if (!_dsoVCompCatalog[catalog[_selected].Index].Has_subId) return -1; } else return -1;
 
   // find the code
-  long result=-1;
   long j=catalog[_selected].Index;
   if (j>getMaxIndex()) j=-1;
   if (j<0) return -1;
-  if (catalogType()==CAT_GEN_STAR)       { for (long i=0; i<=j; i++) { if (_genStarCatalog[i].Has_subId) result++; } } else
-  if (catalogType()==CAT_GEN_STAR_VCOMP) { for (long i=0; i<=j; i++) { if (_genStarVCompCatalog[i].Has_subId) result++; } } else
-  if (catalogType()==CAT_DBL_STAR)       { for (long i=0; i<=j; i++) { if (_dblStarCatalog[i].Has_subId) result++; } } else
-  if (catalogType()==CAT_DBL_STAR_COMP)  { for (long i=0; i<=j; i++) { if (_dblStarCompCatalog[i].Has_subId) result++; } } else
-  if (catalogType()==CAT_VAR_STAR)       { for (long i=0; i<=j; i++) { if (_varStarCatalog[i].Has_subId) result++; } } else
-  if (catalogType()==CAT_VAR_STAR_COMP)  { for (long i=0; i<=j; i++) { if (_varStarCompCatalog[i].Has_subId) result++; } } else
-  if (catalogType()==CAT_DSO)            { for (long i=0; i<=j; i++) { if (_dsoCatalog[i].Has_subId) result++; } } else
-  if (catalogType()==CAT_DSO_COMP)       { for (long i=0; i<=j; i++) { if (_dsoCompCatalog[i].Has_subId) result++; } } else
-  if (catalogType()==CAT_DSO_VCOMP)      { for (long i=0; i<=j; i++) { if (_dsoVCompCatalog[i].Has_subId) result++; } } else return -1;
+  long i=0, result=-1;
+  if (lookupTablesReady()) { i=j-(j%CAT_RANK_BLOCK); result=_subIdRank[j/CAT_RANK_BLOCK]-1; }
+  for (; i<=j; i++) { if (hasSubId(i)) result++; }
 
   return result;
 }
@@ -710,7 +1074,9 @@ long CatMgr::subId() {
 const char* CatMgr::subIdStr() {
   if (_selected<0) return "";
   long elementNum=subId();
-  if (elementNum>=0) return getElementFromString(catalog[_selected].ObjectSubIds,elementNum); else return "";
+  if (elementNum<0) return "";
+  if (lookupTablesReady()) return getElement(catalog[_selected].ObjectSubIds,_subIdOffset,_subIdElements,elementNum);
+  return getElementFromString(catalog[_selected].ObjectSubIds,elementNum);
 }
 
 // For Bayer designated Stars 0 = Alp, etc. to 23. For Fleemstead designated Stars 25 = '1', etc.
@@ -770,12 +1136,155 @@ const char* CatMgr::getElementFromString(const char *data, long elementNum) {
   } else return "";
 }
 
+// returns elementNum 'th element using the offsets from buildElementOffsets()
+const char* CatMgr::getElement(const char *data, const uint16_t *offsets, long elements, long elementNum) {
+  static char result[40] = "";
+  if (elementNum<0 || elementNum>=elements) return "";
+
+  const char *s=&data[offsets[elementNum]];
+  unsigned int k=0;
+  while (s[k]!=';' && s[k]!=0 && k<sizeof(result)-1) { result[k]=s[k]; k++; }
+  result[k]=0;
+  return result;
+}
+
+// records the start offset of each ';' delimited element, returns the number of elements or 0 if they don't all fit
+long CatMgr::buildElementOffsets(const char *data, uint16_t *offsets, long maxElements) {
+  if (data==NULL) return 0;
+  long len=strlen(data);
+  if (len==0 || len>65535) return 0;
+
+  long n=0;
+  offsets[n++]=0;
+  for (long i=0; i<len-1; i++) {
+    if (data[i]==';') {
+      if (n>=maxElements) return 0;
+      offsets[n++]=i+1;
+    }
+  }
+  return n;
+}
+
+// Has_name flag of record index in the selected catalog
+bool CatMgr::hasName(long index) {
+  if (catalogType()==CAT_GEN_STAR)       return _genStarCatalog[index].Has_name; else
+  if (catalogType()==CAT_GEN_STAR_VCOMP) return _genStarVCompCatalog[index].Has_name; else
+  if (catalogType()==CAT_DBL_STAR)       return _dblStarCatalog[index].Has_name; else
+  if (catalogType()==CAT_DBL_STAR_COMP)  return _dblStarCompCatalog[index].Has_name; else
+  if (catalogType()==CAT_VAR_STAR)       return _varStarCatalog[index].Has_name; else
+  if (catalogType()==CAT_VAR_STAR_COMP)  return _varStarCompCatalog[index].Has_name; else
+  if (catalogType()==CAT_DSO)            return _dsoCatalog[index].Has_name; else
+  if (catalogType()==CAT_DSO_COMP)       return _dsoCompCatalog[index].Has_name; else
+  if (catalogType()==CAT_DSO_VCOMP)      return _dsoVCompCatalog[index].Has_name; else return false;
+}
+
+// Has_subId flag of record index in the selected catalog
+bool CatMgr::hasSubId(long index) {
+  if (catalogType()==CAT_GEN_STAR)       return _genStarCatalog[index].Has_subId; else
+  if (catalogType()==CAT_GEN_STAR_VCOMP) return _genStarVCompCatalog[index].Has_subId; else
+  if (catalogType()==CAT_DBL_STAR)       return _dblStarCatalog[index].Has_subId; else
+  if (catalogType()==CAT_DBL_STAR_COMP)  return _dblStarCompCatalog[index].Has_subId; else
+  if (catalogType()==CAT_VAR_STAR)       return _varStarCatalog[index].Has_subId; else
+  if (catalogType()==CAT_VAR_STAR_COMP)  return _varStarCompCatalog[index].Has_subId; else
+  if (catalogType()==CAT_DSO)            return _dsoCatalog[index].Has_subId; else
+  if (catalogType()==CAT_DSO_COMP)       return _dsoCompCatalog[index].Has_subId; else
+  if (catalogType()==CAT_DSO_VCOMP)      return _dsoVCompCatalog[index].Has_subId; else return false;
+}
+
+// builds the lookup tables the first time they are needed for the selected catalog
+bool CatMgr::lookupTablesReady() {
+  if (_selected<0) return false;
+  if (_lookupCatalog!=_selected) buildLookupTables();
+  return _lookupCatalog==_selected;
+}
+
+void CatMgr::buildLookupTables() {
+  _lookupCatalog=-1;
+  if (catalog[_selected].NumObjects>CAT_INDEX_MAX_RECORDS) return;
+
+  _nameElements=buildElementOffsets(catalog[_selected].ObjectNames,_nameOffset,CAT_INDEX_MAX_RECORDS);
+  _subIdElements=buildElementOffsets(catalog[_selected].ObjectSubIds,_subIdOffset,CAT_INDEX_MAX_RECORDS);
+  if (strstr(catalog[_selected].Prefix,";")) {
+    _prefixElements=buildElementOffsets(catalog[_selected].Prefix,_prefixOffset,CAT_PREFIX_MAX_ELEMENTS);
+  } else _prefixElements=0;
+
+  long names=0, subIds=0;
+  for (long i=0; i<=getMaxIndex(); i++) {
+    if (i%CAT_RANK_BLOCK==0) { _nameRank[i/CAT_RANK_BLOCK]=names; _subIdRank[i/CAT_RANK_BLOCK]=subIds; }
+    if (hasName(i)) names++;
+    if (hasSubId(i)) subIds++;
+  }
+  _lookupCatalog=_selected;
+}
+
 // angular distance from current Equ coords, in degrees
 double CatMgr::DistFromEqu(double RA, double Dec) {
   RA=RA/Rad; Dec=Dec/Rad;
   return acos( sin(dec()/Rad)*sin(Dec) + cos(dec()/Rad)*cos(Dec)*cos(ra()/Rad - RA))*Rad;
 }
 
+// assign every record of the selected catalog to a declination band x RA cell
+void CatMgr::buildCellIndex() {
+  _indexedCatalog=-1;
+  _cellMaskValid=false;
+  if (_selected<0 || catalog[_selected].NumObjects>CAT_INDEX_MAX_RECORDS) return;
+
+  long savedIndex=catalog[_selected].Index;
+  for (long i=0; i<=getMaxIndex(); i++) {
+    catalog[_selected].Index=i;
+    int band=(int)((dec()+90.0)/CAT_CELL_SIZE);
+    if (band<0) band=0;
+    if (band>=CAT_CELL_DEC_BANDS) band=CAT_CELL_DEC_BANDS-1;
+    int cell=(int)(ra()/CAT_CELL_SIZE);
+    if (cell<0) cell=0;
+    if (cell>=CAT_CELL_RA_CELLS) cell=CAT_CELL_RA_CELLS-1;
+    _cellOf[i]=band*CAT_CELL_RA_CELLS+cell;
+  }
+  catalog[_selected].Index=savedIndex;
+  _indexedCatalog=_selected;
+}
+
+// mark the cells that could hold a record passing the active position filters, using only the cell centers
+// padded by the cell radius (and by the LST margin for altitude) so the mask never rejects a record that passes
+void CatMgr::buildCellMask() {
+  double lst=lstDegs();
+  memset(_cellMask,0,sizeof(_cellMask));
+  for (int band=0; band<CAT_CELL_DEC_BANDS; band++) {
+    double Dec=-90.0+(band+0.5)*CAT_CELL_SIZE;
+    for (int cell=0; cell<CAT_CELL_RA_CELLS; cell++) {
+      double RA=(cell+0.5)*CAT_CELL_SIZE;
+      if (_fm & FM_NEARBY) {
+        double d=acos(sin(Dec/Rad)*sin(_lastTeleDec/Rad) + cos(Dec/Rad)*cos(_lastTeleDec/Rad)*cos((RA-_lastTeleRA)/Rad))*Rad;
+        if (d-CAT_CELL_RADIUS>=_fm_nearby_dist) continue;
+      }
+      if (_fm & (FM_ABOVE_HORIZON|FM_ALIGN_ALL_SKY)) {
+        double a;
+        EquToAlt(RA,Dec,&a);
+        if (a+CAT_CELL_RADIUS+CAT_CELL_LST_MARGIN<10.0) continue;
+      }
+      int n=band*CAT_CELL_RA_CELLS+cell;
+      _cellMask[n>>3]|=(1<<(n&7));
+    }
+  }
+  _cellMaskLst=lst;
+  _cellMaskValid=true;
+}
+
+// checks to see if the active filters depend on the record position
+bool CatMgr::hasPositionFilter() {
+  if (_selected<0) return false;
+  if (_indexedCatalog!=_selected) buildCellIndex();
+  if (_indexedCatalog!=_selected) return false;
+  return (_fm & (FM_NEARBY|FM_ABOVE_HORIZON|FM_ALIGN_ALL_SKY));
+}
+
+// checks to see if the currently selected object lies in a cell that can pass the position filters
+bool CatMgr::isCellCandidate() {
+  if (!_cellMaskValid || fabs(lstDegs()-_cellMaskLst)>CAT_CELL_LST_MARGIN) buildCellMask();
+  int n=_cellOf[catalog[_selected].Index];
+  return _cellMask[n>>3] & (1<<(n&7));
+}
+
 // convert an HA to RA, in degrees
 double CatMgr::HAToRA(double HA) {
   return (lstDegs()-HA);
@@ -797,6 +1306,35 @@ void CatMgr::EquToHor(double RA, double Dec, double *Alt, double *Azm) {
   *Alt = *Alt*Rad;
 }
 
+// convert a batch of records from the selected catalog to horizon coordinates, in degrees
+// LST and latitude terms are computed once for the batch and single precision trig is used per record since the
+// results are for display and filtering only, Azm may be NULL if only the altitudes are needed
+void CatMgr::EquToHorBatch(const long *indices, int count, float *Alt, float *Azm) {
+  if (_selected<0) return;
+  long savedIndex=catalog[_selected].Index;
+  float lst=fmod(lstDegs(),360.0);
+  float sinLat=_sinLat;
+  float cosLat=_cosLat;
+
+  for (int i=0; i<count; i++) {
+    catalog[_selected].Index=indices[i];
+    float HA=(lst-(float)ra())/(float)Rad;
+    float Dec=(float)dec()/(float)Rad;
+    float sinHA=sinf(HA), cosHA=cosf(HA);
+    float sinDec=sinf(Dec), cosDec=cosf(Dec);
+    float sinAlt=sinDec*sinLat + cosDec*cosLat*cosHA;
+    if (sinAlt>1.0F) sinAlt=1.0F;
+    if (sinAlt<-1.0F) sinAlt=-1.0F;
+    Alt[i]=asinf(sinAlt)*(float)Rad;
+    if (Azm!=NULL) {
+      float z=atan2f(sinHA*cosDec, cosHA*cosDec*sinLat - sinDec*cosLat)*(float)Rad+180.0F;
+      if (z>=360.0F) z-=360.0F;
+      Azm[i]=z;
+    }
+  }
+  catalog[_selected].Index=savedIndex;
+}
+
 // convert equatorial coordinates to horizon, in degrees
 void CatMgr::EquToAlt(double RA, double Dec, double *Alt) {
   double HA=lstDegs()-RA;
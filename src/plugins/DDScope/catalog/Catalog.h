@@ -18,8 +18,34 @@ const unsigned int FM_DBL_MIN_SEP    = 64;
 const unsigned int FM_DBL_MAX_SEP    = 128;
 const unsigned int FM_VAR_MAX_PER    = 256;
 
+// spatial index, the sky is split into declination bands x RA cells so position filters can
+// reject whole cells before doing any per-record trig
+#define CAT_CELL_SIZE            5.0                                    // degrees, both band height and cell width
+#define CAT_CELL_DEC_BANDS       36
+#define CAT_CELL_RA_CELLS        72
+#define CAT_CELL_COUNT           (CAT_CELL_DEC_BANDS*CAT_CELL_RA_CELLS)
+#define CAT_CELL_RADIUS          CAT_CELL_SIZE                          // no point in a cell is farther than this from its center
+#define CAT_CELL_LST_MARGIN      1.0                                    // degrees of LST drift before the horizon mask and match list are rebuilt
+#ifndef CAT_INDEX_MAX_RECORDS
+  #define CAT_INDEX_MAX_RECORDS  8192                                   // catalogs larger than this fall back to unindexed filtering
+#endif
+#define CAT_MATCH_CHUNK          256                                    // records checked per matchListPoll() call
+#define CAT_RANK_BLOCK           32                                     // records per running Has_name/Has_subId count
+#define CAT_PREFIX_MAX_ELEMENTS  512                                    // array type prefixes longer than this are scanned
+
+#define CAT_SEARCH_MAX_QUERY     24                                     // longest query findObjects() looks at
+#ifndef CAT_SEARCH_MAX_KEYS
+  #define CAT_SEARCH_MAX_KEYS    1024                                   // words in object names the name search indexes, any more are searched linearly
+#endif
+
 enum CAT_TYPES {CAT_NONE, CAT_GEN_STAR, CAT_GEN_STAR_VCOMP, CAT_DBL_STAR, CAT_DBL_STAR_COMP, CAT_VAR_STAR, CAT_VAR_STAR_COMP, CAT_DSO, CAT_DSO_COMP, CAT_DSO_VCOMP};
 
+// result of an object search, catalog number and record index
+typedef struct {
+  int  cat;
+  long index;
+} cat_match_t;
+
 class CatMgr {
   public:
 // initialization
@@ -61,6 +87,18 @@ class CatMgr {
     bool        incIndex();
     bool        decIndex();
 
+// filtered match list, built once per filter change (and as the sky turns for the horizon filters) then gives O(1)
+// access to the n'th matching record
+    bool        matchListPoll();
+    bool        matchListReady();
+    long        matchCount();
+    bool        setMatch(long n);
+
+// object search across all catalogs
+    int         findObjects(const char *query, cat_match_t *results, int maxResults);
+    bool        findObject(const char *query, int *cat, long *index, double *RA, double *Dec);
+    long        nameKeysDropped();
+
 // get catalog contents
     int         epoch();
 
@@ -77,6 +115,7 @@ class CatMgr {
 
     void        topocentricToObservedPlace(float *RA, float *Dec);
     void        EquToHor(double RA, double Dec, double *Alt, double *Azm);
+    void        EquToHorBatch(const long *indices, int count, float *Alt, float *Azm);
     double      HAToRA(double ha);
 
     float       period();
@@ -126,6 +165,53 @@ private:
 
     bool isFiltered();
 
+    int _indexedCatalog=-1;
+    bool _cellMaskValid=false;
+    double _cellMaskLst=0;
+
+    int _matchCatalog=-1;
+    long _matchScanned=0;
+    long _matchCount=0;
+    bool _matchReady=false;
+    double _matchLst=0;
+    bool _altCached=false;
+    float _altCache=0;
+
+    bool isFiltering();
+    bool isMatchListActive();
+    bool isMatchListStale();
+    long findMatch(long index);
+
+    int _lookupCatalog=-1;
+    long _nameElements=0;
+    long _subIdElements=0;
+    long _prefixElements=0;
+
+    long recordId(long index);
+    long findPrimaryId(long id);
+    bool prefixMatches(const char *query, int queryLen);
+
+    bool _nameKeysReady=false;
+    long _nameKeyCount=0;
+    long _nameKeysDropped=0;
+    int _nameScanCat=0;
+    long _nameScanIndex=0;
+    long _nameScanOffset=0;
+    void buildNameKeys();
+    void scanNameWords(const char *q, int len, cat_match_t *results, int *n, int maxResults);
+
+    bool hasName(long index);
+    bool hasSubId(long index);
+    bool lookupTablesReady();
+    void buildLookupTables();
+    long buildElementOffsets(const char *data, uint16_t *offsets, long maxElements);
+    const char* getElement(const char *data, const uint16_t *offsets, long elements, long elementNum);
+
+    void buildCellIndex();
+    void buildCellMask();
+    bool hasPositionFilter();
+    bool isCellCandidate();
+
     const char* getElementFromString(const char *data, long elementNum);
     double DistFromEqu(double RA, double Dec);
     
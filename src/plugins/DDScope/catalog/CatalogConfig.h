@@ -54,6 +54,7 @@
 #endif
 
 // Note: There should be a matching line below for every catalog #included above (catalogs appear in the menus in the order the appear below):
+// Note: The object name search indexes up to CAT_SEARCH_MAX_KEYS (Catalog.h) words of the names below and scans for the rest, raise it with the catalogs
 catalog_t catalog[] = {
 // Note: Alignment always uses the first catalog!
 // Note: Sub Menu items should be grouped together in this list!
@@ -26,6 +26,7 @@
 #include "../screens/TreasureCatScreen.h"
 #include "../screens/CustomCatScreen.h"
 #include "../screens/SHCCatScreen.h"
+#include "../screens/SearchScreen.h"
 #include "../screens/DCFocuserScreen.h"
 #include "../screens/GotoScreen.h"
 #include "../screens/GuideScreen.h"
@@ -38,7 +39,7 @@
 
 #ifdef ODRIVE_MOTOR_PRESENT
   #include "../odriveExt/ODriveExt.h"
-  #include "../screens/ODriveScreen.h"
+  #include "../screens/OdriveScreen.h"
 #endif
 
 #define TITLE_BOXSIZE_X         313
@@ -118,6 +119,8 @@ Button menuButton(MENU_X, MENU_Y, MENU_BOXSIZE_X, MENU_BOXSIZE_Y, butOnBackgroun
 CanvasPrint canvDisplayInsPrint(&Inconsolata_Bold8pt7b);
                 
 ScreenEnum Display::currentScreen = HOME_SCREEN;
+MountSnapshot Display::snapshot;
+uint8_t Display::updateHandle = 0;
 //bool Display::_nightMode = false;
 float previousBatVoltage = 2.1;
 char cmdErrGlobal[100] = "";
@@ -148,6 +151,7 @@ void updateScreenWrapper() { display.updateSpecificScreen(); }
 void Display::init() {
   VLF("MSG: Display, started"); 
   tft.begin(); delay(1);
+  tft.setOverwriteCallback(CanvasPrint::invalidate); // a fillRect() over a canvas field redraws it on the next print
   sdInit(); // initialize the SD card and draw start screen
 
   tft.setRotation(0); // display rotation: Note it is different than touchscreen
@@ -167,8 +171,8 @@ void Display::init() {
   //   race conditions that result in the WiFi uncompressedBuffer being overwritten
   //   when in the TFT Screen Mirror mode
   VF("MSG: Setup, start Screen status update task (rate 1000 ms priority 5)... ");
-  uint8_t us_handle = tasks.add(1000, 0, true, 5, updateScreenWrapper, "UpdateSpecificScreen");
-  if (us_handle)  { VLF("success"); } else { VLF("FAILED!"); }
+  updateHandle = tasks.add(1000, 0, true, 5, updateScreenWrapper, "UpdateSpecificScreen");
+  if (updateHandle)  { VLF("success"); } else { VLF("FAILED!"); }
 }
 
 // initialize the SD card and boot screen
@@ -248,6 +252,10 @@ void Display::refreshButtons() {
       if (shcCatScreen.shCatalogButStateChange()) 
         shcCatScreen.updateShcButtons(); 
       break; 
+    case SEARCH_SCREEN:   
+      if (searchScreen.searchButStateChange()) 
+        searchScreen.updateSearchButtons(); 
+      break; 
     case XSTATUS_SCREEN:  
       // No buttons here
       break; 
@@ -266,12 +274,47 @@ void Display::setCurrentScreen(ScreenEnum curScreen) {
 currentScreen = curScreen;
 };
 
+// sample the mount state once for this update tick, everything here runs in this
+// task's context so the fields are consistent with each other
+void Display::refreshSnapshot() {
+  snapshot.current        = mount.getPosition(CR_MOUNT_ALL);
+  snapshot.target         = goTo.getGotoTarget();
+  transform.rightAscensionToHourAngle(&snapshot.target);
+  transform.equToHor(&snapshot.target);
+
+  snapshot.tracking       = mount.isTracking();
+  snapshot.slewing        = mount.isSlewing();
+  snapshot.atHome         = mount.isHome();
+  snapshot.enabled        = mount.isEnabled();
+  snapshot.gotoState      = goTo.state;
+  snapshot.guideState     = guide.state;
+  snapshot.parkState      = park.state;
+  snapshot.generalError   = limits.errorCode();
+  snapshot.trackingRateHz = snapshot.tracking ? siderealToHz(mount.trackingRate) : 0.0F;
+
+  snapshot.dateTimeReady  = site.dateIsReady && site.timeIsReady;
+  snapshot.lst            = site.getSiderealTime();
+  snapshot.timezone       = site.location.timezone;
+  snapshot.local          = site.getDateTime();
+  snapshot.local.hour    -= snapshot.timezone;
+  while (snapshot.local.hour >= 24.0) { snapshot.local.hour -= 24.0; snapshot.local.day += 1.0; }
+  while (snapshot.local.hour < 0.0)   { snapshot.local.hour += 24.0; snapshot.local.day -= 1.0; }
+  snapshot.latitude       = site.location.latitude;
+  snapshot.longitude      = site.location.longitude;
+
+  snapshot.temperature    = weather.getTemperature();
+  snapshot.humidity       = weather.getHumidity();
+  snapshot.dewPoint       = weather.getDewPoint();
+}
+
 // select which screen to update at the Update task rate 
 void Display::updateSpecificScreen() {
 #ifdef ENABLE_TFT_MIRROR
   wifiDisplay.enableScreenCapture(true); 
 #endif
 
+  refreshSnapshot();
+
   display.refreshButtons();
 
   switch (currentScreen) {
@@ -285,6 +328,7 @@ void Display::updateSpecificScreen() {
     case TREASURE_SCREEN:   treasureCatScreen.updateTreasureStatus(); break;
     case CUSTOM_SCREEN:     customCatScreen.updateCustomStatus();     break;
     case SHC_CAT_SCREEN:    shcCatScreen.updateShcStatus();           break;
+    case SEARCH_SCREEN:     searchScreen.updateSearchStatus();        break;
     case PLANETS_SCREEN:    planetsScreen.updatePlanetsStatus();      break;
     case XSTATUS_SCREEN:    extStatusScreen.updateExStatus();         break;
     #ifdef ODRIVE_MOTOR_PRESENT
@@ -296,12 +340,13 @@ void Display::updateSpecificScreen() {
   // don't do the following updates on these screens
   if (currentScreen == CUSTOM_SCREEN || 
     currentScreen == SHC_CAT_SCREEN ||
+    currentScreen == SEARCH_SCREEN ||
     currentScreen == PLANETS_SCREEN ||
     currentScreen == XSTATUS_SCREEN ||
     currentScreen == TREASURE_SCREEN) {
     #ifdef ENABLE_TFT_MIRROR
       wifiDisplay.enableScreenCapture(false);
-      wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
+      wifiDisplay.sendFrameToEsp(FRAME_TYPE_UPDATE);
     #endif
     
     return;
@@ -314,7 +359,7 @@ void Display::updateSpecificScreen() {
   
 #ifdef ENABLE_TFT_MIRROR
   wifiDisplay.enableScreenCapture(false);
-  wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
+  wifiDisplay.sendFrameToEsp(FRAME_TYPE_UPDATE);
 #endif
 }
 
@@ -516,12 +561,13 @@ void Display::showGpsStatus() {
   // not on these screens
   if (currentScreen == CUSTOM_SCREEN || 
     currentScreen == SHC_CAT_SCREEN ||
+    currentScreen == SEARCH_SCREEN ||
     currentScreen == PLANETS_SCREEN ||
     currentScreen == XSTATUS_SCREEN ||
     currentScreen == TREASURE_SCREEN) return;
   uint8_t extern gps_icon[];
   //if (tls.isReady()) {
-  if (commandBool(":GX89#")) {
+  if (!snapshot.dateTimeReady) {
     firstGPS = true; // turn on One-shot trigger
     if (!flash) {
       flash = true;
@@ -540,18 +586,8 @@ void Display::showGpsStatus() {
   } else { // GPS is ready
     //if (firstGPS) {
       // If the GPS (or other TLS) is locked, then send LST and Latitude to the cat_mgr module
-      double f=0;
-      char reply[12];
-
-      // Set LST for the cat_mgr 
-      display.commandWithReply(":GS#", reply);
-      convert.hmsToDouble(&f, reply);
-      cat_mgr.setLstT0(f);
-
-      // Set Latitude for cat_mgr
-      display.commandWithReply(":Gt#", reply);
-      convert.dmsToDouble(&f, reply, true);
-      cat_mgr.setLat(f);
+      cat_mgr.setLstT0(snapshot.lst);
+      cat_mgr.setLat(radToDeg(snapshot.latitude));
     
       // set the RTC in Teensy to the latest GPS reading
       // if (dgps.time.age() < 500) {
@@ -605,6 +641,7 @@ void Display::showOnStepCmdErr() {
   // not on these screens
   if (currentScreen == CUSTOM_SCREEN || 
     currentScreen == SHC_CAT_SCREEN ||
+    currentScreen == SEARCH_SCREEN ||
     currentScreen == PLANETS_SCREEN ||
     currentScreen == XSTATUS_SCREEN ||
     currentScreen == TREASURE_SCREEN) return;
@@ -619,6 +656,7 @@ void Display::showOnStepGenErr() {
   // not on these screens
   if (currentScreen == CUSTOM_SCREEN || 
     currentScreen == SHC_CAT_SCREEN ||
+    currentScreen == SEARCH_SCREEN ||
     currentScreen == PLANETS_SCREEN ||
     currentScreen == XSTATUS_SCREEN ||
     currentScreen == TREASURE_SCREEN) return;
@@ -628,7 +666,7 @@ void Display::showOnStepGenErr() {
   
   //commandWithReply(":GU#", genErr);
   //error = (genErr[strlen(genErr) - 1] - '0');
-  getGeneralErrorMessage(temp, limits.errorCode());
+  getGeneralErrorMessage(temp, snapshot.generalError);
   strcat(temp1, temp);
   canvDisplayInsPrint.printLJ(3, 470, 314, C_HEIGHT+2, temp1, false);
 }
@@ -921,7 +959,7 @@ void Display::updateCommonStatus() {
   // }
 
   // Flash tracking LED if mount is tracking
-  if (mount.isTracking()) {
+  if (snapshot.tracking) {
     if (trackLedOn) {
       digitalWrite(STATUS_TRACK_LED_PIN, HIGH); // LED OFF, active low
       tft.setFont(&Inconsolata_Bold8pt7b);
@@ -951,6 +989,7 @@ void Display::updateCommonStatus() {
 
   if (currentScreen == CUSTOM_SCREEN || 
       currentScreen == SHC_CAT_SCREEN ||
+      currentScreen == SEARCH_SCREEN ||
       currentScreen == PLANETS_SCREEN ||
       currentScreen == TREASURE_SCREEN) return;
 
@@ -961,97 +1000,96 @@ void Display::updateCommonStatus() {
   
   int y_offset = 0;
   // ----- Column 1 -----
-  // Current RA, Returns: HH:MM.T# or HH:MM:SS# (based on precision setting)
-  commandWithReply(":GR#", ra_hms);
+  // Current RA, HH:MM:SS
+  convert.doubleToHms(ra_hms, radToHrs(snapshot.current.r), false, PM_HIGH);
   canvDisplayInsPrint.printRJ(COM_COL1_DATA_X, COM_COL1_DATA_Y, C_WIDTH, C_HEIGHT, ra_hms, false);
 
-  // Target RA, Returns: HH:MM.T# or HH:MM:SS (based on precision setting)
+  // Target RA, HH:MM:SS
   y_offset +=COM_LABEL_Y_SPACE; 
-  commandWithReply(":Gr#", tra_hms);
+  convert.doubleToHms(tra_hms, radToHrs(snapshot.target.r), false, PM_HIGH);
   canvDisplayInsPrint.printRJ(COM_COL1_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH, C_HEIGHT, tra_hms, false);
 
-  // Current DEC
+  // Current DEC, sDD*MM:SS
    y_offset +=COM_LABEL_Y_SPACE; 
-  commandWithReply(":GD#", dec_dms);
+  convert.doubleToDms(dec_dms, radToDeg(snapshot.current.d), false, true, PM_HIGH);
   canvDisplayInsPrint.printRJ(COM_COL1_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH, C_HEIGHT, dec_dms, false);
 
-  // Target DEC
+  // Target DEC, sDD*MM:SS
   y_offset +=COM_LABEL_Y_SPACE;  
-  commandWithReply(":Gd#", tdec_dms); 
+  convert.doubleToDms(tdec_dms, radToDeg(snapshot.target.d), false, true, PM_HIGH);
   canvDisplayInsPrint.printRJ(COM_COL1_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH, C_HEIGHT, tdec_dms, false);
   //VLF("common column 1 check point complete");
   // ----- Column 2 -----
   y_offset =0;
 
-  Coordinate dispTarget = goTo.getGotoTarget();
-  transform.rightAscensionToHourAngle(&dispTarget);
-  transform.equToHor(&dispTarget);
-
   // Get CURRENT AZM
-  //commandWithReply(":GZ#", cAzmDMS); // DDD*MM'SS# 
-  //convert.dmsToDouble(&cAzm_d, cAzmDMS, false, PM_LOW);
-  double temp = NormalizeAzimuth(radToDeg(mount.getPosition(CR_MOUNT_HOR).z));
+  double temp = NormalizeAzimuth(radToDeg(snapshot.current.z));
   canvDisplayInsPrint.printRJ(COM_COL2_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH-20, C_HEIGHT, temp, false);
 
   // Get TARGET AZM
   y_offset +=COM_LABEL_Y_SPACE;  
-  //commandWithReply(":Gz#", tAzmDMS); // DDD*MM'SS# 
-  //convert.dmsToDouble(&tAzm_d, tAzmDMS, false, PM_LOW);
-  temp = NormalizeAzimuth(radToDeg(dispTarget.z));
+  temp = NormalizeAzimuth(radToDeg(snapshot.target.z));
   canvDisplayInsPrint.printRJ(COM_COL2_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH-20, C_HEIGHT, temp, false);
 
   // Get CURRENT ALT
   y_offset +=COM_LABEL_Y_SPACE;  
-  //commandWithReply(":GA#", cAltDMS);	// sDD*MM'SS#
-  //convert.dmsToDouble(&cAlt_d, cAltDMS, true, PM_LOW);
-  temp = radToDeg(mount.getPosition(CR_MOUNT_ALT).a);
+  temp = radToDeg(snapshot.current.a);
   canvDisplayInsPrint.printRJ(COM_COL2_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH-20, C_HEIGHT, temp, false);
   
   // Get TARGET ALT
   y_offset +=COM_LABEL_Y_SPACE;  
-  //commandWithReply(":Gal#", tAltDMS);	// sDD*MM'SS#
-  //convert.dmsToDouble(&tAlt_d, tAltDMS, true, PM_LOW);
-  canvDisplayInsPrint.printRJ(COM_COL2_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH-20, C_HEIGHT, radToDeg(dispTarget.a), false);
+  canvDisplayInsPrint.printRJ(COM_COL2_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH-20, C_HEIGHT, radToDeg(snapshot.target.a), false);
   //VLF("column 2 complete");
 }
 
 // draw a picture -This member function is a copy from rDUINOScope but with 
-//    pushColors() changed to drawPixel() with a loop
+//    pushColors() changed to block reads from SD pushed through one window per block
 // rDUINOScope - Arduino based telescope control system (GOTO).
 //    Copyright (C) 2016 Dessislav Gouzgounov (Desso)
 //    PROJECT Website: http://rduinoscope.byethost24.com
+//
+// Two file formats are accepted:
+//   BMP, 16 bit 565 with the 138 byte V5 header, rows are drawn in file order
+//   Raw, "R565" then width and height (uint16 little endian) then width*height pixels,
+//        big endian RGB565 (display byte order) top row first. No header parsing or
+//        byte swapping, the rows go straight from SD to SPI
+#define PIC_BLOCK_ROWS 8
+static uint8_t picBlock[PIC_BLOCK_ROWS * 480 * 2]; // rows read from SD at a time
+static uint16_t picPixels[PIC_BLOCK_ROWS * 480];   // the same rows converted for pushImage()
+
 void Display::drawPic(File *StarMaps, uint16_t x, uint16_t y, uint16_t WW, uint16_t HH){
   uint8_t header[14 + 124]; // maximum length of bmp file header
-  uint16_t color[320];  
-  uint16_t num;   
-  uint8_t color_l, color_h;
-  uint32_t i,j,k;
   uint32_t width;
   uint32_t height;
   uint16_t bits;
   uint32_t compression;
   uint32_t alpha_mask = 0;
   uint32_t pic_offset;
-  char temp[20]="";
-
-  /** read header of the bmp file */
-  i=0;
-  while (StarMaps->available()) {
-    header[i] = StarMaps->read();
-    i++;
-    if(i==14){
-      break;
+
+  /** read header of the file */
+  if (StarMaps->read(header, 14) != 14) return;
+
+  if (header[0] == 'R' && header[1] == '5' && header[2] == '6' && header[3] == '5') {
+    /** raw 565 format */
+    width = ((uint16_t)header[5] << 8) + header[4];
+    height = ((uint16_t)header[7] << 8) + header[6];
+    if (width == 0 || width > 480) return;
+    uint16_t rows = min((uint32_t)HH, height);
+    uint16_t blockRows = PIC_BLOCK_ROWS * 480 / width;
+    if (blockRows > PIC_BLOCK_ROWS) blockRows = PIC_BLOCK_ROWS;
+    StarMaps->seek(8);
+    tft.setRotation(0);
+    for (uint16_t j = 0; j < rows; j += blockRows) {
+      uint16_t n = min((uint16_t)(rows - j), blockRows);
+      if (StarMaps->read(picBlock, n * width * 2) != (int)(n * width * 2)) break;
+      tft.pushRawImage(x, y + j, width, n, picBlock);
     }
+    return;
   }
 
   pic_offset = (((uint32_t)header[0x0A+3])<<24) + (((uint32_t)header[0x0A+2])<<16) + (((uint32_t)header[0x0A+1])<<8)+(uint32_t)header[0x0A];
-  while (StarMaps->available()) {
-    header[i] = StarMaps->read();
-    i++;
-    if(i==pic_offset){
-      break;
-    }
-  }
+  if (pic_offset > sizeof(header)) return;
+  if (pic_offset > 14 && StarMaps->read(header + 14, pic_offset - 14) != (int)(pic_offset - 14)) return;
  
   /** calculate picture width ,length and bit numbers of color */
   width = (((uint32_t)header[0x12+3])<<24) + (((uint32_t)header[0x12+2])<<16) + (((uint32_t)header[0x12+1])<<8)+(uint32_t)header[0x12];
@@ -1061,45 +1099,31 @@ void Display::drawPic(File *StarMaps, uint16_t x, uint16_t y, uint16_t WW, uint1
   if(pic_offset>0x42){
     alpha_mask = (((uint32_t)header[0x42 + 3])<<24) + (((uint32_t)header[0x42 + 2])<<16) + (((uint32_t)header[0x42 + 1])<<8)+(uint32_t)header[0x42];
   }
-  sprintf(temp, "%lu", pic_offset);  //VF("pic_offset=");  VL(temp);
-  sprintf(temp, "%lu", width);       //VF("width=");       VL(temp);
-  sprintf(temp, "%lu", height);      //VF("height=");      VL(temp);
-  sprintf(temp, "%lu", compression); //VF("compression="); VL(temp);
-  sprintf(temp, "%d",  bits);        //VF("bits=");        VL(temp);
-  sprintf(temp, "%lu", alpha_mask);  //VF("alpha_mask=");  VL(temp);
+  UNUSED(compression);
+
+  /** check picture format */
+  if (pic_offset != 138 || alpha_mask != 0 || bits != 16 || width == 0 || width > 480) return;
+
+  /** 565 format */
+  uint32_t stride = (width * 2 + 3) & ~3UL; // rows are padded to 4 bytes
+  uint16_t drawWidth = min((uint32_t)WW, width);
+  uint16_t rows = min((uint32_t)HH, height);
+  uint16_t blockRows = sizeof(picBlock) / stride;
+  if (blockRows > PIC_BLOCK_ROWS) blockRows = PIC_BLOCK_ROWS;
 
   /** set position to pixel table */
   StarMaps->seek(pic_offset);
-  /** check picture format */
-  if(pic_offset == 138 && alpha_mask == 0){
-    /** 565 format */
-    tft.setRotation(0);
-    /** read from SD card, write to TFT LCD */
-    for(j=0; j<HH; j++){ // read all lines
-      for(k=0; k<WW; k++){ // read two bytes and pack them in int16, continue for a row
-          color_l = StarMaps->read();
-          color_h = StarMaps->read();
-          color[k]=0;
-          color[k] += color_h;
-          color[k] <<= 8;
-          color[k] += color_l;
-      }
-      num = 0;
-    
-      while (num < x + width - 1){  //implementation for DDScope
-      //if ((x < 0) || (x >= _width) || (y < 0) || (y >= _height)) return;
-        //setAddrWindow(x, y, x + 1, y + 1);
-        //pushColor(uint16_t color)
-
-        //while (num < x+width-1){
-        tft.drawPixel(x+num, y+j, color[num]); //implementation for DDScope
-        num++;
-      }
-      // dummy read twice to align for 4 
-      if(width%2){
-        StarMaps->read();StarMaps->read();
-      }
+  tft.setRotation(0);
+  /** read from SD card a block of rows at a time, write to TFT LCD */
+  for (uint16_t j = 0; j < rows; j += blockRows) {
+    uint16_t n = min((uint16_t)(rows - j), blockRows);
+    if (StarMaps->read(picBlock, n * stride) != (int)(n * stride)) break;
+    uint16_t *pixel = picPixels;
+    for (uint16_t r = 0; r < n; r++) {
+      const uint8_t *src = picBlock + r * stride;
+      for (uint16_t k = 0; k < drawWidth; k++) *pixel++ = ((uint16_t)src[k * 2 + 1] << 8) | src[k * 2];
     }
+    tft.pushImage(x, y + j, drawWidth, n, picPixels);
   }
 }
 
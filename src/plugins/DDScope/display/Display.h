@@ -20,6 +20,17 @@
 #define FRAME_TYPE_DEF  0x04 // Deflate compression is a lossless data compression algorithm 
                              // that combines the LZ77 algorithm and Huffman coding to 
                              // reduce the size of data. Has Native browser support.
+#define FRAME_TYPE_DLT  0x05 // Deflated list of changed rectangles since the last frame, falls
+                             // back to FRAME_TYPE_DEF when the client needs a full frame
+
+// COMPILE-TIME SWITCH to send only the changed tiles (FRAME_TYPE_DLT) on the periodic status
+// update, the ESP32S3 and web page must be able to apply delta frames
+//#define ENABLE_TFT_MIRROR_DELTA  // Uncomment this line to enable delta frames
+#ifdef ENABLE_TFT_MIRROR_DELTA
+  #define FRAME_TYPE_UPDATE FRAME_TYPE_DLT
+#else
+  #define FRAME_TYPE_UPDATE FRAME_TYPE_DEF
+#endif
 //=====================================================================================
 
 #include <Arduino.h>
@@ -34,7 +45,11 @@
 #include "src/lib/commands/CommandErrors.h"
 #include "src/libApp/commands/ProcessCmds.h"
 #include "src/telescope/mount/goto/Goto.h"
+#include "src/telescope/mount/guide/Guide.h"
+#include "src/telescope/mount/park/Park.h"
+#include "src/telescope/mount/limits/Limits.h"
 #include "src/telescope/mount/site/Site.h"
+#include "src/libApp/weather/Weather.h"
 #include "src/lib/tasks/OnTask.h"
 #include "src/libApp/commands/ProcessCmds.h"
 #include "UIelements.h"
@@ -159,7 +174,8 @@ enum ScreenEnum
   XSTATUS_SCREEN,  // 9
   TREASURE_SCREEN, // 10
   CUSTOM_SCREEN,   // 11
-  SHC_CAT_SCREEN   // 12
+  SHC_CAT_SCREEN,  // 12
+  SEARCH_SCREEN    // 13
 }; 
 
 enum SelectedCatalog
@@ -203,6 +219,31 @@ const uint8_t  largeFontHeight = 22; // 11pt
 const uint8_t  xlargeFontWidth = 17; // 12pt
 const uint8_t  xlargeFontHeight = 29; // 12pt
 
+// Mount state sampled once per display update tick, screens read these fields
+// instead of sending LX200 Get commands through the local command channel
+typedef struct MountSnapshot {
+  Coordinate current;       // position (r, h, d, a, z) in radians
+  Coordinate target;        // goto target (r, h, d, a, z) in radians
+  bool       tracking;
+  bool       slewing;
+  bool       atHome;
+  bool       enabled;
+  GotoState  gotoState;
+  GuideState guideState;
+  ParkState  parkState;
+  uint8_t    generalError;  // as limits.errorCode()
+  float      trackingRateHz; // 0.0 unless tracking
+  bool       dateTimeReady;
+  double     lst;           // local sidereal time in hours
+  JulianDate local;         // local standard date/time
+  double     timezone;      // hours added to local time to get UT1
+  double     latitude;      // radians, north is positive
+  double     longitude;     // radians, east is negative
+  float      temperature;   // ambient, deg C
+  float      humidity;      // relative, %
+  float      dewPoint;      // deg C
+} MountSnapshot;
+
 // =========================================
 class Display {
   public:
@@ -223,6 +264,7 @@ class Display {
     void drawPic(File *StarMaps, uint16_t x, uint16_t y, uint16_t WW, uint16_t HH);
 
     // Status and updates
+    void refreshSnapshot();
     void updateSpecificScreen();
     void updateCommonStatus();  
     void showOnStepCmdErr();
@@ -244,6 +286,8 @@ class Display {
     bool getGeneralErrorMessage(char message[], uint8_t error);
 
     static ScreenEnum currentScreen;
+    static MountSnapshot snapshot;
+    static uint8_t updateHandle; // screen update task, tasks.immediate() on it to redraw without waiting a second
     uint8_t _colorThemeIndex = 1;  // 0 = Day, 1 = Dusk, 2 = Night
     bool _redrawBut = false;
     volatile bool buttonTouched = false;
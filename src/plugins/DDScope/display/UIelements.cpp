@@ -103,68 +103,120 @@ void Button::setColors(uint16_t active, uint16_t notActive, uint16_t border) {
 // Canvas Print constructor
 CanvasPrint::CanvasPrint(const GFXfont *font) { c_font = (GFXfont *)font; }
 
-// ===================== Canvas Print ==============================
-// Right Justified, vertically centered
-void CanvasPrint::printRJ(int x, int y, uint16_t width, uint16_t height, const char* c_label, bool warning) {
-  char ch_label[80] = "";
+// What was last drawn at a position, a field is skipped if the same text/colors
+// are printed again and the screen hasn't been cleared since
+typedef struct CanvasField {
+  int16_t  x;
+  int16_t  y;
+  int16_t  top;     // y of the drawn box, the font offset moves it from y
+  uint16_t width;
+  uint16_t height;
+  uint32_t hash;
+  uint32_t generation;
+} CanvasField;
+
+static CanvasField canvasCache[CANVAS_CACHE_SIZE];
+static uint8_t canvasCacheCount = 0;
+static uint8_t canvasCacheNext = 0;
+
+static GFXcanvas1 *canvasPool[CANVAS_POOL_SIZE] = { NULL };
+static uint8_t canvasPoolNext = 0;
+
+void CanvasPrint::invalidate() {
+  canvasCacheCount = 0;
+  canvasCacheNext = 0;
+}
+
+void CanvasPrint::invalidate(int16_t x, int16_t y, int16_t width, int16_t height) {
+  for (int i = canvasCacheCount - 1; i >= 0; i--) {
+    CanvasField *f = &canvasCache[i];
+    if (x < f->x + (int16_t)f->width && f->x < x + width && y < f->top + (int16_t)f->height && f->top < y + height) {
+      // move the last field into this slot
+      *f = canvasCache[--canvasCacheCount];
+      canvasCacheNext = 0;
+    }
+  }
+}
+
+// reuse a canvas of this size or replace the oldest one
+GFXcanvas1 *CanvasPrint::getCanvas(uint16_t width, uint16_t height) {
+  for (int i = 0; i < CANVAS_POOL_SIZE; i++) {
+    if (canvasPool[i] != NULL && canvasPool[i]->width() == width && canvasPool[i]->height() == height) return canvasPool[i];
+  }
+  delete canvasPool[canvasPoolNext];
+  GFXcanvas1 *canvas = new GFXcanvas1(width, height); // creates buffer
+  if (canvas->getBuffer() == NULL) { delete canvas; canvas = NULL; }
+  canvasPool[canvasPoolNext] = canvas;
+  canvasPoolNext = (canvasPoolNext + 1) % CANVAS_POOL_SIZE;
+  return canvas;
+}
+
+// render text vertically centered in the box and blit it through one address window
+void CanvasPrint::draw(int x, int y, uint16_t width, uint16_t height, const char* text, bool warning) {
   int y_box_offset;
   if (c_font == NULL) {
     y_box_offset = -6; // default font offset
   } else {
     y_box_offset = 10; // custom font offset
   }
-  GFXcanvas1 canvas(width, height); // creates buffer
-  canvas.setFont(c_font); 
-  canvas.setCursor(0, (height-y_box_offset)/2 + y_box_offset); // offset from top left corner of canvas box
-  sprintf(ch_label, "%9s", c_label);
-  canvas.print(ch_label); // print to buffer
-  if (warning) { // show warning background
-    tft.drawBitmap(x, y - y_box_offset, canvas.getBuffer(), width, height, textColor, butOnBackground);
-  } else {
-    tft.drawBitmap(x, y - y_box_offset, canvas.getBuffer(), width, height, textColor, butBackground);
+  uint16_t background = warning ? butOnBackground : butBackground; // show warning background
+
+  // FNV-1a of everything that affects the pixels
+  uint32_t hash = 2166136261UL;
+  for (const char *p = text; *p; p++) hash = (hash ^ (uint8_t)*p) * 16777619UL;
+  hash = (hash ^ (uint32_t)(uintptr_t)c_font) * 16777619UL;
+  hash = (hash ^ (((uint32_t)textColor << 16) | background)) * 16777619UL;
+
+  uint32_t generation = tft.getScreenGeneration();
+  CanvasField *field = NULL;
+  for (int i = 0; i < canvasCacheCount; i++) {
+    if (canvasCache[i].x == x && canvasCache[i].y == y) { field = &canvasCache[i]; break; }
+  }
+  if (field != NULL && field->generation == generation && field->hash == hash &&
+      field->width == width && field->height == height) return;
+  if (field == NULL) {
+    if (canvasCacheCount < CANVAS_CACHE_SIZE) field = &canvasCache[canvasCacheCount++]; else {
+      field = &canvasCache[canvasCacheNext];
+      canvasCacheNext = (canvasCacheNext + 1) % CANVAS_CACHE_SIZE;
+    }
+    field->x = x;
+    field->y = y;
   }
+  field->top = y - y_box_offset;
+  field->width = width;
+  field->height = height;
+  field->hash = hash;
+  field->generation = generation;
+
+  GFXcanvas1 *canvas = getCanvas(width, height);
+  if (canvas == NULL) return;
+  canvas->fillScreen(0);
+  canvas->setFont(c_font); 
+  canvas->setCursor(0, (height-y_box_offset)/2 + y_box_offset); // offset from top left corner of canvas box
+  canvas->print(text); // print to buffer
+  tft.pushBitmap(x, y - y_box_offset, canvas->getBuffer(), width, height, textColor, background);
+}
+
+// ===================== Canvas Print ==============================
+// Right Justified, vertically centered
+void CanvasPrint::printRJ(int x, int y, uint16_t width, uint16_t height, const char* c_label, bool warning) {
+  char ch_label[80] = "";
+  snprintf(ch_label, sizeof(ch_label), "%9s", c_label);
+  draw(x, y, width, height, ch_label, warning);
 }
 
 // Left Justified, vertically centered
 void CanvasPrint::printLJ(int x, int y, uint16_t width, uint16_t height, const char* c_label, bool warning) {
   char ch_label[80] = "";
-  int y_box_offset;
-  if (c_font == NULL) {
-    y_box_offset = -6; // default font offset
-  } else {
-    y_box_offset = 10; // custom font offset
-  }
-  GFXcanvas1 canvas(width, height);
-  canvas.setFont(c_font); 
-  canvas.setCursor(0, (height-y_box_offset)/2 + y_box_offset); // offset from top left corner of canvas box
-  sprintf(ch_label, "%-9s", c_label);
-  canvas.print(ch_label);
-  if (warning) { // show warning background
-    tft.drawBitmap(x, y - y_box_offset, canvas.getBuffer(), width, height, textColor, butOnBackground);
-  } else {
-    tft.drawBitmap(x, y - y_box_offset, canvas.getBuffer(), width, height, textColor, butBackground);
-  }
+  snprintf(ch_label, sizeof(ch_label), "%-9s", c_label);
+  draw(x, y, width, height, ch_label, warning);
 }
 
 // Right Justified Overload for double
 void CanvasPrint::printRJ(int x, int y, uint16_t width, uint16_t height, double label, bool warning) {
   char ch_label[80] = "";
-  int y_box_offset;
-  if (c_font == NULL) {
-    y_box_offset = -6; // default font offset
-  } else {
-    y_box_offset = 10; // custom font offset
-  }
-  GFXcanvas1 canvas(width, height);
-  canvas.setFont(c_font); 
-  canvas.setCursor(0, (height-y_box_offset)/2 + y_box_offset); // offset from top left corner of canvas box
-  sprintf(ch_label, "%6.1f", label);
-  canvas.print(ch_label);
-  if (warning) { // show warning background
-    tft.drawBitmap(x, y - y_box_offset, canvas.getBuffer(), width, height, textColor, butOnBackground);
-  } else {
-    tft.drawBitmap(x, y - y_box_offset, canvas.getBuffer(), width, height, textColor, butBackground);
-  }
+  snprintf(ch_label, sizeof(ch_label), "%6.1f", label);
+  draw(x, y, width, height, ch_label, warning);
 }
 /*
 // Right Justified Overload for double 
@@ -9,6 +9,9 @@
 
 #define BUTTON_RADIUS 7
 
+#define CANVAS_POOL_SIZE  8   // canvases kept for reuse, matched by size
+#define CANVAS_CACHE_SIZE 48  // fields remembered by position so unchanged values aren't redrawn
+
 //----------------------------------------------------------
 // Button element
 //----------------------------------------------------------
@@ -63,8 +66,16 @@ class CanvasPrint {
 
     void  printLJ(int x, int y, uint16_t width, uint16_t height, const char* c_label, bool warning);
     void  printLJ(int x, int y, uint16_t width, uint16_t height,         int d_label, bool warning);
+
+    // forget the cached fields so each is drawn on its next print
+    static void invalidate();
+    // forget the cached fields that overlap this area, e.g. after a fillRect() over them
+    static void invalidate(int16_t x, int16_t y, int16_t width, int16_t height);
    
   private:
+    void  draw(int x, int y, uint16_t width, uint16_t height, const char* text, bool warning);
+    static GFXcanvas1 *getCanvas(uint16_t width, uint16_t height);
+
     const GFXfont *c_font;    
 };
 
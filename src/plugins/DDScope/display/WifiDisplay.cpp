@@ -35,8 +35,33 @@
 // So must use EXTMEM
 EXTMEM uint8_t compressedBuffer[COMPRESSED_BUFFER_SIZE];
 EXTMEM uint8_t uncompressedBuffer[UNCOMPRESSED_BUFFER_SIZE];
+EXTMEM uint8_t sendBuffer[SEND_BUFFER_SIZE];
 
 bool espIsReady = false;
+bool fullFrameNeeded = true; // a newly connected client has nothing to apply a delta to
+
+// Frame pipeline, sendFrameToEsp() takes a snapshot of the capture buffer into sendBuffer and
+// framePoll() then deflates it a slice at a time and streams it out, so the next frame can be
+// captured while this one is still being sent
+enum FrameState {
+  FRAME_IDLE,
+  FRAME_COMPRESS,
+  FRAME_WAIT_ACK,
+  FRAME_SEND
+};
+
+FrameState frameState = FRAME_IDLE;
+int pendingFrameType = -1;      // requested while busy, sent when idle
+uint8_t frameType = 0;
+const uint8_t *frameData = nullptr;
+size_t frameSize = 0;
+size_t frameSent = 0;
+size_t frameRemaining = 0;      // input bytes not yet handed to the compressor
+unsigned long frameAckTime = 0;
+
+// raw deflate stream, the compressor state is allocated once rather than for every frame
+mz_stream frameStream;
+bool frameStreamReady = false;
 
 // States
 enum TeensyCommState {
@@ -93,36 +118,99 @@ bool waitForEspACK(unsigned long timeoutMillis) {
 
 // ==================== Deflate Compression ====================
 size_t WifiDisplay::compressWithDeflate() {
-  memset(compressedBuffer, 0, COMPRESSED_BUFFER_SIZE);
-
-  mz_stream stream = {0};
-  stream.next_in = uncompressedBuffer;
-  stream.avail_in = UNCOMPRESSED_BUFFER_SIZE;
-  stream.next_out = compressedBuffer;
-  stream.avail_out = COMPRESSED_BUFFER_SIZE;
-
-  // Use mz_deflateInit2 with negative windowBits to get raw deflate
-  int status = mz_deflateInit2(&stream, MZ_DEFAULT_COMPRESSION, MZ_DEFLATED,
-                               -MZ_DEFAULT_WINDOW_BITS, 9, 0);
-  if (status != MZ_OK) {
-    SERIAL_DEBUG.println("Deflate init failed");
-    return 0;
-  }
+  return compressWithDeflate(uncompressedBuffer, UNCOMPRESSED_BUFFER_SIZE);
+}
 
-  status = mz_deflate(&stream, MZ_FINISH);
-  if (status != MZ_STREAM_END) {
+size_t WifiDisplay::compressWithDeflate(const uint8_t *src, size_t len) {
+  if (!deflateStart(src, len)) return 0;
+  if (deflateSlice(len) != 1) {
     SERIAL_DEBUG.println("Deflate compression failed");
-    mz_deflateEnd(&stream);
     return 0;
   }
+  // SERIAL_DEBUG.printf("Deflated %u -> %u bytes\n", len, frameStream.total_out);
+  return frameStream.total_out;
+}
+
+bool WifiDisplay::deflateStart(const uint8_t *src, size_t len) {
+  if (!frameStreamReady) {
+    memset(&frameStream, 0, sizeof(frameStream));
+    // Use mz_deflateInit2 with negative windowBits to get raw deflate
+    int status = mz_deflateInit2(&frameStream, MZ_DEFAULT_COMPRESSION, MZ_DEFLATED,
+                                 -MZ_DEFAULT_WINDOW_BITS, 9, 0);
+    if (status != MZ_OK) {
+      SERIAL_DEBUG.println("Deflate init failed");
+      return false;
+    }
+    frameStreamReady = true;
+  } else if (mz_deflateReset(&frameStream) != MZ_OK) {
+    return false;
+  }
+
+  frameStream.next_in = src;
+  frameStream.avail_in = 0;
+  frameStream.next_out = compressedBuffer;
+  frameStream.avail_out = COMPRESSED_BUFFER_SIZE;
+  frameRemaining = len;
+  return true;
+}
 
-  size_t compressedSize = stream.total_out;
-  mz_deflateEnd(&stream);
+// compresses up to budget more input bytes, returns 1 when finished, 0 if there is more to do, -1 on error
+int WifiDisplay::deflateSlice(size_t budget) {
+  size_t n = min(budget, frameRemaining);
+  frameStream.avail_in = n;
+  frameRemaining -= n;
+
+  int status = mz_deflate(&frameStream, frameRemaining == 0 ? MZ_FINISH : MZ_NO_FLUSH);
+  if (frameRemaining == 0) return status == MZ_STREAM_END ? 1 : -1;
+  if (status != MZ_OK || frameStream.avail_in != 0) return -1;
+  return 0;
+}
+
+// ==================== Delta Frame ====================
+// Only the tiles marked dirty by the pixel capture since the last frame are sent.
+// Horizontally adjacent dirty tiles in a row of tiles are merged into one rectangle.
+// Layout written to sendBuffer (deflated before sending), all values little endian:
+//   [count:2] then count times [x:2][y:2][w:2][h:2][w*h RGB565 pixels, big endian like the full frame]
+size_t WifiDisplay::buildDelta() {
+  size_t writeIndex = 2;
+  uint16_t count = 0;
+
+  for (int ty = 0; ty < MIRROR_TILE_ROWS; ty++) {
+    uint32_t row = dirtyTiles[ty];
+    int tx = 0;
+    while (row) {
+      if (!(row & 1)) { row >>= 1; tx++; continue; }
+      int run = 0;
+      while (row & 1) { row >>= 1; run++; }
+
+      uint16_t x = tx * MIRROR_TILE, y = ty * MIRROR_TILE;
+      uint16_t w = run * MIRROR_TILE, h = MIRROR_TILE;
+      uint16_t header[4] = { x, y, w, h };
+      for (int i = 0; i < 4; i++) {
+        sendBuffer[writeIndex++] = header[i] & 0xFF;
+        sendBuffer[writeIndex++] = header[i] >> 8;
+      }
+      for (int r = 0; r < h; r++) {
+        memcpy(sendBuffer + writeIndex, uncompressedBuffer + ((y + r) * SCREEN_WIDTH + x) * COLOR_DEPTH, w * COLOR_DEPTH);
+        writeIndex += w * COLOR_DEPTH;
+      }
+      count++;
+      tx += run;
+    }
+  }
+  sendBuffer[0] = count & 0xFF;
+  sendBuffer[1] = count >> 8;
+  return writeIndex;
+}
 
-  // SERIAL_DEBUG.printf("Deflated %u -> %u bytes\n", UNCOMPRESSED_BUFFER_SIZE,
-  //               compressedSize);
+int WifiDisplay::dirtyCount() {
+  int count = 0;
+  for (int ty = 0; ty < MIRROR_TILE_ROWS; ty++) count += __builtin_popcount(dirtyTiles[ty]);
+  return count;
+}
 
-  return compressedSize;
+void WifiDisplay::clearDirty() {
+  memset(dirtyTiles, 0, sizeof(dirtyTiles));
 }
 
 // ==================== RLE Compression Function ====================
@@ -199,6 +287,9 @@ size_t WifiDisplay::compressWithRLE() {
 void WifiDisplay::espPoll() {
   // take_esp_lock();
 
+  // the frame ACK belongs to framePoll()
+  if (frameState == FRAME_WAIT_ACK) return;
+
   if (SERIAL_ESP32S3.available()) {
     char incoming = SERIAL_ESP32S3.peek();
 
@@ -206,6 +297,8 @@ void WifiDisplay::espPoll() {
       SERIAL_ESP32S3.read(); // consume it
       SERIAL_DEBUG.println("Received disconnected signal 'D'");
       espIsReady = false;
+      frameState = FRAME_IDLE;
+      pendingFrameType = -1;
       teensyState = WAIT_FOR_IP;
       // give_esp_lock();
       return;
@@ -255,6 +348,7 @@ void WifiDisplay::espPoll() {
         SERIAL_ESP32S3.write('K'); // Client Connect ACK
         SERIAL_ESP32S3.flush();
         espIsReady = true;
+        fullFrameNeeded = true;
         // teensyState = SEND_FRAME;
       }
       break;
@@ -277,123 +371,141 @@ void WifiDisplay::espPoll() {
 // Z (0x5A)= Reset ESP32-S3 state
 // T (0x54)= Touch
 // ================ Send Buffer =================================
-void WifiDisplay::sendFrameToEsp(uint8_t frameType) {
+// Takes the frame snapshot and returns, the compression and transfer are done by framePoll()
+void WifiDisplay::sendFrameToEsp(uint8_t type) {
   if (!espIsReady) {
     SERIAL_DEBUG.println("ESP not ready");
     return;
   }
 
-  // take_esp_lock();
+  // still sending the last frame, a full frame request wins over a delta
+  if (frameState != FRAME_IDLE) {
+    if (pendingFrameType < 0 || type != FRAME_TYPE_DLT) pendingFrameType = type;
+    return;
+  }
+
+  startFrame(type);
+}
 
+void WifiDisplay::startFrame(uint8_t type) {
   // Check if any status byte is available from ESP
   if (SERIAL_ESP32S3.available()) {
     char peekChar = SERIAL_ESP32S3.peek();
     //SERIAL_DEBUG.print(peekChar);
     if (peekChar == 'T' || 'D') {
-      // give_esp_lock();
       return;
     }
   }
 
-  // clear any junk
-  // while (SERIAL_ESP32S3.available()) {
-  //   SERIAL_ESP32S3.read();
-  // }
-  // delay(3);
-  // === Prepare Size of Payload ===
-  size_t bufSize = 0;
-  const uint8_t *bufferToSend = nullptr;
-
-  if (frameType == FRAME_TYPE_RLE) {
-    bufSize = compressWithRLE();
-    if (bufSize == 0) {
-      give_esp_lock();
-      return;
-    }
-    bufferToSend = compressedBuffer;
-    // SERIAL_DEBUG.println("Sending RLE frame to ESP32-S3");
-  } else if (frameType == FRAME_TYPE_DEF) {
-    bufSize = compressWithDeflate();
-    if (bufSize == 0) {
-      give_esp_lock();
-      return;
-    }
-    bufferToSend = compressedBuffer;
-    // SERIAL_DEBUG.println("Sending Deflate frame to ESP32-S3");
-  } else if (frameType == FRAME_TYPE_RAW) {
-    bufSize = UNCOMPRESSED_BUFFER_SIZE;
-    bufferToSend = uncompressedBuffer;
+  // nothing changed since the last frame, or the client needs a full one first
+  if (type == FRAME_TYPE_DLT) {
+    int tiles = dirtyCount();
+    if (tiles == 0 && !fullFrameNeeded) return;
+    if (fullFrameNeeded || tiles > MIRROR_DELTA_MAX_TILES) type = FRAME_TYPE_DEF;
+  }
+
+  // === Snapshot the frame ===
+  if (type == FRAME_TYPE_RLE) {
+    frameSize = compressWithRLE();
+    if (frameSize == 0) return;
+    frameData = compressedBuffer;
+  } else if (type == FRAME_TYPE_DEF) {
+    memcpy(sendBuffer, uncompressedBuffer, UNCOMPRESSED_BUFFER_SIZE);
+    if (!deflateStart(sendBuffer, UNCOMPRESSED_BUFFER_SIZE)) return;
+  } else if (type == FRAME_TYPE_DLT) {
+    if (!deflateStart(sendBuffer, buildDelta())) return;
+  } else if (type == FRAME_TYPE_RAW) {
+    memcpy(sendBuffer, uncompressedBuffer, UNCOMPRESSED_BUFFER_SIZE);
+    frameSize = UNCOMPRESSED_BUFFER_SIZE;
+    frameData = sendBuffer;
   } else {
     SERIAL_DEBUG.printf("Unknown FRAME TYPE");
-    give_esp_lock();
     return;
   }
 
-  // Is ESP ready for Frame
+  // changes from here on go in the next frame
+  clearDirty();
+  fullFrameNeeded = false;
+  frameType = type;
+
+  if (type == FRAME_TYPE_DEF || type == FRAME_TYPE_DLT) frameState = FRAME_COMPRESS; else requestFrame();
+}
+
+// Is ESP ready for Frame
+void WifiDisplay::requestFrame() {
   // SERIAL_DEBUG.println("Sending 'Z'");
   SERIAL_ESP32S3.write('Z');
   SERIAL_ESP32S3.flush();
+  frameAckTime = millis();
+  frameState = FRAME_WAIT_ACK;
+}
 
-  // get ESP ACK
-  bool ackReceived = false;
-  unsigned long ackTime = millis();
-  while (millis() - ackTime < 20) {
-    if (SERIAL_ESP32S3.available()) {
-      char incoming = SERIAL_ESP32S3.read();
-      if (incoming == ACK) {
-        ackReceived = true;
-        // SERIAL_DEBUG.println("Frame ACK from ESP");
-        break;
-      }
-    }
-    yield();
-  }
+// the client missed this frame so it can't apply a delta to it
+void WifiDisplay::abortFrame() {
+  frameState = FRAME_IDLE;
+  fullFrameNeeded = true;
+}
 
-  if (!ackReceived) {
-    SERIAL_DEBUG.println("No ESP32 ACK");
-    // espIsReady = false;
-    // give_esp_lock();
-    return;
+// Runs the frame pipeline one step at a time from its own task
+void WifiDisplay::framePoll() {
+  switch (frameState) {
+  case FRAME_IDLE:
+    if (pendingFrameType >= 0 && espIsReady) {
+      uint8_t type = pendingFrameType;
+      pendingFrameType = -1;
+      startFrame(type);
+    }
+    break;
+
+  case FRAME_COMPRESS: {
+    int status = deflateSlice(FRAME_SLICE_BYTES);
+    if (status < 0) {
+      SERIAL_DEBUG.println("Deflate compression failed");
+      abortFrame();
+    } else if (status > 0) {
+      frameData = compressedBuffer;
+      frameSize = frameStream.total_out;
+      requestFrame();
+    }
+    break;
   }
 
-  // SERIAL_DEBUG.printf("Sending bufSize (%u bytes) as [0x%02X 0x%02X 0x%02X
-  // 0x%02X]\n",
-  //             bufSize,
-  //             (uint8_t)(bufSize & 0xFF),
-  //             (uint8_t)((bufSize >> 8) & 0xFF),
-  //             (uint8_t)((bufSize >> 16) & 0xFF),
-  //             (uint8_t)((bufSize >> 24) & 0xFF)
-  //);
-  //  === Send Type and Size Header ===
-  SERIAL_ESP32S3.write(frameType);
-  SERIAL_ESP32S3.write((uint8_t)(bufSize & 0xFF));
-  SERIAL_ESP32S3.write((uint8_t)((bufSize >> 8) & 0xFF));
-  SERIAL_ESP32S3.write((uint8_t)((bufSize >> 16) & 0xFF));
-  SERIAL_ESP32S3.write((uint8_t)((bufSize >> 24) & 0xFF));
-  SERIAL_ESP32S3.flush();
-
-  // --- Send Payload in 64-byte Chunks with Flow Control ---
-  int totalSent = 0;
-  const size_t packetSize = 64;
-
-  for (size_t i = 0; i < bufSize; i += packetSize) {
-    int chunkSize = min(packetSize, bufSize - i);
-
-    // Wait until there's space to send the next chunk
-    while (SERIAL_ESP32S3.availableForWrite() < chunkSize) {
-      yield(); // Let background USB and other tasks run (required for correct
-               // operation)
+  case FRAME_WAIT_ACK:
+    // get ESP ACK
+    while (SERIAL_ESP32S3.available()) {
+      if (SERIAL_ESP32S3.read() == ACK) {
+        //  === Send Type and Size Header ===
+        SERIAL_ESP32S3.write(frameType);
+        SERIAL_ESP32S3.write((uint8_t)(frameSize & 0xFF));
+        SERIAL_ESP32S3.write((uint8_t)((frameSize >> 8) & 0xFF));
+        SERIAL_ESP32S3.write((uint8_t)((frameSize >> 16) & 0xFF));
+        SERIAL_ESP32S3.write((uint8_t)((frameSize >> 24) & 0xFF));
+        SERIAL_ESP32S3.flush();
+        frameSent = 0;
+        frameState = FRAME_SEND;
+        return;
+      }
     }
-
-    int sent = SERIAL_ESP32S3.write(bufferToSend + i, chunkSize);
-    totalSent += sent;
-    delayMicroseconds(200); // Tune this if needed
+    if (millis() - frameAckTime >= 20) {
+      SERIAL_DEBUG.println("No ESP32 ACK");
+      abortFrame();
+    }
+    break;
+
+  case FRAME_SEND:
+    // --- Send Payload in 64-byte Chunks with Flow Control, a few chunks per call ---
+    for (int i = 0; i < FRAME_SLICE_CHUNKS && frameSent < frameSize; i++) {
+      int chunkSize = min((size_t)64, frameSize - frameSent);
+      if (SERIAL_ESP32S3.availableForWrite() < chunkSize) break; // try again next time
+      frameSent += SERIAL_ESP32S3.write(frameData + frameSent, chunkSize);
+      delayMicroseconds(200); // Tune this if needed
+    }
+    if (frameSent >= frameSize) {
+      SERIAL_ESP32S3.flush();
+      frameState = FRAME_IDLE;
+    }
+    break;
   }
-  SERIAL_ESP32S3.flush();
-  // unsigned long elapsed = millis() - startTime;
-  // SERIAL_DEBUG.printf("Sent %d bytes in %d ms\n", totalSent, elapsed);
-  //  NOTE: the longest elapsed time to compress and send is approx 143 msec.
-  // give_esp_lock();
 }
 
 // ==================== Save Buffer to SD Card ====================
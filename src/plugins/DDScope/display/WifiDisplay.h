@@ -12,8 +12,21 @@
 #define UNCOMPRESSED_BUFFER_SIZE ((SCREEN_WIDTH * SCREEN_HEIGHT * COLOR_DEPTH))
 #define COMPRESSED_BUFFER_SIZE ((SCREEN_WIDTH * SCREEN_HEIGHT * COLOR_DEPTH))
 
+// Dirty tracking for delta frames, the screen is divided into tiles and a tile is marked
+// when a captured pixel changes value. One 32 bit word per row of tiles.
+#define MIRROR_TILE 16
+#define MIRROR_TILE_COLS (SCREEN_WIDTH / MIRROR_TILE)   // 20
+#define MIRROR_TILE_ROWS (SCREEN_HEIGHT / MIRROR_TILE)  // 30
+#define MIRROR_DELTA_MAX_TILES (MIRROR_TILE_COLS * MIRROR_TILE_ROWS / 2) // more than this and a full frame is sent
+#define SEND_BUFFER_SIZE (UNCOMPRESSED_BUFFER_SIZE + 2 + MIRROR_TILE_COLS * MIRROR_TILE_ROWS * 8)
+
+// Frame pipeline work done per framePoll() call
+#define FRAME_SLICE_BYTES (16 * 1024) // input bytes deflated
+#define FRAME_SLICE_CHUNKS 8          // 64 byte chunks written
+
 extern uint8_t compressedBuffer[COMPRESSED_BUFFER_SIZE];
 extern uint8_t uncompressedBuffer[UNCOMPRESSED_BUFFER_SIZE];
+extern uint8_t sendBuffer[SEND_BUFFER_SIZE];
 
 //======================================================================
 class WifiDisplay  
@@ -21,9 +34,15 @@ class WifiDisplay
   public:
     void saveBufferToSD(const char* screenName);
     void enableScreenCapture(bool enable);
-    void sendFrameToEsp(uint8_t frameType);
+    void sendFrameToEsp(uint8_t type);
+    void framePoll();
     size_t compressWithRLE();
     size_t compressWithDeflate();
+    size_t compressWithDeflate(const uint8_t *src, size_t len);
+    size_t buildDelta();
+    int dirtyCount();
+    inline void markDirty(uint16_t x, uint16_t y) { dirtyTiles[y / MIRROR_TILE] |= 1UL << (x / MIRROR_TILE); }
+    void clearDirty();
     void espPoll();
     void take_esp_lock();
     void give_esp_lock();
@@ -32,9 +51,15 @@ class WifiDisplay
     bool isUpdateScreenCaptureEnabled = false;
     volatile bool espIsLocked = false;  // Simple lock for thread safety
     String wifiStaIpStr = "";
+    uint32_t dirtyTiles[MIRROR_TILE_ROWS] = {0};
 
  private:
-  
+    void startFrame(uint8_t type);
+    void requestFrame();
+    void abortFrame();
+    bool deflateStart(const uint8_t *src, size_t len);
+    int deflateSlice(size_t budget);
+
 };
 
 extern WifiDisplay wifiDisplay;
@@ -13,7 +13,9 @@
 //
 #include "LX200Handler.h"
 #include "../display/Display.h"
+#include "../catalog/Catalog.h"
 #include "src/lib/serial/Serial_Local.h"
+#include "src/lib/convert/Convert.h"
 
 void lxWrapper() { lx200Handler.lxPoll(); }
 
@@ -27,10 +29,16 @@ void lxWrapper() { lx200Handler.lxPoll(); }
 //#define SERIAL_ESP32  SERIAL_B
 //#define SERIAL_ESP_BAUD SERIAL_B_BAUD_DEFAULT
 
+// extend the Serial8 ring buffers so a SkySafari burst is held in full between polls
+static uint8_t espRxBuffer[512];
+static uint8_t espTxBuffer[LX200_OUT_BUFFER];
+
 void LX200Handler::init() {
   pinMode(34, INPUT_PULLUP);  // Serial8 RX pin
    
   SERIAL_ESP32.begin(SERIAL_ESP_BAUD);
+  SERIAL_ESP32.addMemoryForRead(espRxBuffer, sizeof(espRxBuffer));
+  SERIAL_ESP32.addMemoryForWrite(espTxBuffer, sizeof(espTxBuffer));
   SERIAL_DEBUG.println("MSG: LX200, Starting ESP32C3 Serial");
   delay(10);
   
@@ -38,8 +46,8 @@ void LX200Handler::init() {
   while (SERIAL_ESP32.available()) SERIAL_ESP32.read(); 
 
   // start LX200 poll task
-  VF("MSG: Setup, start LX200 polling task (rate 10 ms priority 2)... ");
-  uint8_t lx_handle = tasks.add(20, 0, true, 3, lxWrapper, "LX200 task");
+  VF("MSG: Setup, start LX200 polling task (rate 5 ms priority 3)... ");
+  uint8_t lx_handle = tasks.add(5, 0, true, 3, lxWrapper, "LX200 task");
   if (lx_handle) {
     VLF("success");
   } else {
@@ -48,77 +56,120 @@ void LX200Handler::init() {
 }
 
 // =====================================================
+// Each command from the ESP32C3 is framed as 'L' (request), answered with 'K' (ACK),
+// then ":cmd#" answered with "reply#". Everything that has arrived is drained each
+// poll; ACKs and replies are queued and written together when the input runs dry,
+// so the ESP32C3 sees its ACK on the same poll and the next command can already be
+// on the way while this one is processed.
 void LX200Handler::lxPoll() {
+  // abandon a partial frame that stalled, the ESP32C3 will retry with a new 'L'
+  if (frameState == FRAME_CMD && (long)(millis() - frameStart) > LX200_FRAME_TIMEOUT_MS) {
+    frame[frameLen] = 0;
+    VF("MSG: LX200, Timeout or missing '#' terminator. Received so far: \""); V(frame); VLF("\"");
+    frameState = FRAME_IDLE;
+  }
 
-  if (SERIAL_ESP32.available()) {
-    char peekChar = SERIAL_ESP32.peek();
-
-    //SERIAL_DEBUG.print("0x"); SERIAL_DEBUG.println(peekChar, HEX);
-    if (peekChar == 'L') {
-      //unsigned long tStart = micros();  // Start timing
-      SERIAL_ESP32.read();
-      SERIAL_ESP32.write('K'); // ACK
-      SERIAL_ESP32.flush();
-
-      String lxCmd = "";
-
-      // Read command from Teensy until '#' or timeout
-      unsigned long start = micros();
-      const unsigned long timeoutMicros = 10000;
-      while ((micros() - start) < timeoutMicros) {
-        if (SERIAL_ESP32.available()) {
-          char c = SERIAL_ESP32.read();
-          lxCmd += c;
-          if (c == '#') break;
-        }
-      }
+  while (SERIAL_ESP32.available()) {
+    char c = SERIAL_ESP32.read();
+
+    // 'L' outside a command is a request, also when it repeats one not yet followed up
+    if (c == 'L' && (frameState == FRAME_IDLE || frameLen == 0)) {
+      queue("K", 1);
+      frameState = FRAME_CMD;
+      frameStart = millis();
+      frameLen = 0;
+      continue;
+    }
+    if (frameState == FRAME_IDLE) continue;
+
+    // FRAME_CMD
+    if (frameLen == 0 && c != ':') { frameState = FRAME_IDLE; continue; }
+    if (frameLen >= LX200_CMD_MAX) {
+      VLF("MSG: LX200, command too long, dropped");
+      frameState = FRAME_IDLE;
+      continue;
+    }
+    frame[frameLen++] = c;
+    if (c == '#') {
+      frame[frameLen] = 0;
+      frameState = FRAME_IDLE;
+      process(frame);
+    }
+  }
 
-      //SERIAL_DEBUG.print("LX200 Cmd = "); SERIAL_DEBUG.println(lxCmd);
+  flushOut();
+}
 
-      if (lxCmd.length() == 0 || lxCmd.charAt(0) != ':' || lxCmd.charAt(lxCmd.length() - 1) != '#') {
-        SERIAL_DEBUG.printf("MSG: LX200, Timeout or missing '#' terminator. Received so far: \"%s\"\n", lxCmd.c_str());
-        return;
-      }
+// run one complete ":...#" command and queue its reply
+void LX200Handler::process(const char *cmd) {
+  char lxResp[LX200_REPLY_MAX] = "";
+
+  // :ON[name]#  Find an object in the built-in catalogs by identifier ("M31", "NGC 7000") or name ("Vega")
+  //             and set it as the goto target
+  //             Returns: 1# on success, 0# if not found
+  if (cmd[1] == 'O' && cmd[2] == 'N') {
+    char query[CAT_SEARCH_MAX_QUERY + 1] = "";
+    strncpy(query, &cmd[3], CAT_SEARCH_MAX_QUERY);
+    char *term = strchr(query, '#'); if (term) *term = 0;
+    queue(setTargetByName(query) ? "1#" : "0#", 2);
+    return;
+  }
 
-      const char* cmd = lxCmd.c_str();
-      char lxResp[32] = "";
+  // Determine whether command is a setter (e.g., :Sr) or a getter (e.g., :GD)
+  // Setter commands typically begin with :S (Set) and have parameters
+  size_t cmdLen = strlen(cmd);
+  bool isSetter = cmdLen > 3 && cmd[1] == 'S' && isalpha(cmd[2]);
 
-      // Determine whether command is a setter (e.g., :Sr) or a getter (e.g., :GD)
-      bool isSetter = false;
-      if (strlen(cmd) > 3) {
-        // Setter commands typically begin with :S (Set) and have parameters
-        if (cmd[1] == 'S' && isalpha(cmd[2]) && cmd[strlen(cmd) - 1] == '#') {
-          isSetter = true;
-        }
+  if (isSetter) {
+    // Setter: Use commandBool
+    bool result = display.commandBool(cmd);
+    snprintf(lxResp, sizeof(lxResp), "%d#", result ? 1 : 0);
+  } else {
+    // Getter: Use commandWithReply
+    display.commandWithReply(cmd, lxResp);
+    // Make sure '#' is appended
+    size_t len = strlen(lxResp);
+    if (len == 0 || lxResp[len - 1] != '#') {
+      if (len < sizeof(lxResp) - 1) {
+        lxResp[len] = '#';
+        lxResp[len + 1] = '\0';
       }
+    }
+  }
 
-      if (isSetter) {
-        // Setter: Use commandBool
-        bool result = display.commandBool((char*)cmd);
-        snprintf(lxResp, sizeof(lxResp), "%d#", result ? 1 : 0);
-      } else {
-        // Getter: Use commandWithReply
-        display.commandWithReply(cmd, lxResp);
-        // Make sure '#' is appended
-        size_t len = strlen(lxResp);
-        if (len == 0 || lxResp[len - 1] != '#') {
-          if (len < sizeof(lxResp) - 1) {
-            lxResp[len] = '#';
-            lxResp[len + 1] = '\0';
-          }
-        }
-      }
+  queue(lxResp, strlen(lxResp));
+  VF("MSG: LX200, Cmd: "); V(cmd); VF("  Resp: "); VL(lxResp);
+}
 
-      // Send response back over serial
-      SERIAL_ESP32.print(lxResp);
-      SERIAL_ESP32.flush();
+// append to the pending output, writing out first if it would not fit
+void LX200Handler::queue(const char *s, size_t len) {
+  if (outLen + len > sizeof(out)) flushOut();
+  memcpy(&out[outLen], s, len);
+  outLen += len;
+}
 
-      SERIAL_DEBUG.printf("MSG: LX200, Cmd: %-14s  Resp: %s\n", lxCmd.c_str(), lxResp);
+void LX200Handler::flushOut() {
+  if (outLen == 0) return;
+  SERIAL_ESP32.write((const uint8_t *)out, outLen);
+  outLen = 0;
+}
 
-      //unsigned long tEnd = micros();  // End timing
-      ///SERIAL_DEBUG.printf("MSG: LX200, lxPoll() duration: %lu µs\n", tEnd - tStart);
-    }
-  }
+// look up an object by name and write its coordinates as the goto target, the catalog
+// screens' selection is left alone
+bool LX200Handler::setTargetByName(const char *name) {
+  int cat;
+  long index;
+  double ra, dec;
+  if (!cat_mgr.findObject(name, &cat, &index, &ra, &dec)) return false;
+
+  char cmd[20], reply[16];
+  convert.doubleToHms(reply, ra, false, PM_HIGH);
+  snprintf(cmd, sizeof(cmd), ":Sr%s#", reply);
+  if (!display.commandBool(cmd)) return false;
+
+  convert.doubleToDms(reply, dec, false, true, PM_HIGH);
+  snprintf(cmd, sizeof(cmd), ":Sd%s#", reply);
+  return display.commandBool(cmd);
 }
 
 LX200Handler lx200Handler;
\ No newline at end of file
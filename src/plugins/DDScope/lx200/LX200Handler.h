@@ -7,18 +7,35 @@
 
 #define SERIAL_ESP32C3 Serial8
 
+#define LX200_CMD_MAX          48    // longest :...# frame accepted, includes the ':' and '#'
+#define LX200_REPLY_MAX        32    // longest reply to one command
+#define LX200_OUT_BUFFER       512   // ACKs and replies queued during one poll, written at once
+#define LX200_FRAME_TIMEOUT_MS 50    // drop a partial command frame after this long
+
 //======================================================================
 class LX200Handler  {
   public:
     void init();
     void lxPoll();
+    bool setTargetByName(const char *name);
     //void take_esp_lock();
     //void give_esp_lock();
    
     //volatile bool espIsLocked = false;  // Simple lock for thread safety
 
   private:
-  
+    enum FrameState : uint8_t { FRAME_IDLE, FRAME_CMD };
+
+    void process(const char *cmd);
+    void queue(const char *s, size_t len);
+    void flushOut();
+
+    FrameState frameState = FRAME_IDLE;
+    unsigned long frameStart = 0;
+    char frame[LX200_CMD_MAX + 1];
+    uint8_t frameLen = 0;
+    char out[LX200_OUT_BUFFER];
+    size_t outLen = 0;
 };
 
 extern LX200Handler lx200Handler;
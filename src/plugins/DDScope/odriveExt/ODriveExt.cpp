@@ -77,7 +77,8 @@ float ODriveExt::getODriveBusVoltage(int axis) {
     ODRIVE_SERIAL << "r vbus_voltage\n";
     float battery_voltage = _oDriveDriver->readFloat();
   #elif ODRIVE_COMM_MODE == OD_CAN
-    float battery_voltage = _oDriveDriver->GetVbusVoltage(axis);  //Can be sent to either axis
+    UNUSED(axis);
+    float battery_voltage = _oDriveDriver->LatestVbusVoltage();  // requested periodically by the CAN poll task
   #endif
 
   // Handle timeout condition:
@@ -109,7 +110,7 @@ float ODriveExt::getEncoderPositionDeg(int axis) {
     ODRIVE_SERIAL << "r axis" << axis << ".encoder.pos_estimate\n"; Y;
     float turns = _oDriveDriver->readFloat();
   #elif ODRIVE_COMM_MODE == OD_CAN
-    float turns = _oDriveDriver->GetPosition(axis);
+    float turns = _oDriveDriver->LatestPosition(axis);
   #endif
   return turns*360;
 }  
@@ -121,7 +122,7 @@ float ODriveExt::getMotorPositionTurns(int axis) {
     ODRIVE_SERIAL << "r axis" << axis << ".encoder.pos_estimate\n"; Y;
     float turns = _oDriveDriver->readFloat();
   #elif ODRIVE_COMM_MODE == OD_CAN
-    float turns = _oDriveDriver->GetPosition(axis);
+    float turns = _oDriveDriver->LatestPosition(axis);
   #endif
   return turns;
 }  
@@ -145,7 +146,7 @@ float ODriveExt::getMotorCurrent(int axis) {
     ODRIVE_SERIAL << "r axis" << axis << ".motor.I_bus\n"; Y;
     float Iq = _oDriveDriver->readFloat();
   #elif ODRIVE_COMM_MODE == OD_CAN
-    float Iq = _oDriveDriver->GetIqMeasured(axis);
+    float Iq = _oDriveDriver->LatestIqMeasured(axis);
   #endif
   return Iq;
 }  
@@ -186,7 +187,9 @@ float ODriveExt::getMotorPositionDelta(int axis) {
     target = ((float)currentTarget*RAD_DEG_RATIO)/360;
     //int32_t enc_actual = _oDriveDriver->GetEncoderShadowCount(axis); // 2^14 = 16384 counts per revolution
     //actual = (float)enc_actual/16384;
-    actual = _oDriveDriver->GetPosition(axis);
+    unsigned long time;
+    actual = _oDriveDriver->LatestPosition(axis, &time);
+    if (time == 0 || millis() - time > 2*ODRIVE_CAN_TELEMETRY_MS) return 0.0F; // no recent estimate
     deltaPos = (target - actual); 
     //char deltaPosS[9]="";
     //char actualS[9]="";
@@ -290,9 +293,12 @@ uint32_t ODriveExt::getODriveErrors(int axis, Component component) {
       if (component == AXIS) {
         return axisErr = _oDriveDriver->GetAxisError(axis);
       } else if (component == MOTOR) {
-        return axisErr = _oDriveDriver->GetMotorError(axis);
+        // reply arrives by the next screen update
+        _oDriveDriver->request(axis, ODriveTeensyCAN::CMD_ID_GET_MOTOR_ERROR);
+        return axisErr = _oDriveDriver->LatestMotorError(axis);
       } else if (component == ENCODER) {
-        return axisErr = _oDriveDriver->GetEncoderError(axis);
+        _oDriveDriver->request(axis, ODriveTeensyCAN::CMD_ID_GET_ENCODER_ERROR);
+        return axisErr = _oDriveDriver->LatestEncoderError(axis);
       } else if (component == CONTROLLER) {
         return axisErr = _oDriveDriver->GetControllerFlags(axis);
       } else {
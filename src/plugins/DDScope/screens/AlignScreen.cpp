@@ -124,6 +124,7 @@ void AlignScreen::draw() {
   canvAlignInsPrint.printLJ(247, 249, 67, 15, guideRateText, false);
   showCorrections();
   updateAlignStatus();
+  refreshSnapshot();
   updateCommonStatus();
 
   if (moreScreen.objectSelected) restoreAlignState(); // coming back from the STARS screen
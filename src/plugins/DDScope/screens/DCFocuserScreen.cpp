@@ -139,6 +139,7 @@ void DCFocuserScreen::draw() {
   tft.setCursor(FOC_LABEL_X, FOC_LABEL_Y + y_offset);
   tft.print(" Target Delta:");
 
+  refreshSnapshot();
   updateCommonStatus();
   updateFocuserStatus();
 
@@ -16,6 +16,9 @@
 #define STATUS_X                 10 
 #define STATUS_Y                104 
 #define STATUS_SPACING           13 
+#ifdef TASKS_HISTOGRAM_ENABLE
+  #define TASK_STATUS_Y         451 
+#endif
 
 // ========== Draw the Extended Status Screen ==========
 void ExtStatusScreen::draw() {
@@ -44,6 +47,9 @@ void ExtStatusScreen::draw() {
   mountStatus();
   tlsStatus();
   limitsStatus();
+  #ifdef TASKS_HISTOGRAM_ENABLE
+    taskStatus();
+  #endif
 
   #ifdef ENABLE_TFT_MIRROR
   wifiDisplay.enableScreenCapture(false);
@@ -61,6 +67,10 @@ void ExtStatusScreen::updateExStatus() {
   //tft.fillRect(STATUS_X, STATUS_Y, 250, TFT_HEIGHT-150, pgBackground);
   //tlsStatus();
   //limitsStatus();
+  #ifdef TASKS_HISTOGRAM_ENABLE
+    tft.fillRect(STATUS_X, TASK_STATUS_Y + 2, 300, STATUS_SPACING*2, pgBackground);
+    taskStatus();
+  #endif
 }
 
 void ExtStatusScreen::mountStatus() {
@@ -208,4 +218,37 @@ void ExtStatusScreen::limitsStatus() {
   tft.print("Overhead Limit = "); tft.print(exReply);  
 }
 
+#ifdef TASKS_HISTOGRAM_ENABLE
+// worst task timing from the OnTask histograms, read directly rather than through :GXJ
+void ExtStatusScreen::taskStatus() {
+  static const char *binLabel[TASKS_HISTOGRAM_BINS] = { "<4us", "<16us", "<64us", "<256us", "<1ms", "<4ms", "<16ms", ">16ms" };
+  TaskHistogram h;
+  uint8_t lateHandle = 0, lateCount = 0, runHandle = 0, runBin = 0;
+  unsigned long lateMost = 0;
+
+  uint8_t handle = tasks.getFirstHandle();
+  for (int i = 0; i < TASKS_MAX; i++) {
+    if (handle == 0) break;
+    if (tasks.getHistogram(handle, &h)) {
+      // arrivals 1ms or more late (bins 5 and up)
+      unsigned long late = 0, total = 0;
+      for (uint8_t b = 0; b < TASKS_HISTOGRAM_BINS; b++) { total += h.arrival[b]; if (b >= 5) late += h.arrival[b]; }
+      if (late > lateMost) { lateMost = late; lateHandle = handle; lateCount = (late*100UL)/total; }
+
+      for (uint8_t b = TASKS_HISTOGRAM_BINS - 1; b > runBin; b--) if (h.runtime[b]) { runBin = b; runHandle = handle; break; }
+    }
+    handle = tasks.getNextHandle(handle);
+  }
+
+  int y_offset = TASK_STATUS_Y;
+  y_offset +=STATUS_SPACING; tft.setCursor(STATUS_X, y_offset);
+  tft.print("Late>1ms: ");
+  if (lateHandle) { tft.print(tasks.getNameStr(lateHandle)); tft.print(" "); tft.print(lateCount); tft.print("%"); } else tft.print("None");
+
+  y_offset +=STATUS_SPACING; tft.setCursor(STATUS_X, y_offset);
+  tft.print("Longest Run: ");
+  if (runHandle) { tft.print(tasks.getNameStr(runHandle)); tft.print(" "); tft.print(binLabel[runBin]); } else tft.print("None");
+}
+#endif
+
 ExtStatusScreen extStatusScreen;
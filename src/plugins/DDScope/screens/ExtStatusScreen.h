@@ -12,6 +12,9 @@ class ExtStatusScreen : public Display {
     void mountStatus();
     void tlsStatus();
     void limitsStatus();
+    #ifdef TASKS_HISTOGRAM_ENABLE
+      void taskStatus();
+    #endif
     void updateExStatus();
 
   private: 
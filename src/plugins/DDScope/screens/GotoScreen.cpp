@@ -138,6 +138,7 @@ void GotoScreen::draw() {
   tft.fillRect(TEXT_FIELD_X, TEXT_FIELD_Y+CUSTOM_FONT_OFFSET, TEXT_FIELD_WIDTH, TEXT_FIELD_HEIGHT-9,  butBackground);
   tft.fillRect(TEXT_FIELD_X, TEXT_FIELD_Y+TEXT_SPACING_Y+CUSTOM_FONT_OFFSET, TEXT_FIELD_WIDTH, TEXT_FIELD_HEIGHT-9,  butBackground);
   
+  refreshSnapshot();
   updateCommonStatus();
   showGpsStatus();
   #ifdef ENABLE_TFT_MIRROR
@@ -92,6 +92,7 @@ void GuideScreen::draw() {
   updateGuideButtons();
   //showOnStepCmdErr(); // show error bar
 
+  refreshSnapshot();
   updateCommonStatus();
   showGpsStatus();
   updateGuideStatus();
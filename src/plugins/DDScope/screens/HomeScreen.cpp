@@ -69,16 +69,6 @@
 #define COL_2_ROW_5_S_STR "AZM MotTemp:"
 #define COL_2_ROW_6_S_STR "ALT MotTemp:"
 
-// Column 1 Command strings
-#define COL_1_ROW_1_C_STR ":GL#  "
-#define COL_1_ROW_2_C_STR ":GS#  "
-#define COL_1_ROW_3_C_STR ":Gt#  "
-#define COL_1_ROW_4_C_STR ":Gg#  "
-#define COL_1_ROW_5_C_STR ":GX9A#" // temperature deg C
-#define COL_1_ROW_6_C_STR ":GX9C#" // humidity
-#define COL_1_ROW_7_C_STR ":GX9E#" // dew point deg C
-//#define COL_1_ROW_8_C_STR ":GX9D#" // altitiude
-
 // Column One Status strings
 //static const char colOneStatusStr[COL_1_NUM_ROWS][12] = {
 const char colOneStatusStr[COL_1_NUM_ROWS][12] = {
@@ -91,12 +81,6 @@ const char colTwoStatusStr[COL_2_NUM_ROWS][14] = {
   COL_2_ROW_1_S_STR, COL_2_ROW_2_S_STR, COL_2_ROW_3_S_STR, COL_2_ROW_4_S_STR,
   COL_2_ROW_5_S_STR, COL_2_ROW_6_S_STR};
 
-// Column One Status commands
-//static const char colOneCmdStr[COL_1_NUM_ROWS][8] = {
-const char colOneCmdStr[COL_1_NUM_ROWS][8] = {
-  COL_1_ROW_1_C_STR, COL_1_ROW_2_C_STR, COL_1_ROW_3_C_STR, COL_1_ROW_4_C_STR,
-  COL_1_ROW_5_C_STR, COL_1_ROW_6_C_STR, COL_1_ROW_7_C_STR};
-
 // Home Screen Button object
 Button homeButton(
                 ACTION_COL_1_X, ACTION_COL_1_Y, ACTION_BOXSIZE_X, ACTION_BOXSIZE_Y,
@@ -152,6 +136,7 @@ void HomeScreen::draw() {
   drawCommonStatusLabels();
   //showOnStepCmdErr(); // show error bar
   //getOnStepGenErr(); // and the next one
+  refreshSnapshot();
   updateHomeStatus();
   updateCommonStatus();
   showGpsStatus();
@@ -175,17 +160,21 @@ void HomeScreen::updateHomeStatus() {
   float currentALTMotorCur  = 00.0;
   float currentALTMotorTemp = 00.0;
   float currentAZMotorTemp  = 00.0;
-  char curCol1[11][8] = { {0} };
+  char curCol1[COL_1_NUM_ROWS][13] = { {0} };
   char xchReply[13]="";
   int y_offset = 0;
 
-  // Loop through Column 1 poll updates
+  // Loop through Column 1 updates, formatted from the display snapshot
+  const MountSnapshot &snap = snapshot;
   for (int i=0; i<COL_1_NUM_ROWS; i++) {
-    commandWithReply(colOneCmdStr[i], xchReply); 
-
-    if (i == (int)4) { // handle special case....convert C to F
-      double tempF = ((atof(xchReply)*9)/5) + 32;
-      sprintf(xchReply, "%3.1f F", tempF); // convert back to string to right justify
+    switch (i) {
+      case 0: convert.doubleToHms(xchReply, snap.local.hour, false, convert.precision); break;  // local time
+      case 1: convert.doubleToHms(xchReply, snap.lst, false, convert.precision); break;         // LST
+      case 2: convert.doubleToDms(xchReply, radToDeg(snap.latitude), false, true, PM_LOW); break;
+      case 3: convert.doubleToDms(xchReply, radToDeg(snap.longitude), true, true, PM_LOW); break;
+      case 4: sprintf(xchReply, "%3.1f F", ((snap.temperature*9)/5) + 32); break;              // convert C to F
+      case 5: sprintf(xchReply, "%3.1f", snap.humidity); break;
+      case 6: sprintf(xchReply, "%3.1f", snap.dewPoint); break;
     }
 
     // only update screen if value is different
@@ -14,6 +14,7 @@
 #include "TreasureCatScreen.h"
 #include "CustomCatScreen.h"
 #include "SHCCatScreen.h"
+#include "SearchScreen.h"
 #include "PlanetsScreen.h"
 #include "HomeScreen.h"
 #include "../catalog/Catalog.h" // from SHC
@@ -61,7 +62,13 @@
 #define STOP_BOXSIZE_X         100
 #define STOP_BOXSIZE_Y          38
 
-char MoreScreen::catSelectionStr1[28] = {"Name: "};
+// Selected target box, touch it to find an object
+#define TARGET_X               120
+#define TARGET_Y               358
+#define TARGET_BOXSIZE_X       199
+#define TARGET_BOXSIZE_Y        80
+
+char MoreScreen::catSelectionStr1[28] = {"Name: touch here to find"};
 char MoreScreen::catSelectionStr2[28] = {"Mag:  "};
 char MoreScreen::catSelectionStr3[28] = {"Cons: "};
 char MoreScreen::catSelectionStr4[28] = {"Type: "};
@@ -109,6 +116,7 @@ void MoreScreen::draw() {
   drawCommonStatusLabels(); // Common status at top of most screens
   updateMoreButtons(); // Draw initial More Page Buttons; false=no redraw
   //showOnStepCmdErr(); // show error bar
+  refreshSnapshot();
   updateCommonStatus();
   showGpsStatus();
   site.updateLocation();
@@ -120,8 +128,8 @@ void MoreScreen::draw() {
   // Serial.println(moreScreen.catSelectionStr5); 
 
   // Show any target object data that was selected from Catalog Screens
-  uint16_t x = 120; uint16_t y = 358; 
-  tft.fillRect(x-2, y+3, 199, 5*16, butBackground);
+  uint16_t x = TARGET_X; uint16_t y = TARGET_Y; 
+  tft.fillRect(x-2, y+3, TARGET_BOXSIZE_X, TARGET_BOXSIZE_Y, butBackground);
 
   tft.setCursor(x,y+16  ); tft.print(moreScreen.catSelectionStr1);
   tft.setCursor(x,y+16*2); tft.print(moreScreen.catSelectionStr2);
@@ -555,6 +563,13 @@ bool MoreScreen::touchPoll(uint16_t px, uint16_t py) {
     return false; // shut off flag that draws More Page buttons
   }
 
+  // Selected target box opens the Find Object keyboard
+  if (px > TARGET_X-2 && px < TARGET_X-2 + TARGET_BOXSIZE_X && py > TARGET_Y+3 && py < TARGET_Y+3 + TARGET_BOXSIZE_Y) {
+    BEEP;
+    searchScreen.draw();
+    return false; // shut off flag that draws More Page buttons
+  }
+
   // Check emergeyncy ABORT button area
   display.motorsOff(px, py);
 
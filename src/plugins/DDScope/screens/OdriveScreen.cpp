@@ -2,7 +2,7 @@
 // ODriveScreen.cpp
 //
 // Author: Richard Benear 2022
-#include "ODriveScreen.h"
+#include "OdriveScreen.h"
 #include "../../../telescope/mount/Mount.h"
 #include "../fonts/Inconsolata_Bold8pt7b.h"
 #include "src/lib/tasks/OnTask.h"
@@ -120,6 +120,7 @@ void ODriveScreen::draw() {
   tft.print(oDversion.fwRev);
 
   drawCommonStatusLabels();
+  refreshSnapshot();
   updateCommonStatus();
   updateOdriveButtons();
   updateOdriveStatus();
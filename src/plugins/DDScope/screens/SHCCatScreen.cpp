@@ -97,13 +97,8 @@ void SHCCatScreen::init(uint8_t catSelected) {
   moreScreen.objectSelected = false;
   _catSelected = catSelected; // save for others in this class
 
-  // initialize paging array indexes
-  for (int i = 0; i < MAX_SHC_PAGES; i++) shcPagingArrayIndex[i] = 0;
-
   // initialize which catalog is selected
-  shcPrevRowIndex = cat_mgr.getIndex();
   cat_mgr.select(catSelected);
-  cat_mgr.setIndex(0);                     // initialize row index for entire catalog array at zero
   strcpy(prefix, cat_mgr.catalogPrefix()); // prefix for catalog e.g. Star, M, N, I etc
 
   // Show Page Title
@@ -121,19 +116,20 @@ void SHCCatScreen::init(uint8_t catSelected) {
   strcpy(title, cat_mgr.catalogSubMenu());
   tft.print(title);
 
-  // show number of catalog entries and active filter
+  // show active filter
   tft.fillRect(6, 9, 77, 32, butBackground); // erase page numbers
-  tft.setCursor(235, 25);
-  tft.print("Entries=");
-  if (moreScreen.activeFilter)
-    tft.print("?Filt");
-  else
-    tft.print((uint16_t)(cat_mgr.getMaxIndex()));
   tft.setCursor(235, 9);
   tft.print(activeFilterStr[moreScreen.activeFilter]);
 
+  // draw first page of the selected catalog, or once the list of records passing the active filter is built
   shcCurrentPage = 0;
-  drawShcCat(); // draw first page of the selected catalog
+  shcRow = 0;
+  if (cat_mgr.matchListReady()) {
+    drawShcCat();
+  } else {
+    canvShcInsPrint.printLJ(CAT_X, CAT_Y, 200, CAT_H, "Building list...", false);
+    startMatchList();
+  }
 
   tft.setFont(&Inconsolata_Bold8pt7b);
   shcCatButton.draw(BACK_X, BACK_Y, BACK_W, BACK_H, "BACK", BUT_OFF);
@@ -160,41 +156,30 @@ void SHCCatScreen::drawShcCat() {
   //#define CAT_STAR_LINE_LENGTH (MAG_LENGTH + BAYER_LENGTH + CONS_LENGTH + OBJTYPE_LENGTH + 4 + 1)
   //char catStLine[CAT_STAR_LINE_LENGTH] = ""; // hold the string that is displayed beside the button on each page
 
-  // Show Page number and total Pages
+  // Page number and total Pages, a rebuilt list can be shorter
+  long matches = cat_mgr.matchCount();
+  shcLastPage = (matches + NUM_CAT_ROWS_PER_SCREEN - 1) / NUM_CAT_ROWS_PER_SCREEN;
+  if (shcCurrentPage >= shcLastPage && shcLastPage > 0) shcCurrentPage = shcLastPage - 1;
+  long pageStart = (long)shcCurrentPage * NUM_CAT_ROWS_PER_SCREEN;
   tft.fillRect(6, 9, 70, 12, butBackground);   // erase page numbers
   tft.fillRect(2, 60, 317, 353, pgBackground); // clear lower screen
   tft.setFont(0);                              // basic Arial default
-  tft.setCursor(6, 9);
+
+  // number of catalog entries
+  tft.fillRect(235, 25, 80, 8, titleBackground);
+  tft.setCursor(235, 25);
+  tft.print("Entries=");
+  tft.print((uint16_t)matches);
+  tft.setCursor(8, 9);
   tft.print("Page ");
   tft.print((uint16_t)(shcCurrentPage + 1));
   tft.print(" of ");
-  if (moreScreen.activeFilter == FM_ABOVE_HORIZON)
-    tft.print("??");
-  else
-    tft.print(shcLastPage);
+  tft.print(shcLastPage);
   tft.setCursor(6, 25);
   tft.print(activeFilterStr[moreScreen.activeFilter]);
 
-  cat_mgr.setIndex(shcPagingArrayIndex[shcCurrentPage]); // array of page 1st row indexes
-  if (cat_mgr.hasActiveFilter()) {
-    shcLastPage = shcPrevRowIndex >= cat_mgr.getIndex();
-  } else {
-    shcLastPage = ((cat_mgr.getMaxIndex() / NUM_CAT_ROWS_PER_SCREEN) + 1);
-  }
-  shcLastRow = (cat_mgr.getMaxIndex() % NUM_CAT_ROWS_PER_SCREEN);
-
-  while ((shcRow < NUM_CAT_ROWS_PER_SCREEN) || ((shcRow < shcLastRow) && shcLastPage)) {
-    // Page number and total Pages
-    tft.fillRect(8, 9, 70, 12, butBackground);
-    tft.setCursor(8, 9);
-    tft.print("Page ");
-    tft.print(shcCurrentPage + 1);
-    tft.print(" of ");
-    if (moreScreen.activeFilter)
-      tft.print("??");
-    else
-      tft.print((uint16_t)((cat_mgr.getMaxIndex() / NUM_CAT_ROWS_PER_SCREEN) + 1));
-
+  shcEndOfList = false;
+  while (shcRow < NUM_CAT_ROWS_PER_SCREEN && cat_mgr.setMatch(pageStart + shcRow)) {
     // erase any previous data
     tft.setCursor(CAT_X + CAT_W + 2, CAT_Y + shcRow * (CAT_H + CAT_Y_SPACING));
     tft.fillRect(CAT_X + CAT_W + 5, CAT_Y + shcRow * (CAT_H + CAT_Y_SPACING), 197, 17, butBackground);
@@ -271,8 +256,8 @@ void SHCCatScreen::drawShcCat() {
     // shcDECCustLine is used later by the "Save to custom catalog" feature
     snprintf(shcDECCustLine[shcRow], 15, "%+03d*%02u:%02u", (int)*shcDecDeg[shcRow], (unsigned int)*shcDecMin[shcRow], (unsigned int)*shcDecSec[shcRow]);
 
-    // save the Alt and Azm for use later
-    cat_mgr.EquToHor(cat_mgr.ra(), cat_mgr.dec(), &shcAlt[shcRow], &shcAzm[shcRow]);
+    // save the record so Alt and Azm can be found for the whole page at once
+    shcRecordIndex[shcRow] = cat_mgr.getIndex();
 
     //Serial.printf("RA=%f, Dec=%f\n", cat_mgr.ra(), cat_mgr.dec());
     //Serial.printf("Alt=%f, Azm=%f\n", shcAlt[shcRow], shcAzm[shcRow]);
@@ -284,25 +269,45 @@ void SHCCatScreen::drawShcCat() {
     snprintf(shcDecSrCmd[shcRow], 16, ":Sd%s#", bufTemp);
     // snprintf(shcDecSrCmd[shcRow], 16, ":Sd%s#", shcDECCustLine[shcRow]); // written to the controller for GoTo coordinates
 
-    shcPrevRowIndex = cat_mgr.getIndex();
-    shcRow++;           // increments through the number of lines on screen
-    cat_mgr.incIndex(); // increment the index that keeps track of the entire catalog's contents
-
-    // stop printing data if last field on the last page
-    // VF("shcIndex="); VL(cat_mgr.getIndex());
-    // VF("shcPrevRowIndex="); VL(shcPrevRowIndex);
-    if ((shcPrevRowIndex >= cat_mgr.getIndex()) || (cat_mgr.getIndex() == cat_mgr.getMaxIndex())) {
-      shcEndOfList = true;
-      return;
-    }
+    shcRow++; // increments through the number of lines on screen
   }
-  shcPagingArrayIndex[shcCurrentPage + 1] = cat_mgr.getIndex(); // shcPagingArrayIndex holds index of first element of page to help with NEXT and BACK paging
-  // VF("shcPagingArrayIndex+1="); VL(shcPagingArrayIndex[shcCurrentPage+1]);
+
+  // Alt and Azm for use later
+  cat_mgr.EquToHorBatch(shcRecordIndex, shcRow, shcAlt, shcAzm);
+
+  // stop paging forward if the last match is on this page
+  if (pageStart + shcRow >= matches) shcEndOfList = true;
 }
 
-// show status changes on tasks timer tick
+// show status changes on tasks timer tick, the match list is rebuilt when the horizon filter
+// needs it as the sky turns and the page is drawn again once it is ready
 void SHCCatScreen::updateShcStatus() {
-  //no status, just button updates
+  if (!listPending && !cat_mgr.matchListReady()) startMatchList();
+  if (listDrawPending) {
+    listDrawPending = false;
+    drawShcCat();
+  }
+}
+
+void shcMatchListWrapper() { shcCatScreen.pollMatchList(); }
+
+// build the match list in the background a chunk at a time rather than waiting on it here
+void SHCCatScreen::startMatchList() {
+  listPending = true;
+  if (!listHandle) listHandle = tasks.add(0, 0, true, 6, shcMatchListWrapper, "ShcList");
+  tasks.setPeriod(listHandle, 5);
+}
+
+// match list task, stops itself once the list is built and has the update task draw the page
+void SHCCatScreen::pollMatchList() {
+  if (listPending && display.currentScreen == SHC_CAT_SCREEN) {
+    cat_mgr.select(_catSelected);
+    if (!cat_mgr.matchListPoll()) return;
+    listDrawPending = true;
+    tasks.immediate(display.updateHandle);
+  }
+  listPending = false;
+  tasks.setPeriod(listHandle, 0);
 }
 
 // redraw screen to show state change
@@ -430,8 +435,7 @@ bool SHCCatScreen::touchPoll(uint16_t px, uint16_t py) {
   // BACK button
   if (py > BACK_Y && py < (BACK_Y + BACK_H) && px > BACK_X && px < (BACK_X + BACK_W)) {
     BEEP;
-    if (shcCurrentPage > 0) {
-      shcEndOfList = false;
+    if (shcCurrentPage > 0 && cat_mgr.matchListReady()) {
       shcCurrentPage--;
       drawShcCat();
     }
@@ -441,7 +445,7 @@ bool SHCCatScreen::touchPoll(uint16_t px, uint16_t py) {
   // NEXT page button - reuse BACK button box size
   if (py > NEXT_Y && py < (NEXT_Y + BACK_H) && px > NEXT_X && px < (NEXT_X + BACK_W)) {
     BEEP;
-    if (!shcEndOfList) {
+    if (!shcEndOfList && cat_mgr.matchListReady()) {
       shcCurrentPage++;
       drawShcCat();
     }
@@ -482,7 +486,7 @@ bool SHCCatScreen::touchPoll(uint16_t px, uint16_t py) {
       shCatButDetected = true;
       //Serial.println(shCatButDetected);
 
-      if (shcLastPage && i >= shcRow) {
+      if (i >= shcRow) {
         //Serial.println("Touch below last valid row — ignoring");
         return false;
       }
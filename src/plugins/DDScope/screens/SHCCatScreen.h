@@ -11,7 +11,6 @@ class Display;
 
 #define NUM_CAT_ROWS_PER_SCREEN 16 //(370/CAT_H+CAT_Y_SPACING)
 //#define SD_CARD_LINE_LEN       110 // Length of line stored to SD card for Custom Catalog
-#define MAX_SHC_PAGES           30 // used by paging indexer affay for SHC
 
 //===============================
 class SHCCatScreen : public Display {
@@ -21,8 +20,10 @@ class SHCCatScreen : public Display {
     bool touchPoll(uint16_t px, uint16_t py);
     bool shCatalogButStateChange();
     void updateShcStatus();
+    void pollMatchList();
     
   private:
+    void startMatchList();
     void updateScreen();
     void drawShcCat();
     void saveSHC();
@@ -35,6 +36,9 @@ class SHCCatScreen : public Display {
     bool saveTouched = false;
     bool shcCatalog =false;
     bool shcEndOfList = false;
+    bool listPending = false;
+    bool listDrawPending = false;
+    uint8_t listHandle = 0;
     
     // === Catalog selection & paging ===
     uint8_t  _catSelected;
@@ -44,10 +48,7 @@ class SHCCatScreen : public Display {
     uint16_t shcLastPage = 0;
     uint16_t pre_shcIndex = 0;
     uint16_t curSelSIndex = 0;
-    uint16_t shcPrevRowIndex = 0;
-    uint16_t shcLastRow = 0;
     uint16_t shcRow = 0;
-    uint16_t shcPagingArrayIndex[MAX_SHC_PAGES];
     
     // === Strings and fixed char arrays ===
     const char *activeFilterStr[3] = {"Filt: None", "Filt: Abv Hor", "Filt: All Sky"};
@@ -77,8 +78,9 @@ class SHCCatScreen : public Display {
     uint8_t   shcDecMin[NUM_CAT_ROWS_PER_SCREEN][3];
     uint8_t   shcDecSec[NUM_CAT_ROWS_PER_SCREEN][3];
     
-    double       shcAlt[NUM_CAT_ROWS_PER_SCREEN];
-    double       shcAzm[NUM_CAT_ROWS_PER_SCREEN];
+    long    shcRecordIndex[NUM_CAT_ROWS_PER_SCREEN];
+    float        shcAlt[NUM_CAT_ROWS_PER_SCREEN];
+    float        shcAzm[NUM_CAT_ROWS_PER_SCREEN];
 
 };
 
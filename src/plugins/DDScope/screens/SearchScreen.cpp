@@ -0,0 +1,271 @@
+// =====================================================
+// SearchScreen.cpp
+//
+// Find Object Screen
+// Type an object id (M31, NGC 7009, IC 93) or a word of its name (Vega, andromeda) on the touch
+// keyboard, the SHC catalogs are searched as each key is pressed and touching a result makes it
+// the GoTo target like selecting it on a catalog screen does
+#include "../display/Display.h"
+#include "SearchScreen.h"
+#include "MoreScreen.h"
+#include "../catalog/Catalog.h"
+#include "../fonts/Inconsolata_Bold8pt7b.h"
+#include "src/lib/convert/Convert.h"
+
+#define QUERY_X          5
+#define QUERY_Y         50
+#define QUERY_W        310
+#define QUERY_H         26
+
+#define RES_X            5
+#define RES_Y           82
+#define RES_W          310
+#define RES_H           24
+#define RES_Y_SPACING    2
+
+#define KEY_X            5
+#define KEY_Y          244
+#define KEY_W           29
+#define KEY_H           32
+#define KEY_SPACING      2
+#define KEY_COLS        10
+#define KEY_ROWS         4
+
+#define CLEAR_X          5
+#define CLEAR_Y        384
+#define CLEAR_W        100
+#define CLEAR_H         34
+
+#define RETURN_X       215
+#define RETURN_Y   CLEAR_Y
+
+#define STATUS_STR_X     3
+#define STATUS_STR_Y   428
+#define STATUS_STR_W   314
+#define STATUS_STR_H    16
+
+// keyboard rows, the third row ends with DEL and the last with a wide SPACE key
+const char *searchKeys[KEY_ROWS] = {"1234567890", "QWERTYUIOP", "ASDFGHJKL", "ZXCVBNM"};
+#define DEL_ROW          2
+#define SPACE_ROW        3
+
+// Search Button object custom font
+Button searchButton(0, 0, 0, 0, butOnBackground, butBackground, butOutline, mainFontWidth, mainFontHeight, "");
+
+// Canvas Print object, Inconsolata_Bold8pt7b font
+CanvasPrint canvSearchInsPrint(&Inconsolata_Bold8pt7b);
+
+extern const char *Txt_Bayer[];
+
+// Draw the Find Object Screen
+void SearchScreen::draw() {
+  setCurrentScreen(SEARCH_SCREEN);
+  searchButton.setColors(butOnBackground, butBackground, butOutline);
+
+#ifdef ENABLE_TFT_MIRROR
+  wifiDisplay.enableScreenCapture(true);
+#endif
+  tft.setTextColor(textColor);
+  tft.fillScreen(pgBackground);
+  drawTitle(100, TITLE_TEXT_Y, "Find Object");
+
+  // keyboard
+  tft.setFont(&Inconsolata_Bold8pt7b);
+  char key[2] = "";
+  for (int r = 0; r < KEY_ROWS; r++) {
+    int keys = strlen(searchKeys[r]);
+    for (int c = 0; c < keys; c++) {
+      key[0] = searchKeys[r][c];
+      searchButton.draw(KEY_X + c*(KEY_W + KEY_SPACING), KEY_Y + r*(KEY_H + KEY_SPACING), KEY_W, KEY_H, key, BUT_OFF);
+    }
+  }
+  searchButton.draw(KEY_X + 9*(KEY_W + KEY_SPACING), KEY_Y + DEL_ROW*(KEY_H + KEY_SPACING), KEY_W, KEY_H, "<", BUT_OFF);
+  searchButton.draw(KEY_X + 7*(KEY_W + KEY_SPACING), KEY_Y + SPACE_ROW*(KEY_H + KEY_SPACING), 3*KEY_W + 2*KEY_SPACING, KEY_H, "SPACE", BUT_OFF);
+  searchButton.draw(CLEAR_X, CLEAR_Y, CLEAR_W, CLEAR_H, "CLEAR", BUT_OFF);
+  searchButton.draw(RETURN_X, RETURN_Y, CLEAR_W, CLEAR_H, "RETURN", BUT_OFF);
+
+  rowActive = -1;
+  drawQuery();
+  drawResults();
+  if (cat_mgr.nameKeysDropped() > 0)
+    canvSearchInsPrint.printLJ(STATUS_STR_X, STATUS_STR_Y, STATUS_STR_W, STATUS_STR_H, "Name index full, search slower", true);
+
+#ifdef ENABLE_TFT_MIRROR
+  wifiDisplay.enableScreenCapture(false);
+  wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
+#endif
+#ifdef ENABLE_TFT_CAPTURE
+  tft.saveBufferToSD("Search");
+#endif
+}
+
+// show the query being typed
+void SearchScreen::drawQuery() {
+  char line[CAT_SEARCH_MAX_QUERY + 8];
+  snprintf(line, sizeof(line), "Find: %s_", query);
+  canvSearchInsPrint.printLJ(QUERY_X, QUERY_Y, QUERY_W, QUERY_H, line, false);
+}
+
+// search the catalogs for the query and show a button for each match
+void SearchScreen::drawResults() {
+  resultCount = queryLen > 0 ? cat_mgr.findObjects(query, results, NUM_SEARCH_ROWS) : 0;
+
+  tft.setFont(&Inconsolata_Bold8pt7b);
+  for (int i = 0; i < NUM_SEARCH_ROWS; i++) {
+    int y = RES_Y + i*(RES_H + RES_Y_SPACING);
+    if (i >= resultCount) {
+      tft.fillRect(RES_X, y, RES_W, RES_H, pgBackground);
+      continue;
+    }
+
+    // id then name e.g. "M31 Andromeda Galaxy" or for stars "Alp Lyr Vega"
+    cat_mgr.select(results[i].cat);
+    cat_mgr.setIndex(results[i].index);
+    if (!cat_mgr.isDsoCatalog())
+      snprintf(resultStr[i], SEARCH_ROW_LENGTH, "%s %s",
+               cat_mgr.bayerFlam() < 24 ? Txt_Bayer[cat_mgr.bayerFlam()] : cat_mgr.bayerFlamStr(), cat_mgr.constellationStr());
+    else if (cat_mgr.hasPrimaryIdInPrefix())
+      snprintf(resultStr[i], SEARCH_ROW_LENGTH, "%s", cat_mgr.catalogPrefix());
+    else
+      snprintf(resultStr[i], SEARCH_ROW_LENGTH, "%s%ld", cat_mgr.catalogPrefix(), cat_mgr.primaryId());
+    if (cat_mgr.objectName() != -1) {
+      int len = strlen(resultStr[i]);
+      snprintf(resultStr[i] + len, SEARCH_ROW_LENGTH - len, " %s", cat_mgr.objectNameStr());
+    }
+    searchButton.drawLJ(RES_X, y, RES_W, RES_H, resultStr[i], i == rowActive);
+  }
+
+  if (queryLen > 0 && resultCount == 0)
+    canvSearchInsPrint.printLJ(RES_X, RES_Y, RES_W, RES_H, "No match", true);
+}
+
+// show status changes on tasks timer tick
+void SearchScreen::updateSearchStatus() {
+  //no status, just button updates
+}
+
+// redraw screen to show state change
+bool SearchScreen::searchButStateChange() {
+  bool changed = false;
+
+  if (display.buttonTouched) {
+    display.buttonTouched = false;
+    if (queryChanged || rowSelected) {
+      changed = true;
+    }
+  }
+
+  if (display._redrawBut) {
+    display._redrawBut = false;
+    changed = true;
+  }
+  return changed;
+}
+
+// =========  Update Screen buttons  ===========
+void SearchScreen::updateSearchButtons() {
+  if (queryChanged) {
+    queryChanged = false;
+    rowActive = -1;
+    drawQuery();
+    drawResults();
+  }
+
+  if (rowSelected) {
+    rowSelected = false;
+    rowActive = rowTouched;
+    drawResults();
+    selectResult(rowActive);
+  }
+  tft.setFont(0);
+}
+
+// ======= write the result as the GoTo target and show it on the More page =========
+void SearchScreen::selectResult(int row) {
+  cat_mgr.select(results[row].cat);
+  cat_mgr.setIndex(results[row].index);
+
+  char ra[16], dec[16], cmd[24];
+  convert.doubleToHms(ra, cat_mgr.rah(), false, PM_HIGH);
+  convert.doubleToDms(dec, cat_mgr.dec(), false, true, PM_HIGH);
+
+  //: Sr[HH:MM:SS]#
+  snprintf(cmd, sizeof(cmd), ":Sr%s#", ra);
+  bool ok = commandBool(cmd);
+
+  //: Sd[sDD*MM:SS]#
+  snprintf(cmd, sizeof(cmd), ":Sd%s#", dec);
+  ok = commandBool(cmd) && ok;
+  moreScreen.objectSelected = ok;
+
+  char line[sizeof(ra) + sizeof(dec) + 12];
+  snprintf(line, sizeof(line), "RA: %s  DEC: %s", ra, dec);
+  canvSearchInsPrint.printLJ(STATUS_STR_X, STATUS_STR_Y, STATUS_STR_W, STATUS_STR_H, ok ? line : "Target not set", !ok);
+
+  // the following 5 lines are displayed on the Catalog/More page
+  snprintf(moreScreen.catSelectionStr1, 26, "Name-:%-18s", resultStr[row]);
+  snprintf(moreScreen.catSelectionStr2, 26, "Mag--:%4.1f",  cat_mgr.magnitude());
+  snprintf(moreScreen.catSelectionStr3, 26, "Const:%-3s",   cat_mgr.constellationStr());
+  snprintf(moreScreen.catSelectionStr4, 26, "Type-:%-14s", cat_mgr.objectTypeStr());
+  snprintf(moreScreen.catSelectionStr5, 26, "Id---:%-6s",  cat_mgr.subIdStr());
+}
+
+// =============== check the keyboard and result buttons ================
+bool SearchScreen::touchPoll(uint16_t px, uint16_t py) {
+
+  // RETURN button
+  if (py > RETURN_Y && py < (RETURN_Y + CLEAR_H) && px > RETURN_X && px < (RETURN_X + CLEAR_W)) {
+    BEEP;
+    moreScreen.draw();
+    return false; // don't update this screen since returning to MORE
+  }
+
+  // CLEAR button
+  if (py > CLEAR_Y && py < (CLEAR_Y + CLEAR_H) && px > CLEAR_X && px < (CLEAR_X + CLEAR_W)) {
+    BEEP;
+    query[0] = 0;
+    queryLen = 0;
+    queryChanged = true;
+    return true;
+  }
+
+  // Keyboard
+  if (py > KEY_Y && py < KEY_Y + KEY_ROWS*(KEY_H + KEY_SPACING) && px > KEY_X && px < KEY_X + KEY_COLS*(KEY_W + KEY_SPACING)) {
+    int r = (py - KEY_Y)/(KEY_H + KEY_SPACING);
+    int c = (px - KEY_X)/(KEY_W + KEY_SPACING);
+    int keys = strlen(searchKeys[r]);
+    BEEP;
+
+    if (c < keys) {
+      if (queryLen >= CAT_SEARCH_MAX_QUERY) return false;
+      query[queryLen++] = searchKeys[r][c];
+    } else if (r == DEL_ROW) {
+      if (queryLen == 0) return false;
+      queryLen--;
+    } else if (r == SPACE_ROW) {
+      if (queryLen == 0 || queryLen >= CAT_SEARCH_MAX_QUERY || query[queryLen - 1] == ' ') return false;
+      query[queryLen++] = ' ';
+    } else return false;
+    query[queryLen] = 0;
+    queryChanged = true;
+    return true;
+  }
+
+  // Result buttons
+  for (int i = 0; i < resultCount; i++) {
+    uint16_t yStart = RES_Y + i*(RES_H + RES_Y_SPACING);
+    if (py > yStart && py < yStart + RES_H && px > RES_X && px < (RES_X + RES_W)) {
+      BEEP;
+      rowTouched = i;
+      rowSelected = true;
+      return true;
+    }
+  }
+
+  // Check emergeyncy ABORT button area
+  display.motorsOff(px, py);
+
+  return false;
+}
+
+SearchScreen searchScreen;
@@ -0,0 +1,44 @@
+// =====================================================
+// SearchScreen.h
+
+#ifndef SEARCH_S_H
+#define SEARCH_S_H
+
+#include <Arduino.h>
+#include "../catalog/Catalog.h"
+
+class Display;
+
+#define NUM_SEARCH_ROWS   6  // results shown for a query
+#define SEARCH_ROW_LENGTH 36 // chars in a result row, id and name
+
+//===============================
+class SearchScreen : public Display {
+  public:
+    void draw();
+    bool touchPoll(uint16_t px, uint16_t py);
+    bool searchButStateChange();
+    void updateSearchButtons();
+    void updateSearchStatus();
+
+  private:
+    void drawQuery();
+    void drawResults();
+    void selectResult(int row);
+
+    bool queryChanged = false;
+    bool rowSelected = false;
+    int  rowTouched = 0;
+    int  rowActive = -1;
+
+    char query[CAT_SEARCH_MAX_QUERY + 1] = "";
+    int  queryLen = 0;
+
+    cat_match_t results[NUM_SEARCH_ROWS];
+    int  resultCount = 0;
+    char resultStr[NUM_SEARCH_ROWS][SEARCH_ROW_LENGTH];
+};
+
+extern SearchScreen searchScreen;
+
+#endif
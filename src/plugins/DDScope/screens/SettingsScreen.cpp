@@ -157,6 +157,7 @@ void SettingsScreen::draw() {
   tft.fillRect(TXT_FIELD_X, TXT_FIELD_Y+TXT_SPACING_Y*3+CUSTOM_FONT_OFFSET, TXT_FIELD_WIDTH, TXT_FIELD_HEIGHT, butBackground);
   tft.fillRect(TXT_FIELD_X, TXT_FIELD_Y+TXT_SPACING_Y*4+CUSTOM_FONT_OFFSET, TXT_FIELD_WIDTH, TXT_FIELD_HEIGHT, butBackground);
 
+  refreshSnapshot();
   updateCommonStatus();
   showGpsStatus();
   updateSettingsStatus();
@@ -172,25 +173,28 @@ void SettingsScreen::draw() {
 // task update for this screen
 void SettingsScreen::updateSettingsStatus() {
 
-  char tempReply[10];
+  char tempReply[16];
+  const MountSnapshot &snap = snapshot;
+
   // show Local Time 24 Hr format
-  commandWithReply(":GL#", tempReply); 
+  convert.doubleToHms(tempReply, snap.local.hour, false, convert.precision);
   canvSettingsInsPrint.printRJ(TDU_DISP_X+TDU_OFFSET_X, TDU_DISP_Y, 80, 16, tempReply, false);
 
   // show Current Date
-  commandWithReply(":GC#", tempReply); 
+  GregorianDate date = calendars.julianToGregorian(snap.local);
+  sprintf(tempReply, "%02d/%02d/%02d", (int)date.month, (int)date.day, (int)date.year % 100);
   canvSettingsInsPrint.printRJ(TDU_DISP_X+TDU_OFFSET_X, TDU_DISP_Y+TDU_OFFSET_Y, 80, 16, tempReply, false);
 
   // show TZ Offset
-  commandWithReply(":GG#", tempReply); 
+  convert.doubleToHms(tempReply, snap.timezone, true, PM_LOWEST);
   canvSettingsInsPrint.printRJ(TDU_DISP_X+TDU_OFFSET_X, TDU_DISP_Y+TDU_OFFSET_Y*2, 80, 16, tempReply, false);
 
   // show Latitude
-  commandWithReply(":Gt#", tempReply); 
+  convert.doubleToDms(tempReply, radToDeg(snap.latitude), false, true, PM_LOW);
   canvSettingsInsPrint.printRJ(TDU_DISP_X+TDU_OFFSET_X, TDU_DISP_Y+TDU_OFFSET_Y*3, 80, 16, tempReply, false);
 
   // show Longitude
-  commandWithReply(":Gg#", tempReply); 
+  convert.doubleToDms(tempReply, radToDeg(snap.longitude), true, true, PM_LOW);
   canvSettingsInsPrint.printRJ(TDU_DISP_X+TDU_OFFSET_X, TDU_DISP_Y+TDU_OFFSET_Y*4, 80, 16, tempReply, false);
 }
 
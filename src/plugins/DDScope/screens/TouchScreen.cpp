@@ -17,12 +17,13 @@
 #include "../screens/MoreScreen.h"
 #include "../screens/PlanetsScreen.h"
 #include "../screens/SHCCatScreen.h"
+#include "../screens/SearchScreen.h"
 #include "../screens/SettingsScreen.h"
 #include "../screens/TreasureCatScreen.h"
 #include "../display/WifiDisplay.h"
 
 #ifdef ODRIVE_MOTOR_PRESENT
-#include "../screens/ODriveScreen.h"
+#include "../screens/OdriveScreen.h"
 #endif
 
 void touchWrapper() { touchScreen.touchScreenPoll(display.currentScreen); }
@@ -173,6 +174,11 @@ void TouchScreen::processTouch(ScreenEnum tCurScreen) {
     }
       //Serial.println("Touch on SHC_CAT_SCREEN");
     break;
+  case SEARCH_SCREEN:
+    if (searchScreen.touchPoll(p.x, p.y)) {
+      display.buttonTouched = true;
+    }
+    break;
   case XSTATUS_SCREEN:
     break;
 
@@ -219,7 +225,8 @@ void TouchScreen::processTouch(ScreenEnum tCurScreen) {
   // Detect which Screen is requested by Menu buttons
   // skip checking these page menus since they don't have this menu setup
   if ((tCurScreen == TREASURE_SCREEN) || (tCurScreen == CUSTOM_SCREEN) ||
-      (tCurScreen == SHC_CAT_SCREEN) || (tCurScreen == PLANETS_SCREEN))
+      (tCurScreen == SHC_CAT_SCREEN) || (tCurScreen == PLANETS_SCREEN) ||
+      (tCurScreen == SEARCH_SCREEN))
     return;
 
   // Check for any Menu buttons pressed
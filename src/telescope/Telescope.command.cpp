@@ -29,36 +29,72 @@
   HAL_RESET_FUNC;
 #endif
 
+// handlers that can accept a command, keyed by the command code; the G and S families
+// are split again on :GX/:SX since most handlers only take the extended forms there
+// any handler that can return true for a code must have its bit set here, the handlers only see
+// the codes routed to them so a command with a new code (first letter, or :GX/:SX) needs an entry too
+// test/test_command_route replays every handler's commands through this and the full chain
+uint16_t commandRoute(char c0, char c1) {
+  switch (c0) {
+    case '$': return CH(CH_MOUNT) | CH(CH_PEC);
+    case '%': return CH(CH_MOUNT);
+    case 'A': return CH(CH_GOTO);
+    case 'C': return CH(CH_GOTO);
+    case 'D': return CH(CH_GOTO);
+    case 'F': return CH(CH_FOCUSER);
+    case 'G':
+      if (c1 == 'X') return CH(CH_MOUNT) | CH(CH_GUIDE) | CH(CH_GPIO) | CH(CH_GOTO) | CH(CH_SITE) | CH(CH_LIMITS) |
+                            CH(CH_PEC) | CH_AXES | CH(CH_FEATURES);
+      return CH(CH_MOUNT) | CH(CH_STATUS) | CH(CH_GOTO) | CH(CH_SITE) | CH(CH_LIMITS);
+    case 'L': return CH(CH_LIBRARY);
+    case 'M': return CH(CH_GUIDE) | CH(CH_GOTO);
+    case 'Q': return CH(CH_GUIDE);
+    case 'R': return CH(CH_GUIDE);
+    case 'S':
+      if (c1 == 'X') return CH(CH_MOUNT) | CH(CH_GPIO) | CH(CH_STATUS) | CH(CH_GOTO) | CH(CH_LIMITS) |
+                            CH(CH_PEC) | CH_AXES | CH(CH_FEATURES);
+      return CH(CH_MOUNT) | CH(CH_GOTO) | CH(CH_SITE) | CH(CH_LIMITS);
+    case 'T': return CH(CH_MOUNT);
+    case 'V': return CH(CH_PEC);
+    case 'W': return CH(CH_SITE) | CH(CH_PEC);
+    case 'h': return CH(CH_PARK) | CH(CH_HOME) | CH(CH_ROTATOR) | CH(CH_FOCUSER);
+    case 'r': return CH(CH_ROTATOR);
+    default:  return 0;
+  }
+}
+
 bool Telescope::command(char reply[], char command[], char parameter[], bool *supressFrame, bool *numericReply, CommandError *commandError) {
 
+  uint16_t route = commandRoute(command[0], command[1]);
+
   #ifdef MOUNT_PRESENT
-    if (mount.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (guide.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (gpio.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    if ((route & CH(CH_MOUNT)) && mount.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    if ((route & CH(CH_GUIDE)) && guide.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    if ((route & CH(CH_GPIO)) && gpio.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
     #if GOTO_FEATURE == ON
-      if (mountStatus.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-      if (goTo.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-      if (park.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-      if (library.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+      if ((route & CH(CH_STATUS)) && mountStatus.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+      if ((route & CH(CH_GOTO)) && goTo.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+      if ((route & CH(CH_PARK)) && park.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+      if ((route & CH(CH_LIBRARY)) && library.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
     #endif
-    if (site.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (limits.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (home.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (pec.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (axis1.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (axis2.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    if ((route & CH(CH_SITE)) && site.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    if ((route & CH(CH_LIMITS)) && limits.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    if ((route & CH(CH_HOME)) && home.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    if ((route & CH(CH_PEC)) && pec.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    if ((route & CH(CH_AXIS1)) && axis1.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    if ((route & CH(CH_AXIS2)) && axis2.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
   #endif
 
   #ifdef ROTATOR_PRESENT
-    if (rotator.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    if ((route & CH(CH_ROTATOR)) && rotator.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
   #endif
 
   #ifdef FOCUSER_PRESENT
-    if (focuser.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    if ((route & CH(CH_FOCUSER)) && focuser.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
   #endif
 
   #ifdef FEATURES_PRESENT
-    if (features.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    if ((route & CH(CH_FEATURES)) && features.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
   #endif
 
   //  B - Reticle/Accessory Control
@@ -151,6 +187,28 @@ bool Telescope::command(char reply[], char command[], char parameter[], bool *su
       *numericReply = false;
     } else
 
+    #ifdef TASKS_HISTOGRAM_ENABLE
+      // :GXJ[c][n]# Get task timing histogram [c] for task handle [n] (1 to TASKS_MAX)
+      //            [c] = A arrival lateness or R runtime, in bins of <4us, <16us, <64us ... >=16ms
+      //            [c] = D yield depth, tasks already running when it started, in bins of 0, 1, 2 ... >=7
+      //            Returns: name,n0,n1,n2,n3,n4,n5,n6,n7#
+      if (command[1] == 'X' && parameter[0] == 'J' && parameter[1] != 0 && parameter[2] != 0) {
+        TaskHistogram h;
+        int handle = atoi(&parameter[2]);
+        if (handle < 1 || handle > 255 || !tasks.getHistogram(handle, &h)) { *commandError = CE_PARAM_RANGE; return true; }
+        uint16_t *bins;
+        switch (parameter[1]) {
+          case 'A': bins = h.arrival; break;
+          case 'R': bins = h.runtime; break;
+          case 'D': bins = h.depth; break;
+          default: *commandError = CE_PARAM_FORM; return true;
+        }
+        strcpy(reply, tasks.getNameStr(handle));
+        for (uint8_t i = 0; i < TASKS_HISTOGRAM_BINS; i++) sprintf(&reply[strlen(reply)], ",%u", (unsigned int)bins[i]);
+        *numericReply = false;
+      } else
+    #endif
+
     if (command[1] == 'X' && parameter[2] == 0) {
       if (parameter[0] == '9') {
         // :GX9A#     temperature in deg. C
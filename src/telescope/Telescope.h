@@ -32,6 +32,16 @@ typedef struct Firmware {
   char time[20];
 } Firmware;
 
+// command handlers, in the order Telescope::command() tries them
+enum CommandHandler: uint8_t {
+  CH_MOUNT, CH_GUIDE, CH_GPIO, CH_STATUS, CH_GOTO, CH_PARK, CH_LIBRARY, CH_SITE,
+  CH_LIMITS, CH_HOME, CH_PEC, CH_AXIS1, CH_AXIS2, CH_ROTATOR, CH_FOCUSER, CH_FEATURES};
+#define CH(h) (1U << (h))
+#define CH_AXES (CH(CH_AXIS1) | CH(CH_AXIS2) | CH(CH_ROTATOR) | CH(CH_FOCUSER))
+
+// bitmask of the command handlers that can accept a command code, a new command code must be added there
+uint16_t commandRoute(char c0, char c1);
+
 class Telescope {
   public:
     // setup the location, time keeping, and coordinate converson
@@ -117,8 +117,8 @@ void Mount::init() {
     #endif
   #endif
 
-  VF("MSG: Mount, start tracking monitor task (rate 1000ms priority 6)... ");
-  if (tasks.add(1000, 0, true, 6, mountWrapper, "MntTrk")) { VLF("success"); } else { VLF("FAILED!"); }
+  VF("MSG: Mount, start tracking monitor task (rate "); V(TRACKING_RATE_MS); VF("ms priority 6)... ");
+  if (tasks.add(TRACKING_RATE_MS, 0, true, 6, mountWrapper, "MntTrk")) { VLF("success"); } else { VLF("FAILED!"); }
 
   update();
 }
@@ -175,7 +175,7 @@ void Mount::syncToEncoders(bool state) {
 }
 
 // updates the tracking rates, etc. as appropriate for the mount state
-// called once a second by poll() but available here for immediate action
+// called every TRACKING_RATE_MS by poll() but available here for immediate action
 void Mount::update() {
   static int lastStatusFlashMs = 0;
   int statusFlashMs = 0;
@@ -219,12 +219,11 @@ void Mount::update() {
 
 void Mount::poll() {
 
+  // the pointing model works in floats, a step this wide keeps their resolution out of its partial derivatives
   #ifdef HAL_NO_DOUBLE_PRECISION
     #define DiffRange  0.0087266463F         // 30 arc-minutes in radians
-    #define DiffRange2 0.017453292F          // 60 arc-minutes in radians
   #else
-    #define DiffRange  2.908882086657216e-4L // 1 arc-minute in radians
-    #define DiffRange2 5.817764173314432e-4L // 2 arc-minutes in radians
+    #define DiffRange  0.004363323129985824L // 15 arc-minutes in radians
   #endif
 
   if (trackingState == TS_NONE) {
@@ -241,7 +240,6 @@ void Mount::poll() {
     return;
   }
 
-  // get positions 1 (or 30) arc-min ahead and behind the current
   updatePosition(CR_MOUNT_ALL);
   double altitude = current.a;
   double declination = current.d;
@@ -252,56 +250,56 @@ void Mount::poll() {
     if (transform.mountType == ALTAZM) transform.horToEqu(&current);
   #endif
 
-  Coordinate ahead = current;
-  Coordinate behind = current;
-  Y;
-  ahead.h += DiffRange;
-  behind.h -= DiffRange;
-
-  // create horizon coordinates that would exist ahead and behind the current position
+  // motion per radian of hour angle at the topocentric position
+  double j[4];
+  double rate1 = 1.0;
+  double rate2 = 0.0;
   if (transform.mountType == ALTAZM) {
-    transform.equToHor(&ahead); Y;
-    transform.equToHor(&behind); Y;
+    transform.equToHorJacobian(&current, j);
+    rate1 = j[0];
+    rate2 = j[2];
   }
 
-  // apply (optional) pointing model and refraction
-  if (settings.rc == RC_MODEL || settings.rc == RC_MODEL_DUAL) {
-    transform.topocentricToObservedPlace(&ahead); Y;
-    transform.topocentricToObservedPlace(&behind); Y;
-    transform.observedPlaceToMount(&ahead); Y;
-    transform.observedPlaceToMount(&behind); Y;
-  } else if (settings.rc == RC_REFRACTION || settings.rc == RC_REFRACTION_DUAL) {
-    transform.topocentricToObservedPlace(&ahead); Y;
-    transform.topocentricToObservedPlace(&behind); Y;
-  }
+  // apply (optional) refraction and pointing model
+  if (settings.rc != RC_NONE) {
+    Coordinate observed = current;
+    transform.topocentricToObservedPlace(&observed);
 
-  // transfer to variables named appropriately for mount coordinates
-  float aheadAxis1, aheadAxis2, behindAxis1, behindAxis2;
-  if (transform.mountType == ALTAZM) {
-    aheadAxis1 = ahead.z;
-    aheadAxis2 = ahead.a;
-    behindAxis1 = behind.z;
-    behindAxis2 = behind.a;
-  } else {
-    aheadAxis1 = ahead.h;
-    aheadAxis2 = ahead.d;
-    behindAxis1 = behind.h;
-    behindAxis2 = behind.d;
+    if (transform.mountType == ALTAZM) {
+      rate2 *= 1.0 + transform.trueRefracSlope(current.a);
+    } else {
+      // refraction acts on altitude so carry the motion into horizon coordinates and back at the observed place
+      double k[4];
+      transform.equToHorJacobian(&current, j);
+      transform.equToHorJacobian(&observed, k);
+      double rateZ = j[0];
+      double rateA = j[2]*(1.0 + transform.trueRefracSlope(current.a));
+      double det = k[0]*k[3] - k[1]*k[2];
+      if (fabs(det) > SmallestFloat) {
+        rate1 = (k[3]*rateZ - k[1]*rateA)/det;
+        rate2 = (k[0]*rateA - k[2]*rateZ)/det;
+      }
+    }
+
+    if (settings.rc == RC_MODEL || settings.rc == RC_MODEL_DUAL) {
+      if (modelJacobianAge == 0 || modelJacobianStale()) {
+        updateModelJacobian(&observed);
+        modelJacobianAge = 1000/TRACKING_RATE_MS;
+      }
+      modelJacobianAge--;
+      double modelRate1 = modelJacobian[0]*rate1 + modelJacobian[1]*rate2;
+      rate2 = modelJacobian[2]*rate1 + modelJacobian[3]*rate2;
+      rate1 = modelRate1;
+    }
   }
 
-  // calculate the Axis1 tracking rate
-  if (aheadAxis1 < -Deg90 && behindAxis1 > Deg90) aheadAxis1 += Deg360;
-  if (behindAxis1 < -Deg90 && aheadAxis1 > Deg90) behindAxis1 += Deg360;
-  float rate1 = (aheadAxis1 - behindAxis1)/DiffRange2;
-  if (fabs(trackingRateAxis1 - rate1) <= 0.005F)
-    trackingRateAxis1 = (trackingRateAxis1*9.0F + rate1)/10.0F; else trackingRateAxis1 = rate1;
+  // the rates are in radians per radian of hour angle, that is relative to the sidereal rate
+  trackingRateAxis1 = rate1;
 
-  // calculate the Axis2 Dec/Alt tracking rate (if dual axis or ALTAZM mode)
+  // the Axis2 Dec/Alt tracking rate (if dual axis or ALTAZM mode)
   if (settings.rc == RC_REFRACTION_DUAL || settings.rc == RC_MODEL_DUAL || transform.mountType == ALTAZM) {
-    float rate2;
-    rate2 = (aheadAxis2 - behindAxis2)/DiffRange2;
-    if (current.pierSide == PIER_SIDE_WEST) rate2 = -rate2;
-    if (fabs(trackingRateAxis2 - rate2) <= 0.005F) trackingRateAxis2 = (trackingRateAxis2*9.0F + rate2)/10.0F; else trackingRateAxis2 = rate2;
+    trackingRateAxis2 = rate2;
+    if (current.pierSide == PIER_SIDE_WEST) trackingRateAxis2 = -trackingRateAxis2;
   } else trackingRateAxis2 = 0.0F;
 
   // override for special case of near a celestial pole
@@ -319,6 +317,51 @@ void Mount::poll() {
   update();
 }
 
+// pointing model partial derivatives (mount axes with respect to observed place axes) by central differences
+void Mount::updateModelJacobian(Coordinate *observed) {
+  Coordinate ahead1 = *observed;
+  Coordinate behind1 = *observed;
+  Coordinate ahead2 = *observed;
+  Coordinate behind2 = *observed;
+  if (transform.mountType == ALTAZM) {
+    ahead1.z += DiffRange; behind1.z -= DiffRange; ahead2.a += DiffRange; behind2.a -= DiffRange;
+  } else {
+    ahead1.h += DiffRange; behind1.h -= DiffRange; ahead2.d += DiffRange; behind2.d -= DiffRange;
+  }
+
+  transform.observedPlaceToMount(&ahead1); Y;
+  transform.observedPlaceToMount(&behind1); Y;
+  transform.observedPlaceToMount(&ahead2); Y;
+  transform.observedPlaceToMount(&behind2); Y;
+
+  double d1 = ahead1.a1 - behind1.a1;
+  double d2 = ahead2.a1 - behind2.a1;
+  if (d1 > Deg180) d1 -= Deg360; else if (d1 < -Deg180) d1 += Deg360;
+  if (d2 > Deg180) d2 -= Deg360; else if (d2 < -Deg180) d2 += Deg360;
+
+  modelJacobian[0] = d1/(2.0*DiffRange);
+  modelJacobian[1] = d2/(2.0*DiffRange);
+  modelJacobian[2] = (ahead1.a2 - behind1.a2)/(2.0*DiffRange);
+  modelJacobian[3] = (ahead2.a2 - behind2.a2)/(2.0*DiffRange);
+
+  modelJacobianAxis1 = current.a1;
+  modelJacobianAxis2 = current.a2;
+  #if ALIGN_MAX_NUM_STARS > 1
+    modelJacobianModel = transform.align.model;
+    modelJacobianReady = transform.align.modelReady();
+  #endif
+}
+
+// the partial derivatives barely change over a degree of sky, a sync or goto moves further than that
+bool Mount::modelJacobianStale() {
+  if (fabs(current.a1 - modelJacobianAxis1) > degToRad(1.0) || fabs(current.a2 - modelJacobianAxis2) > degToRad(1.0)) return true;
+  #if ALIGN_MAX_NUM_STARS > 1
+    if (transform.align.modelReady() != modelJacobianReady) return true;
+    if (memcmp(&transform.align.model, &modelJacobianModel, sizeof(AlignModel)) != 0) return true;
+  #endif
+  return false;
+}
+
 // alternate tracking rate calculation method
 float Mount::ztr(float a) {
   if (a > degToRadF(89.8F)) return 0.99998667F; else if (a > degToRadF(89.5F)) return 0.99996667F;
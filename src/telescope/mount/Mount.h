@@ -24,6 +24,11 @@ enum RateCompensation: uint8_t {RC_NONE, RC_REFRACTION, RC_REFRACTION_DUAL, RC_M
   #define RC_DEFAULT RC_MODEL_DUAL
 #endif
 
+// tracking rate update period in milliseconds
+#ifndef TRACKING_RATE_MS
+  #define TRACKING_RATE_MS 100
+#endif
+
 enum TrackingState: uint8_t    {TS_NONE, TS_SIDEREAL};
 enum CoordReturn: uint8_t      {CR_MOUNT, CR_MOUNT_EQU, CR_MOUNT_ALT, CR_MOUNT_HOR, CR_MOUNT_ALL};
 
@@ -94,6 +99,10 @@ class Mount {
 
     void poll();
 
+    // tracking rates from the last poll() relative to the sidereal rate
+    inline float getTrackingRateAxis1() { return trackingRateAxis1; }
+    inline float getTrackingRateAxis2() { return trackingRateAxis2; }
+
     float trackingRate = 1.0F;
     MountSettings settings = {RC_DEFAULT, { 0, 0 }};
 
@@ -101,6 +110,12 @@ class Mount {
     // alternate tracking rate calculation method
     float ztr(float a);
 
+    // refresh the pointing model partial derivatives used by the tracking rates
+    void updateModelJacobian(Coordinate *observed);
+
+    // true if the pointing model changed or the mount was synced or moved away since the partial derivatives were found
+    bool modelJacobianStale();
+
     // update where we are pointing *now*
     // CR_MOUNT for Horizon or Equatorial mount coordinates, depending on mount
     // CR_MOUNT_EQU for Equatorial mount coordinates, depending on mode
@@ -117,6 +132,17 @@ class Mount {
     float trackingRateAxis1     = 0.0F;
     float trackingRateAxis2     = 0.0F;
 
+    // pointing model partial derivatives, d(a1,a2)/d(observed axis1,axis2), refreshed once a second
+    // and straight away when stale, along with the mount axes and model they were found for
+    double modelJacobian[4]     = { 1.0, 0.0, 0.0, 1.0 };
+    uint8_t modelJacobianAge    = 0;
+    double modelJacobianAxis1   = 0.0;
+    double modelJacobianAxis2   = 0.0;
+    #if ALIGN_MAX_NUM_STARS > 1
+      AlignModel modelJacobianModel = {};
+      bool modelJacobianReady   = false;
+    #endif
+
     bool syncToEncodersEnabled = false;
 
     bool atHome = true;
@@ -66,6 +66,7 @@ void GeoAlign::modelClear() {
   model.pdCor  = 0;  // altitude axis/Azimuth orthogonal correction
   model.dfCor  = 0;  // altitude axis axis flex
   model.tfCor  = 0;  // tube flex
+  fit.valid = false;
   modelIsReady = false;
 }
 
@@ -77,8 +78,17 @@ CommandError GeoAlign::addStar(int thisStar, int numberStars, Coordinate *actual
   // just return if we are processing a model or the star count is out of range, this should never happen
   if (autoModelTask != 0 || thisStar < 1 || thisStar > ALIGN_MAX_NUM_STARS || numberStars < 1 || numberStars > ALIGN_MAX_NUM_STARS) return CE_ALIGN_FAIL;
 
-  int i = thisStar - 1;
+  setStar(thisStar - 1, actual, mount);
 
+  // two or more stars and finished
+  if (thisStar >= 2 && thisStar == numberStars) {
+    createModel(numberStars);
+  }
+
+  return CE_NONE;
+}
+
+void GeoAlign::setStar(int i, Coordinate *actual, Coordinate *mount) {
   this->mount[i].h = mount->h;
   this->mount[i].d = mount->d;
   this->actual[i].h = actual->h;
@@ -107,13 +117,6 @@ CommandError GeoAlign::addStar(int thisStar, int numberStars, Coordinate *actual
     this->actual[i].side = 1;
     this->mount[i].side = 1;
   }
-
-  // two or more stars and finished
-  if (thisStar >= 2 && thisStar == numberStars) {
-    createModel(numberStars);
-  }
-
-  return CE_NONE;
 }
 
 void GeoAlign::createModel(int numberStars) {
@@ -186,6 +189,52 @@ void GeoAlign::correct(float a1, float a2, float pierSide, float sf, float _deo,
   *a2r  = (+PZ*sinA1       + PA*cosA1             +  DFd + FFd + TFd);
 }
 
+// update the cached Axis1 trig and residual for all samples at index offset oh
+void GeoAlign::samplesAxis1(float oh) {
+  for (l = 0; l < num; l++) {
+    float ma1 = mount[l].ax1 + oh;
+    samples.sinA1[l] = sinf(ma1);
+    samples.cosA1[l] = cosf(ma1);
+    float r = actual[l].ax1 - ma1;
+    if (r >  Deg180) r = r - Deg360; else
+    if (r < -Deg180) r = r + Deg360;
+    samples.r1[l] = r;
+  }
+}
+
+// update the cached Axis2 trig and residual for all samples at index offset od (east side, west is mirrored)
+void GeoAlign::samplesAxis2(float od) {
+  for (l = 0; l < num; l++) {
+    float ma2 = mount[l].ax2 + od*mount[l].side;
+    samples.cosA2[l] = cosf(ma2);
+    samples.tanA2[l] = tanf(ma2);
+    samples.r2[l] = actual[l].ax2 - ma2;
+  }
+}
+
+// rebuild the per-term corrections from the cached trig, these are the terms of correct() for a unit parameter
+void GeoAlign::samplesTerms() {
+  for (l = 0; l < num; l++) sampleTerms(l);
+}
+
+void GeoAlign::sampleTerms(long i) {
+  float side = mount[i].side;
+  float sinA1 = samples.sinA1[i];
+  float cosA1 = samples.cosA1[i];
+  float cosA2 = samples.cosA2[i];
+  float tanA2 = samples.tanA2[i];
+
+  samples.k1[ALIGN_TERM_DO][i] = side/cosA2;                   samples.k2[ALIGN_TERM_DO][i] = 0;
+  samples.k1[ALIGN_TERM_PD][i] = -tanA2*side;                  samples.k2[ALIGN_TERM_PD][i] = 0;
+  samples.k1[ALIGN_TERM_PZ][i] = -cosA1*tanA2;                 samples.k2[ALIGN_TERM_PZ][i] = sinA1;
+  samples.k1[ALIGN_TERM_PE][i] = sinA1*tanA2;                  samples.k2[ALIGN_TERM_PE][i] = cosA1;
+  samples.k1[ALIGN_TERM_TF][i] = cosLat*sinA1/cosA2;           samples.k2[ALIGN_TERM_TF][i] = cosLat*cosA1 - sinLat*cosA2;
+  samples.k1[ALIGN_TERM_FF][i] = 0;                            samples.k2[ALIGN_TERM_FF][i] = cosA1;
+  samples.k1[ALIGN_TERM_DF][i] = 0;                            samples.k2[ALIGN_TERM_DF][i] = -(cosLat*cosA1 + sinLat*tanA2);
+  samples.k1[ALIGN_TERM_OD][i] = 0;                            samples.k2[ALIGN_TERM_OD][i] = -side;
+  samples.k1[ALIGN_TERM_OH][i] = -1;                           samples.k2[ALIGN_TERM_OH][i] = 0;
+}
+
 void GeoAlign::doSearch(float sf, int p1, int p2, int p3, int p4, int p5, int p6, int p7, int p8, int p9) {
   long l,
 
@@ -215,72 +264,213 @@ void GeoAlign::doSearch(float sf, int p1, int p2, int p3, int p4, int p5, int p6
   _od_m = -p8 + round(best_ode/sf); _od_p = p8 + round(best_ode/sf);
   _oh_m = -p9 + round(best_ohe/sf); _oh_p = p9 + round(best_ohe/sf);
 
-  float ma2, ma1;
-  for (_deo = _deo_m; _deo <= _deo_p; _deo++)
-  for (_pd = _pd_m; _pd <= _pd_p; _pd++)
-  for (_pz = _pz_m; _pz <= _pz_p; _pz++)
-  for (_pe = _pe_m; _pe <= _pe_p; _pe++)
-  for (_df = _df_m; _df <= _df_p; _df++)
-  for (_ff = _ff_m; _ff <= _ff_p; _ff++)
-  for (_tf = _tf_m; _tf <= _tf_p; _tf++)
-  for (_ohe = _oh_m; _ohe <= _oh_p; _ohe++)
-  for (_ode = _od_m; _ode <= _od_p; _ode++) {
-    ode = _ode*sf1;
-    odw = -ode;
+  // the index offsets are the outer loops so the trig is only recalculated when they change
+  float norm = 1.0F/(num - 1);
+  for (_ohe = _oh_m; _ohe <= _oh_p; _ohe++) {
     ohe = _ohe*sf1;
     ohw = ohe;
-    
-    // check the combinations for all samples
-    for (l = 0; l < num; l++) {
-      ma1 = mount[l].ax1;
-      ma2 = mount[l].ax2;
-      
-      if (mount[l].side == -1) // west of the mount
-      {
-        ma1 = ma1 + ohw;
-        ma2 = ma2 + odw;
-      } else
-      if (mount[l].side == 1) // east of the mount, default (fork mounts)
-      {
-        ma1 = ma1 + ohe;
-        ma2 = ma2 + ode;
+    samplesAxis1(ohe);
+
+    for (_ode = _od_m; _ode <= _od_p; _ode++) {
+      ode = _ode*sf1;
+      odw = -ode;
+      samplesAxis2(ode);
+      samplesTerms();
+
+      for (_deo = _deo_m; _deo <= _deo_p; _deo++)
+      for (_pd = _pd_m; _pd <= _pd_p; _pd++)
+      for (_pz = _pz_m; _pz <= _pz_p; _pz++)
+      for (_pe = _pe_m; _pe <= _pe_p; _pe++)
+      for (_df = _df_m; _df <= _df_p; _df++)
+      for (_ff = _ff_m; _ff <= _ff_p; _ff++)
+      for (_tf = _tf_m; _tf <= _tf_p; _tf++) {
+        float deo = _deo*sf1, pd = _pd*sf1, pz = _pz*sf1, pe = _pe*sf1, df = _df*sf1, ff = _ff*sf1, tf = _tf*sf1;
+
+        // check the combination for all samples
+        float sum1 = 0.0F, sum2 = 0.0F;
+        for (l = 0; l < num; l++) {
+          float d1 = samples.r1[l] + deo*samples.k1[ALIGN_TERM_DO][l] + pd*samples.k1[ALIGN_TERM_PD][l] + pz*samples.k1[ALIGN_TERM_PZ][l] +
+                                     pe*samples.k1[ALIGN_TERM_PE][l] + tf*samples.k1[ALIGN_TERM_TF][l];
+          float d2 = samples.r2[l] + pz*samples.k2[ALIGN_TERM_PZ][l] + pe*samples.k2[ALIGN_TERM_PE][l] + tf*samples.k2[ALIGN_TERM_TF][l] +
+                                     ff*samples.k2[ALIGN_TERM_FF][l] + df*samples.k2[ALIGN_TERM_DF][l];
+          d1 = d1*samples.w[l];
+          sum1 = sum1 + d1*d1;
+          sum2 = sum2 + d2*d2;
+        }
+
+        // the standard deviations combined
+        max_dist = sqrtf((sum1 + sum2)*norm);
+
+        // remember the best fit
+        if (max_dist < best_dist) {
+          best_dist = max_dist;
+          best_deo  = _deo*sf;
+          best_pd   = _pd*sf;
+          best_pz   = _pz*sf;
+          best_pe   = _pe*sf;
+
+          best_tf   = _tf*sf;
+          best_df   = _df*sf;
+          best_ff   = _ff*sf;
+          
+          if (p8 != 0) best_odw = radToArcsec(odw); else best_odw = best_pe/2.0;
+          if (p8 != 0) best_ode = radToArcsec(ode); else best_ode = -best_pe/2.0;
+          if (p9 != 0) best_ohw = radToArcsec(ohw);
+          if (p9 != 0) best_ohe = radToArcsec(ohe);
+        }
       }
+      // once per block of terms, a point is now too cheap to be worth a yield each
+      Y;
+    }
+  }
+}
 
-      float ma1r, ma2r;
-      correct(ma1, ma2, mount[l].side, sf1, _deo, _pd, _pz, _pe, _df, _ff, _tf, &ma1r, &ma2r);
-
-      delta[l].ax1 = actual[l].ax1 - (ma1 - ma1r);
-      if (delta[l].ax1 >  Deg180) delta[l].ax1 = delta[l].ax1 - Deg360; else
-      if (delta[l].ax1 < -Deg180) delta[l].ax1 = delta[l].ax1 + Deg360;
-      delta[l].ax2 = actual[l].ax2 - (ma2 - ma2r);
-      delta[l].side = mount[l].side;
+// solves the n x n system a*x = b in place by Gaussian elimination with partial pivoting
+// returns false if the system is singular
+static bool solveLinear(double a[][ALIGN_TERMS], double *b, double *x, int n) {
+  for (int c = 0; c < n; c++) {
+    int pivot = c;
+    for (int r = c + 1; r < n; r++) if (fabs(a[r][c]) > fabs(a[pivot][c])) pivot = r;
+    if (fabs(a[pivot][c]) < 1.0E-12) return false;
+    if (pivot != c) {
+      for (int k = 0; k < n; k++) { double t = a[c][k]; a[c][k] = a[pivot][k]; a[pivot][k] = t; }
+      double t = b[c]; b[c] = b[pivot]; b[pivot] = t;
+    }
+    for (int r = c + 1; r < n; r++) {
+      double f = a[r][c]/a[c][c];
+      for (int k = c; k < n; k++) a[r][k] -= f*a[c][k];
+      b[r] -= f*b[c];
     }
+  }
+  for (int r = n - 1; r >= 0; r--) {
+    double t = b[r];
+    for (int k = r + 1; k < n; k++) t -= a[r][k]*x[k];
+    x[r] = t/a[r][r];
+  }
+  return true;
+}
+
+// adds the rows for star i to the normal equations of the fit, Axis1 weighted as in doSearch()
+void GeoAlign::normalAdd(double ata[][ALIGN_TERMS], double *atb, long i) {
+  double w = samples.w[i];
+
+  // the fit drives (actual - mount) + corrections - offsets to zero
+  double b1 = mount[i].ax1 - actual[i].ax1;
+  if (b1 >  Deg180) b1 -= Deg360; else
+  if (b1 < -Deg180) b1 += Deg360;
+  double b2 = mount[i].ax2 - actual[i].ax2;
+
+  for (int r = 0; r < fit.terms; r++) {
+    double jr1 = samples.k1[fit.map[r]][i]*w, jr2 = samples.k2[fit.map[r]][i];
+    for (int c = 0; c < fit.terms; c++) ata[r][c] += jr1*samples.k1[fit.map[c]][i]*w + jr2*samples.k2[fit.map[c]][i];
+    atb[r] += jr1*b1*w + jr2*b2;
+  }
+}
+
+// checks the terms p (in radians) are reasonable and if so makes them the best fit
+bool GeoAlign::fitAccept(double *p) {
+  // the grid search covers about 9 degrees of polar misalignment and 4 degrees of cone error, anything outside
+  // of that range is more likely a bad star than a real fit
+  if (fabs(p[ALIGN_TERM_PZ]) > degToRad(9.0) || fabs(p[ALIGN_TERM_PE]) > degToRad(9.0) || fabs(p[ALIGN_TERM_DO]) > degToRad(4.0)) return false;
+
+  // standard deviations as in doSearch()
+  for (l = 0; l < num; l++) {
+    float ma1 = mount[l].ax1 + p[ALIGN_TERM_OH];
+    float ma2 = mount[l].ax2 + p[ALIGN_TERM_OD]*mount[l].side;
+    float ma1r, ma2r;
+    correct(ma1, ma2, mount[l].side, 1.0F, p[ALIGN_TERM_DO], p[ALIGN_TERM_PD], p[ALIGN_TERM_PZ], p[ALIGN_TERM_PE], p[ALIGN_TERM_DF], p[ALIGN_TERM_FF], p[ALIGN_TERM_TF], &ma1r, &ma2r);
+    delta[l].ax1 = actual[l].ax1 - (ma1 - ma1r);
+    if (delta[l].ax1 >  Deg180) delta[l].ax1 = delta[l].ax1 - Deg360; else
+    if (delta[l].ax1 < -Deg180) delta[l].ax1 = delta[l].ax1 + Deg360;
+    delta[l].ax2 = actual[l].ax2 - (ma2 - ma2r);
+    delta[l].side = mount[l].side;
+  }
+  float a, b;
+  sum1 = 0.0; for (l = 0; l < num; l++) sum1 = sum1 + sq(delta[l].ax1*samples.w[l]); a = sqrtf(sum1/(num - 1));
+  sum1 = 0.0; for (l = 0; l < num; l++) sum1 = sum1 + sq(delta[l].ax2); b = sqrtf(sum1/(num - 1));
+  best_dist = sqrtf(sq(a) + sq(b));
+
+  best_deo = radToArcsec(p[ALIGN_TERM_DO]);
+  best_pd  = radToArcsec(p[ALIGN_TERM_PD]);
+  best_pz  = radToArcsec(p[ALIGN_TERM_PZ]);
+  best_pe  = radToArcsec(p[ALIGN_TERM_PE]);
+  best_tf  = radToArcsec(p[ALIGN_TERM_TF]);
+  best_ff  = radToArcsec(p[ALIGN_TERM_FF]);
+  best_df  = radToArcsec(p[ALIGN_TERM_DF]);
+  best_ode = radToArcsec(p[ALIGN_TERM_OD]);
+  best_odw = -best_ode;
+  best_ohe = radToArcsec(p[ALIGN_TERM_OH]);
+  best_ohw = best_ohe;
 
-    // calculate the standard deviations
-    float a, b;
-    sum1 = 0.0; for (l = 0; l < num; l++) sum1 = sum1 + sq(delta[l].ax1*cosf(actual[l].ax2)); a = sqrtf(sum1/(num - 1));
-    sum1 = 0.0; for (l = 0; l < num; l++) sum1 = sum1 + sq(delta[l].ax2); b = sqrtf(sum1/(num - 1));
-    max_dist = sqrtf(sq(a) + sq(b));
-
-    // remember the best fit
-    if (max_dist < best_dist) {
-      best_dist = max_dist;
-      best_deo  = _deo*sf;
-      best_pd   = _pd*sf;
-      best_pz   = _pz*sf;
-      best_pe   = _pe*sf;
-
-      best_tf   = _tf*sf;
-      best_df   = _df*sf;
-      best_ff   = _ff*sf;
-      
-      if (p8 != 0) best_odw = radToArcsec(odw); else best_odw = best_pe/2.0;
-      if (p8 != 0) best_ode = radToArcsec(ode); else best_ode = -best_pe/2.0;
-      if (p9 != 0) best_ohw = radToArcsec(ohw);
-      if (p9 != 0) best_ohe = radToArcsec(ohe);
+  for (int i = 0; i < ALIGN_TERMS; i++) fit.p[i] = p[i];
+
+  return true;
+}
+
+// least squares fit of the same terms doSearch() looks for, p1 to p9 enable (1) or disable (0) each term
+// the corrections are linear in every term once the trig of the axis positions is known, so each Gauss-Newton
+// pass is a single linear least squares solve with the trig evaluated at the current index offsets (OD/OH)
+// the normal equations are kept in fit so addModelStar() can add to them later
+// returns false (leaving the best_ values alone) if the fit is singular or doesn't converge
+bool GeoAlign::leastSquaresSearch(int p1, int p2, int p3, int p4, int p5, int p6, int p7, int p8, int p9) {
+  int enabled[ALIGN_TERMS] = {p1, p2, p3, p4, p5, p6, p7, p8, p9};
+  fit.valid = false;
+  fit.terms = 0;
+  for (int i = 0; i < ALIGN_TERMS; i++) if (enabled[i]) fit.map[fit.terms++] = i;
+  int n = fit.terms;
+  if (n == 0 || num*2 < n) return false;
+
+  // parameters in radians, starting from the average Axis1 offset
+  double p[ALIGN_TERMS] = {0, 0, 0, 0, 0, 0, 0, 0, arcsecToRad(best_ohe)};
+
+  bool converged = false;
+  for (int pass = 0; pass < ALIGN_LSQ_PASSES; pass++) {
+    memset(fit.ata, 0, sizeof(fit.ata));
+    memset(fit.atb, 0, sizeof(fit.atb));
+
+    samplesAxis1(p[ALIGN_TERM_OH]);
+    samplesAxis2(p[ALIGN_TERM_OD]);
+    samplesTerms();
+    for (l = 0; l < num; l++) normalAdd(fit.ata, fit.atb, l);
+
+    // a little Levenberg-Marquardt damping keeps weakly constrained terms from running away
+    double ata[ALIGN_TERMS][ALIGN_TERMS], atb[ALIGN_TERMS];
+    memcpy(ata, fit.ata, sizeof(ata));
+    memcpy(atb, fit.atb, sizeof(atb));
+    for (int r = 0; r < n; r++) ata[r][r] += ata[r][r]*1.0E-9 + 1.0E-15;
+
+    double x[ALIGN_TERMS];
+    if (!solveLinear(ata, atb, x, n)) return false;
+
+    double change = 0;
+    for (int r = 0; r < n; r++) {
+      change = fmax(change, fabs(x[r] - p[fit.map[r]]));
+      p[fit.map[r]] = x[r];
     }
+    if (isnan(change)) return false;
+    if (change < arcsecToRad(0.1)) { converged = true; break; }
     Y;
   }
+  if (!converged) return false;
+
+  if (!fitAccept(p)) return false;
+
+  fit.valid = true;
+  return true;
+}
+
+// geometric corrections from the best fit
+void GeoAlign::bestToModel() {
+  model.doCor = arcsecToRad(best_deo);
+  model.pdCor = arcsecToRad(best_pd);
+  model.azmCor = arcsecToRad(best_pz);
+  model.altCor = arcsecToRad(best_pe);
+
+  model.tfCor = arcsecToRad(best_tf);
+  if (mountType == FORK || mountType == ALTAZM) model.dfCor = arcsecToRad(best_ff); else model.dfCor = arcsecToRad(best_df);
+
+  model.ax1Cor = arcsecToRad(best_ohw);
+  model.ax2Cor = arcsecToRad(best_odw);
 }
 
 void GeoAlign::autoModel(int n) {
@@ -315,6 +505,9 @@ void GeoAlign::autoModel(int n) {
   best_ohe = round(radToArcsec(ohe));
   best_ohw = best_ohe;
 
+  // the Axis1 weights don't depend on the model
+  for (l = 0; l < num; l++) samples.w[l] = cosf(actual[l].ax2);
+
   // fork flex or dec axis flex, as appropriate
   if (mountType == ALTAZM) { Ff = 0; Df = 0; } else if (mountType == FORK) { Ff = 1; Df = 0; } else { Ff = 0; Df = 1; }
 
@@ -322,48 +515,49 @@ void GeoAlign::autoModel(int n) {
   int Do = 0;
   if (num > 2) Do = 1;
 
-  // search, this can handle about 9 degrees of polar misalignment, and 4 degrees of cone error
-  //              DoPdPzPeTfFf Df OdOh
-  doSearch(16384,0 ,0,1,1,0, 0, 0,1,1);
-  doSearch( 8192,Do,0,1,1,0, 0, 0,1,1);
-  doSearch( 4096,Do,0,1,1,0, 0, 0,1,1);
-  doSearch( 2048,Do,0,1,1,0, 0, 0,1,1);
-  doSearch( 1024,Do,0,1,1,0, 0, 0,1,1);
-  doSearch(  512,Do,0,1,1,0, 0, 0,1,1);
-  #ifdef HAL_SLOW_PROCESSOR
-    doSearch(256,Do,0,1,1,0, 0, 0,1,1);
-    doSearch(128,Do,0,1,1,0, 0, 0,1,1);
-  #else
-    if (num > 4) {
-      doSearch(256,Do,1,1,1,0,Ff,Df,1,1);
-      doSearch(128,Do,1,1,1,1,Ff,Df,1,1);
-      doSearch( 64,Do,1,1,1,1,Ff,Df,1,1);
-      #ifdef HAL_FAST_PROCESSOR
-        doSearch( 32,Do,1,1,1,1,Ff,Df,1,1);
-        doSearch( 16,Do,1,1,1,1,Ff,Df,1,1);
-      #endif
-    } else {
+  // only fit the orthogonality and flex terms if > 4 stars
+  int Pd = 0, Tf = 0, Fx = 0, Dx = 0;
+  if (num > 4) { Pd = 1; Tf = 1; Fx = Ff; Dx = Df; }
+
+  //                      DoPdPzPeTfFf Df OdOh
+  if (leastSquaresSearch(Do,Pd,1,1,Tf,Fx,Dx,1,1)) {
+    VF("MSG: Align, least squares fit rms "); V(radToArcsec(best_dist)); VLF(" arc-sec");
+  } else {
+    VLF("MSG: Align, least squares fit failed using grid search");
+    // search, this can handle about 9 degrees of polar misalignment, and 4 degrees of cone error
+    //              DoPdPzPeTfFf Df OdOh
+    doSearch(16384,0 ,0,1,1,0, 0, 0,1,1);
+    doSearch( 8192,Do,0,1,1,0, 0, 0,1,1);
+    doSearch( 4096,Do,0,1,1,0, 0, 0,1,1);
+    doSearch( 2048,Do,0,1,1,0, 0, 0,1,1);
+    doSearch( 1024,Do,0,1,1,0, 0, 0,1,1);
+    doSearch(  512,Do,0,1,1,0, 0, 0,1,1);
+    #ifdef HAL_SLOW_PROCESSOR
       doSearch(256,Do,0,1,1,0, 0, 0,1,1);
       doSearch(128,Do,0,1,1,0, 0, 0,1,1);
-      doSearch( 64,Do,0,1,1,0, 0, 0,1,1);
-      doSearch( 32,Do,0,1,1,0, 0, 0,1,1);
-      #ifdef HAL_FAST_PROCESSOR
-        doSearch( 16,Do,0,1,1,0, 0, 0,1,1);
-      #endif
-    }
-  #endif
+    #else
+      if (num > 4) {
+        doSearch(256,Do,1,1,1,0,Ff,Df,1,1);
+        doSearch(128,Do,1,1,1,1,Ff,Df,1,1);
+        doSearch( 64,Do,1,1,1,1,Ff,Df,1,1);
+        #ifdef HAL_FAST_PROCESSOR
+          doSearch( 32,Do,1,1,1,1,Ff,Df,1,1);
+          doSearch( 16,Do,1,1,1,1,Ff,Df,1,1);
+        #endif
+      } else {
+        doSearch(256,Do,0,1,1,0, 0, 0,1,1);
+        doSearch(128,Do,0,1,1,0, 0, 0,1,1);
+        doSearch( 64,Do,0,1,1,0, 0, 0,1,1);
+        doSearch( 32,Do,0,1,1,0, 0, 0,1,1);
+        #ifdef HAL_FAST_PROCESSOR
+          doSearch( 16,Do,0,1,1,0, 0, 0,1,1);
+        #endif
+      }
+    #endif
+  }
 
   // geometric corrections
-  model.doCor = arcsecToRad(best_deo);
-  model.pdCor = arcsecToRad(best_pd);
-  model.azmCor = arcsecToRad(best_pz);
-  model.altCor = arcsecToRad(best_pe);
-
-  model.tfCor = arcsecToRad(best_tf);
-  if (mountType == FORK || mountType == ALTAZM) model.dfCor = arcsecToRad(best_ff); else model.dfCor = arcsecToRad(best_df);
-
-  model.ax1Cor = arcsecToRad(best_ohw);
-  model.ax2Cor = arcsecToRad(best_odw);
+  bestToModel();
 
   // update status and exit
   modelIsReady = true;
@@ -373,6 +567,61 @@ void GeoAlign::autoModel(int n) {
   autoModelTask = 0;
 }
 
+CommandError GeoAlign::addModelStar(Coordinate *actual, Coordinate *mount) {
+  if (autoModelTask != 0 || !modelIsReady || num < 2 || num >= ALIGN_MAX_MODEL_STARS) return CE_ALIGN_FAIL;
+
+  setStar(num, actual, mount);
+  samples.w[num] = cosf(this->actual[num].ax2);
+
+  // the third and fifth stars bring in more terms and the grid search leaves no normal equations, start over
+  if (!fit.valid || num == 2 || num == 4) {
+    createModel(num + 1);
+    return CE_NONE;
+  }
+
+  // fold the star into the normal equations at the current linearization
+  double ata[ALIGN_TERMS][ALIGN_TERMS], atb[ALIGN_TERMS];
+  memcpy(ata, fit.ata, sizeof(ata));
+  memcpy(atb, fit.atb, sizeof(atb));
+
+  float ma1 = this->mount[num].ax1 + fit.p[ALIGN_TERM_OH];
+  float ma2 = this->mount[num].ax2 + fit.p[ALIGN_TERM_OD]*this->mount[num].side;
+  samples.sinA1[num] = sinf(ma1);
+  samples.cosA1[num] = cosf(ma1);
+  samples.cosA2[num] = cosf(ma2);
+  samples.tanA2[num] = tanf(ma2);
+  sampleTerms(num);
+  normalAdd(ata, atb, num);
+
+  double a[ALIGN_TERMS][ALIGN_TERMS], b[ALIGN_TERMS], x[ALIGN_TERMS], p[ALIGN_TERMS];
+  memcpy(a, ata, sizeof(a));
+  memcpy(b, atb, sizeof(b));
+  for (int r = 0; r < fit.terms; r++) a[r][r] += a[r][r]*1.0E-9 + 1.0E-15;
+  if (!solveLinear(a, b, x, fit.terms)) return CE_ALIGN_FAIL;
+
+  memcpy(p, fit.p, sizeof(p));
+  for (int r = 0; r < fit.terms; r++) p[fit.map[r]] = x[r];
+
+  num++;
+
+  // the index offsets moved enough that the cached trig is stale, relinearize with all the stars
+  if (fabs(p[ALIGN_TERM_OH] - fit.p[ALIGN_TERM_OH]) > arcsecToRad(ALIGN_LSQ_RELINEARIZE) ||
+      fabs(p[ALIGN_TERM_OD] - fit.p[ALIGN_TERM_OD]) > arcsecToRad(ALIGN_LSQ_RELINEARIZE)) {
+    int e[ALIGN_TERMS] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    for (int r = 0; r < fit.terms; r++) e[fit.map[r]] = 1;
+    if (!leastSquaresSearch(e[0], e[1], e[2], e[3], e[4], e[5], e[6], e[7], e[8])) { num--; return CE_ALIGN_FAIL; }
+  } else {
+    if (!fitAccept(p)) { num--; return CE_ALIGN_FAIL; }
+    memcpy(fit.ata, ata, sizeof(ata));
+    memcpy(fit.atb, atb, sizeof(atb));
+  }
+
+  bestToModel();
+  VF("MSG: Align, model star "); V(num); VF(" added rms "); V(radToArcsec(best_dist)); VLF(" arc-sec");
+
+  return CE_NONE;
+}
+
 void GeoAlign::observedPlaceToMount(Coordinate *coord) {
   if (!modelIsReady) return;
 
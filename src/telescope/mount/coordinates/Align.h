@@ -26,6 +26,19 @@
   #endif
 #endif
 
+// stars the pointing model can hold, the align sequence adds up to ALIGN_MAX_NUM_STARS and the rest are
+// folded into the model one at a time after the align completes
+#ifndef ALIGN_MAX_MODEL_STARS
+  #if defined(HAL_FAST_PROCESSOR)
+    #define ALIGN_MAX_MODEL_STARS 32
+  #else
+    #define ALIGN_MAX_MODEL_STARS ALIGN_MAX_NUM_STARS
+  #endif
+#endif
+#if ALIGN_MAX_MODEL_STARS < ALIGN_MAX_NUM_STARS
+  #error "ALIGN_MAX_MODEL_STARS must be at least ALIGN_MAX_NUM_STARS"
+#endif
+
 enum PierSide: uint8_t {PIER_SIDE_NONE, PIER_SIDE_EAST, PIER_SIDE_WEST};
 
 typedef struct Coordinate {
@@ -52,6 +65,35 @@ typedef struct AlignCoordinate {
   int side;
 } AlignCoordinate;
 
+// pointing model terms in the order doSearch() and leastSquaresSearch() take them
+enum AlignTerm: uint8_t {ALIGN_TERM_DO, ALIGN_TERM_PD, ALIGN_TERM_PZ, ALIGN_TERM_PE, ALIGN_TERM_TF, ALIGN_TERM_FF, ALIGN_TERM_DF, ALIGN_TERM_OD, ALIGN_TERM_OH, ALIGN_TERMS};
+#define ALIGN_LSQ_PASSES 8
+#define ALIGN_LSQ_RELINEARIZE 10.0 // arc-seconds the index offsets can move before an added star triggers a full refit
+
+// per-sample terms for the model fit, the trig only changes with the index offsets (OD/OH) so it's
+// cached here and the search runs down each column as a short multiply-add
+typedef struct AlignSamples {
+  float sinA1[ALIGN_MAX_MODEL_STARS];
+  float cosA1[ALIGN_MAX_MODEL_STARS];
+  float cosA2[ALIGN_MAX_MODEL_STARS];
+  float tanA2[ALIGN_MAX_MODEL_STARS];
+  float r1[ALIGN_MAX_MODEL_STARS];               // actual - mount Axis1 at the current index offsets
+  float r2[ALIGN_MAX_MODEL_STARS];               // actual - mount Axis2 at the current index offsets
+  float w[ALIGN_MAX_MODEL_STARS];                // Axis1 weight, cos(actual Axis2)
+  float k1[ALIGN_TERMS][ALIGN_MAX_MODEL_STARS];  // Axis1 correction per unit of each term
+  float k2[ALIGN_TERMS][ALIGN_MAX_MODEL_STARS];  // Axis2 correction per unit of each term
+} AlignSamples;
+
+// state of the last least squares fit, kept so more stars can be folded in without starting over
+typedef struct AlignFit {
+  bool valid;
+  int terms;                              // number of terms in the fit
+  int map[ALIGN_TERMS];                   // AlignTerm for each row of the normal equations
+  double p[ALIGN_TERMS];                  // terms in radians
+  double ata[ALIGN_TERMS][ALIGN_TERMS];   // normal equations at the current linearization
+  double atb[ALIGN_TERMS];
+} AlignFit;
+
 #define AlignModelSize 32
 typedef struct AlignModel {
   float ax1Cor;
@@ -86,6 +128,11 @@ class GeoAlign
     // mount:  equatorial or horizon coordinate (depending on the mount type) for where the star is (in mount coordinates)
     CommandError addStar(int thisStar, int numberStars, Coordinate *actual, Coordinate *mount);
 
+    // add a star to a completed alignment model, up to ALIGN_MAX_MODEL_STARS
+    // the star is folded into the last fit directly, a full refit is only scheduled when the fit needs more terms
+    // actual, mount: as for addStar()
+    CommandError addModelStar(Coordinate *actual, Coordinate *mount);
+
     void createModel(int numberStars);
     
     // convert equatorial (h,d) or horizon (a,z) coordinate from observed place to mount
@@ -95,14 +142,26 @@ class GeoAlign
 
     void autoModel(int n);
 
-    AlignCoordinate mount[ALIGN_MAX_NUM_STARS];
-    AlignCoordinate actual[ALIGN_MAX_NUM_STARS];
-    AlignCoordinate delta[ALIGN_MAX_NUM_STARS];
+    AlignCoordinate mount[ALIGN_MAX_MODEL_STARS];
+    AlignCoordinate actual[ALIGN_MAX_MODEL_STARS];
+    AlignCoordinate delta[ALIGN_MAX_MODEL_STARS];
     AlignModel model;
 
   private:
     void correct(float ha, float dec, float pierSide, float sf, float _deo, float _pd, float _pz, float _pe, float _da, float _ff, float _tf, float *h1, float *d1);
     void doSearch(float sf, int p1, int p2, int p3, int p4, int p5, int p6, int p7, int p8, int p9);
+    bool leastSquaresSearch(int p1, int p2, int p3, int p4, int p5, int p6, int p7, int p8, int p9);
+    void samplesAxis1(float oh);
+    void samplesAxis2(float od);
+    void samplesTerms();
+    void sampleTerms(long i);
+    void normalAdd(double ata[][ALIGN_TERMS], double *atb, long i);
+    bool fitAccept(double *p);
+    void setStar(int i, Coordinate *actual, Coordinate *mount);
+    void bestToModel();
+
+    AlignSamples samples;
+    AlignFit fit;
 
     bool modelIsReady;
     int8_t mountType;
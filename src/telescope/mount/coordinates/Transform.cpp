@@ -231,6 +231,23 @@ void Transform::equToHor(Coordinate *coord) {
   if (coord->z > Deg180) coord->z -= Deg360;
 }
 
+void Transform::equToHorJacobian(Coordinate *coord, double j[4]) {
+  double cosHA  = cos(coord->h);
+  double sinHA  = sin(coord->h);
+  double cosDec = cos(coord->d);
+  double sinDec = sin(coord->d);
+  double sinAlt = sinDec*site.locationEx.latitude.sine + cosDec*site.locationEx.latitude.cosine*cosHA;
+  double cosAlt = sqrt(1.0 - sinAlt*sinAlt);
+  // differentiate z = atan2(t1, t2) as in equToHor()
+  double t2     = cosHA*site.locationEx.latitude.sine - (sinDec/cosDec)*site.locationEx.latitude.cosine;
+  double n      = sinHA*sinHA + t2*t2;
+  if (cosAlt < OneArcSec || fabs(cosDec) < OneArcSec || n < OneArcSec*OneArcSec) { j[0] = j[1] = j[2] = j[3] = 0.0; return; }
+  j[0] = (t2*cosHA + sinHA*sinHA*site.locationEx.latitude.sine)/n;
+  j[1] = (sinHA*site.locationEx.latitude.cosine)/(cosDec*cosDec*n);
+  j[2] = -(site.locationEx.latitude.cosine*cosDec*sinHA)/cosAlt;
+  j[3] = (site.locationEx.latitude.sine*cosDec - site.locationEx.latitude.cosine*sinDec*cosHA)/cosAlt;
+}
+
 void Transform::equToAlt(Coordinate *coord) {
   double cosHA  = cos(coord->h);
   double sinAlt = sin(coord->d)*site.locationEx.latitude.sine + cos(coord->d)*site.locationEx.latitude.cosine*cosHA;  
@@ -249,12 +266,7 @@ void Transform::horToEqu(Coordinate *coord) {
 }
 
 double Transform::trueRefrac(double altitude) {
-  float pressure = 1010.0F;
-  float temperature = 10.0F;
-  if (!isnan(weather.getPressure())) pressure = weather.getPressure();
-  if (!isnan(weather.getTemperature())) temperature = weather.getTemperature();
-  float TPC = (pressure/1010.0F)*(283.0F/(273.0F + temperature));
-  float r   = 2.9670597e-4F*cotf(altitude + 0.0031375594F/(altitude + 0.089186324F))*TPC;
+  float r = 2.9670597e-4F*cotf(altitude + 0.0031375594F/(altitude + 0.089186324F))*refractionTPC();
   if (r < 0.0F) r = 0.0F;
   return r;
 }
@@ -264,6 +276,22 @@ double Transform::apparentRefrac(double altitude) {
   return trueRefrac(altitude - r);
 }
 
+double Transform::trueRefracSlope(double altitude) {
+  float t = altitude + 0.089186324F;
+  float u = altitude + 0.0031375594F/t;
+  if (cotf(u) < 0.0F) return 0.0;
+  float sinU = sinf(u);
+  return -2.9670597e-4F*refractionTPC()*(1.0F - 0.0031375594F/(t*t))/(sinU*sinU);
+}
+
+float Transform::refractionTPC() {
+  float pressure = 1010.0F;
+  float temperature = 10.0F;
+  if (!isnan(weather.getPressure())) pressure = weather.getPressure();
+  if (!isnan(weather.getTemperature())) temperature = weather.getTemperature();
+  return (pressure/1010.0F)*(283.0F/(273.0F + temperature));
+}
+
 float Transform::cotf(float n) {
   return 1.0F/tanf(n);
 }
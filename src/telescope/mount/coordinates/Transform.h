@@ -64,6 +64,9 @@ class Transform {
     void equToAlt(Coordinate *coord);
     // converts from Equatorial (h,d) to Horizon (a,z) coordinates
     void horToEqu(Coordinate *coord);
+    // partial derivatives of the Equatorial (h,d) to Horizon (a,z) conversion at this coordinate
+    // j[0] = dz/dh, j[1] = dz/dd, j[2] = da/dh, j[3] = da/dd (all zero where degenerate, at the zenith or poles)
+    void equToHorJacobian(Coordinate *coord, double j[4]);
 
     // refraction at altitude, pressure (millibars), and temperature (celsius)
     // returns amount of refraction at the true altitude
@@ -71,6 +74,8 @@ class Transform {
     // refraction at altitude, pressure (millibars), and temperature (celsius)
     // returns the amount of refraction at the apparent altitude
     double apparentRefrac(double altitude);
+    // rate of change of trueRefrac() with altitude
+    double trueRefracSlope(double altitude);
 
     #if ALIGN_MAX_NUM_STARS > 1  
       GeoAlign align;
@@ -81,6 +86,9 @@ class Transform {
   private:
 
     float cotf(float n);
+
+    // refraction scale factor for the current pressure and temperature
+    float refractionTPC();
     
     // adjust coordinate back into 0 to 360 "degrees" range (in radians)
     double backInRads(double angle);
@@ -66,6 +66,7 @@ bool Goto::command(char *reply, char *command, char *parameter, bool *supressFra
     } else
 
     // :A+#       Align accept target location
+    //            once the align is done this adds the star to the pointing model (up to ALIGN_MAX_MODEL_STARS)
     //            Return: 0 on failure
     //                    1 on success
     if (command[1] == '+' && parameter[0] == 0) {
@@ -77,6 +78,13 @@ bool Goto::command(char *reply, char *command, char *parameter, bool *supressFra
           *commandError = e;
           DLF("ERR: Mount, failed to add align point");
         } else { VLF("MSG: Mount, align point added"); }
+      } else
+      if (alignDone()) {
+        CommandError e = alignAddModelStar();
+        if (e != CE_NONE) {
+          *commandError = e;
+          DLF("ERR: Mount, failed to add model point");
+        } else { VLF("MSG: Mount, model point added"); }
       } else *commandError = CE_ALIGN_NOT_ACTIVE;
     } else *commandError = CE_CMD_UNKNOWN;
   } else
@@ -104,11 +104,8 @@ CommandError Goto::request(Coordinate *coords, PierSideSelect pierSideSelect, bo
   destination = target;
   nearDestinationRefineStages = 1;
 
-  // add waypoint if needed
-  if (transform.mountType != ALTAZM && MFLIP_SKIP_HOME == OFF && start.pierSide != destination.pierSide) {
-    VLF("MSG: Mount, goto changes pier side, setting waypoint at home");
-    waypoint(&current);
-  }
+  // add waypoints if needed
+  waypoint(&current);
 
   // start the goto monitor
   if (taskHandle != 0) tasks.remove(taskHandle);
@@ -311,6 +308,23 @@ CommandError Goto::alignAddStar() {
   return e;
 }
 
+// add a star to the pointing model once an align is done (at the current position relative to target)
+CommandError Goto::alignAddModelStar() {
+  if (!alignDone()) return CE_ALIGN_NOT_ACTIVE;
+
+  #if ALIGN_MAX_NUM_STARS > 1
+    Coordinate mountPosition = mount.getMountPosition(CR_MOUNT_ALL);
+
+    // update the targets HA and Horizon coords as necessary
+    transform.rightAscensionToHourAngle(&gotoTarget);
+    if (transform.mountType == ALTAZM) transform.equToHor(&gotoTarget);
+
+    return transform.align.addModelStar(&target, &mountPosition);
+  #else
+    return CE_ALIGN_FAIL;
+  #endif
+}
+
 // reset the alignment model
 void Goto::alignReset() {
   alignState.currentStar = 0;
@@ -320,38 +334,38 @@ void Goto::alignReset() {
   #endif
 }
 
-// set any additional destinations required for a goto
+// plan any waypoints the goto needs to stay within the limits and visit home on a meridian flip
 void Goto::waypoint(Coordinate *current) {
-  // HA goes from +90...0..-90
-  //                W   .   E
-  // meridian flip, only happens for equatorial mounts
-
-  stage = GG_WAYPOINT_HOME;
-
-  // default goes straight to the home position
-  destination = home.position;
-
-  // if the home position is at 0 hours, we're done
-  if (home.position.h == 0.0) return;
-
-  double d60 = degToRad(120);
-  double d45 = degToRad(135);
-  if (current->pierSide == PIER_SIDE_EAST) { d60 = Deg180 - d60; d45 = Deg180 - d45; }
-
-  // decide if we should first move to 60 deg. HA (4 hours) to get away from the horizon limits
-  if (current->a < Deg10 && fabs(start.h) > Deg90) { destination.h = d60; stage = GG_WAYPOINT_AVOID; return; }
-
-  // decide if we should first move to 45 deg. HA (3 hours) to get away from the horizon limits
-  // if at a low latitude and in the opposite sky, |HA| = 6 is very low on the horizon and we need
-  // to delay arriving there during a meridian flip.  In the extreme case, where the user is very
-  // near the Earths equator an Horizon limit of -10 or -15 may be necessary for proper operation
-  if (current->a < Deg20 && site.locationEx.latitude.absval < Deg45) {
-    if (site.location.latitude >= 0) {
-      if (current->d <= Deg90 - site.location.latitude) { destination.h = d45; stage = GG_WAYPOINT_AVOID; }
-    } else {
-      if (current->d >= -Deg90 - site.location.latitude) { destination.h = d45; stage = GG_WAYPOINT_AVOID; }
-    }
+  waypointCount = 0;
+  waypointNext = 0;
+  waypointHome = -1;
+
+  axis1.setFrequencySlew(radsPerSecondCurrent);
+  axis2.setFrequencySlew(radsPerSecondCurrent);
+
+  // a path that can't be planned falls back to a direct slew, the limits still stop it if need be
+  int count;
+  if (transform.mountType != ALTAZM && MFLIP_SKIP_HOME == OFF && current->pierSide != destination.pierSide) {
+    VLF("MSG: Mount, goto changes pier side, setting waypoint at home");
+    count = gotoPlanner.plan(current, &home.position, waypoints, GOTO_WAYPOINTS_MAX - 1);
+    if (count < 0) count = 0;
+    waypointHome = count;
+    waypoints[count++] = home.position;
+    int more = gotoPlanner.plan(&home.position, &destination, &waypoints[count], GOTO_WAYPOINTS_MAX - count);
+    if (more > 0) count += more;
+  } else {
+    count = gotoPlanner.plan(current, &destination, waypoints, GOTO_WAYPOINTS_MAX);
+    if (count < 0) count = 0;
   }
+
+  waypointCount = count;
+  if (waypointCount > 0) nextWaypoint();
+}
+
+// set the next waypoint as the destination
+void Goto::nextWaypoint() {
+  stage = waypointNext == waypointHome ? GG_WAYPOINT_HOME : GG_WAYPOINT_AVOID;
+  destination = waypoints[waypointNext++];
 }
 
 // update acceleration rates for goto and guiding
@@ -399,21 +413,18 @@ void Goto::poll() {
   }
 
   if (!mount.isSlewing()) {
-    if (stage == GG_WAYPOINT_AVOID) {
-      VLF("MSG: Mount, goto waypoint reached");
-      stage = GG_WAYPOINT_HOME;
-      destination = home.position;
-      startAutoSlew();
-    } else
-
-    if (stage == GG_WAYPOINT_HOME) {
-      if (settings.meridianFlipPause && !meridianFlipHome.resume) { meridianFlipHome.paused = true; goto skip; }
-      meridianFlipHome.paused = false;
-      meridianFlipHome.resume = false;
-
-      VLF("MSG: Mount, goto home reached");
-      stage = GG_NEAR_DESTINATION;
-      destination = target;
+    if (stage == GG_WAYPOINT_AVOID || stage == GG_WAYPOINT_HOME) {
+      if (stage == GG_WAYPOINT_HOME) {
+        if (settings.meridianFlipPause && !meridianFlipHome.resume) { meridianFlipHome.paused = true; goto skip; }
+        meridianFlipHome.paused = false;
+        meridianFlipHome.resume = false;
+        VLF("MSG: Mount, goto home reached");
+      } else VLF("MSG: Mount, goto waypoint reached");
+
+      if (waypointNext < waypointCount) nextWaypoint(); else {
+        stage = GG_NEAR_DESTINATION;
+        destination = target;
+      }
       startAutoSlew();
     } else
 
@@ -475,6 +486,12 @@ void Goto::poll() {
       nearTarget.h -= slewDestinationDistHA;
       nearTarget.d -= slewDestinationDistDec;
 
+      // hold the led destination until the predicted arrival
+      if (arrivalMs != 0) {
+        long remainingMs = (long)(arrivalMs - millis());
+        if (remainingMs > 0) nearTarget.h += (remainingMs/1000.0)*leadRate(); else arrivalMs = 0;
+      }
+
       if (transform.mountType == ALTAZM) transform.equToHor(&nearTarget);
       double a1, a2;
       transform.mountToInstrument(&nearTarget, &a1, &a2);
@@ -489,9 +506,16 @@ void Goto::poll() {
 CommandError Goto::startAutoSlew() {
   CommandError e;
 
+  arrivalMs = 0;
   if (stage == GG_NEAR_DESTINATION || stage == GG_DESTINATION) {
+    if (mount.isTracking()) transform.rightAscensionToHourAngle(&destination);
     destination.h -= slewDestinationDistHA;
     destination.d -= slewDestinationDistDec;
+    if (transform.mountType == ALTAZM) transform.equToHor(&destination);
+    leadDestination(&destination);
+
+    // alt-az gotos that arrive at the led destination don't need refine passes
+    if (transform.mountType == ALTAZM && arrivalMs != 0) stage = GG_DESTINATION;
   }
 
   double a1, a2;
@@ -509,9 +533,57 @@ CommandError Goto::startAutoSlew() {
 
   e = axis1.autoGoto(degToRadF((float)(SLEW_ACCELERATION_DIST)), radsPerSecondCurrent);
   if (e == CE_NONE) e = axis2.autoGoto(degToRadF((float)(SLEW_ACCELERATION_DIST)), radsPerSecondCurrent);
+
+  #if AXIS_JERK_PERCENT != OFF
+    // stretch the shorter S-curve so both axes arrive together
+    if (e == CE_NONE) {
+      float t = axis1.getAutoGotoTime();
+      if (axis2.getAutoGotoTime() > t) t = axis2.getAutoGotoTime();
+      axis1.setAutoGotoTime(t);
+      axis2.setAutoGotoTime(t);
+    }
+  #endif
   return e;
 }
 
+// predict when the axes arrive at the destination and lead it by the tracking motion until then
+void Goto::leadDestination(Coordinate *dest) {
+  if (!mount.isTracking() || park.state == PS_PARKING || home.state == HS_HOMING) return;
+
+  // the slew time depends on the distance which depends on the lead, this converges in a few passes
+  axis1.setFrequencySlew(radsPerSecondCurrent);
+  axis2.setFrequencySlew(radsPerSecondCurrent);
+  double a1, a2;
+  float seconds = 0.0F;
+  Coordinate led = *dest;
+  for (int pass = 0; pass < 3; pass++) {
+    led = *dest;
+    led.h += seconds*leadRate();
+    transform.equToHor(&led);
+    transform.mountToInstrument(&led, &a1, &a2);
+    float t1 = axis1.getSlewTime(fabs(a1 - axis1.getInstrumentCoordinate()));
+    float t2 = axis2.getSlewTime(fabs(a2 - axis2.getInstrumentCoordinate()));
+    seconds = t1 > t2 ? t1 : t2;
+    Y;
+  }
+
+  // don't lead into a limit, the goto then stays on the present target and tracking carries on from there
+  Coordinate check = led;
+  if (limits.validateCoords(&check) != CE_NONE) {
+    VLF("MSG: Mount, goto lead skipped (led destination outside limits)");
+    return;
+  }
+
+  VF("MSG: Mount, goto arrival predicted in "); V(seconds); VLF("s, leading destination");
+  *dest = led;
+  arrivalMs = millis() + (unsigned long)(seconds*1000.0F);
+  if (arrivalMs == 0) arrivalMs = 1;
+}
+
+double Goto::leadRate() {
+  return siderealToRad(mount.trackingRate)*SIDEREAL_RATIO;
+}
+
 Goto goTo;
 
 #endif
@@ -8,6 +8,7 @@
 
 #include "../../../libApp/commands/ProcessCmds.h"
 #include "../coordinates/Transform.h"
+#include "GotoPlanner.h"
 
 enum MeridianFlip: uint8_t     {MF_NEVER, MF_ALWAYS};
 enum GotoState: uint8_t        {GS_NONE, GS_GOTO};
@@ -71,6 +72,9 @@ class Goto {
     // add an align star (at the current position relative to target)
     CommandError alignAddStar();
 
+    // add a star to the pointing model once an align is done (at the current position relative to target)
+    CommandError alignAddModelStar();
+
     // reset the alignment model
     void alignReset();
 
@@ -111,9 +115,12 @@ class Goto {
 
   private:
 
-    // set any additional destinations required for a goto
+    // plan any waypoints the goto needs to stay within the limits and visit home on a meridian flip
     void waypoint(Coordinate *current);
 
+    // set the next waypoint as the destination
+    void nextWaypoint();
+
     // update acceleration rates for goto and guiding
     void updateAccelerationRates();
 
@@ -123,6 +130,12 @@ class Goto {
     // start slews with approach correction and parking support
     CommandError startAutoSlew();
 
+    // predict when the axes arrive at the destination and lead it by the tracking motion until then
+    void leadDestination(Coordinate *dest);
+
+    // tracking motion of the target in hour angle, in radians per second
+    double leadRate();
+
     Coordinate gotoTarget;
     Coordinate start, destination, target;
     GotoStage  stage                = GG_NONE;
@@ -130,6 +143,12 @@ class Goto {
     GotoState  stateLast            = GS_NONE;
     uint8_t    taskHandle           = 0;
     int        nearDestinationRefineStages;
+    unsigned long arrivalMs         = 0;  // predicted arrival at the led destination, 0 if not leading
+
+    Coordinate waypoints[GOTO_WAYPOINTS_MAX];
+    uint8_t    waypointCount        = 0;
+    uint8_t    waypointNext         = 0;
+    int8_t     waypointHome         = -1; // index of the home position in the waypoints, -1 if not visited
 
     MeridianFlipHome meridianFlipHome = {false, false};
 
@@ -0,0 +1,194 @@
+//--------------------------------------------------------------------------------------------------
+// telescope mount control, goto path planning
+
+#include "GotoPlanner.h"
+
+#if defined(MOUNT_PRESENT) && GOTO_FEATURE == ON
+
+#include "../../../lib/tasks/OnTask.h"
+
+#include "../Mount.h"
+#include "../site/Site.h"
+#include "../limits/Limits.h"
+
+#define NODE_TIME_NONE 1.0E9F
+
+// Slews are planned in instrument coordinates with both axes starting together, each on its own S-curve
+// stretched to finish with the other so the path between waypoints is a curve that's followed by sampling
+// the profiles.  The direct slew is used if it's clear, otherwise this is an A* search over a grid of
+// waypoints, each slew between them costs the time of the slower axis and the least time to go from a
+// waypoint is a direct slew to the destination so the first path found that reaches it is the quickest
+int GotoPlanner::plan(Coordinate *start, Coordinate *destination, Coordinate *waypoints, int maxWaypoints) {
+  checks = 0;
+  if (!limits.isEnabled()) return 0;
+
+  double a1s, a2s, a1d, a2d;
+  transform.mountToInstrument(start, &a1s, &a2s);
+  transform.mountToInstrument(destination, &a1d, &a2d);
+  if (clear(a1s, a2s, a1d, a2d)) return 0;
+
+  // node 0 is the start and node 1 the destination, the rest are waypoints on the grid
+  nodeA1[0] = a1s; nodeA2[0] = a2s;
+  nodeA1[1] = a1d; nodeA2[1] = a2d;
+  nodeCount = 2;
+  double levels[GOTO_PLANNER_LEVELS];
+  levels[0] = a2s;
+  levels[1] = a2d;
+  for (int l = 2; l < GOTO_PLANNER_LEVELS; l++) {
+    levels[l] = site.locationEx.latitude.sign*(Deg90 - Deg180 + degToRad((l - 2)*GOTO_PLANNER_GRID_AXIS2));
+  }
+  for (int l = 0; l < GOTO_PLANNER_LEVELS; l++) {
+    for (int i = 0; i <= 540/GOTO_PLANNER_GRID; i++) addNode(degToRad(-180.0 + i*GOTO_PLANNER_GRID), levels[l]);
+  }
+  VF("MSG: Mount, goto path blocked, planning with "); V(nodeCount - 2); VLF(" waypoint candidates");
+
+  for (int i = 0; i < nodeCount; i++) {
+    nodeTime[i] = NODE_TIME_NONE;
+    nodeFrom[i] = -1;
+    nodeDone[i] = false;
+    nodeToGo[i] = slewTime(nodeA1[i], nodeA2[i], a1d, a2d);
+  }
+  nodeTime[0] = 0.0F;
+
+  for (;;) {
+    // next the node on the path that could reach the destination soonest
+    int u = -1;
+    float best = NODE_TIME_NONE;
+    for (int i = 0; i < nodeCount; i++) {
+      if (nodeDone[i] || nodeTime[i] >= NODE_TIME_NONE) continue;
+      if (nodeTime[i] + nodeToGo[i] < best) { best = nodeTime[i] + nodeToGo[i]; u = i; }
+    }
+    if (u < 0) { VLF("MSG: Mount, goto path planning found no clear path"); return -1; }
+    if (u == 1) break;
+    nodeDone[u] = true;
+
+    for (int v = 1; v < nodeCount; v++) {
+      if (nodeDone[v] || (u == 0 && v == 1)) continue;
+      float t = nodeTime[u] + slewTime(nodeA1[u], nodeA2[u], nodeA1[v], nodeA2[v]);
+      if (t < nodeTime[v] && clear(nodeA1[u], nodeA2[u], nodeA1[v], nodeA2[v])) { nodeTime[v] = t; nodeFrom[v] = u; }
+    }
+    Y;
+  }
+
+  int count = 0;
+  for (int i = nodeFrom[1]; i != 0; i = nodeFrom[i]) count++;
+  if (count > maxWaypoints) { VLF("MSG: Mount, goto path planning needs too many waypoints"); return -1; }
+
+  int w = count;
+  for (int i = nodeFrom[1]; i != 0; i = nodeFrom[i]) waypoints[--w] = transform.instrumentToMount(nodeA1[i], nodeA2[i]);
+
+  VF("MSG: Mount, goto path planned with "); V(count); V(" waypoint(s), "); V(nodeTime[1]); VF("s, ");
+  V(checks); VLF(" limit checks");
+  return count;
+}
+
+// true if the instrument position (in radians) is within the limits
+bool GotoPlanner::clear(double a1, double a2) {
+  double altitude;
+  return clear(a1, a2, &altitude);
+}
+
+// true if the instrument position is within the limits, also returns the altitude there
+bool GotoPlanner::clear(double a1, double a2, double *altitude) {
+  checks++;
+  Coordinate coords = transform.instrumentToMount(a1, a2);
+  if (transform.mountType != ALTAZM) transform.equToAlt(&coords);
+  *altitude = coords.a;
+
+  if (coords.a < limits.settings.altitude.min || coords.a > limits.settings.altitude.max) return false;
+
+  if (transform.meridianFlips) {
+    if (coords.pierSide == PIER_SIDE_EAST && coords.h < -limits.settings.pastMeridianE) return false;
+    if (coords.pierSide == PIER_SIDE_WEST && coords.h > limits.settings.pastMeridianW) return false;
+  }
+
+  if (flt(coords.a1, axis1.settings.limits.min) || fgt(coords.a1, axis1.settings.limits.max)) return false;
+  #if AXIS2_TANGENT_ARM == OFF
+    if (flt(coords.a2, axis2.settings.limits.min) || fgt(coords.a2, axis2.settings.limits.max)) return false;
+  #endif
+
+  return true;
+}
+
+// true if a slew between two instrument positions stays within the limits
+bool GotoPlanner::clear(double a1From, double a2From, double a1To, double a2To) {
+  double distance = fabs(a1To - a1From);
+  if (fabs(a2To - a2From) > distance) distance = fabs(a2To - a2From);
+  int steps = ceil(distance/degToRad(GOTO_PLANNER_STEP));
+  if (steps < 1) steps = 1;
+
+  slewBegin(a1From, a2From, a1To, a2To);
+  double a1f0 = a1From, a2f0 = a2From, a1f1, a2f1, f0 = 0.0, alt0, alt1;
+  clear(a1From, a2From, &alt0);
+  for (int i = 1; i <= steps; i++) {
+    double f1 = (double)i/steps;
+    slewAt(f1, &a1f1, &a2f1);
+    if (!clear(a1f1, a2f1, &alt1)) return false;
+    if (!clearBetween(f0, a1f0, a2f0, alt0, f1, a1f1, a2f1, alt1)) return false;
+    f0 = f1;
+    a1f0 = a1f1;
+    a2f0 = a2f1;
+    alt0 = alt1;
+  }
+  return true;
+}
+
+// the meridian and axis limits are crossed at most once along each axis' move but the altitude isn't
+// linear, it changes no faster than the axes move so if it could pass a limit between two points the
+// point half way in time is checked too
+bool GotoPlanner::clearBetween(double f0, double a1f0, double a2f0, double alt0, double f1, double a1f1, double a2f1, double alt1) {
+  double reach = (fabs(a1f1 - a1f0) + fabs(a2f1 - a2f0))/2.0;
+  double mid = (alt0 + alt1)/2.0;
+  if (mid + reach <= limits.settings.altitude.max && mid - reach >= limits.settings.altitude.min) return true;
+  if (reach < degToRad(GOTO_PLANNER_RESOLUTION)) return true;
+
+  double fm = (f0 + f1)/2.0, a1fm, a2fm, altm;
+  slewAt(fm, &a1fm, &a2fm);
+  if (!clear(a1fm, a2fm, &altm)) return false;
+  return clearBetween(f0, a1f0, a2f0, alt0, fm, a1fm, a2fm, altm) &&
+         clearBetween(fm, a1fm, a2fm, altm, f1, a1f1, a2f1, alt1);
+}
+
+// instrument position a fraction f of the way through the time of a slew, each axis on its own profile
+void GotoPlanner::slewPoint(double a1From, double a2From, double a1To, double a2To, double f, double *a1, double *a2) {
+  slewBegin(a1From, a2From, a1To, a2To);
+  slewAt(f, a1, a2);
+}
+
+// sets the slew slewAt() samples
+void GotoPlanner::slewBegin(double a1From, double a2From, double a1To, double a2To) {
+  slewA1From = a1From;
+  slewA2From = a2From;
+  slewA1Distance = fabs(a1To - a1From);
+  slewA2Distance = fabs(a2To - a2From);
+  slewA1Dir = a1To >= a1From ? 1 : -1;
+  slewA2Dir = a2To >= a2From ? 1 : -1;
+  slewSeconds = slewTime(a1From, a2From, a1To, a2To);
+}
+
+// instrument position a fraction f of the way through the time of the slew, the shorter move's
+// S-curve is stretched to the longer's time as Goto does so neither is a straight line in general
+void GotoPlanner::slewAt(double f, double *a1, double *a2) {
+  float t = slewSeconds*f;
+  *a1 = slewA1From + slewA1Dir*axis1.getSlewDistance(slewA1Distance, slewSeconds, t);
+  *a2 = slewA2From + slewA2Dir*axis2.getSlewDistance(slewA2Distance, slewSeconds, t);
+}
+
+// seconds for a slew between two instrument positions
+float GotoPlanner::slewTime(double a1From, double a2From, double a1To, double a2To) {
+  float t1 = axis1.getSlewTime(fabs(a1To - a1From));
+  float t2 = axis2.getSlewTime(fabs(a2To - a2From));
+  return t1 > t2 ? t1 : t2;
+}
+
+// adds a waypoint candidate if it's within the limits
+void GotoPlanner::addNode(double a1, double a2) {
+  if (nodeCount >= GOTO_PLANNER_NODES || !clear(a1, a2)) return;
+  nodeA1[nodeCount] = a1;
+  nodeA2[nodeCount] = a2;
+  nodeCount++;
+}
+
+GotoPlanner gotoPlanner;
+
+#endif
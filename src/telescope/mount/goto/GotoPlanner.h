@@ -0,0 +1,94 @@
+//--------------------------------------------------------------------------------------------------
+// telescope mount control, goto path planning
+#pragma once
+
+#include "../../../Common.h"
+
+#if defined(MOUNT_PRESENT) && GOTO_FEATURE == ON
+
+#include "../coordinates/Transform.h"
+
+// most waypoints in a planned goto path, including the home position on a meridian flip
+#ifndef GOTO_WAYPOINTS_MAX
+  #define GOTO_WAYPOINTS_MAX 6
+#endif
+
+// waypoint grid spacing along axis1 in degrees, from -180 to 360 to cover both pier sides, a wider
+// spacing on either axis uses less RAM (about 20 bytes per waypoint) and plans faster
+#ifndef GOTO_PLANNER_GRID
+  #define GOTO_PLANNER_GRID 15
+#endif
+
+// slews are checked against the limits at points this many degrees apart along the longer axis move
+#ifndef GOTO_PLANNER_STEP
+  #define GOTO_PLANNER_STEP 2.0
+#endif
+
+// the altitude between those points is followed to within this many degrees of a limit
+#ifndef GOTO_PLANNER_RESOLUTION
+  #define GOTO_PLANNER_RESOLUTION 0.01
+#endif
+
+// waypoint grid spacing along axis2 in degrees, from the pole to the opposite pole on either pier side
+#ifndef GOTO_PLANNER_GRID_AXIS2
+  #define GOTO_PLANNER_GRID_AXIS2 30
+#endif
+
+// the grid also has waypoints level with the start and destination along axis2
+#define GOTO_PLANNER_LEVELS (2 + 360/GOTO_PLANNER_GRID_AXIS2 + 1)
+#define GOTO_PLANNER_NODES (2 + GOTO_PLANNER_LEVELS*(540/GOTO_PLANNER_GRID + 1))
+
+class GotoPlanner {
+  public:
+    // plans the quickest path from start to destination (Mount coordinates) that keeps the slews clear
+    // of the horizon, overhead, meridian and axis limits, the axes slew frequency and acceleration must
+    // be set, returns the number of waypoints (0 for a direct slew) or -1 if no clear path was found
+    int plan(Coordinate *start, Coordinate *destination, Coordinate *waypoints, int maxWaypoints);
+
+    // true if the instrument position (in radians) is within the limits
+    bool clear(double a1, double a2);
+
+    // true if a slew between two instrument positions stays within the limits
+    bool clear(double a1From, double a2From, double a1To, double a2To);
+
+    // instrument position a fraction f of the way through the time of a slew, each axis on its own profile
+    void slewPoint(double a1From, double a2From, double a1To, double a2To, double f, double *a1, double *a2);
+
+    // seconds for a slew between two instrument positions
+    float slewTime(double a1From, double a2From, double a1To, double a2To);
+
+    // limit checks made by the last plan
+    long checks = 0;
+
+  private:
+    // true if the instrument position is within the limits, also returns the altitude there
+    bool clear(double a1, double a2, double *altitude);
+
+    // true if the altitude stays within the limits between fractions f0 and f1 of the way through the slew
+    bool clearBetween(double f0, double a1f0, double a2f0, double alt0, double f1, double a1f1, double a2f1, double alt1);
+
+    // sets the slew slewAt() samples
+    void slewBegin(double a1From, double a2From, double a1To, double a2To);
+
+    // instrument position a fraction f of the way through the time of the slew
+    void slewAt(double f, double *a1, double *a2);
+
+    // adds a waypoint candidate if it's within the limits
+    void addNode(double a1, double a2);
+
+    double slewA1From, slewA2From;
+    float slewA1Distance, slewA2Distance, slewSeconds;
+    int8_t slewA1Dir, slewA2Dir;
+
+    int nodeCount = 0;
+    float nodeA1[GOTO_PLANNER_NODES];
+    float nodeA2[GOTO_PLANNER_NODES];
+    float nodeTime[GOTO_PLANNER_NODES];
+    float nodeToGo[GOTO_PLANNER_NODES];
+    int16_t nodeFrom[GOTO_PLANNER_NODES];
+    bool nodeDone[GOTO_PLANNER_NODES];
+};
+
+extern GotoPlanner gotoPlanner;
+
+#endif
@@ -48,6 +48,9 @@ bool Limits::command(char *reply, char *command, char *parameter, bool *supressF
   } else
   
   if (command[0] == 'S') {
+    // limits may move, recheck them on the next pass
+    marginValid = false;
+
     //  :Sh[sDD]#
     //            Set the elevation lower limit
     //            Return: 0 on failure
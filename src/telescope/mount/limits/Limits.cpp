@@ -30,8 +30,10 @@ void Limits::init() {
   constrainMeridianLimits();
 
   // start limit monitor task
-  VF("MSG: Mount, limits start monitor task (rate 100ms priority 2)... ");
-  if (tasks.add(100, 0, true, 2, limitsWrapper, "MntLmt")) { VLF("success"); } else { VLF("FAILED!"); }
+  VF("MSG: Mount, limits start monitor task (rate "); V(LIMITS_PERIOD_MS); VF("ms priority 2)... ");
+  handle = tasks.add(LIMITS_PERIOD_MS, 0, true, 2, limitsWrapper, "MntLmt");
+  if (handle) { VLF("success"); } else { VLF("FAILED!"); }
+  lastPollMs = millis();
 }
 
 // constrain meridian limits to the allowed range
@@ -161,33 +163,27 @@ void Limits::stopAxis2(GuideAction stopDirection) {
   if (transform.mountType == ALTAZM) mount.tracking(false);
 }
 
-void Limits::poll() {
-  static int autoFlipDelayCycles = 0;
-  if (autoFlipDelayCycles > 0) autoFlipDelayCycles--;
-
-  LimitsError lastError = error;
-
-  Coordinate current = mount.getMountPosition(CR_MOUNT_ALT);
-
+// full limit check, updates the error state and the margins to each limit
+void Limits::check(Coordinate *current, LimitsError *lastError) {
   if (limitsEnabled) {
     // overhead and horizon limits
-    if (current.a < settings.altitude.min) error.altitude.min = true; else error.altitude.min = false;
-    if (current.a > settings.altitude.max) error.altitude.max = true; else error.altitude.max = false;
+    if (current->a < settings.altitude.min) error.altitude.min = true; else error.altitude.min = false;
+    if (current->a > settings.altitude.max) error.altitude.max = true; else error.altitude.max = false;
 
     // meridian limits
-    if (transform.meridianFlips && current.pierSide == PIER_SIDE_EAST) {
-      if (current.h < -settings.pastMeridianE) {
+    if (transform.meridianFlips && current->pierSide == PIER_SIDE_EAST) {
+      if (current->h < -settings.pastMeridianE) {
         stopAxis1(GA_REVERSE);
         error.meridian.east = true;
       } else error.meridian.east = false;
     } else error.meridian.east = false;
 
-    if (transform.meridianFlips && current.pierSide == PIER_SIDE_WEST) {
-      if (current.h > settings.pastMeridianW && autoFlipDelayCycles == 0) {
+    if (transform.meridianFlips && current->pierSide == PIER_SIDE_WEST) {
+      if (current->h > settings.pastMeridianW && autoFlipDelayMs <= 0) {
         #if GOTO_FEATURE == ON && AXIS2_TANGENT_ARM == OFF
           if (goTo.isAutoFlipEnabled() && mount.isTracking()) {
             // disable this limit for a second to allow goto to exit the out of limits region
-            autoFlipDelayCycles = 10;
+            autoFlipDelayMs = 1000;
             VLF("MSG: Mount, start automatic meridian flip");
             Coordinate target = mount.getMountPosition();
             CommandError e = goTo.request(&target, PSS_EAST_ONLY, false);
@@ -206,30 +202,30 @@ void Limits::poll() {
     } else error.meridian.west = false;
 
     #if AXIS2_TANGENT_ARM == ON
-      current.a2 = axis2.getMotorPosition();
+      current->a2 = axis2.getMotorPosition();
     #endif
 
     // min and max limits
-    if (flt(current.a1, axis1.settings.limits.min)) {
+    if (flt(current->a1, axis1.settings.limits.min)) {
       stopAxis1(GA_REVERSE);
       error.limit.axis1.min = true;
       // ---------------------------------------------------------
-      if (lastError.limit.axis1.min != error.limit.axis1.min) {
+      if (lastError->limit.axis1.min != error.limit.axis1.min) {
         D("WRN: Limits, min error A1 = ");
-        D(radToDeg(current.a1));
+        D(radToDeg(current->a1));
         D(" A2 = ");
-        D(radToDeg(current.a2));
+        D(radToDeg(current->a2));
         D(" MIN = ");
         DL(radToDeg(axis1.settings.limits.min));
       }
       // ---------------------------------------------------------
     } else error.limit.axis1.min = false;
 
-    if (fgt(current.a1, axis1.settings.limits.max) && autoFlipDelayCycles == 0) {
+    if (fgt(current->a1, axis1.settings.limits.max) && autoFlipDelayMs <= 0) {
       #if GOTO_FEATURE == ON && AXIS2_TANGENT_ARM == OFF
-        if (transform.meridianFlips && current.pierSide == PIER_SIDE_EAST && goTo.isAutoFlipEnabled() && mount.isTracking()) {
+        if (transform.meridianFlips && current->pierSide == PIER_SIDE_EAST && goTo.isAutoFlipEnabled() && mount.isTracking()) {
           // disable this limit for a second to allow goto to exit the out of limits region
-          autoFlipDelayCycles = 10;
+          autoFlipDelayMs = 1000;
           VLF("MSG: Mount, start automatic meridian flip");
           Coordinate target = mount.getMountPosition();
           CommandError e = goTo.request(&target, PSS_WEST_ONLY, false);
@@ -244,11 +240,11 @@ void Limits::poll() {
         stopAxis1(GA_FORWARD);
         error.limit.axis1.max = true;
         // -------------------------------------------------------------
-        if (lastError.limit.axis1.max != error.limit.axis1.max) {
+        if (lastError->limit.axis1.max != error.limit.axis1.max) {
           D("MSG: Limits, max error A1 = ");
-          D(radToDeg(current.a1));
+          D(radToDeg(current->a1));
           D(" A2 = ");
-          D(radToDeg(current.a2));
+          D(radToDeg(current->a2));
           D(" MAX = ");
           DL(radToDeg(axis1.settings.limits.max));
         }
@@ -256,15 +252,27 @@ void Limits::poll() {
       }
     } else error.limit.axis1.max = false;
 
-    if (flt(current.a2, axis2.settings.limits.min)) {
-      stopAxis2((current.pierSide == PIER_SIDE_EAST) ? GA_REVERSE : GA_FORWARD);
+    if (flt(current->a2, axis2.settings.limits.min)) {
+      stopAxis2((current->pierSide == PIER_SIDE_EAST) ? GA_REVERSE : GA_FORWARD);
       error.limit.axis2.min = true;
     } else error.limit.axis2.min = false;
 
-    if (fgt(current.a2, axis2.settings.limits.max)) {
-      stopAxis2((current.pierSide == PIER_SIDE_EAST) ? GA_FORWARD : GA_REVERSE);
+    if (fgt(current->a2, axis2.settings.limits.max)) {
+      stopAxis2((current->pierSide == PIER_SIDE_EAST) ? GA_FORWARD : GA_REVERSE);
       error.limit.axis2.max = true;
     } else error.limit.axis2.max = false;
+
+    // distance to the nearest limit on each axis and in altitude
+    margin.axis1 = min(current->a1 - axis1.settings.limits.min, axis1.settings.limits.max - current->a1);
+    if (transform.meridianFlips) {
+      if (current->pierSide == PIER_SIDE_EAST) margin.axis1 = min(margin.axis1, current->h + settings.pastMeridianE); else
+      if (current->pierSide == PIER_SIDE_WEST) margin.axis1 = min(margin.axis1, settings.pastMeridianW - current->h);
+    }
+    margin.axis2 = min(current->a2 - axis2.settings.limits.min, axis2.settings.limits.max - current->a2);
+    margin.altitude = min(current->a - settings.altitude.min, settings.altitude.max - current->a);
+    marginOrigin = *current;
+    marginValid = true;
+    fullCheckAgeMs = 0;
   } else {
     error.altitude.min = false;
     error.altitude.max = false;
@@ -274,6 +282,67 @@ void Limits::poll() {
     error.limit.axis2.max = false;
     error.meridian.east = false;
     error.meridian.west = false;
+    marginValid = false;
+  }
+
+}
+
+// seconds until a limit could be reached moving from here at these axis rates (radians per second)
+float Limits::timeToLimit(Coordinate *current, float rate1, float rate2) {
+  if (!marginValid) return 0.0F;
+
+  float moved1 = fabs(current->a1 - marginOrigin.a1);
+  float moved2 = fabs(current->a2 - marginOrigin.a2);
+  float left1 = margin.axis1 - moved1;
+  float left2 = margin.axis2 - moved2;
+
+  // altitude changes no faster than the combined motion of both axes
+  float leftAlt, rateAlt;
+  if (transform.mountType == ALTAZM) {
+    leftAlt = margin.altitude - moved2;
+    rateAlt = rate2;
+  } else {
+    leftAlt = margin.altitude - moved1 - moved2;
+    rateAlt = rate1 + rate2;
+  }
+  if (left1 <= 0.0F || left2 <= 0.0F || leftAlt <= 0.0F) return 0.0F;
+
+  float seconds = 3600.0F;
+  if (left1 < rate1*seconds) seconds = left1/rate1;
+  if (left2 < rate2*seconds) seconds = left2/rate2;
+  if (leftAlt < rateAlt*seconds) seconds = leftAlt/rateAlt;
+  return seconds;
+}
+
+void Limits::poll() {
+  unsigned long now = millis();
+  long elapsedMs = (long)(now - lastPollMs);
+  lastPollMs = now;
+  if (autoFlipDelayMs > 0) autoFlipDelayMs -= elapsedMs;
+  if (fullCheckAgeMs < LIMITS_FULL_CHECK_MS) fullCheckAgeMs += elapsedMs;
+
+  LimitsError lastError = error;
+
+  // axis rates, allowing for the acceleration seen since the last pass to continue
+  float rate1 = fabs(axis1.getFrequency());
+  float rate2 = fabs(axis2.getFrequency());
+  float leadRate1 = rate1 + 2.0F*(rate1 > lastRate1 ? rate1 - lastRate1 : 0.0F);
+  float leadRate2 = rate2 + 2.0F*(rate2 > lastRate2 ? rate2 - lastRate2 : 0.0F);
+  lastRate1 = rate1;
+  lastRate2 = rate2;
+
+  // the mount coordinates alone are cheap, only do the full check when a limit could be reached before the next pass
+  Coordinate current = mount.getMountPosition(CR_MOUNT);
+  #if AXIS2_TANGENT_ARM == ON
+    current.a2 = axis2.getMotorPosition();
+  #endif
+  float seconds = timeToLimit(&current, leadRate1, leadRate2);
+
+  if (!limitsEnabled || !marginValid || autoFlipDelayMs > 0 || fullCheckAgeMs >= LIMITS_FULL_CHECK_MS ||
+      seconds < LIMITS_PERIOD_MS/500.0F) {
+    current = mount.getMountPosition(CR_MOUNT_ALT);
+    check(&current, &lastError);
+    seconds = timeToLimit(&current, leadRate1, leadRate2);
   }
 
   // min and max limit switches
@@ -337,6 +406,17 @@ void Limits::poll() {
     if (!lastError.altitude.min && error.altitude.min) stop();
     if (!lastError.altitude.max && error.altitude.max) stop();
   }
+
+  // arm the next pass for half the time a limit could be reached in, so the stop lands within LIMITS_PERIOD_MIN_US of it
+  unsigned long us = LIMITS_PERIOD_MS*1000UL;
+  if (seconds > 0.0F && seconds < us/500000.0F) {
+    us = lroundf(seconds*500000.0F);
+    if (us < LIMITS_PERIOD_MIN_US) us = LIMITS_PERIOD_MIN_US;
+  }
+  if (us != periodUs) {
+    periodUs = us;
+    tasks.setPeriodMicros(handle, periodUs);
+  }
 }
 
 Limits limits;
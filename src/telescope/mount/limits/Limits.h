@@ -8,6 +8,21 @@
 
 #include "../guide/Guide.h"
 
+// limit monitor period in milliseconds, a slew closing in on a limit is checked sooner
+#ifndef LIMITS_PERIOD_MS
+  #define LIMITS_PERIOD_MS 100
+#endif
+
+// shortest limit monitor period in microseconds
+#ifndef LIMITS_PERIOD_MIN_US
+  #define LIMITS_PERIOD_MIN_US 1000
+#endif
+
+// altitude, meridian and axis limits are fully rechecked at least this often in milliseconds
+#ifndef LIMITS_FULL_CHECK_MS
+  #define LIMITS_FULL_CHECK_MS 1000
+#endif
+
 #pragma pack(1)
 typedef struct AltitudeLimits {
   float min;
@@ -37,6 +52,12 @@ typedef struct AxisMinMaxError {
   MinMaxError axis2;
 } AxisMinMaxError;
 
+typedef struct LimitMargins {
+  float axis1;
+  float axis2;
+  float altitude;
+} LimitMargins;
+
 typedef struct LimitsError {
   MinMaxError     altitude;
   AxisMinMaxError limit;
@@ -77,8 +98,27 @@ class Limits {
     void stopAxis1(GuideAction stopDirection = GA_BREAK);
     void stopAxis2(GuideAction stopDirection = GA_BREAK);
 
+    // full limit check, updates the error state and the margins to each limit
+    void check(Coordinate *current, LimitsError *lastError);
+
+    // seconds until a limit could be reached moving from here at these axis rates (radians per second)
+    float timeToLimit(Coordinate *current, float rate1, float rate2);
+
     bool limitsEnabled = false;
     LimitsError error;
+
+    // distance to the nearest limit from the position of the last full check
+    LimitMargins margin = { 0.0F, 0.0F, 0.0F };
+    Coordinate marginOrigin;
+    bool marginValid = false;
+
+    uint8_t handle = 0;
+    unsigned long periodUs = LIMITS_PERIOD_MS*1000UL;
+    unsigned long lastPollMs = 0;
+    unsigned long fullCheckAgeMs = 0;
+    long autoFlipDelayMs = 0;
+    float lastRate1 = 0.0F;
+    float lastRate2 = 0.0F;
 };
 
 extern Limits limits;
@@ -0,0 +1,116 @@
+// -----------------------------------------------------------------------------------
+// CatMgr benchmarks, record walk, position filtered match list, batch alt/az and object search
+
+#include <unity.h>
+#include <Benchmark.h>
+#include <NativeFirmware.h>
+
+#include "src/plugins/DDScope/catalog/Catalog.h"
+
+static int largestCatalog() {
+  int best = 0; long bestCount = 0;
+  for (int i = 0; i < cat_mgr.numCatalogs(); i++) {
+    cat_mgr.select(i);
+    if (cat_mgr.getMaxIndex() > bestCount) { bestCount = cat_mgr.getMaxIndex(); best = i; }
+  }
+  return best;
+}
+
+static void BM_CatMgrWalk(benchmark::State &state) {
+  cat_mgr.select(largestCatalog());
+  cat_mgr.filtersClear();
+  long records = cat_mgr.getMaxIndex() + 1;
+  double sum = 0;
+  for (auto _ : state) {
+    cat_mgr.setIndex(0);
+    for (long i = 0; i < records; i++) { sum += cat_mgr.ra() + cat_mgr.dec(); cat_mgr.incIndex(); }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations()*records);
+}
+BENCHMARK(BM_CatMgrWalk);
+
+static void BM_CatMgrAboveHorizonMatchList(benchmark::State &state) {
+  cat_mgr.select(largestCatalog());
+  cat_mgr.filtersClear();
+  cat_mgr.filterAdd(FM_ABOVE_HORIZON);
+  long records = cat_mgr.getMaxIndex() + 1;
+  for (auto _ : state) {
+    cat_mgr.setLat(40.0); // drops the match list and horizon mask
+    while (!cat_mgr.matchListPoll()) {}
+  }
+  state.SetItemsProcessed(state.iterations()*records);
+  state.SetLabel(std::to_string(cat_mgr.matchCount()) + " above the horizon");
+  cat_mgr.filtersClear();
+}
+BENCHMARK(BM_CatMgrAboveHorizonMatchList);
+
+static void BM_CatMgrEquToHorBatch(benchmark::State &state) {
+  const int count = state.range(0);
+  cat_mgr.select(largestCatalog());
+  long indices[256]; float alt[256], azm[256];
+  for (int i = 0; i < count; i++) indices[i] = i*7 % (cat_mgr.getMaxIndex() + 1);
+  for (auto _ : state) {
+    cat_mgr.EquToHorBatch(indices, count, alt, azm);
+    benchmark::DoNotOptimize(alt[0]);
+  }
+  state.SetItemsProcessed(state.iterations()*count);
+}
+BENCHMARK(BM_CatMgrEquToHorBatch)->Arg(16)->Arg(256);
+
+// the same records one at a time in double precision, as a page did before EquToHorBatch
+static void BM_CatMgrEquToHorPerRecord(benchmark::State &state) {
+  const int count = state.range(0);
+  cat_mgr.select(largestCatalog());
+  cat_mgr.filtersClear();
+  long indices[256];
+  for (int i = 0; i < count; i++) indices[i] = i*7 % (cat_mgr.getMaxIndex() + 1);
+  double sum = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < count; i++) { cat_mgr.setIndex(indices[i]); sum += cat_mgr.alt() + cat_mgr.azm(); }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations()*count);
+}
+BENCHMARK(BM_CatMgrEquToHorPerRecord)->Arg(16)->Arg(256);
+
+static void findQueries(benchmark::State &state, const char **queries, int count) {
+  cat_match_t results[8];
+  int found = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < count; i++) found += cat_mgr.findObjects(queries[i], results, 8);
+  }
+  benchmark::DoNotOptimize(found);
+  state.SetItemsProcessed(state.iterations()*count);
+}
+
+// catalog prefix or title plus the primary id
+static void BM_CatMgrFindById(benchmark::State &state) {
+  const char *queries[] = { "M31", "NGC7000", "IC434", "C 14" };
+  findQueries(state, queries, 4);
+}
+BENCHMARK(BM_CatMgrFindById);
+
+// object names, including one that isn't there
+static void BM_CatMgrFindByName(benchmark::State &state) {
+  const char *queries[] = { "Vega", "Polaris", "andromeda", "NoSuchObject" };
+  findQueries(state, queries, 4);
+}
+BENCHMARK(BM_CatMgrFindByName);
+
+void setUp() {}
+void tearDown() {}
+
+static void test_catmgr_benchmarks() {
+  nativeFirmwareBegin();
+  cat_mgr.setLat(40.0);
+  cat_mgr.setLstT0(6.0);
+  TEST_ASSERT_EQUAL(0, benchmark::RunSpecifiedBenchmarks());
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_catmgr_benchmarks);
+  return UNITY_END();
+}
@@ -0,0 +1,103 @@
+// -----------------------------------------------------------------------------------
+// GeoAlign benchmarks, pointing model fit, folding in a star and the per-goto correction
+
+#include <unity.h>
+#include <Benchmark.h>
+#include <NativeFirmware.h>
+
+#include "src/telescope/mount/coordinates/Transform.h"
+
+#define STARS ALIGN_MAX_MODEL_STARS
+
+static Coordinate actualStars[STARS], mountStars[STARS];
+
+// stars spread over the sky with the mount off by a fixed index offset plus a little noise
+static void makeStars() {
+  srandom(7);
+  for (int i = 0; i < STARS; i++) {
+    Coordinate c = {};
+    c.h = degToRad(random(-80, 80));
+    c.d = degToRad(random(-20, 80));
+    c.pierSide = c.h < 0 ? PIER_SIDE_WEST : PIER_SIDE_EAST;
+    actualStars[i] = c;
+    c.h += arcsecToRad(600 + random(-5, 5));
+    c.d += arcsecToRad(-300 + random(-5, 5));
+    mountStars[i] = c;
+  }
+}
+
+// puts the first n stars into the model arrays the way addStar() does, without starting the fit task
+static void addStars(int n) {
+  GeoAlign &align = transform.align;
+  align.modelClear();
+  for (int i = 0; i < n; i++) {
+    Coordinate a = actualStars[i], m = mountStars[i];
+    if (transform.mountType == ALTAZM) {
+      transform.equToHor(&a);
+      transform.equToHor(&m);
+      align.actual[i].ax1 = a.z; align.actual[i].ax2 = a.a;
+      align.mount[i].ax1 = m.z; align.mount[i].ax2 = m.a;
+    } else {
+      align.actual[i].ax1 = a.h; align.actual[i].ax2 = a.d;
+      align.mount[i].ax1 = m.h; align.mount[i].ax2 = m.d;
+    }
+    align.actual[i].h = a.h; align.actual[i].d = a.d;
+    align.mount[i].h = m.h; align.mount[i].d = m.d;
+    align.actual[i].side = align.mount[i].side = m.pierSide == PIER_SIDE_WEST ? -1 : 1;
+  }
+}
+
+static void BM_GeoAlignAutoModel(benchmark::State &state) {
+  const int n = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    addStars(n);
+    state.ResumeTiming();
+    transform.align.autoModel(n);
+  }
+  if (!transform.align.modelReady()) state.SkipWithError("no model");
+}
+BENCHMARK(BM_GeoAlignAutoModel)->Arg(3)->Arg(ALIGN_MAX_NUM_STARS)->Arg(STARS/2)->Arg(STARS - 1);
+
+static void BM_GeoAlignAddModelStar(benchmark::State &state) {
+  const int n = STARS/2;
+  for (auto _ : state) {
+    state.PauseTiming();
+    addStars(n);
+    transform.align.autoModel(n);
+    state.ResumeTiming();
+    Coordinate a = actualStars[n], m = mountStars[n];
+    transform.align.addModelStar(&a, &m);
+  }
+}
+BENCHMARK(BM_GeoAlignAddModelStar);
+
+static void BM_GeoAlignObservedPlaceToMount(benchmark::State &state) {
+  addStars(ALIGN_MAX_NUM_STARS);
+  transform.align.autoModel(ALIGN_MAX_NUM_STARS);
+  long i = 0;
+  for (auto _ : state) {
+    Coordinate c = actualStars[i++ % STARS];
+    transform.align.observedPlaceToMount(&c);
+    benchmark::DoNotOptimize(c.h);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GeoAlignObservedPlaceToMount);
+
+void setUp() {}
+void tearDown() {}
+
+static void test_geoalign_benchmarks() {
+  nativeFirmwareBegin();
+  makeStars();
+  TEST_ASSERT_EQUAL(0, benchmark::RunSpecifiedBenchmarks());
+  transform.align.modelClear();
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_geoalign_benchmarks);
+  return UNITY_END();
+}
@@ -0,0 +1,62 @@
+// -----------------------------------------------------------------------------------
+// NV benchmarks, cached reads and writes and committing the cache to EEPROM
+
+#include <unity.h>
+#include <Benchmark.h>
+
+#include "src/Common.h"
+
+static void BM_NvReadCached(benchmark::State &state) {
+  float sum = 0;
+  uint16_t i = 0;
+  for (auto _ : state) {
+    sum += nv.readF(i);
+    i = (i + 4) % (nv.size - 4);
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetBytesProcessed(state.iterations()*4);
+}
+BENCHMARK(BM_NvReadCached);
+
+static void BM_NvWriteCached(benchmark::State &state) {
+  uint16_t i = 0;
+  float f = 0;
+  for (auto _ : state) {
+    nv.write(i, f += 1.0F);
+    i = (i + 4) % (nv.size - 4);
+  }
+  state.SetBytesProcessed(state.iterations()*4);
+}
+BENCHMARK(BM_NvWriteCached);
+
+// commit a block of changed bytes with the poll() the SysSvcs task calls every 10ms
+static void BM_NvCommit(benchmark::State &state) {
+  const int bytes = state.range(0);
+  long polls = 0;
+  uint8_t v = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    v++;
+    for (int i = 0; i < bytes; i++) nv.write((uint16_t)i, v);
+    state.ResumeTiming();
+    while (!nv.committed()) { nv.poll(false); polls++; }
+  }
+  state.SetBytesProcessed(state.iterations()*bytes);
+  state.SetLabel(std::to_string(polls/state.iterations()) + " polls");
+}
+BENCHMARK(BM_NvCommit)->Arg(64)->Arg(1024);
+
+void setUp() {}
+void tearDown() {}
+
+static void test_nv_benchmarks() {
+  HAL_NV_INIT();
+  TEST_ASSERT_EQUAL(0, benchmark::RunSpecifiedBenchmarks());
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_nv_benchmarks);
+  return UNITY_END();
+}
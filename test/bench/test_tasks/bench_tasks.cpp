@@ -0,0 +1,63 @@
+// -----------------------------------------------------------------------------------
+// OnTask benchmarks, cost of tasks.yield() as the number of tasks grows, run in native_bench for the
+// scan and native_bench_heap for the heap scheduler
+
+#include <unity.h>
+#include <Benchmark.h>
+
+#include "src/Common.h"
+#include "src/lib/tasks/OnTask.h"
+
+#ifdef TASKS_SCHEDULER_HEAP
+  #define SCHEDULER "heap"
+#else
+  #define SCHEDULER "scan"
+#endif
+
+static volatile long runs = 0;
+static void work() { runs++; }
+
+static void BM_TasksYield(benchmark::State &state) {
+  const int count = state.range(0);
+  uint8_t handle[TASKS_MAX];
+  srandom(3);
+  for (int i = 0; i < count; i++) {
+    handle[i] = tasks.add(0, 0, true, random(0, 8), work, "Bench");
+    // mix of sub-ms, ms and slow tasks like the firmware has
+    switch (i % 3) {
+      case 0: tasks.setPeriodMicros(handle[i], random(200, 2000)); break;
+      case 1: tasks.setPeriod(handle[i], random(1, 10)); break;
+      case 2: tasks.setPeriod(handle[i], random(10, 200)); break;
+    }
+  }
+  runs = 0;
+  for (auto _ : state) tasks.yield();
+  for (int i = 0; i < count; i++) tasks.remove(handle[i]);
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(std::string(SCHEDULER) + ", " + std::to_string(runs) + " runs");
+}
+// the firmware allows TASKS_MAX 72
+BENCHMARK(BM_TasksYield)->Arg(8)->Arg(32)->Arg(64);
+
+static void BM_TasksAddRemove(benchmark::State &state) {
+  for (auto _ : state) {
+    uint8_t h = tasks.add(10, 0, true, 4, work, "Bench");
+    tasks.remove(h);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TasksAddRemove);
+
+void setUp() {}
+void tearDown() {}
+
+static void test_tasks_benchmarks() {
+  TEST_ASSERT_EQUAL(0, benchmark::RunSpecifiedBenchmarks());
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_tasks_benchmarks);
+  return UNITY_END();
+}
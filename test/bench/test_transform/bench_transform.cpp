@@ -0,0 +1,107 @@
+// -----------------------------------------------------------------------------------
+// Transform benchmarks, the coordinate conversions done for every goto and status update
+
+#include <unity.h>
+#include <Benchmark.h>
+#include <NativeFirmware.h>
+
+#include "src/telescope/mount/coordinates/Transform.h"
+
+#define POINTS 64
+
+static Coordinate points[POINTS];
+
+static void makePoints() {
+  srandom(11);
+  for (int i = 0; i < POINTS; i++) {
+    Coordinate c = {};
+    c.r = degToRad(random(0, 360));
+    c.h = degToRad(random(-90, 90));
+    c.d = degToRad(random(-30, 85));
+    c.pierSide = PIER_SIDE_NONE;
+    transform.equToHor(&c);
+    points[i] = c;
+  }
+}
+
+static void BM_TransformEquToHor(benchmark::State &state) {
+  long i = 0;
+  for (auto _ : state) {
+    Coordinate c = points[i++ % POINTS];
+    transform.equToHor(&c);
+    benchmark::DoNotOptimize(c.a);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TransformEquToHor);
+
+static void BM_TransformHorToEqu(benchmark::State &state) {
+  long i = 0;
+  for (auto _ : state) {
+    Coordinate c = points[i++ % POINTS];
+    transform.horToEqu(&c);
+    benchmark::DoNotOptimize(c.h);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TransformHorToEqu);
+
+static void BM_TransformObservedPlaceToMount(benchmark::State &state) {
+  long i = 0;
+  for (auto _ : state) {
+    Coordinate c = points[i++ % POINTS];
+    transform.observedPlaceToMount(&c);
+    benchmark::DoNotOptimize(c.h);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TransformObservedPlaceToMount);
+
+static void BM_TransformMountToNative(benchmark::State &state) {
+  long i = 0;
+  for (auto _ : state) {
+    Coordinate c = points[i++ % POINTS];
+    Coordinate n = transform.mountToNative(&c, true);
+    benchmark::DoNotOptimize(n.r);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TransformMountToNative);
+
+static void BM_TransformNativeToMount(benchmark::State &state) {
+  long i = 0;
+  double a1, a2;
+  for (auto _ : state) {
+    Coordinate c = points[i++ % POINTS];
+    transform.nativeToMount(&c, &a1, &a2);
+    benchmark::DoNotOptimize(a1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TransformNativeToMount);
+
+static void BM_TransformApparentRefrac(benchmark::State &state) {
+  long i = 0;
+  for (auto _ : state) {
+    double r = transform.apparentRefrac(points[i++ % POINTS].a);
+    benchmark::DoNotOptimize(r);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TransformApparentRefrac);
+
+void setUp() {}
+void tearDown() {}
+
+static void test_transform_benchmarks() {
+  nativeFirmwareBegin();
+  makePoints();
+  TEST_ASSERT_EQUAL(0, benchmark::RunSpecifiedBenchmarks());
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_transform_benchmarks);
+  return UNITY_END();
+}
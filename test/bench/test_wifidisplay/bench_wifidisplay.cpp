@@ -0,0 +1,78 @@
+// -----------------------------------------------------------------------------------
+// WifiDisplay benchmarks, the frame compressors and the delta builder on a synthetic screen
+
+#include <unity.h>
+#include <Benchmark.h>
+
+#include "src/Common.h"
+#include "src/plugins/DDScope/display/WifiDisplay.h"
+
+// a screen that looks like the DDScope ones, a plain background with buttons and some text
+static void drawScreen(uint8_t seed) {
+  for (int y = 0; y < SCREEN_HEIGHT; y++) {
+    for (int x = 0; x < SCREEN_WIDTH; x++) {
+      uint16_t c = 0x0841;
+      if (y >= 60 && y < 420 && (y/40) % 2 == 0 && x >= 20 && x < 300) c = 0x3186;
+      if (y >= 60 && y < 420 && (y % 40) >= 12 && (y % 40) < 24 && (x % 8) < 5 && ((x*7 + y*3 + seed) % 11) < 4) c = 0xFFFF;
+      uncompressedBuffer[(y*SCREEN_WIDTH + x)*COLOR_DEPTH] = c >> 8;
+      uncompressedBuffer[(y*SCREEN_WIDTH + x)*COLOR_DEPTH + 1] = c & 0xFF;
+    }
+  }
+}
+
+static void BM_WifiDisplayRLE(benchmark::State &state) {
+  drawScreen(0);
+  size_t size = 0;
+  for (auto _ : state) size = wifiDisplay.compressWithRLE();
+  state.SetBytesProcessed(state.iterations()*UNCOMPRESSED_BUFFER_SIZE);
+  state.SetLabel(std::to_string(size) + " bytes out");
+  if (size == 0) state.SkipWithError("RLE overflow");
+}
+BENCHMARK(BM_WifiDisplayRLE);
+
+static void BM_WifiDisplayDeflate(benchmark::State &state) {
+  drawScreen(0);
+  size_t size = 0;
+  for (auto _ : state) size = wifiDisplay.compressWithDeflate();
+  state.SetBytesProcessed(state.iterations()*UNCOMPRESSED_BUFFER_SIZE);
+  state.SetLabel(std::to_string(size) + " bytes out");
+  if (size == 0) state.SkipWithError("deflate failed");
+}
+BENCHMARK(BM_WifiDisplayDeflate);
+
+// a delta of the given number of dirty tiles, built then deflated like startFrame() does
+static void BM_WifiDisplayDelta(benchmark::State &state) {
+  const int tiles = state.range(0);
+  drawScreen(1);
+  size_t raw = 0, size = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    wifiDisplay.clearDirty();
+    for (int i = 0; i < tiles; i++) {
+      int t = (i*7) % (MIRROR_TILE_COLS*MIRROR_TILE_ROWS);
+      wifiDisplay.markDirty((t % MIRROR_TILE_COLS)*MIRROR_TILE, (t / MIRROR_TILE_COLS)*MIRROR_TILE);
+    }
+    state.ResumeTiming();
+    raw = wifiDisplay.buildDelta();
+    size = wifiDisplay.compressWithDeflate(sendBuffer, raw);
+  }
+  wifiDisplay.clearDirty();
+  state.SetBytesProcessed(state.iterations()*raw);
+  state.SetLabel(std::to_string(raw) + " -> " + std::to_string(size) + " bytes");
+  if (size == 0) state.SkipWithError("deflate failed");
+}
+BENCHMARK(BM_WifiDisplayDelta)->Arg(4)->Arg(32)->Arg(MIRROR_DELTA_MAX_TILES);
+
+void setUp() {}
+void tearDown() {}
+
+static void test_wifidisplay_benchmarks() {
+  TEST_ASSERT_EQUAL(0, benchmark::RunSpecifiedBenchmarks());
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_wifidisplay_benchmarks);
+  return UNITY_END();
+}
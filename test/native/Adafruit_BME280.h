@@ -0,0 +1,16 @@
+// -----------------------------------------------------------------------------------
+// Adafruit BME280 stand-in for the native (host) build, the sensor is never found
+#pragma once
+
+#include "Wire.h"
+
+class Adafruit_BME280 {
+  public:
+    Adafruit_BME280() {}
+    Adafruit_BME280(int8_t cs) { (void)cs; }
+    Adafruit_BME280(int8_t cs, int8_t mosi, int8_t miso, int8_t sck) { (void)cs; (void)mosi; (void)miso; (void)sck; }
+    bool begin(uint8_t address = 0x77, TwoWire *wire = &Wire) { (void)address; (void)wire; return false; }
+    float readTemperature() { return NAN; }
+    float readPressure() { return NAN; }
+    float readHumidity() { return NAN; }
+};
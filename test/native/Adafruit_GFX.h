@@ -0,0 +1,308 @@
+// -----------------------------------------------------------------------------------
+// Adafruit GFX stand-in for the native build, the drawing the display code uses with the
+// library's signatures and text/cursor behavior; the classic 5x7 font draws as blank cells
+#pragma once
+
+#include <Arduino.h>
+#include <gfxfont.h>
+
+class Adafruit_GFX : public Print {
+  public:
+    Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+    virtual ~Adafruit_GFX() {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    virtual void startWrite() {}
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color) { drawPixel(x, y, color); }
+    virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { fillRect(x, y, w, h, color); }
+    virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { drawFastVLine(x, y, h, color); }
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { drawFastHLine(x, y, w, color); }
+    virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+      bool steep = abs(y1 - y0) > abs(x1 - x0);
+      if (steep) { std::swap(x0, y0); std::swap(x1, y1); }
+      if (x0 > x1) { std::swap(x0, x1); std::swap(y0, y1); }
+      int16_t dx = x1 - x0, dy = abs(y1 - y0), err = dx/2, ystep = y0 < y1 ? 1 : -1;
+      for (; x0 <= x1; x0++) {
+        if (steep) writePixel(y0, x0, color); else writePixel(x0, y0, color);
+        err -= dy;
+        if (err < 0) { y0 += ystep; err += dx; }
+      }
+    }
+    virtual void endWrite() {}
+
+    virtual void setRotation(uint8_t r) {
+      rotation = r & 3;
+      if (rotation & 1) { _width = HEIGHT; _height = WIDTH; } else { _width = WIDTH; _height = HEIGHT; }
+    }
+    virtual void invertDisplay(bool i) { (void)i; }
+
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { startWrite(); writeLine(x, y, x, y + h - 1, color); endWrite(); }
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { startWrite(); writeLine(x, y, x + w - 1, y, color); endWrite(); }
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+      startWrite();
+      for (int16_t i = x; i < x + w; i++) writeFastVLine(i, y, h, color);
+      endWrite();
+    }
+    virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+    virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+      if (x0 == x1) { if (y0 > y1) std::swap(y0, y1); drawFastVLine(x0, y0, y1 - y0 + 1, color); } else
+      if (y0 == y1) { if (x0 > x1) std::swap(x0, x1); drawFastHLine(x0, y0, x1 - x0 + 1, color); } else
+      { startWrite(); writeLine(x0, y0, x1, y1, color); endWrite(); }
+    }
+    virtual void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+      startWrite();
+      writeFastHLine(x, y, w, color);
+      writeFastHLine(x, y + h - 1, w, color);
+      writeFastVLine(x, y, h, color);
+      writeFastVLine(x + w - 1, y, h, color);
+      endWrite();
+    }
+
+    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+      startWrite();
+      writePixel(x0, y0 + r, color); writePixel(x0, y0 - r, color); writePixel(x0 + r, y0, color); writePixel(x0 - r, y0, color);
+      drawCircleHelper(x0, y0, r, 0xF, color);
+      endWrite();
+    }
+    void drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername, uint16_t color) {
+      int16_t f = 1 - r, ddF_x = 1, ddF_y = -2*r, x = 0, y = r;
+      while (x < y) {
+        if (f >= 0) { y--; ddF_y += 2; f += ddF_y; }
+        x++; ddF_x += 2; f += ddF_x;
+        if (cornername & 0x4) { writePixel(x0 + x, y0 + y, color); writePixel(x0 + y, y0 + x, color); }
+        if (cornername & 0x2) { writePixel(x0 + x, y0 - y, color); writePixel(x0 + y, y0 - x, color); }
+        if (cornername & 0x8) { writePixel(x0 - y, y0 + x, color); writePixel(x0 - x, y0 + y, color); }
+        if (cornername & 0x1) { writePixel(x0 - y, y0 - x, color); writePixel(x0 - x, y0 - y, color); }
+      }
+    }
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+      startWrite();
+      writeFastVLine(x0, y0 - r, 2*r + 1, color);
+      fillCircleHelper(x0, y0, r, 3, 0, color);
+      endWrite();
+    }
+    void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color) {
+      int16_t f = 1 - r, ddF_x = 1, ddF_y = -2*r, x = 0, y = r, px = x, py = y;
+      delta++;
+      while (x < y) {
+        if (f >= 0) { y--; ddF_y += 2; f += ddF_y; }
+        x++; ddF_x += 2; f += ddF_x;
+        if (x < (y + 1)) {
+          if (corners & 1) writeFastVLine(x0 + x, y0 - y, 2*y + delta, color);
+          if (corners & 2) writeFastVLine(x0 - x, y0 - y, 2*y + delta, color);
+        }
+        if (y != py) {
+          if (corners & 1) writeFastVLine(x0 + py, y0 - px, 2*px + delta, color);
+          if (corners & 2) writeFastVLine(x0 - py, y0 - px, 2*px + delta, color);
+          py = y;
+        }
+        px = x;
+      }
+    }
+    void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+      int16_t max_radius = ((w < h) ? w : h)/2;
+      if (r > max_radius) r = max_radius;
+      startWrite();
+      writeFastHLine(x + r, y, w - 2*r, color);
+      writeFastHLine(x + r, y + h - 1, w - 2*r, color);
+      writeFastVLine(x, y + r, h - 2*r, color);
+      writeFastVLine(x + w - 1, y + r, h - 2*r, color);
+      drawCircleHelper(x + r, y + r, r, 1, color);
+      drawCircleHelper(x + w - r - 1, y + r, r, 2, color);
+      drawCircleHelper(x + w - r - 1, y + h - r - 1, r, 4, color);
+      drawCircleHelper(x + r, y + h - r - 1, r, 8, color);
+      endWrite();
+    }
+    void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+      int16_t max_radius = ((w < h) ? w : h)/2;
+      if (r > max_radius) r = max_radius;
+      startWrite();
+      writeFillRect(x + r, y, w - 2*r, h, color);
+      fillCircleHelper(x + w - r - 1, y + r, r, 1, h - 2*r - 1, color);
+      fillCircleHelper(x + r, y + r, r, 2, h - 2*r - 1, color);
+      endWrite();
+    }
+
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color) {
+      int16_t byteWidth = (w + 7)/8; uint8_t b = 0;
+      startWrite();
+      for (int16_t j = 0; j < h; j++, y++) {
+        for (int16_t i = 0; i < w; i++) {
+          if (i & 7) b <<= 1; else b = bitmap[j*byteWidth + i/8];
+          if (b & 0x80) writePixel(x + i, y, color);
+        }
+      }
+      endWrite();
+    }
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg) {
+      int16_t byteWidth = (w + 7)/8; uint8_t b = 0;
+      startWrite();
+      for (int16_t j = 0; j < h; j++, y++) {
+        for (int16_t i = 0; i < w; i++) {
+          if (i & 7) b <<= 1; else b = bitmap[j*byteWidth + i/8];
+          writePixel(x + i, y, (b & 0x80) ? color : bg);
+        }
+      }
+      endWrite();
+    }
+
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) { drawChar(x, y, c, color, bg, size, size); }
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size_x, uint8_t size_y) {
+      if (!gfxFont) {
+        // classic font cell, no glyph data in the stand-in
+        if (bg != color) fillRect(x, y, 6*size_x, 8*size_y, bg);
+        return;
+      }
+      c -= (uint8_t)gfxFont->first;
+      GFXglyph *glyph = gfxFont->glyph + c;
+      uint8_t *bitmap = gfxFont->bitmap;
+      uint16_t bo = glyph->bitmapOffset;
+      uint8_t w = glyph->width, h = glyph->height, xx, yy, bits = 0, bit = 0;
+      int8_t xo = glyph->xOffset, yo = glyph->yOffset;
+      startWrite();
+      for (yy = 0; yy < h; yy++) {
+        for (xx = 0; xx < w; xx++) {
+          if (!(bit++ & 7)) bits = bitmap[bo++];
+          if (bits & 0x80) {
+            if (size_x == 1 && size_y == 1) writePixel(x + xo + xx, y + yo + yy, color);
+            else writeFillRect(x + (xo + xx)*size_x, y + (yo + yy)*size_y, size_x, size_y, color);
+          }
+          bits <<= 1;
+        }
+      }
+      endWrite();
+    }
+
+    size_t write(uint8_t c) override {
+      if (!gfxFont) {
+        if (c == '\n') { cursor_x = 0; cursor_y += textsize_y*8; } else
+        if (c != '\r') {
+          if (wrap && (cursor_x + textsize_x*6 > _width)) { cursor_x = 0; cursor_y += textsize_y*8; }
+          drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+          cursor_x += textsize_x*6;
+        }
+      } else {
+        if (c == '\n') { cursor_x = 0; cursor_y += (int16_t)textsize_y*gfxFont->yAdvance; } else
+        if (c != '\r') {
+          if (c >= gfxFont->first && c <= gfxFont->last) {
+            GFXglyph *glyph = gfxFont->glyph + (c - gfxFont->first);
+            if (glyph->width > 0 && glyph->height > 0) {
+              if (wrap && (cursor_x + textsize_x*(glyph->xOffset + glyph->width)) > _width) { cursor_x = 0; cursor_y += (int16_t)textsize_y*gfxFont->yAdvance; }
+              drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+            }
+            cursor_x += glyph->xAdvance*(int16_t)textsize_x;
+          }
+        }
+      }
+      return 1;
+    }
+    using Print::write;
+
+    void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+    void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+    void setTextColor(uint16_t c, uint16_t bg) { textcolor = c; textbgcolor = bg; }
+    void setTextSize(uint8_t s) { setTextSize(s, s); }
+    void setTextSize(uint8_t sx, uint8_t sy) { textsize_x = sx > 0 ? sx : 1; textsize_y = sy > 0 ? sy : 1; }
+    void setTextWrap(bool w) { wrap = w; }
+    void cp437(bool x = true) { _cp437 = x; }
+    void setFont(const GFXfont *f = NULL) {
+      if (f) { if (!gfxFont) cursor_y += 6; } else if (gfxFont) cursor_y -= 6;
+      gfxFont = (GFXfont *)f;
+    }
+
+    void getTextBounds(const char *str, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h) {
+      int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+      *x1 = x; *y1 = y; *w = *h = 0;
+      uint8_t c;
+      while ((c = *str++)) charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+      if (maxx >= minx) { *x1 = minx; *w = maxx - minx + 1; }
+      if (maxy >= miny) { *y1 = miny; *h = maxy - miny + 1; }
+    }
+    void getTextBounds(const String &str, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h) { getTextBounds(str.c_str(), x, y, x1, y1, w, h); }
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+    uint8_t getRotation() const { return rotation; }
+    int16_t getCursorX() const { return cursor_x; }
+    int16_t getCursorY() const { return cursor_y; }
+
+  protected:
+    void charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx, int16_t *miny, int16_t *maxx, int16_t *maxy) {
+      if (gfxFont) {
+        if (c == '\n') { *x = 0; *y += textsize_y*gfxFont->yAdvance; } else
+        if (c != '\r' && c >= gfxFont->first && c <= gfxFont->last) {
+          GFXglyph *glyph = gfxFont->glyph + (c - gfxFont->first);
+          uint8_t gw = glyph->width, gh = glyph->height, xa = glyph->xAdvance;
+          int8_t xo = glyph->xOffset, yo = glyph->yOffset;
+          if (wrap && ((*x + (((int16_t)xo + gw)*textsize_x)) > _width)) { *x = 0; *y += textsize_y*gfxFont->yAdvance; }
+          int16_t x1 = *x + xo*textsize_x, y1 = *y + yo*textsize_y, x2 = x1 + gw*textsize_x - 1, y2 = y1 + gh*textsize_y - 1;
+          if (x1 < *minx) *minx = x1;
+          if (y1 < *miny) *miny = y1;
+          if (x2 > *maxx) *maxx = x2;
+          if (y2 > *maxy) *maxy = y2;
+          *x += xa*textsize_x;
+        }
+      } else {
+        if (c == '\n') { *x = 0; *y += textsize_y*8; } else
+        if (c != '\r') {
+          if (wrap && ((*x + textsize_x*6) > _width)) { *x = 0; *y += textsize_y*8; }
+          int x2 = *x + textsize_x*6 - 1, y2 = *y + textsize_y*8 - 1;
+          if (x2 > *maxx) *maxx = x2;
+          if (y2 > *maxy) *maxy = y2;
+          if (*x < *minx) *minx = *x;
+          if (*y < *miny) *miny = *y;
+          *x += textsize_x*6;
+        }
+      }
+    }
+
+    int16_t WIDTH, HEIGHT;
+    int16_t _width, _height;
+    int16_t cursor_x = 0, cursor_y = 0;
+    uint16_t textcolor = 0xFFFF, textbgcolor = 0xFFFF;
+    uint8_t textsize_x = 1, textsize_y = 1;
+    uint8_t rotation = 0;
+    bool wrap = true;
+    bool _cp437 = false;
+    GFXfont *gfxFont = NULL;
+};
+
+// 1 bit per pixel canvas, rows padded to whole bytes, most significant bit first
+class GFXcanvas1 : public Adafruit_GFX {
+  public:
+    GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+      uint32_t bytes = ((w + 7)/8)*h;
+      buffer = (uint8_t *)calloc(bytes, 1);
+    }
+    ~GFXcanvas1() { free(buffer); }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+      if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height) return;
+      int16_t t;
+      switch (rotation) {
+        case 1: t = x; x = WIDTH - 1 - y; y = t; break;
+        case 2: x = WIDTH - 1 - x; y = HEIGHT - 1 - y; break;
+        case 3: t = x; x = y; y = HEIGHT - 1 - t; break;
+      }
+      uint8_t *ptr = &buffer[(x/8) + y*((WIDTH + 7)/8)];
+      if (color) *ptr |= 0x80 >> (x & 7); else *ptr &= ~(0x80 >> (x & 7));
+    }
+    bool getPixel(int16_t x, int16_t y) const {
+      if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height) return false;
+      int16_t t;
+      switch (rotation) {
+        case 1: t = x; x = WIDTH - 1 - y; y = t; break;
+        case 2: x = WIDTH - 1 - x; y = HEIGHT - 1 - y; break;
+        case 3: t = x; x = y; y = HEIGHT - 1 - t; break;
+      }
+      return (buffer[(x/8) + y*((WIDTH + 7)/8)] & (0x80 >> (x & 7))) != 0;
+    }
+    void fillScreen(uint16_t color) override {
+      if (buffer) memset(buffer, color ? 0xFF : 0x00, ((WIDTH + 7)/8)*HEIGHT);
+    }
+    uint8_t *getBuffer() const { return buffer; }
+
+  private:
+    uint8_t *buffer;
+};
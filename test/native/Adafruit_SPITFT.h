@@ -0,0 +1,6 @@
+// -----------------------------------------------------------------------------------
+// Adafruit_SPITFT stand-in for the native build
+#pragma once
+
+#include <Adafruit_GFX.h>
+#include <SPI.h>
@@ -0,0 +1,285 @@
+// -----------------------------------------------------------------------------------
+// Arduino core stand-in for the native (host) build, just enough for the firmware sources
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+#include <stdarg.h>
+#include <chrono>
+#include <string>
+#include <deque>
+#include <algorithm>
+#include <type_traits>
+
+using std::isnan;
+using std::isinf;
+
+// like the Teensy core, min() and max() accept mixed argument types
+template <class A, class B> constexpr typename std::common_type<A, B>::type min(A a, B b) { return a < b ? a : b; }
+template <class A, class B> constexpr typename std::common_type<A, B>::type max(A a, B b) { return a > b ? a : b; }
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define INPUT_PULLDOWN 3
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+#define LED_BUILTIN 13
+#define A0 14
+
+#ifndef PI
+  #define PI 3.1415926535897932384626433832795
+#endif
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define radians(deg) ((deg)*DEG_TO_RAD)
+#define degrees(rad) ((rad)*RAD_TO_DEG)
+#define sq(x) ((x)*(x))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+// memory placement attributes have no meaning on the host
+#define PROGMEM
+#define EXTMEM
+#define DMAMEM
+#define FLASHMEM
+#define FASTRUN
+#define PSTR(s) (s)
+#define F(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_float(addr) (*(const float *)(addr))
+#define pgm_read_ptr(addr) (*(void * const *)(addr))
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strcmp_P strcmp
+#define strlen_P strlen
+#define memcpy_P memcpy
+#define sprintf_P sprintf
+typedef const char __FlashStringHelper;
+
+// time, the clock runs in real time unless a test takes it over with nativeClock
+struct NativeClock {
+  bool manual = false;
+  uint64_t us = 0;
+  uint32_t step = 0;
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  uint64_t now() {
+    if (manual) { us += step; return us; }
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+  }
+  // stop real time and continue from the current time in steps set by advance(), delay() advances
+  // the clock at once and each reading adds stepMicros so polling loops still see time pass
+  void hold(uint32_t stepMicros = 1) { us = now(); step = stepMicros; manual = true; }
+  void release() { t0 = std::chrono::steady_clock::now() - std::chrono::microseconds(us); manual = false; }
+  void advance(uint64_t microseconds) { us += microseconds; }
+};
+inline NativeClock nativeClock;
+
+inline unsigned long micros() { return (unsigned long)nativeClock.now(); }
+inline unsigned long millis() { return (unsigned long)(nativeClock.now()/1000ULL); }
+inline void delayMicroseconds(unsigned int us) { if (nativeClock.manual) nativeClock.advance(us); else { unsigned long t = micros(); while (micros() - t < us) {} } }
+inline void delay(unsigned long ms) { delayMicroseconds(ms*1000UL); }
+// Teensy RTC, seconds since 1970 that count with the clock above
+class teensy3_clock_class {
+  public:
+    unsigned long get() { return base + millis()/1000UL; }
+    void set(unsigned long t) { base = t - millis()/1000UL; }
+  private:
+    unsigned long base = 0;
+};
+inline teensy3_clock_class Teensy3Clock;
+
+inline void yield() {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+inline void cli() {}
+inline void sei() {}
+inline long random(long howbig) { return howbig > 0 ? ::random() % howbig : 0; }
+inline long random(long howsmall, long howbig) { return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall); }
+inline void randomSeed(unsigned long seed) { srandom(seed); }
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+inline char *dtostrf(double val, signed char width, unsigned char prec, char *buf) { sprintf(buf, "%*.*f", width, prec, val); return buf; }
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) { return (x - in_min)*(out_max - out_min)/(in_max - in_min) + out_min; }
+
+// pins, outputs are remembered so a test can read them back, and each high to low edge counted (a chip select)
+inline uint8_t nativePins[256];
+inline uint32_t nativePinFalls[256];
+inline void pinMode(int pin, int mode) { (void)pin; (void)mode; }
+inline void digitalWrite(int pin, int value) {
+  if (pin < 0 || pin >= 256) return;
+  if (nativePins[pin] != LOW && value == LOW) nativePinFalls[pin]++;
+  nativePins[pin] = value;
+}
+inline int digitalRead(int pin) { return (pin >= 0 && pin < 256) ? nativePins[pin] : LOW; }
+inline int analogRead(int pin) { (void)pin; return 0; }
+inline void analogWrite(int pin, int value) { (void)pin; (void)value; }
+inline void analogReadResolution(int bits) { (void)bits; }
+inline void analogWriteResolution(int bits) { (void)bits; }
+inline void analogWriteFrequency(int pin, float freq) { (void)pin; (void)freq; }
+inline void tone(int pin, unsigned int freq, unsigned long duration = 0) { (void)pin; (void)freq; (void)duration; }
+inline void noTone(int pin) { (void)pin; }
+inline void attachInterrupt(int irq, void (*isr)(), int mode) { (void)irq; (void)isr; (void)mode; }
+inline void detachInterrupt(int irq) { (void)irq; }
+#define digitalPinToInterrupt(p) (p)
+#define digitalWriteFast digitalWrite
+#define digitalReadFast digitalRead
+
+// minimal Arduino String, only what the sources use
+class String {
+  public:
+    String() {}
+    String(const char *s) { if (s) str = s; }
+    String(const std::string &s) : str(s) {}
+    String(char c) { str = c; }
+    String(int v) { str = std::to_string(v); }
+    String(unsigned int v) { str = std::to_string(v); }
+    String(long v) { str = std::to_string(v); }
+    String(unsigned long v) { str = std::to_string(v); }
+    String(float v, int decimals = 2) { char b[32]; snprintf(b, sizeof(b), "%.*f", decimals, v); str = b; }
+    String(double v, int decimals = 2) { char b[32]; snprintf(b, sizeof(b), "%.*f", decimals, v); str = b; }
+    const char *c_str() const { return str.c_str(); }
+    unsigned int length() const { return str.length(); }
+    char charAt(unsigned int i) const { return i < str.length() ? str[i] : 0; }
+    char operator[](unsigned int i) const { return charAt(i); }
+    String &operator+=(const String &s) { str += s.str; return *this; }
+    String &operator+=(const char *s) { str += s; return *this; }
+    String &operator+=(char c) { str += c; return *this; }
+    bool concat(const String &s) { str += s.str; return true; }
+    bool concat(char c) { str += c; return true; }
+    friend String operator+(const String &a, const String &b) { return String(a.str + b.str); }
+    friend String operator+(const String &a, const char *b) { return String(a.str + b); }
+    friend String operator+(const char *a, const String &b) { return String(a + b.str); }
+    bool operator==(const String &s) const { return str == s.str; }
+    bool operator==(const char *s) const { return str == s; }
+    bool operator!=(const String &s) const { return str != s.str; }
+    bool equals(const String &s) const { return str == s.str; }
+    bool startsWith(const String &s) const { return str.rfind(s.str, 0) == 0; }
+    bool endsWith(const String &s) const { return str.size() >= s.str.size() && str.compare(str.size() - s.str.size(), s.str.size(), s.str) == 0; }
+    int indexOf(char c, unsigned int from = 0) const { size_t i = str.find(c, from); return i == std::string::npos ? -1 : (int)i; }
+    int indexOf(const String &s, unsigned int from = 0) const { size_t i = str.find(s.str, from); return i == std::string::npos ? -1 : (int)i; }
+    String substring(unsigned int from) const { return from < str.size() ? String(str.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const { return from < str.size() && to > from ? String(str.substr(from, to - from)) : String(); }
+    void toCharArray(char *buf, unsigned int size) const { if (size) { strncpy(buf, str.c_str(), size - 1); buf[size - 1] = 0; } }
+    long toInt() const { return atol(str.c_str()); }
+    float toFloat() const { return atof(str.c_str()); }
+    void trim() { size_t a = str.find_first_not_of(" \t\r\n"); size_t b = str.find_last_not_of(" \t\r\n"); str = a == std::string::npos ? "" : str.substr(a, b - a + 1); }
+    void toUpperCase() { for (auto &c : str) c = toupper(c); }
+    void toLowerCase() { for (auto &c : str) c = tolower(c); }
+    void remove(unsigned int index) { if (index < str.size()) str.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < str.size()) str.erase(index, count); }
+    void replace(const String &a, const String &b) { size_t i = 0; while (!a.str.empty() && (i = str.find(a.str, i)) != std::string::npos) { str.replace(i, a.str.size(), b.str); i += b.str.size(); } }
+    void reserve(unsigned int size) { str.reserve(size); }
+  private:
+    std::string str;
+};
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) { size_t n = 0; while (size--) n += write(*buffer++); return n; }
+    size_t write(const char *s) { return s ? write((const uint8_t *)s, strlen(s)) : 0; }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+    virtual int availableForWrite() { return 1024; }
+    virtual void flush() {}
+
+    size_t print(const char *s) { return write(s); }
+    size_t print(const String &s) { return write(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(int v, int base = DEC) { return print((long)v, base); }
+    size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(long v, int base = DEC) { if (base == DEC) return printf("%ld", v); return print((unsigned long)v, base); }
+    size_t print(unsigned long v, int base = DEC) {
+      char b[66]; int i = 64; b[65] = 0; if (base < 2) base = 10;
+      do { int d = v % base; b[i--] = d < 10 ? '0' + d : 'A' + d - 10; v /= base; } while (v && i >= 0);
+      return write(&b[i + 1]);
+    }
+    size_t print(long long v) { return printf("%lld", v); }
+    size_t print(unsigned long long v) { return printf("%llu", v); }
+    size_t print(double v, int digits = 2) { return printf("%.*f", digits, v); }
+    size_t println() { return write("\r\n"); }
+    template <typename T> size_t println(const T &v) { size_t n = print(v); return n + println(); }
+    template <typename T> size_t println(const T &v, int f) { size_t n = print(v, f); return n + println(); }
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+      char b[512]; va_list args; va_start(args, format); int n = vsnprintf(b, sizeof(b), format, args); va_end(args);
+      if (n < 0) return 0;
+      return write((const uint8_t *)b, strlen(b));
+    }
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    void setTimeout(unsigned long ms) { timeout = ms; }
+    size_t readBytes(char *buffer, size_t length) { size_t n = 0; while (n < length) { int c = timedRead(); if (c < 0) break; buffer[n++] = c; } return n; }
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+    size_t readBytesUntil(char terminator, char *buffer, size_t length) { size_t n = 0; while (n < length) { int c = timedRead(); if (c < 0 || c == terminator) break; buffer[n++] = c; } return n; }
+    String readStringUntil(char terminator) { String s; int c; while ((c = timedRead()) >= 0 && c != terminator) s += (char)c; return s; }
+  protected:
+    int timedRead() { return available() ? read() : -1; }
+    unsigned long timeout = 1000;
+};
+
+// a serial port with a receive queue a test can feed and a transmit log it can inspect
+class HardwareSerial : public Stream {
+  public:
+    void begin(unsigned long baud, int config = 0) { this->baud = baud; (void)config; }
+    void end() {}
+    int available() override { return (int)rx.size(); }
+    int read() override { if (rx.empty()) return -1; int c = rx.front(); rx.pop_front(); return c; }
+    int peek() override { return rx.empty() ? -1 : rx.front(); }
+    size_t write(uint8_t c) override { writes++; put(c); return 1; }
+    size_t write(const uint8_t *buffer, size_t size) override { writes++; for (size_t i = 0; i < size; i++) put(buffer[i]); return size; }
+    using Print::write;
+    operator bool() { return true; }
+    void transmitterEnable(int pin) { (void)pin; }
+    void setRX(int pin) { (void)pin; }
+    void setTX(int pin) { (void)pin; }
+    void addMemoryForRead(void *buffer, size_t size) { (void)buffer; (void)size; }
+    void addMemoryForWrite(void *buffer, size_t size) { (void)buffer; (void)size; }
+
+    // test side
+    void inject(const char *s) { while (*s) rx.push_back((uint8_t)*s++); }
+    void inject(const uint8_t *s, size_t n) { while (n--) rx.push_back(*s++); }
+    std::string tx;
+    std::deque<uint8_t> rx;
+    uint32_t writes = 0;         // write() calls, a buffer counts once
+    bool echo = false;
+    unsigned long baud = 0;
+
+  private:
+    void put(uint8_t c) { if (echo) fputc(c, stdout); tx += (char)c; }
+};
+typedef HardwareSerial usb_serial_class;
+
+inline HardwareSerial Serial, Serial1, Serial2, Serial3, Serial4, Serial5, Serial6, Serial7, Serial8, SerialUSB1, SerialUSB2;
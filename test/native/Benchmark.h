@@ -0,0 +1,161 @@
+// -----------------------------------------------------------------------------------
+// minimal Google Benchmark style harness for the native benchmarks
+//
+//   static void BM_something(benchmark::State &state) {
+//     setup...
+//     for (auto _ : state) { work... }
+//     state.SetItemsProcessed(state.iterations()*n);
+//   }
+//   BENCHMARK(BM_something)->Arg(8)->Arg(64);
+//
+// benchmark::RunSpecifiedBenchmarks() runs each until it has taken about MinTime seconds and
+// prints a table like Google Benchmark's; runs in real (host) time whatever nativeClock is doing
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+
+  template <class T> inline void DoNotOptimize(T const &value) { asm volatile("" : : "r,m"(value) : "memory"); }
+  template <class T> inline void DoNotOptimize(T &value) { asm volatile("" : "+r,m"(value) : : "memory"); }
+  inline void ClobberMemory() { asm volatile("" : : : "memory"); }
+
+  class State {
+    public:
+      State(uint64_t iterations, const std::vector<int64_t> &args) : maxIterations(iterations), args(args) {}
+
+      struct Iterator {
+        State *state; uint64_t left;
+        bool operator!=(const Iterator &) const {
+          if (left) return true;
+          state->finish();
+          return false;
+        }
+        void operator++() { left--; }
+        struct Value { ~Value() {} };  // non trivial so "for (auto _ : state)" is not an unused variable
+        Value operator*() const { return Value(); }
+      };
+      Iterator begin() { start(); return Iterator{ this, maxIterations }; }
+      Iterator end() { return Iterator{ this, 0 }; }
+      bool KeepRunning() {
+        if (!started) start();
+        if (done < maxIterations) { done++; return true; }
+        finish(); return false;
+      }
+
+      // time spent between PauseTiming() and ResumeTiming() is not counted
+      void PauseTiming() { pausedAt = clock::now(); }
+      void ResumeTiming() { paused += clock::now() - pausedAt; }
+
+      int64_t range(size_t i = 0) const { return i < args.size() ? args[i] : 0; }
+      uint64_t iterations() const { return maxIterations; }
+      void SetItemsProcessed(int64_t items) { itemsProcessed = items; }
+      void SetBytesProcessed(int64_t bytes) { bytesProcessed = bytes; }
+      void SetLabel(const std::string &text) { label = text; }
+      void SkipWithError(const char *message) { error = message; }
+
+      double seconds() const { return std::chrono::duration<double>(elapsed).count(); }
+      bool ran() const { return finished; }
+      int64_t itemsProcessed = 0;
+      int64_t bytesProcessed = 0;
+      std::string label;
+      const char *error = nullptr;
+
+    private:
+      typedef std::chrono::steady_clock clock;
+      void start() { started = true; paused = clock::duration::zero(); t0 = clock::now(); }
+      void finish() { if (!finished) { elapsed = clock::now() - t0 - paused; finished = true; } }
+      uint64_t maxIterations, done = 0;
+      std::vector<int64_t> args;
+      bool started = false, finished = false;
+      clock::time_point t0, pausedAt;
+      clock::duration paused, elapsed = clock::duration::zero();
+  };
+
+  typedef void (*Function)(State &);
+
+  class Benchmark {
+    public:
+      Benchmark(const char *name, Function fn) : name(name), fn(fn) {}
+      Benchmark *Arg(int64_t a) { args.push_back({ a }); return this; }
+      Benchmark *Args(const std::vector<int64_t> &a) { args.push_back(a); return this; }
+      Benchmark *Range(int64_t lo, int64_t hi) { for (int64_t a = lo; a < hi; a *= 8) Arg(a); return Arg(hi); }
+      Benchmark *Iterations(uint64_t n) { fixedIterations = n; return this; }
+      std::string name;
+      Function fn;
+      std::vector<std::vector<int64_t>> args;
+      uint64_t fixedIterations = 0;
+  };
+
+  inline std::vector<Benchmark *> &registered() { static std::vector<Benchmark *> list; return list; }
+  inline Benchmark *RegisterBenchmark(const char *name, Function fn) { registered().push_back(new Benchmark(name, fn)); return registered().back(); }
+
+  inline double MinTime = 0.2;
+
+  struct Result { std::string name; double nsPerIteration; uint64_t iterations; double itemsPerSecond; double bytesPerSecond; std::string label; };
+  inline std::vector<Result> &results() { static std::vector<Result> list; return list; }
+
+  inline void printRate(double perSecond, const char *unit) {
+    if (perSecond <= 0) return;
+    const char *prefix[] = { "", "k", "M", "G" }; int p = 0;
+    while (perSecond >= 1000.0 && p < 3) { perSecond /= 1000.0; p++; }
+    printf(" %8.2f %s%s/s", perSecond, prefix[p], unit);
+  }
+
+  // runs every registered benchmark, returns the number that reported an error
+  inline int RunSpecifiedBenchmarks() {
+    int errors = 0;
+    printf("%-48s %14s %12s\n", "Benchmark", "Time", "Iterations");
+    printf("--------------------------------------------------------------------------------\n");
+    for (Benchmark *b : registered()) {
+      std::vector<std::vector<int64_t>> argSets = b->args.empty() ? std::vector<std::vector<int64_t>>{ {} } : b->args;
+      for (auto &args : argSets) {
+        std::string name = b->name;
+        for (auto a : args) name += "/" + std::to_string(a);
+
+        uint64_t n = b->fixedIterations ? b->fixedIterations : 1;
+        State *state = nullptr;
+        for (;;) {
+          delete state;
+          state = new State(n, args);
+          b->fn(*state);
+          if (!state->error && !state->ran()) state->SkipWithError("the benchmark loop did not run");
+          if (state->error || b->fixedIterations || state->seconds() >= MinTime || n >= 1000000000ULL) break;
+          double scale = state->seconds() > 0 ? MinTime*1.4/state->seconds() : 100.0;
+          if (scale > 100.0) scale = 100.0;
+          n = (uint64_t)(n*scale) + 1;
+        }
+        if (state->error) {
+          printf("%-48s ERROR: %s\n", name.c_str(), state->error);
+          errors++;
+        } else {
+          Result r;
+          r.name = name;
+          r.iterations = n;
+          r.nsPerIteration = state->seconds()*1e9/n;
+          r.itemsPerSecond = state->itemsProcessed/state->seconds();
+          r.bytesPerSecond = state->bytesProcessed/state->seconds();
+          r.label = state->label;
+          results().push_back(r);
+          printf("%-48s %11.1f ns %12llu", name.c_str(), r.nsPerIteration, (unsigned long long)n);
+          printRate(r.itemsPerSecond, "items");
+          printRate(r.bytesPerSecond, "B");
+          if (!r.label.empty()) printf(" %s", r.label.c_str());
+          printf("\n");
+        }
+        delete state;
+      }
+    }
+    fflush(stdout);
+    return errors;
+  }
+
+}
+
+#define BENCHMARK_CONCAT2(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT2(a, b)
+#define BENCHMARK(fn) static benchmark::Benchmark *BENCHMARK_CONCAT(_benchmark_, __LINE__) __attribute__((unused)) = benchmark::RegisterBenchmark(#fn, fn)
@@ -0,0 +1,21 @@
+// -----------------------------------------------------------------------------------
+// EEPROM stand-in for the native (host) build, 4KB like the Teensy 4.1
+#pragma once
+
+#include "Arduino.h"
+
+#define E2END 0xFFF
+
+class EEPROMClass {
+  public:
+    uint8_t read(int i) { return data[i & E2END]; }
+    void write(int i, uint8_t v) { data[i & E2END] = v; writes++; }
+    void update(int i, uint8_t v) { if (data[i & E2END] != v) write(i, v); }
+    uint16_t length() { return E2END + 1; }
+
+    // test side
+    uint8_t data[E2END + 1];
+    unsigned long writes = 0;
+};
+
+inline EEPROMClass EEPROM;
@@ -0,0 +1,61 @@
+// -----------------------------------------------------------------------------------
+// FlexCAN_T4 stand-in for the native (host) build, a mock bus shared by every controller
+#pragma once
+
+#include "Arduino.h"
+
+typedef struct CAN_message_t {
+  uint32_t id = 0;
+  uint16_t timestamp = 0;
+  uint8_t idhit = 0;
+  struct {
+    bool extended = 0;
+    bool remote = 0;
+    bool overrun = 0;
+    bool reserved = 0;
+  } flags;
+  uint8_t len = 8;
+  uint8_t buf[8] = { 0 };
+  int8_t mb = 0;
+  uint8_t bus = 0;
+  bool seq = 0;
+} CAN_message_t;
+
+// frames the firmware writes collect in tx, frames a test puts in rx are what the firmware reads;
+// txMailboxes limits how many writes are accepted before a test drains tx (like full TX mailboxes)
+struct NativeCanBus {
+  std::deque<CAN_message_t> tx;
+  std::deque<CAN_message_t> rx;
+  int txMailboxes = 16;
+  unsigned long writes = 0;
+  unsigned long rejected = 0;
+  void reset() { tx.clear(); rx.clear(); txMailboxes = 16; writes = 0; rejected = 0; }
+};
+inline NativeCanBus nativeCan;
+
+enum CAN_DEV_TABLE { CAN1, CAN2, CAN3 };
+enum FLEXCAN_RXQUEUE_TABLE { RX_SIZE_2 = 2, RX_SIZE_4 = 4, RX_SIZE_8 = 8, RX_SIZE_16 = 16, RX_SIZE_32 = 32, RX_SIZE_64 = 64, RX_SIZE_128 = 128, RX_SIZE_256 = 256, RX_SIZE_512 = 512, RX_SIZE_1024 = 1024 };
+enum FLEXCAN_TXQUEUE_TABLE { TX_SIZE_2 = 2, TX_SIZE_4 = 4, TX_SIZE_8 = 8, TX_SIZE_16 = 16, TX_SIZE_32 = 32, TX_SIZE_64 = 64, TX_SIZE_128 = 128, TX_SIZE_256 = 256, TX_SIZE_512 = 512, TX_SIZE_1024 = 1024 };
+
+template <CAN_DEV_TABLE _bus, FLEXCAN_RXQUEUE_TABLE _rxSize = RX_SIZE_16, FLEXCAN_TXQUEUE_TABLE _txSize = TX_SIZE_16>
+class FlexCAN_T4 {
+  public:
+    void begin() {}
+    void setBaudRate(uint32_t baud) { (void)baud; }
+    void setMaxMB(uint8_t n) { (void)n; }
+    void enableFIFO(bool state = 1) { (void)state; }
+    void enableFIFOInterrupt(bool state = 1) { (void)state; }
+    void mailboxStatus() {}
+    int write(const CAN_message_t &msg) {
+      if ((int)nativeCan.tx.size() >= nativeCan.txMailboxes) { nativeCan.rejected++; return 0; }
+      nativeCan.tx.push_back(msg);
+      nativeCan.writes++;
+      return 1;
+    }
+    int read(CAN_message_t &msg) {
+      if (nativeCan.rx.empty()) return 0;
+      msg = nativeCan.rx.front();
+      nativeCan.rx.pop_front();
+      return 1;
+    }
+};
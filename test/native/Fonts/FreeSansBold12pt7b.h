@@ -0,0 +1,9 @@
+// -----------------------------------------------------------------------------------
+// native build placeholder for the Adafruit GFX library font of the same name
+#pragma once
+
+#include "NativeFont.h"
+
+static const GFXglyph FreeSansBold12pt7bGlyphs[] = { NATIVE_GLYPHS95(12, 17, 15) };
+
+static const GFXfont FreeSansBold12pt7b = { (uint8_t *)NativeFontBitmaps, (GFXglyph *)FreeSansBold12pt7bGlyphs, 0x20, 0x7E, 29 };
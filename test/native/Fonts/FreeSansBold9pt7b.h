@@ -0,0 +1,9 @@
+// -----------------------------------------------------------------------------------
+// native build placeholder for the Adafruit GFX library font of the same name
+#pragma once
+
+#include "NativeFont.h"
+
+static const GFXglyph FreeSansBold9pt7bGlyphs[] = { NATIVE_GLYPHS95(9, 13, 11) };
+
+static const GFXfont FreeSansBold9pt7b = { (uint8_t *)NativeFontBitmaps, (GFXglyph *)FreeSansBold9pt7bGlyphs, 0x20, 0x7E, 22 };
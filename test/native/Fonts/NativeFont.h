@@ -0,0 +1,19 @@
+// -----------------------------------------------------------------------------------
+// placeholder for the Adafruit GFX library fonts in the native build, every printable
+// character is a solid box with roughly the metrics of the font it stands in for
+#pragma once
+
+#include <gfxfont.h>
+
+#define NATIVE_GLYPH(w, h, adv) { 0, w, h, adv, 1, (int8_t)-(h) }
+#define NATIVE_GLYPHS5(w, h, adv) NATIVE_GLYPH(w, h, adv), NATIVE_GLYPH(w, h, adv), NATIVE_GLYPH(w, h, adv), NATIVE_GLYPH(w, h, adv), NATIVE_GLYPH(w, h, adv)
+#define NATIVE_GLYPHS95(w, h, adv) NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv), \
+  NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv), \
+  NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv), \
+  NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv), NATIVE_GLYPHS5(w, h, adv)
+
+// enough set bits for the largest box
+static const uint8_t NativeFontBitmaps[] = {
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
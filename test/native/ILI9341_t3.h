@@ -0,0 +1,5 @@
+// -----------------------------------------------------------------------------------
+// ILI9341_t3 stand-in for the native build, the ILI9486 driver only includes it
+#pragma once
+
+#include <Arduino.h>
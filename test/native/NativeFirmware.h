@@ -0,0 +1,24 @@
+// -----------------------------------------------------------------------------------
+// brings the whole firmware up on the host, for tests that need the mount, site, catalogs, etc.
+// the clock is held so setup() runs its delays instantly and the results repeat run to run
+#pragma once
+
+#include <Arduino.h>
+
+extern void setup();
+extern void loop();
+
+inline bool nativeFirmwareStarted = false;
+
+inline void nativeFirmwareBegin() {
+  if (nativeFirmwareStarted) return;
+  nativeFirmwareStarted = true;
+  nativeClock.hold();
+  setup();
+}
+
+// runs the task loop for ms of (held) time
+inline void nativeFirmwareRun(unsigned long ms) {
+  unsigned long t0 = millis();
+  while (millis() - t0 < ms) loop();
+}
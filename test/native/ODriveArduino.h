@@ -0,0 +1,6 @@
+// -----------------------------------------------------------------------------------
+// ODriveArduino stand-in for the native build, the sources only use its enums
+#pragma once
+
+#include <Arduino.h>
+#include <ODriveEnums.h>
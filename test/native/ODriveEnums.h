@@ -0,0 +1,94 @@
+// -----------------------------------------------------------------------------------
+// ODriveEnums stand-in for the native (host) build, the subset of the ODrive v0.5 enums the firmware uses
+#pragma once
+
+enum ODriveError {
+  ODRIVE_ERROR_NONE                        = 0x00000000,
+  ODRIVE_ERROR_CONTROL_ITERATION_MISSED    = 0x00000001,
+  ODRIVE_ERROR_DC_BUS_UNDER_VOLTAGE        = 0x00000002,
+  ODRIVE_ERROR_DC_BUS_OVER_VOLTAGE         = 0x00000004,
+  ODRIVE_ERROR_DC_BUS_OVER_REGEN_CURRENT   = 0x00000008,
+  ODRIVE_ERROR_DC_BUS_OVER_CURRENT         = 0x00000010,
+  ODRIVE_ERROR_BRAKE_DEADTIME_VIOLATION    = 0x00000020,
+  ODRIVE_ERROR_BRAKE_DUTY_CYCLE_NAN        = 0x00000040,
+  ODRIVE_ERROR_INVALID_BRAKE_RESISTANCE    = 0x00000080,
+};
+
+enum AxisState {
+  AXIS_STATE_UNDEFINED                     = 0,
+  AXIS_STATE_IDLE                          = 1,
+  AXIS_STATE_STARTUP_SEQUENCE              = 2,
+  AXIS_STATE_FULL_CALIBRATION_SEQUENCE     = 3,
+  AXIS_STATE_MOTOR_CALIBRATION             = 4,
+  AXIS_STATE_ENCODER_INDEX_SEARCH          = 6,
+  AXIS_STATE_ENCODER_OFFSET_CALIBRATION    = 7,
+  AXIS_STATE_CLOSED_LOOP_CONTROL           = 8,
+};
+
+enum AxisError {
+  AXIS_ERROR_NONE                          = 0x00000000,
+  AXIS_ERROR_INVALID_STATE                 = 0x00000001,
+  AXIS_ERROR_WATCHDOG_TIMER_EXPIRED        = 0x00000800,
+  AXIS_ERROR_MIN_ENDSTOP_PRESSED           = 0x00001000,
+  AXIS_ERROR_MAX_ENDSTOP_PRESSED           = 0x00002000,
+  AXIS_ERROR_ESTOP_REQUESTED               = 0x00004000,
+  AXIS_ERROR_HOMING_WITHOUT_ENDSTOP        = 0x00020000,
+  AXIS_ERROR_OVER_TEMP                     = 0x00040000,
+  AXIS_ERROR_UNKNOWN_POSITION              = 0x00080000,
+};
+
+enum MotorError : uint64_t {
+  MOTOR_ERROR_NONE                         = 0x000000000,
+  MOTOR_ERROR_PHASE_RESISTANCE_OUT_OF_RANGE = 0x000000001,
+  MOTOR_ERROR_PHASE_INDUCTANCE_OUT_OF_RANGE = 0x000000002,
+  MOTOR_ERROR_DRV_FAULT                    = 0x000000008,
+  MOTOR_ERROR_CONTROL_DEADLINE_MISSED      = 0x000000010,
+  MOTOR_ERROR_MODULATION_MAGNITUDE         = 0x000000080,
+  MOTOR_ERROR_CURRENT_SENSE_SATURATION     = 0x000000400,
+  MOTOR_ERROR_CURRENT_LIMIT_VIOLATION      = 0x000001000,
+  MOTOR_ERROR_MODULATION_IS_NAN            = 0x000010000,
+  MOTOR_ERROR_MOTOR_THERMISTOR_OVER_TEMP   = 0x000020000,
+  MOTOR_ERROR_FET_THERMISTOR_OVER_TEMP     = 0x000040000,
+  MOTOR_ERROR_TIMER_UPDATE_MISSED          = 0x000080000,
+  MOTOR_ERROR_CURRENT_MEASUREMENT_UNAVAILABLE = 0x000100000,
+  MOTOR_ERROR_CONTROLLER_FAILED            = 0x000200000,
+  MOTOR_ERROR_I_BUS_OUT_OF_RANGE           = 0x000400000,
+  MOTOR_ERROR_BRAKE_RESISTOR_DISARMED      = 0x000800000,
+  MOTOR_ERROR_SYSTEM_LEVEL                 = 0x001000000,
+  MOTOR_ERROR_BAD_TIMING                   = 0x002000000,
+  MOTOR_ERROR_UNKNOWN_PHASE_ESTIMATE       = 0x004000000,
+  MOTOR_ERROR_UNKNOWN_PHASE_VEL            = 0x008000000,
+  MOTOR_ERROR_UNKNOWN_TORQUE               = 0x010000000,
+  MOTOR_ERROR_UNKNOWN_CURRENT_COMMAND      = 0x020000000,
+  MOTOR_ERROR_UNKNOWN_CURRENT_MEASUREMENT  = 0x040000000,
+  MOTOR_ERROR_UNKNOWN_VBUS_VOLTAGE         = 0x080000000,
+  MOTOR_ERROR_UNKNOWN_VOLTAGE_COMMAND      = 0x100000000,
+  MOTOR_ERROR_UNKNOWN_GAINS                = 0x200000000,
+  MOTOR_ERROR_CONTROLLER_INITIALIZING      = 0x400000000,
+  MOTOR_ERROR_UNBALANCED_PHASES            = 0x800000000,
+};
+
+enum EncoderError {
+  ENCODER_ERROR_NONE                       = 0x00000000,
+  ENCODER_ERROR_UNSTABLE_GAIN              = 0x00000001,
+  ENCODER_ERROR_CPR_POLEPAIRS_MISMATCH     = 0x00000002,
+  ENCODER_ERROR_NO_RESPONSE                = 0x00000004,
+  ENCODER_ERROR_UNSUPPORTED_ENCODER_MODE   = 0x00000008,
+  ENCODER_ERROR_ILLEGAL_HALL_STATE         = 0x00000010,
+  ENCODER_ERROR_INDEX_NOT_FOUND_YET        = 0x00000020,
+  ENCODER_ERROR_ABS_SPI_TIMEOUT            = 0x00000040,
+  ENCODER_ERROR_ABS_SPI_COM_FAIL           = 0x00000080,
+  ENCODER_ERROR_ABS_SPI_NOT_READY          = 0x00000100,
+};
+
+enum ControllerError {
+  CONTROLLER_ERROR_NONE                    = 0x00000000,
+  CONTROLLER_ERROR_OVERSPEED               = 0x00000001,
+  CONTROLLER_ERROR_INVALID_INPUT_MODE      = 0x00000002,
+  CONTROLLER_ERROR_UNSTABLE_GAIN           = 0x00000004,
+  CONTROLLER_ERROR_INVALID_MIRROR_AXIS     = 0x00000008,
+  CONTROLLER_ERROR_INVALID_LOAD_ENCODER    = 0x00000010,
+  CONTROLLER_ERROR_INVALID_ESTIMATE        = 0x00000020,
+  CONTROLLER_ERROR_INVALID_CIRCULAR_RANGE  = 0x00000040,
+  CONTROLLER_ERROR_SPINOUT_DETECTED        = 0x00000080,
+};
@@ -0,0 +1,93 @@
+// -----------------------------------------------------------------------------------
+// SD stand-in for the native build, files live in memory and a test can preload them
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <vector>
+
+#define BUILTIN_SDCARD 254
+#define O_READ 0x01
+#define O_WRITE 0x02
+#define O_RDWR (O_READ | O_WRITE)
+#define O_CREAT 0x10
+#define O_APPEND 0x20
+#define FILE_READ O_READ
+#define FILE_WRITE (O_RDWR | O_CREAT | O_APPEND)
+
+typedef std::shared_ptr<std::vector<uint8_t>> NativeFileData;
+
+class File : public Stream {
+  public:
+    File() {}
+    File(NativeFileData data, bool append) : data(data) { if (append) pos = data->size(); }
+    operator bool() const { return (bool)data; }
+    bool operator==(int v) const { return v == 0 ? !data : (bool)data; }
+
+    int available() override { return data ? (int)(data->size() - pos) : 0; }
+    int read() override { return available() > 0 ? (*data)[pos++] : -1; }
+    int peek() override { return available() > 0 ? (*data)[pos] : -1; }
+    int read(void *buf, size_t count) {
+      if (!data) return -1;
+      size_t n = min(count, data->size() - pos);
+      memcpy(buf, data->data() + pos, n);
+      pos += n;
+      return (int)n;
+    }
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buf, size_t count) override {
+      if (!data) return 0;
+      if (pos + count > data->size()) data->resize(pos + count);
+      memcpy(data->data() + pos, buf, count);
+      pos += count;
+      return count;
+    }
+    using Print::write;
+    bool seek(uint64_t position) { if (!data || position > data->size()) return false; pos = position; return true; }
+    uint64_t position() { return pos; }
+    uint64_t size() { return data ? data->size() : 0; }
+    void close() { data.reset(); pos = 0; }
+
+  private:
+    NativeFileData data;
+    size_t pos = 0;
+};
+
+class SDClass {
+  public:
+    bool begin(uint8_t csPin = BUILTIN_SDCARD) { (void)csPin; return present; }
+    File open(const char *path, uint8_t mode = FILE_READ) {
+      std::string name = normalize(path);
+      auto f = files.find(name);
+      if (f == files.end()) {
+        if (!(mode & O_CREAT)) return File();
+        f = files.emplace(name, std::make_shared<std::vector<uint8_t>>()).first;
+      }
+      return File(f->second, mode & O_APPEND);
+    }
+    bool exists(const char *path) { return files.count(normalize(path)) > 0; }
+    bool remove(const char *path) { return files.erase(normalize(path)) > 0; }
+
+    // test side, add a file from memory or from the host file system
+    void addFile(const char *path, const void *bytes, size_t count) {
+      files[normalize(path)] = std::make_shared<std::vector<uint8_t>>((const uint8_t *)bytes, (const uint8_t *)bytes + count);
+    }
+    bool addHostFile(const char *path, const char *hostPath) {
+      FILE *fp = fopen(hostPath, "rb");
+      if (!fp) return false;
+      std::vector<uint8_t> bytes;
+      uint8_t b[4096]; size_t n;
+      while ((n = fread(b, 1, sizeof(b), fp)) > 0) bytes.insert(bytes.end(), b, b + n);
+      fclose(fp);
+      addFile(path, bytes.data(), bytes.size());
+      return true;
+    }
+    bool present = true;
+    std::map<std::string, NativeFileData> files;
+
+  private:
+    static std::string normalize(const char *path) { return path[0] == '/' ? std::string(path + 1) : std::string(path); }
+};
+
+inline SDClass SD;
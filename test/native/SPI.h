@@ -0,0 +1,63 @@
+// -----------------------------------------------------------------------------------
+// SPI stand-in for the native build, counts what would go out on the bus
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+#define MSBFIRST 1
+#define LSBFIRST 0
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+#define SPI_HAS_TRANSACTION 1
+
+class SPISettings {
+  public:
+    SPISettings() {}
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+    uint32_t clock = 4000000;
+    uint8_t bitOrder = MSBFIRST;
+    uint8_t dataMode = SPI_MODE0;
+};
+
+class SPIClass {
+  public:
+    void begin() {}
+    void end() {}
+    void setMOSI(uint8_t pin) { (void)pin; }
+    void setMISO(uint8_t pin) { (void)pin; }
+    void setSCK(uint8_t pin) { (void)pin; }
+    void usingInterrupt(uint8_t irq) { (void)irq; }
+    void beginTransaction(SPISettings settings) { this->settings = settings; transactions++; }
+    void endTransaction() {}
+
+    uint8_t transfer(uint8_t data) { record(&data, 1); return 0; }
+    uint16_t transfer16(uint16_t data) { uint8_t b[2] = { (uint8_t)(data >> 8), (uint8_t)data }; record(b, 2); return 0; }
+    void transfer(void *buf, size_t count) { record((const uint8_t *)buf, count); if (buf) memset(buf, 0, count); }
+    // Teensy form, separate transmit and receive buffers, either may be nullptr
+    void transfer(const void *txBuffer, void *rxBuffer, size_t count) {
+      record((const uint8_t *)txBuffer, count);
+      if (rxBuffer) memset(rxBuffer, 0, count);
+    }
+
+    // test side
+    void reset() { transactions = 0; calls = 0; bytes = 0; data.clear(); }
+    uint32_t transactions = 0;
+    uint32_t calls = 0;
+    uint64_t bytes = 0;
+    bool capture = false;        // when set every byte sent is kept in data
+    std::vector<uint8_t> data;
+    SPISettings settings;
+
+  private:
+    void record(const uint8_t *b, size_t count) {
+      calls++;
+      bytes += count;
+      if (!capture) return;
+      if (b) data.insert(data.end(), b, b + count); else data.insert(data.end(), count, 0);
+    }
+};
+
+inline SPIClass SPI, SPI1, SPI2;
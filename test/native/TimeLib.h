@@ -0,0 +1,34 @@
+// -----------------------------------------------------------------------------------
+// TimeLib stand-in for the native (host) build
+#pragma once
+
+#include "Arduino.h"
+#include <time.h>
+
+typedef time_t time_t;
+
+inline time_t nativeTimeBase = 0;
+inline unsigned long nativeTimeSetMs = 0;
+
+inline time_t now() { return nativeTimeBase + (millis() - nativeTimeSetMs)/1000; }
+inline void setTime(time_t t) { nativeTimeBase = t; nativeTimeSetMs = millis(); }
+inline void setTime(int hr, int min, int sec, int day, int month, int yr) {
+  struct tm tm = {};
+  tm.tm_year = yr - 1900; tm.tm_mon = month - 1; tm.tm_mday = day;
+  tm.tm_hour = hr; tm.tm_min = min; tm.tm_sec = sec;
+  setTime(timegm(&tm));
+}
+inline struct tm nativeTm(time_t t) { struct tm tm; gmtime_r(&t, &tm); return tm; }
+inline int year(time_t t) { return nativeTm(t).tm_year + 1900; }
+inline int month(time_t t) { return nativeTm(t).tm_mon + 1; }
+inline int day(time_t t) { return nativeTm(t).tm_mday; }
+inline int hour(time_t t) { return nativeTm(t).tm_hour; }
+inline int minute(time_t t) { return nativeTm(t).tm_min; }
+inline int second(time_t t) { return nativeTm(t).tm_sec; }
+inline int year() { return year(now()); }
+inline int month() { return month(now()); }
+inline int day() { return day(now()); }
+inline int hour() { return hour(now()); }
+inline int minute() { return minute(now()); }
+inline int second() { return second(now()); }
+inline void setSyncProvider(time_t (*provider)()) { (void)provider; }
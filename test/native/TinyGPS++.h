@@ -0,0 +1,15 @@
+// -----------------------------------------------------------------------------------
+// TinyGPSPlus stand-in for the native (host) build, never gets a fix
+#pragma once
+
+#include "Arduino.h"
+
+class TinyGPSPlus {
+  public:
+    struct { bool isValid() { return false; } double lat() { return 0.0; } double lng() { return 0.0; } } location;
+    struct { bool isValid() { return false; } uint16_t year() { return 2000; } uint8_t month() { return 1; } uint8_t day() { return 1; } } date;
+    struct { bool isValid() { return false; } uint8_t hour() { return 0; } uint8_t minute() { return 0; } uint8_t second() { return 0; } } time;
+    struct { bool isValid() { return false; } double meters() { return 0.0; } } altitude;
+    struct { bool isValid() { return false; } uint32_t value() { return 0; } } satellites;
+    bool encode(char c) { (void)c; return false; }
+};
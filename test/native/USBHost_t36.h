@@ -0,0 +1,16 @@
+// -----------------------------------------------------------------------------------
+// USB host stand-in for the native build, the ESP32 link is a serial port a test can feed
+#pragma once
+
+#include <Arduino.h>
+
+class USBHost {
+  public:
+    void begin() {}
+    void Task() {}
+};
+
+class USBSerial : public HardwareSerial {
+  public:
+    USBSerial(USBHost &host) { (void)host; }
+};
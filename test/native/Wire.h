@@ -0,0 +1,23 @@
+// -----------------------------------------------------------------------------------
+// I2C stand-in for the native (host) build, no devices answer
+#pragma once
+
+#include "Arduino.h"
+
+class TwoWire : public Stream {
+  public:
+    void begin() {}
+    void begin(uint8_t address) { (void)address; }
+    void end() {}
+    void setClock(uint32_t clock) { (void)clock; }
+    void beginTransmission(uint8_t address) { (void)address; }
+    uint8_t endTransmission(bool stop = true) { (void)stop; return 2; }
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t stop = true) { (void)address; (void)quantity; (void)stop; return 0; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    size_t write(uint8_t c) override { (void)c; return 1; }
+    using Print::write;
+};
+
+inline TwoWire Wire, Wire1, Wire2;
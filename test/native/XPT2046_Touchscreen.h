@@ -0,0 +1,28 @@
+// -----------------------------------------------------------------------------------
+// XPT2046 stand-in for the native build, a test can press the screen with touch()
+#pragma once
+
+#include <Arduino.h>
+
+class TS_Point {
+  public:
+    TS_Point() {}
+    TS_Point(int16_t x, int16_t y, int16_t z) : x(x), y(y), z(z) {}
+    int16_t x = 0, y = 0, z = 0;
+};
+
+class XPT2046_Touchscreen {
+  public:
+    XPT2046_Touchscreen(uint8_t csPin, uint8_t tirqPin = 255) { (void)csPin; (void)tirqPin; }
+    bool begin() { return true; }
+    void setRotation(uint8_t n) { (void)n; }
+    bool tirqTouched() { return pressed; }
+    bool touched() { return pressed; }
+    bool bufferEmpty() { return !pressed; }
+    TS_Point getPoint() { pressed = false; return point; }
+
+    // test side, raw coordinates like the controller reports them
+    void touch(int16_t x, int16_t y) { point = TS_Point(x, y, 1000); pressed = true; }
+    bool pressed = false;
+    TS_Point point;
+};
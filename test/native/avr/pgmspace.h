@@ -0,0 +1,7 @@
+// -----------------------------------------------------------------------------------
+// avr/pgmspace.h stand-in for the native build, C sources only need PROGMEM
+#pragma once
+
+#ifndef PROGMEM
+  #define PROGMEM
+#endif
@@ -0,0 +1,203 @@
+// -----------------------------------------------------------------------------------
+// Axis::autoGoto S-curve profile, a goto sampled at 100Hz ramps with its acceleration and jerk
+// held near the profile's, lands on the target and settles within a few seconds of the planned
+// time, also when the axis falls behind and the profile is planned again for the rest, and two
+// axes stretched to the same time arrive together
+//
+// pio test -e native_ramp runs the same gotos with AXIS_JERK_PERCENT OFF, the constant acceleration
+// ramp the profile replaced, test_ramp_comparison reports the settle time and peak acceleration
+// and jerk of both on the same lines
+
+#include <unity.h>
+
+#include "src/Common.h"
+#include "NativeFirmware.h"
+#include "src/telescope/mount/Mount.h"
+#include "src/telescope/mount/guide/Guide.h"
+
+// seconds past the planned time the axis may take, the crawl that finishes the move and
+// any profile planned again for the rest
+#define SETTLE_MAX 1.0
+
+// seconds apart two coordinated axes may arrive, each ends in its own minimum frequency crawl
+#define ARRIVAL_MAX 0.75
+
+// the velocity is averaged over this many 10ms samples before it's differentiated, the ODrive
+// axes move in 64 step chunks so the 10ms differences are noisy
+#define WINDOW 10
+
+// outside this the motor's minimum frequency and the end crawl set the motion, not the profile
+#define BODY_RATE 0.15      // degrees per second
+#define BODY_DISTANCE 0.05  // degrees
+
+static char message[240];
+
+static void waitForStop() {
+  for (int i = 0; i < 600000 && (axis1.isSlewing() || axis2.isSlewing()); i++) nativeFirmwareRun(1);
+}
+
+typedef struct {
+  double planned, took, error; // seconds, seconds, arc-seconds
+  double peakRate, peakAccel, peakJerk;
+} GotoResult;
+
+// a goto on axis1 at this rate and acceleration, in degrees
+static GotoResult slew(double degrees, float rate, float accel) {
+  GotoResult r;
+  memset(&r, 0, sizeof(r));
+  double start = axis1.getInstrumentCoordinate();
+  axis1.setSlewAccelerationRate(degToRadF(accel));
+  axis1.setTargetCoordinate(start + degToRad(degrees));
+  TEST_ASSERT_EQUAL(CE_NONE, axis1.autoGoto(degToRadF(rate*rate/(2.0F*accel)), degToRadF(rate)));
+  r.planned = axis1.getSlewTime(degToRadF(fabs(degrees)));
+
+  double sum = 0.0, lastRate = NAN, lastAccel = NAN;
+  bool body = true;
+  int n = 0;
+  while (axis1.isSlewing() && n < 600000) {
+    nativeFirmwareRun(10);
+    n++;
+    double v = radToDeg(fabs(axis1.getFrequency()));
+    if (v > r.peakRate) r.peakRate = v;
+    sum += v;
+    body = body && v > BODY_RATE && radToDeg(fabs(axis1.getTargetDistance())) > BODY_DISTANCE;
+    if (n % WINDOW != 0) continue;
+
+    double windowRate = sum/WINDOW;
+    double dt = WINDOW/100.0;
+    if (body) {
+      double a = (windowRate - lastRate)/dt;
+      if (!isnan(a) && fabs(a) > r.peakAccel) r.peakAccel = fabs(a);
+      double j = (a - lastAccel)/dt;
+      if (!isnan(j) && fabs(j) > r.peakJerk) r.peakJerk = fabs(j);
+      lastAccel = a;
+      lastRate = windowRate;
+    } else lastAccel = lastRate = NAN;
+    sum = 0.0;
+    body = true;
+  }
+  r.took = n/100.0;
+  r.error = radToDeg(axis1.getInstrumentCoordinate() - start - degToRad(degrees))*3600.0;
+
+  snprintf(message, sizeof(message), "%.0f deg at %.1f deg/s %.1f deg/s/s: planned %.2fs took %.2fs, peak rate %.2f accel %.3f jerk %.3f, error %.1f\"",
+           degrees, rate, accel, r.planned, r.took, r.peakRate, r.peakAccel, r.peakJerk, r.error);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_FALSE_MESSAGE(axis1.isSlewing(), message);
+  TEST_ASSERT_TRUE_MESSAGE(fabs(r.error) < 1.0, message);
+  TEST_ASSERT_TRUE_MESSAGE(r.took < r.planned + SETTLE_MAX, message);
+  return r;
+}
+
+void setUp() {
+  nativeFirmwareBegin();
+  guide.stop();
+  waitForStop();
+  mount.tracking(false);
+  mount.enable(true);
+  axis1.settings.limits.min = -Deg180;
+  axis1.settings.limits.max = Deg180;
+  axis2.settings.limits.min = -Deg180;
+  axis2.settings.limits.max = Deg180;
+}
+
+void tearDown() {}
+
+#if AXIS_JERK_PERCENT != OFF
+  // the profile's jerk, the acceleration over the share of the ramp time AXIS_JERK_PERCENT sets
+  static double profileJerk(double rate, double accel) { return accel/((rate/accel)*AXIS_JERK_PERCENT/100.0); }
+#endif
+
+// a constant acceleration ramp's corners would show as about accel/window = 4 deg/s^3, the
+// profile's jerk is 0.16 deg/s^3
+static void test_slow_gotos() {
+  const double distances[] = { 5.0, 30.0, -90.0 };
+  for (int i = 0; i < 3; i++) {
+    GotoResult r = slew(distances[i], 2.0F, 0.4F);
+    TEST_ASSERT_TRUE_MESSAGE(r.peakRate <= 2.0*1.01, message);
+    TEST_ASSERT_TRUE_MESSAGE(r.peakAccel <= 0.4*1.1, message);
+    #if AXIS_JERK_PERCENT != OFF
+      TEST_ASSERT_TRUE_MESSAGE(r.peakJerk <= profileJerk(2.0, 0.4)*1.25, message);
+    #endif
+  }
+}
+
+// too short to reach the slew rate, the stopping speed cap sets the end of the ramp down
+static void test_short_goto() {
+  GotoResult r = slew(1.0, 2.0F, 0.4F);
+  TEST_ASSERT_TRUE_MESSAGE(r.peakRate < 1.0, message);
+}
+
+static void test_fast_goto() {
+  GotoResult r = slew(60.0, 6.0F, 4.0F);
+  TEST_ASSERT_TRUE_MESSAGE(r.peakAccel <= 4.0*1.1, message);
+  #if AXIS_JERK_PERCENT != OFF
+    TEST_ASSERT_TRUE_MESSAGE(r.peakJerk <= profileJerk(6.0, 4.0)*1.25, message);
+  #endif
+}
+
+// both axes stretched to the longer profile the way Goto does, the short move must finish with the long one
+static void test_two_axis_arrival() {
+  #if AXIS_JERK_PERCENT != OFF
+    const double degrees1 = 80.0, degrees2 = -20.0;
+    double start1 = axis1.getInstrumentCoordinate();
+    double start2 = axis2.getInstrumentCoordinate();
+    axis1.setSlewAccelerationRate(degToRadF(1.0F));
+    axis2.setSlewAccelerationRate(degToRadF(1.0F));
+    axis1.setTargetCoordinate(start1 + degToRad(degrees1));
+    axis2.setTargetCoordinate(start2 + degToRad(degrees2));
+    TEST_ASSERT_EQUAL(CE_NONE, axis1.autoGoto(degToRadF(2.0F), degToRadF(2.0F)));
+    TEST_ASSERT_EQUAL(CE_NONE, axis2.autoGoto(degToRadF(2.0F), degToRadF(2.0F)));
+    double short2 = axis2.getAutoGotoTime();
+    float t = axis1.getAutoGotoTime();
+    if (axis2.getAutoGotoTime() > t) t = axis2.getAutoGotoTime();
+    axis1.setAutoGotoTime(t);
+    axis2.setAutoGotoTime(t);
+
+    double took1 = NAN, took2 = NAN;
+    int n = 0;
+    while ((axis1.isSlewing() || axis2.isSlewing()) && n < 600000) {
+      nativeFirmwareRun(10);
+      n++;
+      if (isnan(took1) && !axis1.isSlewing()) took1 = n/100.0;
+      if (isnan(took2) && !axis2.isSlewing()) took2 = n/100.0;
+    }
+    double error1 = radToDeg(axis1.getInstrumentCoordinate() - start1 - degToRad(degrees1))*3600.0;
+    double error2 = radToDeg(axis2.getInstrumentCoordinate() - start2 - degToRad(degrees2))*3600.0;
+
+    snprintf(message, sizeof(message), "%.0f and %.0f deg: axis2 alone %.2fs, stretched to %.2fs, axis1 took %.2fs axis2 %.2fs, error %.1f\" %.1f\"",
+             degrees1, degrees2, short2, t, took1, took2, error1, error2);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE_MESSAGE(fabs(error1) < 1.0 && fabs(error2) < 1.0, message);
+    TEST_ASSERT_TRUE_MESSAGE(fabs(took1 - took2) < ARRIVAL_MAX, message);
+    TEST_ASSERT_TRUE_MESSAGE(took1 < t + SETTLE_MAX && took2 < t + SETTLE_MAX, message);
+  #else
+    TEST_IGNORE_MESSAGE("the constant acceleration ramp has no time to stretch to");
+  #endif
+}
+
+// the same gotos in both builds, compare the lines with those from pio test -e native_ramp
+static void test_ramp_comparison() {
+  #if AXIS_JERK_PERCENT != OFF
+    const char *name = "S-curve";
+  #else
+    const char *name = "constant ramp";
+  #endif
+  const double distances[] = { 30.0, 90.0 };
+  char line[240];
+  for (int i = 0; i < 2; i++) {
+    GotoResult r = slew(distances[i], 2.0F, 0.4F);
+    snprintf(line, sizeof(line), "%s %.0f deg: took %.2fs, peak accel %.3f deg/s/s jerk %.3f deg/s/s/s", name, distances[i], r.took, r.peakAccel, r.peakJerk);
+    TEST_MESSAGE(line);
+  }
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_slow_gotos);
+  RUN_TEST(test_short_goto);
+  RUN_TEST(test_fast_goto);
+  RUN_TEST(test_two_axis_arrival);
+  RUN_TEST(test_ramp_comparison);
+  return UNITY_END();
+}
@@ -0,0 +1,90 @@
+// -----------------------------------------------------------------------------------
+// CanvasPrint field cache, an unchanged field is skipped but anything that clears it
+// (fillScreen, a fillRect or image over it) makes the next print draw it again
+
+#include <unity.h>
+
+#include "src/Common.h"
+#include "src/plugins/DDScope/display/Display.h"
+#include "src/plugins/DDScope/display/WifiDisplay.h"
+#include "src/plugins/DDScope/fonts/Inconsolata_Bold8pt7b.h"
+
+static CanvasPrint canvas(&Inconsolata_Bold8pt7b);
+
+static uint16_t pixel(int x, int y) {
+  const uint8_t *p = uncompressedBuffer + (y*SCREEN_WIDTH + x)*COLOR_DEPTH;
+  return (p[0] << 8) | p[1];
+}
+
+// true if every pixel of the box is the color
+static bool filled(int x, int y, int w, int h, uint16_t color) {
+  for (int r = y; r < y + h; r++) for (int c = x; c < x + w; c++) if (pixel(c, r) != color) return false;
+  return true;
+}
+
+void setUp() {
+  tft.setOverwriteCallback(CanvasPrint::invalidate);
+  wifiDisplay.enableScreenCapture(true);
+  tft.fillScreen(pgBackground);
+}
+
+void tearDown() {
+  wifiDisplay.enableScreenCapture(false);
+}
+
+// a field's box, printLJ at (20, 100) 120x16 draws from y - 10 for custom fonts
+#define FX 20
+#define FY 100
+#define FW 120
+#define FH 16
+#define FTOP (FY - 10)
+
+static void test_unchanged_field_is_skipped() {
+  canvas.printLJ(FX, FY, FW, FH, "RA 12:34:56", false);
+  TEST_ASSERT_FALSE(filled(FX, FTOP, FW, FH, pgBackground));
+  wifiDisplay.clearDirty();
+  canvas.printLJ(FX, FY, FW, FH, "RA 12:34:56", false);
+  TEST_ASSERT_EQUAL(0, wifiDisplay.dirtyCount());
+}
+
+static void test_fill_rect_redraws_field() {
+  canvas.printLJ(FX, FY, FW, FH, "RA 12:34:56", false);
+  tft.fillRect(2, 60, 317, 353, pgBackground); // like a catalog page clearing its lower screen
+  TEST_ASSERT_TRUE(filled(FX, FTOP, FW, FH, pgBackground));
+  canvas.printLJ(FX, FY, FW, FH, "RA 12:34:56", false);
+  TEST_ASSERT_FALSE(filled(FX, FTOP, FW, FH, pgBackground));
+}
+
+static void test_partial_overlap_redraws_field() {
+  canvas.printLJ(FX, FY, FW, FH, "DEC +45*30", false);
+  tft.fillRect(FX + FW - 4, FTOP + FH - 4, 20, 20, butOnBackground);
+  canvas.printLJ(FX, FY, FW, FH, "DEC +45*30", false);
+  TEST_ASSERT_TRUE(filled(FX + FW - 4, FTOP + FH - 4, 4, 4, butBackground));
+
+  // a fill next to the field leaves it cached
+  wifiDisplay.clearDirty();
+  tft.fillRect(FX, FTOP + FH, FW, 10, butBackground);
+  wifiDisplay.clearDirty();
+  canvas.printLJ(FX, FY, FW, FH, "DEC +45*30", false);
+  TEST_ASSERT_EQUAL(0, wifiDisplay.dirtyCount());
+}
+
+static void test_image_redraws_field() {
+  static uint16_t image[FW*FH];
+  for (int i = 0; i < FW*FH; i++) image[i] = pgBackground;
+  canvas.printLJ(FX, FY, FW, FH, "ALT 45.0", false);
+  tft.pushImage(FX, FTOP, FW, FH, image);
+  TEST_ASSERT_TRUE(filled(FX, FTOP, FW, FH, pgBackground));
+  canvas.printLJ(FX, FY, FW, FH, "ALT 45.0", false);
+  TEST_ASSERT_FALSE(filled(FX, FTOP, FW, FH, pgBackground));
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_unchanged_field_is_skipped);
+  RUN_TEST(test_fill_rect_redraws_field);
+  RUN_TEST(test_partial_overlap_redraws_field);
+  RUN_TEST(test_image_redraws_field);
+  return UNITY_END();
+}
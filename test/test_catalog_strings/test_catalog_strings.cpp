@@ -0,0 +1,351 @@
+// -----------------------------------------------------------------------------------
+// CatMgr name, subId and prefix strings for every record of every libCatalogs catalog, the
+// offset and rank tables must give the same strings as walking the records and the ';' joined
+// strings from the start each time, as the lookups did before the tables
+
+#include <unity.h>
+
+#include "src/Common.h"
+#include "src/plugins/DDScope/catalog/Catalog.h"
+#include "src/plugins/DDScope/catalog/CatalogTypes.h"
+
+// each catalog in its own namespace as the variants share names
+#define HEADER(name, num) const catalog_t header = {Cat_##name##_Title, Cat_##name##_Prefix, NUM_##num, Cat_##name, \
+                          Cat_##name##_Names, Cat_##name##_SubId, Cat_##name##_Type, 2000, 0};
+
+namespace stars {
+  #include "src/plugins/DDScope/libCatalogs/stars.h"
+  HEADER(Stars, STARS)
+}
+#undef Cat_Stars_Title
+#undef Cat_Stars_Prefix
+#undef NUM_STARS
+
+namespace stars_vc {
+  #include "src/plugins/DDScope/libCatalogs/stars_vc.h"
+  HEADER(Stars, STARS)
+}
+#undef Cat_Stars_Title
+#undef Cat_Stars_Prefix
+#undef NUM_STARS
+
+namespace stf {
+  #include "src/plugins/DDScope/libCatalogs/stf.h"
+  HEADER(STF, STF)
+}
+#undef Cat_STF_Title
+#undef Cat_STF_Prefix
+#undef NUM_STF
+
+namespace stf_c {
+  #include "src/plugins/DDScope/libCatalogs/stf_c.h"
+  HEADER(STF, STF)
+}
+#undef Cat_STF_Title
+#undef Cat_STF_Prefix
+#undef NUM_STF
+
+namespace stf_select_c {
+  #include "src/plugins/DDScope/libCatalogs/stf_select_c.h"
+  HEADER(STF, STF)
+}
+#undef Cat_STF_Title
+#undef Cat_STF_Prefix
+#undef NUM_STF
+
+namespace stt {
+  #include "src/plugins/DDScope/libCatalogs/stt.h"
+  HEADER(STT, STT)
+}
+#undef Cat_STT_Title
+#undef Cat_STT_Prefix
+#undef NUM_STT
+
+namespace stt_c {
+  #include "src/plugins/DDScope/libCatalogs/stt_c.h"
+  HEADER(STT, STT)
+}
+#undef Cat_STT_Title
+#undef Cat_STT_Prefix
+#undef NUM_STT
+
+namespace stt_select_c {
+  #include "src/plugins/DDScope/libCatalogs/stt_select_c.h"
+  HEADER(STT, STT)
+}
+#undef Cat_STT_Title
+#undef Cat_STT_Prefix
+#undef NUM_STT
+
+namespace gcvs {
+  #include "src/plugins/DDScope/libCatalogs/gcvs.h"
+  HEADER(GCVS, GCVS)
+}
+#undef Cat_GCVS_Title
+#undef Cat_GCVS_Prefix
+#undef NUM_GCVS
+
+namespace gcvs_select_c {
+  #include "src/plugins/DDScope/libCatalogs/gcvs_select_c.h"
+  HEADER(GCVS, GCVS)
+}
+#undef Cat_GCVS_Title
+#undef Cat_GCVS_Prefix
+#undef NUM_GCVS
+
+namespace carbon {
+  #include "src/plugins/DDScope/libCatalogs/carbon.h"
+  HEADER(Carbon, CARBON)
+}
+#undef Cat_Carbon_Title
+#undef Cat_Carbon_Prefix
+#undef NUM_CARBON
+
+namespace messier {
+  #include "src/plugins/DDScope/libCatalogs/messier.h"
+  HEADER(Messier, MESSIER)
+}
+#undef Cat_Messier_Title
+#undef Cat_Messier_Prefix
+#undef NUM_MESSIER
+
+namespace messier_c {
+  #include "src/plugins/DDScope/libCatalogs/messier_c.h"
+  HEADER(Messier, MESSIER)
+}
+#undef Cat_Messier_Title
+#undef Cat_Messier_Prefix
+#undef NUM_MESSIER
+
+namespace caldwell {
+  #include "src/plugins/DDScope/libCatalogs/caldwell.h"
+  HEADER(Caldwell, CALDWELL)
+}
+#undef Cat_Caldwell_Title
+#undef Cat_Caldwell_Prefix
+#undef NUM_CALDWELL
+
+namespace caldwell_c {
+  #include "src/plugins/DDScope/libCatalogs/caldwell_c.h"
+  HEADER(Caldwell, CALDWELL)
+}
+#undef Cat_Caldwell_Title
+#undef Cat_Caldwell_Prefix
+#undef NUM_CALDWELL
+
+namespace herschel {
+  #include "src/plugins/DDScope/libCatalogs/herschel.h"
+  HEADER(Herschel, HERSCHEL)
+}
+#undef Cat_Herschel_Title
+#undef Cat_Herschel_Prefix
+#undef NUM_HERSCHEL
+
+namespace herschel_c {
+  #include "src/plugins/DDScope/libCatalogs/herschel_c.h"
+  HEADER(Herschel, HERSCHEL)
+}
+#undef Cat_Herschel_Title
+#undef Cat_Herschel_Prefix
+#undef NUM_HERSCHEL
+
+namespace collinder {
+  #include "src/plugins/DDScope/libCatalogs/collinder.h"
+  HEADER(Collinder, COLLINDER)
+}
+#undef Cat_Collinder_Title
+#undef Cat_Collinder_Prefix
+#undef NUM_COLLINDER
+
+namespace collinder_vc {
+  #include "src/plugins/DDScope/libCatalogs/collinder_vc.h"
+  HEADER(Collinder, COLLINDER)
+}
+#undef Cat_Collinder_Title
+#undef Cat_Collinder_Prefix
+#undef NUM_COLLINDER
+
+namespace ngc {
+  #include "src/plugins/DDScope/libCatalogs/ngc.h"
+  HEADER(NGC, NGC)
+}
+#undef Cat_NGC_Title
+#undef Cat_NGC_Prefix
+#undef NUM_NGC
+
+namespace ngc_vc {
+  #include "src/plugins/DDScope/libCatalogs/ngc_vc.h"
+  HEADER(NGC, NGC)
+}
+#undef Cat_NGC_Title
+#undef Cat_NGC_Prefix
+#undef NUM_NGC
+
+namespace ngc_select_c {
+  #include "src/plugins/DDScope/libCatalogs/ngc_select_c.h"
+  HEADER(NGC, NGC)
+}
+#undef Cat_NGC_Title
+#undef Cat_NGC_Prefix
+#undef NUM_NGC
+
+namespace ic {
+  #include "src/plugins/DDScope/libCatalogs/ic.h"
+  HEADER(IC, IC)
+}
+#undef Cat_IC_Title
+#undef Cat_IC_Prefix
+#undef NUM_IC
+
+namespace ic_select_c {
+  #include "src/plugins/DDScope/libCatalogs/ic_select_c.h"
+  HEADER(IC, IC)
+}
+#undef Cat_IC_Title
+#undef Cat_IC_Prefix
+#undef NUM_IC
+
+typedef struct { const char *file; const catalog_t *header; } libCatalog_t;
+static const libCatalog_t libCatalogs[] = {
+  {"stars", &stars::header},
+  {"stars_vc", &stars_vc::header},
+  {"stf", &stf::header},
+  {"stf_c", &stf_c::header},
+  {"stf_select_c", &stf_select_c::header},
+  {"stt", &stt::header},
+  {"stt_c", &stt_c::header},
+  {"stt_select_c", &stt_select_c::header},
+  {"gcvs", &gcvs::header},
+  {"gcvs_select_c", &gcvs_select_c::header},
+  {"carbon", &carbon::header},
+  {"messier", &messier::header},
+  {"messier_c", &messier_c::header},
+  {"caldwell", &caldwell::header},
+  {"caldwell_c", &caldwell_c::header},
+  {"herschel", &herschel::header},
+  {"herschel_c", &herschel_c::header},
+  {"collinder", &collinder::header},
+  {"collinder_vc", &collinder_vc::header},
+  {"ngc", &ngc::header},
+  {"ngc_vc", &ngc_vc::header},
+  {"ngc_select_c", &ngc_select_c::header},
+  {"ic", &ic::header},
+  {"ic_select_c", &ic_select_c::header}
+};
+#define LIB_CATALOGS (int)(sizeof(libCatalogs)/sizeof(libCatalogs[0]))
+
+// the catalogs configured for this build, the test swaps its own into the first two slots
+extern catalog_t catalog[];
+
+static char message[160];
+
+// the element of a ';' joined string, found from the start of the string
+static const char *elementFromString(const char *data, long elementNum) {
+  static char result[40] = "";
+  long n = elementNum, len = strlen(data);
+  for (long i = 0; i < len; i++) {
+    if (n == 0) {
+      long k = 0;
+      for (long j = i; j < len && data[j] != ';'; j++) result[k++] = data[j];
+      result[k] = 0;
+      return result;
+    }
+    if (data[i] == ';') n--;
+  }
+  return "";
+}
+
+// the name or subId element for a record, counted over the records before it
+template <typename T> static long elementOf(const void *objects, long index, bool name) {
+  const T *records = (const T *)objects;
+  if (name ? !records[index].Has_name : !records[index].Has_subId) return -1;
+  long result = -1;
+  for (long i = 0; i <= index; i++) if (name ? records[i].Has_name : records[i].Has_subId) result++;
+  return result;
+}
+
+static long element(const catalog_t *c, long index, bool name) {
+  switch (c->CatalogType) {
+    case CAT_GEN_STAR:       return elementOf<gen_star_t>(c->Objects, index, name);
+    case CAT_GEN_STAR_VCOMP: return elementOf<gen_star_vcomp_t>(c->Objects, index, name);
+    case CAT_DBL_STAR:       return elementOf<dbl_star_t>(c->Objects, index, name);
+    case CAT_DBL_STAR_COMP:  return elementOf<dbl_star_comp_t>(c->Objects, index, name);
+    case CAT_VAR_STAR:       return elementOf<var_star_t>(c->Objects, index, name);
+    case CAT_VAR_STAR_COMP:  return elementOf<var_star_comp_t>(c->Objects, index, name);
+    case CAT_DSO:            return elementOf<dso_t>(c->Objects, index, name);
+    case CAT_DSO_COMP:       return elementOf<dso_comp_t>(c->Objects, index, name);
+    case CAT_DSO_VCOMP:      return elementOf<dso_vcomp_t>(c->Objects, index, name);
+    default:                 return -1;
+  }
+}
+
+// the prefix for a record with an array type prefix, as catalogPrefix() gives it
+static const char *prefix(const catalog_t *c, long primaryId) {
+  static char result[40];
+  if (!strstr(c->Prefix, ";")) return c->Prefix;
+  if (primaryId < 0) return "?";
+  strcpy(result, elementFromString(c->Prefix, primaryId));
+  if (strlen(result) > 0) return result;
+  snprintf(result, sizeof(result), "%s%ld", elementFromString(c->Prefix, 0), primaryId);
+  return result;
+}
+
+static void check(const char *what, const char *file, long index, const char *expected, const char *actual) {
+  snprintf(message, sizeof(message), "%s record %ld %s: expected '%s' was '%s'", file, index, what, expected, actual);
+  TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, actual, message);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_all_catalogs() {
+  static uint8_t saved[2*sizeof(catalog_t)];
+  memcpy(saved, (void *)catalog, sizeof(saved));
+
+  long records = 0, names = 0, subIds = 0;
+  char expected[40];
+  for (int k = 0; k < LIB_CATALOGS; k++) {
+    // alternate slots so the tables are rebuilt for each catalog
+    int slot = k % 2;
+    const catalog_t *c = libCatalogs[k].header;
+    memcpy((void *)&catalog[slot], c, sizeof(catalog_t));
+    cat_mgr.select(slot);
+    TEST_ASSERT_EQUAL(c->NumObjects - 1, cat_mgr.getMaxIndex());
+
+    for (long i = 0; i < c->NumObjects; i++) {
+      cat_mgr.setIndex(i);
+      TEST_ASSERT_EQUAL(i, cat_mgr.getIndex());
+
+      long name = element(c, i, true);
+      snprintf(message, sizeof(message), "%s record %ld name element", libCatalogs[k].file, i);
+      TEST_ASSERT_EQUAL_MESSAGE(name, cat_mgr.objectName(), message);
+      strcpy(expected, name >= 0 ? elementFromString(c->ObjectNames, name) : "");
+      check("name", libCatalogs[k].file, i, expected, cat_mgr.objectNameStr());
+      if (name >= 0) names++;
+
+      long subId = element(c, i, false);
+      snprintf(message, sizeof(message), "%s record %ld subId element", libCatalogs[k].file, i);
+      TEST_ASSERT_EQUAL_MESSAGE(subId, cat_mgr.subId(), message);
+      strcpy(expected, subId >= 0 ? elementFromString(c->ObjectSubIds, subId) : "");
+      check("subId", libCatalogs[k].file, i, expected, cat_mgr.subIdStr());
+      if (subId >= 0) subIds++;
+
+      strcpy(expected, prefix(c, cat_mgr.primaryId()));
+      check("prefix", libCatalogs[k].file, i, expected, cat_mgr.catalogPrefix());
+      records++;
+    }
+  }
+
+  memcpy((void *)catalog, saved, sizeof(saved));
+  cat_mgr.select(0);
+
+  snprintf(message, sizeof(message), "%d catalogs, %ld records, %ld names, %ld subIds", LIB_CATALOGS, records, names, subIds);
+  TEST_MESSAGE(message);
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_all_catalogs);
+  return UNITY_END();
+}
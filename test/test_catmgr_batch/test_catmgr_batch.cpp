@@ -0,0 +1,97 @@
+// -----------------------------------------------------------------------------------
+// CatMgr::EquToHorBatch, the single precision batch conversion catalog pages and match lists use
+// agrees with the double precision per-record alt() and azm() for every record of every catalog
+
+#include <unity.h>
+
+#include "src/Common.h"
+#include "src/plugins/DDScope/catalog/Catalog.h"
+
+// degrees, the batch converts in single precision
+#define ALT_TOLERANCE 0.001
+#define AZM_TOLERANCE 0.001
+
+static long indices[CAT_MATCH_CHUNK];
+static float batchAlt[CAT_MATCH_CHUNK];
+static float batchAzm[CAT_MATCH_CHUNK];
+static char message[160];
+
+void setUp() {
+  nativeClock.hold();
+  cat_mgr.filtersClear();
+}
+
+void tearDown() {}
+
+// worst difference from alt() and azm() over all records at one latitude and sidereal time
+static void compareAll(double latitude, double lst, double *altError, double *azmError, long *records) {
+  cat_mgr.setLat(latitude);
+  cat_mgr.setLstT0(lst);
+  for (int c = 0; c < cat_mgr.numCatalogs(); c++) {
+    cat_mgr.select(c);
+    long count = cat_mgr.getMaxIndex() + 1;
+    for (long first = 0; first < count; first += CAT_MATCH_CHUNK) {
+      int n = (int)min(count - first, (long)CAT_MATCH_CHUNK);
+      for (int i = 0; i < n; i++) indices[i] = first + i;
+      cat_mgr.setIndex(first);
+      cat_mgr.EquToHorBatch(indices, n, batchAlt, batchAzm);
+      TEST_ASSERT_EQUAL(first, cat_mgr.getIndex());
+
+      for (int i = 0; i < n; i++) {
+        cat_mgr.setIndex(indices[i]);
+        double alt = cat_mgr.alt();
+        double e = fabs(batchAlt[i] - alt);
+        snprintf(message, sizeof(message), "%s record %ld altitude %.5f batch %.5f", cat_mgr.catalogTitle(), indices[i], alt, batchAlt[i]);
+        TEST_ASSERT_TRUE_MESSAGE(e < ALT_TOLERANCE, message);
+        if (e > *altError) *altError = e;
+
+        // azimuth is undefined at the zenith
+        if (fabs(alt) > 89.0) continue;
+        double azm = cat_mgr.azm();
+        e = fabs(batchAzm[i] - azm);
+        if (e > 180.0) e = 360.0 - e;
+        snprintf(message, sizeof(message), "%s record %ld azimuth %.5f batch %.5f", cat_mgr.catalogTitle(), indices[i], azm, batchAzm[i]);
+        TEST_ASSERT_TRUE_MESSAGE(e < AZM_TOLERANCE, message);
+        TEST_ASSERT_TRUE_MESSAGE(batchAzm[i] >= 0.0F && batchAzm[i] < 360.0F, message);
+        if (e > *azmError) *azmError = e;
+      }
+      (*records) += n;
+    }
+  }
+}
+
+static void test_batch_matches_per_record() {
+  const double latitudes[] = { 40.0, -35.0, 0.0 };
+  const double lst[] = { 6.0, 20.5 };
+  double altError = 0.0, azmError = 0.0;
+  long records = 0;
+  for (int l = 0; l < 3; l++) {
+    for (int t = 0; t < 2; t++) compareAll(latitudes[l], lst[t], &altError, &azmError, &records);
+  }
+  snprintf(message, sizeof(message), "%ld records, largest difference %.6f deg in altitude %.6f deg in azimuth", records, altError, azmError);
+  TEST_MESSAGE(message);
+}
+
+// rows of a page in any order, azimuth is optional
+static void test_scattered_indices() {
+  cat_mgr.setLat(40.0);
+  cat_mgr.setLstT0(6.0);
+  cat_mgr.select(0);
+  long count = cat_mgr.getMaxIndex() + 1;
+  for (int i = 0; i < 16; i++) indices[i] = count - 1 - (i*37) % count;
+  cat_mgr.setIndex(5);
+  cat_mgr.EquToHorBatch(indices, 16, batchAlt, NULL);
+  TEST_ASSERT_EQUAL(5, cat_mgr.getIndex());
+  for (int i = 0; i < 16; i++) {
+    cat_mgr.setIndex(indices[i]);
+    TEST_ASSERT_FLOAT_WITHIN(ALT_TOLERANCE, cat_mgr.alt(), batchAlt[i]);
+  }
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_batch_matches_per_record);
+  RUN_TEST(test_scattered_indices);
+  return UNITY_END();
+}
@@ -0,0 +1,193 @@
+// -----------------------------------------------------------------------------------
+// CatMgr declination band x RA cell index, the FM_NEARBY, FM_ABOVE_HORIZON and FM_ALIGN_ALL_SKY
+// match lists built through the cell mask hold the same records as a per-record check of every
+// record, across the RA wrap, near the poles and at several latitudes and sidereal times
+
+#include <unity.h>
+
+#include "src/Common.h"
+#include "src/plugins/DDScope/catalog/Catalog.h"
+
+// records this close to the 10 degree altitude cut are left out of the comparison, the match list
+// converts altitude in single precision (see EquToHorBatch)
+#define ALT_BAND 0.01
+
+static double recordRa[CAT_INDEX_MAX_RECORDS];
+static double recordDec[CAT_INDEX_MAX_RECORDS];
+static double recordAlt[CAT_INDEX_MAX_RECORDS];
+static float recordMag[CAT_INDEX_MAX_RECORDS];
+static bool listed[CAT_INDEX_MAX_RECORDS];
+static char message[160];
+static long compared = 0;
+
+// every record of the selected catalog with the filters cleared
+static long readRecords() {
+  cat_mgr.filtersClear();
+  long records = cat_mgr.getMaxIndex() + 1;
+  for (long i = 0; i < records; i++) {
+    cat_mgr.setIndex(i);
+    recordRa[i] = cat_mgr.ra();
+    recordDec[i] = cat_mgr.dec();
+    recordAlt[i] = cat_mgr.alt();
+    recordMag[i] = cat_mgr.magnitude();
+  }
+  return records;
+}
+
+// the match list for the filters set, as a flag per record
+static long matchList(long records) {
+  while (!cat_mgr.matchListPoll()) {}
+  for (long i = 0; i < records; i++) listed[i] = false;
+  long count = cat_mgr.matchCount();
+  for (long n = 0; n < count; n++) {
+    TEST_ASSERT_TRUE(cat_mgr.setMatch(n));
+    listed[cat_mgr.getIndex()] = true;
+  }
+  return count;
+}
+
+static double distance(double ra1, double dec1, double ra2, double dec2) {
+  ra1 = degToRad(ra1); dec1 = degToRad(dec1); ra2 = degToRad(ra2); dec2 = degToRad(dec2);
+  return radToDeg(acos(sin(dec1)*sin(dec2) + cos(dec1)*cos(dec2)*cos(ra1 - ra2)));
+}
+
+// index selects the catalog, skips those too large to be indexed
+static bool selectIndexed(int c) {
+  cat_mgr.select(c);
+  return cat_mgr.getMaxIndex() + 1 <= CAT_INDEX_MAX_RECORDS;
+}
+
+void setUp() {
+  nativeClock.hold();
+  cat_mgr.setLat(40.0);
+  cat_mgr.setLstT0(6.0);
+}
+
+void tearDown() { cat_mgr.filtersClear(); }
+
+static void test_nearby() {
+  const double positions[][2] = { { 0.2, 0.0 }, { 359.8, 30.0 }, { 120.0, 89.5 }, { 250.0, -60.0 }, { 80.0, 45.0 }, { 180.0, -88.0 } };
+  const double radius[] = { 1.0, 5.0, 10.0, 15.0 };
+
+  for (int c = 0; c < cat_mgr.numCatalogs(); c++) {
+    if (!selectIndexed(c)) continue;
+    long records = readRecords();
+    for (unsigned p = 0; p < sizeof(positions)/sizeof(positions[0]); p++) {
+      for (int r = 0; r < 4; r++) {
+        cat_mgr.setLastTeleEqu(positions[p][0], positions[p][1]);
+        cat_mgr.select(c);
+        cat_mgr.filtersClear();
+        cat_mgr.filterAdd(FM_NEARBY, r);
+        matchList(records);
+        for (long i = 0; i < records; i++) {
+          bool expected = distance(recordRa[i], recordDec[i], positions[p][0], positions[p][1]) < radius[r];
+          snprintf(message, sizeof(message), "%s record %ld at %.3f %.3f, %.0f deg from %.1f %.1f",
+                   cat_mgr.catalogTitle(), i, recordRa[i], recordDec[i], radius[r], positions[p][0], positions[p][1]);
+          TEST_ASSERT_EQUAL_MESSAGE(expected, listed[i], message);
+          compared++;
+        }
+      }
+    }
+  }
+}
+
+static void altitudeFilter(int fm) {
+  const double latitudes[] = { 40.0, -35.0, 0.0, 89.0 };
+  const double lst[] = { 0.0, 6.5, 18.2, 23.99 };
+
+  for (int l = 0; l < 4; l++) {
+    for (int t = 0; t < 4; t++) {
+      cat_mgr.setLat(latitudes[l]);
+      cat_mgr.setLstT0(lst[t] == 0.0 ? 24.0 : lst[t]);
+      for (int c = 0; c < cat_mgr.numCatalogs(); c++) {
+        if (!selectIndexed(c)) continue;
+        long records = readRecords();
+        cat_mgr.filterAdd(fm);
+        matchList(records);
+        for (long i = 0; i < records; i++) {
+          if (fabs(recordAlt[i] - 10.0) < ALT_BAND) continue;
+          bool expected = recordAlt[i] >= 10.0;
+          if (fm == FM_ALIGN_ALL_SKY) expected = expected && recordMag[i] <= 3.0 && fabs(recordDec[i]) <= 80.0;
+          snprintf(message, sizeof(message), "%s record %ld at altitude %.3f, latitude %.0f LST %.2fh",
+                   cat_mgr.catalogTitle(), i, recordAlt[i], latitudes[l], lst[t]);
+          TEST_ASSERT_EQUAL_MESSAGE(expected, listed[i], message);
+          compared++;
+        }
+      }
+    }
+  }
+}
+
+static void test_above_horizon() { altitudeFilter(FM_ABOVE_HORIZON); }
+static void test_align_all_sky() { altitudeFilter(FM_ALIGN_ALL_SKY); }
+
+// the horizon mask follows the sidereal time, a filtered walk an hour after the mask was built
+// (no match list, as when paging a catalog before the list is ready) finds the records above
+// the horizon then
+static void test_lst_drift() {
+  for (int c = 0; c < cat_mgr.numCatalogs(); c++) {
+    if (!selectIndexed(c)) continue;
+    long records = readRecords();
+    cat_mgr.filterAdd(FM_ABOVE_HORIZON);
+    if (!cat_mgr.setIndex(0)) continue;
+
+    nativeClock.advance(3600UL*1000000UL);
+    for (long i = 0; i < records; i++) listed[i] = false;
+    cat_mgr.setIndex(0);
+    long first = cat_mgr.getIndex();
+    do { listed[cat_mgr.getIndex()] = true; } while (cat_mgr.incIndex() && cat_mgr.getIndex() != first);
+
+    for (long i = 0; i < records; i++) {
+      double alt, azm;
+      cat_mgr.EquToHor(recordRa[i], recordDec[i], &alt, &azm);
+      if (fabs(alt - 10.0) < ALT_BAND) continue;
+      snprintf(message, sizeof(message), "%s record %ld at altitude %.3f an hour on", cat_mgr.catalogTitle(), i, alt);
+      TEST_ASSERT_EQUAL_MESSAGE(alt >= 10.0, listed[i], message);
+      compared++;
+    }
+  }
+  snprintf(message, sizeof(message), "%ld records compared", compared);
+  TEST_MESSAGE(message);
+}
+
+// a horizon filtered match list goes stale as the sidereal time moves on, it isn't used then and
+// matchListPoll() rebuilds it for the new sky
+static void test_match_list_lst_drift() {
+  for (int c = 0; c < cat_mgr.numCatalogs(); c++) {
+    if (!selectIndexed(c)) continue;
+    long records = readRecords();
+    cat_mgr.filterAdd(FM_ABOVE_HORIZON);
+    matchList(records);
+    TEST_ASSERT_TRUE(cat_mgr.matchListReady());
+
+    // still good inside the margin
+    nativeClock.advance((unsigned long)(CAT_CELL_LST_MARGIN/15.0*0.9*3600.0*1000000.0));
+    TEST_ASSERT_TRUE(cat_mgr.matchListReady());
+
+    nativeClock.advance(3600UL*1000000UL);
+    TEST_ASSERT_FALSE(cat_mgr.matchListReady());
+    TEST_ASSERT_FALSE(cat_mgr.setMatch(0));
+    matchList(records);
+    TEST_ASSERT_TRUE(cat_mgr.matchListReady());
+
+    for (long i = 0; i < records; i++) {
+      double alt, azm;
+      cat_mgr.EquToHor(recordRa[i], recordDec[i], &alt, &azm);
+      if (fabs(alt - 10.0) < ALT_BAND) continue;
+      snprintf(message, sizeof(message), "%s record %ld at altitude %.3f an hour on", cat_mgr.catalogTitle(), i, alt);
+      TEST_ASSERT_EQUAL_MESSAGE(alt >= 10.0, listed[i], message);
+      compared++;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_nearby);
+  RUN_TEST(test_above_horizon);
+  RUN_TEST(test_align_all_sky);
+  RUN_TEST(test_lst_drift);
+  RUN_TEST(test_match_list_lst_drift);
+  return UNITY_END();
+}
@@ -0,0 +1,127 @@
+// -----------------------------------------------------------------------------------
+// CatMgr object search, ids and name keys across all catalogs and that a search leaves the
+// catalog selection alone
+
+#include <unity.h>
+#include <chrono>
+
+#include "src/Common.h"
+#include "src/plugins/DDScope/catalog/Catalog.h"
+
+static cat_match_t results[512];
+
+static bool found(int n, int cat, long index) {
+  for (int r = 0; r < n; r++) if (results[r].cat == cat && results[r].index == index) return true;
+  return false;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// the first search builds the name keys, time that then a warm search
+static void test_name_keys_build_time() {
+  auto t0 = std::chrono::steady_clock::now();
+  int n = cat_mgr.findObjects("Vega", results, 8);
+  auto t1 = std::chrono::steady_clock::now();
+  n += cat_mgr.findObjects("Polaris", results, 8);
+  auto t2 = std::chrono::steady_clock::now();
+  char s[80];
+  snprintf(s, sizeof(s), "name keys built in %.1f us, warm search %.2f us",
+           std::chrono::duration<double, std::micro>(t1 - t0).count(), std::chrono::duration<double, std::micro>(t2 - t1).count());
+  TEST_MESSAGE(s);
+  TEST_ASSERT_TRUE(n >= 2);
+}
+
+static void test_find_by_id() {
+  int n = cat_mgr.findObjects("M31", results, 8);
+  TEST_ASSERT_TRUE(n >= 1);
+  cat_mgr.select(results[0].cat);
+  cat_mgr.setIndex(results[0].index);
+  TEST_ASSERT_EQUAL(31, cat_mgr.primaryId());
+  TEST_ASSERT_EQUAL_STRING("M", cat_mgr.catalogPrefix());
+
+  TEST_ASSERT_TRUE(cat_mgr.findObjects("messier 31", results, 8) >= 1);
+  // Herschel 400 records are NGC numbers
+  n = cat_mgr.findObjects("NGC 7009", results, 8);
+  TEST_ASSERT_TRUE(n >= 1);
+  cat_mgr.select(results[0].cat);
+  cat_mgr.setIndex(results[0].index);
+  TEST_ASSERT_EQUAL(7009, cat_mgr.primaryId());
+  TEST_ASSERT_TRUE(cat_mgr.findObjects("ic93", results, 8) >= 1);
+  TEST_ASSERT_EQUAL(0, cat_mgr.findObjects("NoSuchObject", results, 8));
+}
+
+// CAT_SEARCH_MAX_KEYS covers the names of the configured catalogs, so none are left to the linear scan
+static void test_name_keys_cover_catalogs() {
+  long dropped = cat_mgr.nameKeysDropped();
+  char s[80];
+  snprintf(s, sizeof(s), "%ld name words past CAT_SEARCH_MAX_KEYS %d", dropped, CAT_SEARCH_MAX_KEYS);
+  TEST_MESSAGE(s);
+  TEST_ASSERT_EQUAL(0, dropped);
+}
+
+// every word of every name finds its record, case-insensitively
+static void test_every_name_word_is_found() {
+  long words = 0;
+  for (int c = 0; c < cat_mgr.numCatalogs(); c++) {
+    cat_mgr.select(c);
+    for (long i = 0; i <= cat_mgr.getMaxIndex(); i++) {
+      cat_mgr.select(c);
+      cat_mgr.setIndex(i);
+      char name[64];
+      strncpy(name, cat_mgr.objectNameStr(), sizeof(name) - 1); name[sizeof(name) - 1] = 0;
+      if (name[0] == 0) continue;
+
+      for (char *w = strtok(name, " "); w; w = strtok(NULL, " ")) {
+        // a trailing number would make this an id search
+        if (isdigit(w[strlen(w) - 1])) continue;
+        char query[CAT_SEARCH_MAX_QUERY + 1];
+        strncpy(query, w, CAT_SEARCH_MAX_QUERY); query[CAT_SEARCH_MAX_QUERY] = 0;
+        for (char *q = query; *q; q++) *q = tolower(*q);
+        int n = cat_mgr.findObjects(query, results, 512);
+        char msg[96];
+        snprintf(msg, sizeof(msg), "'%s' didn't find catalog %d record %ld", query, c, i);
+        TEST_ASSERT_TRUE_MESSAGE(found(n, c, i), msg);
+        words++;
+      }
+    }
+  }
+  TEST_ASSERT_TRUE(words > 100);
+}
+
+// the goto by name path must not move the catalog screens' selection
+static void test_find_object_keeps_selection() {
+  cat_mgr.select(0);
+  cat_mgr.setIndex(5);
+  const char *title = cat_mgr.catalogTitle();
+
+  int cat; long index; double ra, dec;
+  TEST_ASSERT_TRUE(cat_mgr.findObject("M31", &cat, &index, &ra, &dec));
+  TEST_ASSERT_EQUAL_STRING(title, cat_mgr.catalogTitle());
+  TEST_ASSERT_EQUAL(5, cat_mgr.getIndex());
+
+  // M31 J2000 00h42m44s +41d16m
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 0.712, ra);
+  TEST_ASSERT_FLOAT_WITHIN(0.1, 41.27, dec);
+
+  // nor the index of the catalog the match was found in
+  cat_mgr.select(cat);
+  cat_mgr.setIndex(3);
+  cat_mgr.select(0);
+  TEST_ASSERT_TRUE(cat_mgr.findObject("M31", &cat, &index, &ra, &dec));
+  cat_mgr.select(cat);
+  TEST_ASSERT_EQUAL(3, cat_mgr.getIndex());
+
+  TEST_ASSERT_FALSE(cat_mgr.findObject("NoSuchObject", &cat, &index, &ra, &dec));
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_name_keys_build_time);
+  RUN_TEST(test_find_by_id);
+  RUN_TEST(test_name_keys_cover_catalogs);
+  RUN_TEST(test_every_name_word_is_found);
+  RUN_TEST(test_find_object_keeps_selection);
+  return UNITY_END();
+}
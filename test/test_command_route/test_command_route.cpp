@@ -0,0 +1,195 @@
+// -----------------------------------------------------------------------------------
+// Telescope::command() routing, every command code is replayed through the old chain (each
+// handler tried in turn) and through the commandRoute() masked chain, the replies, error codes
+// and frame flags must match and a handler left out of a route must never act on the command
+
+#include <unity.h>
+
+#include "src/Common.h"
+#include "NativeFirmware.h"
+#include "src/lib/gpio/Gpio.h"
+#include "src/telescope/Telescope.h"
+#include "src/telescope/mount/Mount.h"
+#include "src/telescope/mount/goto/Goto.h"
+#include "src/telescope/mount/guide/Guide.h"
+#include "src/telescope/mount/home/Home.h"
+#include "src/telescope/mount/library/Library.h"
+#include "src/telescope/mount/limits/Limits.h"
+#include "src/telescope/mount/park/Park.h"
+#include "src/telescope/mount/pec/Pec.h"
+#include "src/telescope/mount/site/Site.h"
+#include "src/telescope/mount/status/Status.h"
+#include "src/telescope/rotator/Rotator.h"
+#include "src/telescope/focuser/Focuser.h"
+#include "src/telescope/auxiliary/Features.h"
+
+typedef bool (*Handler)(char *, char *, char *, bool *, bool *, CommandError *);
+typedef struct { CommandHandler id; const char *name; Handler fn; } HandlerEntry;
+#define HANDLER(h, object) { h, #object, [](char *r, char *c, char *p, bool *s, bool *n, CommandError *e) { return object.command(r, c, p, s, n, e); } }
+
+// in the same order and under the same conditions as Telescope::command()
+static const HandlerEntry handlers[] = {
+  #ifdef MOUNT_PRESENT
+    HANDLER(CH_MOUNT, mount), HANDLER(CH_GUIDE, guide), HANDLER(CH_GPIO, gpio),
+    #if GOTO_FEATURE == ON
+      HANDLER(CH_STATUS, mountStatus), HANDLER(CH_GOTO, goTo), HANDLER(CH_PARK, park), HANDLER(CH_LIBRARY, library),
+    #endif
+    HANDLER(CH_SITE, site), HANDLER(CH_LIMITS, limits), HANDLER(CH_HOME, home), HANDLER(CH_PEC, pec),
+    HANDLER(CH_AXIS1, axis1), HANDLER(CH_AXIS2, axis2),
+  #endif
+  #ifdef ROTATOR_PRESENT
+    HANDLER(CH_ROTATOR, rotator),
+  #endif
+  #ifdef FOCUSER_PRESENT
+    HANDLER(CH_FOCUSER, focuser),
+  #endif
+  #ifdef FEATURES_PRESENT
+    HANDLER(CH_FEATURES, features),
+  #endif
+};
+#define HANDLER_COUNT (int)(sizeof(handlers)/sizeof(handlers[0]))
+
+typedef struct {
+  int handler;  // index into handlers[] of the one that accepted the command, -1 if none did
+  char reply[80];
+  bool supressFrame;
+  bool numericReply;
+  CommandError error;
+} Result;
+
+static void begin(Result *r, char *command, char *parameter, const char *code, const char *param) {
+  memset(r, 0, sizeof(Result));
+  r->handler = -1;
+  r->numericReply = true;
+  r->error = CE_NONE;
+  // zero filled like the command channel buffers, some handlers look past the terminator
+  memset(command, 0, 3);
+  memset(parameter, 0, 40);
+  strcpy(command, code);
+  strcpy(parameter, param);
+}
+
+// try handlers in order, all of them or only those in the route
+static Result chain(const char *code, const char *param, bool routed) {
+  Result r;
+  char command[3], parameter[40];
+  begin(&r, command, parameter, code, param);
+  uint16_t route = commandRoute(command[0], command[1]);
+  for (int h = 0; h < HANDLER_COUNT; h++) {
+    if (routed && !(route & CH(handlers[h].id))) continue;
+    if (handlers[h].fn(r.reply, command, parameter, &r.supressFrame, &r.numericReply, &r.error)) { r.handler = h; break; }
+  }
+  return r;
+}
+
+static Result telescopeCommand(const char *code, const char *param, bool *accepted) {
+  Result r;
+  char command[3], parameter[40];
+  begin(&r, command, parameter, code, param);
+  *accepted = telescope.command(r.reply, command, parameter, &r.supressFrame, &r.numericReply, &r.error);
+  return r;
+}
+
+static bool same(const Result &a, const Result &b) {
+  return a.handler == b.handler && strcmp(a.reply, b.reply) == 0 && a.supressFrame == b.supressFrame &&
+         a.numericReply == b.numericReply && a.error == b.error;
+}
+
+static char message[320];
+static const char *describe(const char *what, const char *code, const char *param, const Result &a, const Result &b) {
+  snprintf(message, sizeof(message), ":%s%s# %s, old %s '%s' e%d f%d%d, new %s '%s' e%d f%d%d", code, param, what,
+           a.handler >= 0 ? handlers[a.handler].name : "none", a.reply, (int)a.error, a.supressFrame, a.numericReply,
+           b.handler >= 0 ? handlers[b.handler].name : "none", b.reply, (int)b.error, b.supressFrame, b.numericReply);
+  return message;
+}
+
+static long accepted = 0, compared = 0, stateful = 0;
+
+// one command through every path
+static void replay(const char *code, const char *param) {
+  uint16_t route = commandRoute(code[0], code[1]);
+
+  // a handler left out of the route must not accept the command or touch the reply, error or flags
+  for (int h = 0; h < HANDLER_COUNT; h++) {
+    if (route & CH(handlers[h].id)) continue;
+    Result r, none;
+    char command[3], parameter[40];
+    begin(&r, command, parameter, code, param);
+    none = r;
+    bool acted = handlers[h].fn(r.reply, command, parameter, &r.supressFrame, &r.numericReply, &r.error);
+    if (acted) r.handler = h;
+    TEST_ASSERT_TRUE_MESSAGE(!acted && same(r, none), describe("unrouted handler acted", code, param, none, r));
+  }
+
+  // old chain, routed chain then old chain again, a command that answers differently the second
+  // time (it changed state) is only checked for which handler took it
+  Result before = chain(code, param, false);
+  Result routed = chain(code, param, true);
+  Result after = chain(code, param, false);
+  if (before.handler >= 0) accepted++;
+  TEST_ASSERT_EQUAL_MESSAGE(before.handler, routed.handler, describe("handler differs", code, param, before, routed));
+  if (!same(before, after)) { stateful++; return; }
+  TEST_ASSERT_TRUE_MESSAGE(same(before, routed), describe("result differs", code, param, before, routed));
+  compared++;
+
+  // and the firmware's own dispatch gives the same answer for anything a handler accepts
+  if (before.handler >= 0) {
+    bool ok;
+    Result full = telescopeCommand(code, param, &ok);
+    full.handler = before.handler;
+    TEST_ASSERT_TRUE_MESSAGE(ok && same(before, full), describe("Telescope::command differs", code, param, before, full));
+  }
+}
+
+// command codes, all two character codes from these first and second characters
+static const char *firstChars = "$%ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+static const char *secondChars = "$%+-?0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+// parameters that reach past the first checks of most handlers
+static const char *params[] = { "", "0", "1", "5", "+45", "-10", "12:34:56", "+45*30:00", "+045*30:00", "120*00", "1.5", "A", "E", "W", "N", "S" };
+
+void setUp() {}
+void tearDown() {}
+
+static void test_all_codes() {
+  char code[3] = "";
+  for (const char *a = firstChars; *a; a++) {
+    for (const char *b = secondChars; *b; b++) {
+      // :GX and :SX take their own sub-codes, below
+      if ((*a == 'G' || *a == 'S') && *b == 'X') continue;
+      code[0] = *a; code[1] = *b; code[2] = 0;
+      for (unsigned int p = 0; p < sizeof(params)/sizeof(params[0]); p++) replay(code, params[p]);
+    }
+  }
+  snprintf(message, sizeof(message), "%ld accepted, %ld compared, %ld changed state", accepted, compared, stateful);
+  TEST_MESSAGE(message);
+}
+
+// :GX[c][c]# and :SX[c][c],[value]#
+static void test_extended_codes() {
+  const char *sub = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+  const char *values[] = { "", ",0", ",1", ",5", ",+45", ",12:00:00", ",1.5", ",N" };
+  char param[24];
+  accepted = compared = stateful = 0;
+  for (const char *a = sub; *a; a++) {
+    for (const char *b = sub; *b; b++) {
+      param[0] = *a; param[1] = *b; param[2] = 0;
+      replay("GX", param);
+      for (unsigned int v = 0; v < sizeof(values)/sizeof(values[0]); v++) {
+        snprintf(param, sizeof(param), "%c%c%s", *a, *b, values[v]);
+        replay("SX", param);
+      }
+    }
+  }
+  snprintf(message, sizeof(message), "%ld accepted, %ld compared, %ld changed state", accepted, compared, stateful);
+  TEST_MESSAGE(message);
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  nativeFirmwareBegin();
+  UNITY_BEGIN();
+  RUN_TEST(test_all_codes);
+  RUN_TEST(test_extended_codes);
+  return UNITY_END();
+}
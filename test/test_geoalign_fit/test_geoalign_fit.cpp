@@ -0,0 +1,307 @@
+// -----------------------------------------------------------------------------------
+// GeoAlign pointing model fit on a GEM, stars placed by a known model are fit back to that model
+// by the least squares search, with and without measurement noise and with the stars folded in
+// one at a time after the align, and the grid search it falls back to finds the same model as
+// the original search that called correct() for every star at every grid point
+
+#include <unity.h>
+#include <chrono>
+
+#include "src/Common.h"
+#include "NativeFirmware.h"
+#include "src/lib/tasks/OnTask.h"
+#include "src/telescope/mount/coordinates/Transform.h"
+
+#define STARS ALIGN_MAX_MODEL_STARS
+
+static GeoAlign &align = transform.align;
+static Coordinate actualStars[STARS], mountStars[STARS];
+static char message[200];
+
+// arc-seconds, cone (DO), polar axis (PZ/PE) and index (OH/OD) terms any fit of three or more stars finds
+static const AlignModel basicModel = { 600.0F, -300.0F, 1200.0F, -900.0F, 240.0F, 0.0F, 0.0F, 0.0F };
+// and the dec axis orthogonality (PD), flexure (DF) and tube flex (TF) terms a fit of five or more finds
+static const AlignModel fullModel = { 600.0F, -300.0F, 1200.0F, -900.0F, 240.0F, 120.0F, 90.0F, 60.0F };
+
+static AlignModel toRadians(const AlignModel &m) {
+  AlignModel r;
+  r.ax1Cor = arcsecToRad(m.ax1Cor); r.ax2Cor = arcsecToRad(m.ax2Cor);
+  r.altCor = arcsecToRad(m.altCor); r.azmCor = arcsecToRad(m.azmCor);
+  r.doCor = arcsecToRad(m.doCor); r.pdCor = arcsecToRad(m.pdCor);
+  r.dfCor = arcsecToRad(m.dfCor); r.tfCor = arcsecToRad(m.tfCor);
+  return r;
+}
+
+// stars spread over the sky on both sides of the pier, where a mount with this model points for
+// each one, plus up to noise arc-seconds of measurement error
+static void makeStars(const AlignModel &truth, int noise) {
+  srandom(11);
+
+  // any fitted model to get the conversion going, then swap in the truth
+  for (int i = 0; i < 3; i++) {
+    align.actual[i] = align.mount[i] = { (float)degToRad(i*30.0 - 30.0), (float)degToRad(20.0), 0.0F, 0.0F, 1 };
+  }
+  align.autoModel(3);
+  align.model = toRadians(truth);
+
+  for (int i = 0; i < STARS; i++) {
+    Coordinate c = {};
+    c.h = degToRad(random(-85, 85));
+    c.d = degToRad(random(-25, 80));
+    c.pierSide = c.h < 0 ? PIER_SIDE_WEST : PIER_SIDE_EAST;
+    actualStars[i] = c;
+    align.observedPlaceToMount(&c);
+    if (noise) {
+      c.h += arcsecToRad(random(-noise, noise + 1));
+      c.d += arcsecToRad(random(-noise, noise + 1));
+    }
+    mountStars[i] = c;
+  }
+  align.modelClear();
+}
+
+// puts star i into the model arrays the way setStar() does on an equatorial mount
+static void setStar(int i) {
+  align.actual[i].ax1 = align.actual[i].h = actualStars[i].h;
+  align.actual[i].ax2 = align.actual[i].d = actualStars[i].d;
+  align.mount[i].ax1 = align.mount[i].h = mountStars[i].h;
+  align.mount[i].ax2 = align.mount[i].d = mountStars[i].d;
+  align.actual[i].side = align.mount[i].side = mountStars[i].pierSide == PIER_SIDE_WEST ? -1 : 1;
+}
+
+static double fit(int n) {
+  for (int i = 0; i < n; i++) setStar(i);
+  auto t0 = std::chrono::steady_clock::now();
+  align.autoModel(n);
+  auto t1 = std::chrono::steady_clock::now();
+  TEST_ASSERT_TRUE(align.modelReady());
+  return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+// each term of the fitted model is within tolerance arc-seconds of the truth
+static void assertModel(const AlignModel &truth, float tolerance, const char *label) {
+  const float *t = &truth.ax1Cor;
+  const float *m = &align.model.ax1Cor;
+  const char *names[] = { "ax1Cor", "ax2Cor", "altCor", "azmCor", "doCor", "pdCor", "dfCor", "tfCor" };
+  for (int i = 0; i < 8; i++) {
+    snprintf(message, sizeof(message), "%s %s %.1f\" expected %.1f\"", label, names[i], radToArcsec(m[i]), t[i]);
+    TEST_ASSERT_FLOAT_WITHIN_MESSAGE(tolerance, t[i], radToArcsec(m[i]), message);
+  }
+}
+
+// rms arc-seconds between where the fitted model points for each star and where the mount was
+static double pointingRms(int n) {
+  double sum = 0;
+  for (int i = 0; i < n; i++) {
+    Coordinate c = actualStars[i];
+    align.observedPlaceToMount(&c);
+    double dh = (c.h - mountStars[i].h)*cos(c.d), dd = c.d - mountStars[i].d;
+    sum += dh*dh + dd*dd;
+  }
+  return radToArcsec(sqrt(sum/n));
+}
+
+// the refits addModelStar() schedules run as a task on transform.align
+// the grid search as it was before the per-star trig was cached, replayed here on the same stars
+namespace original {
+  static float cosLat, sinLat;
+  static long num;
+  static float best_deo, best_pd, best_pz, best_pe, best_ohw, best_odw, best_ohe, best_ode, best_tf, best_df, best_ff;
+  static float best_dist;
+
+  static void correct(float a1, float a2, float pierSide, float sf, float _deo, float _pd, float _pz, float _pe, float _df, float _ff, float _tf, float *a1r, float *a2r) {
+    float cosA2 = cosf(a2);
+    float tanA2 = tanf(a2);
+    float sinA1 = sinf(a1);
+    float cosA1 = cosf(a1);
+    float DOh = _deo*sf*(1.0F/cosA2)*pierSide;
+    float PDh = -_pd*sf*tanA2*pierSide;
+    float PZ  = _pz*sf;
+    float PA  = _pe*sf;
+    float DFd = -_df*sf*(cosLat*cosA1 + sinLat*tanA2);
+    float FFd = _ff*sf*cosA1;
+    float TF  = _tf*sf;
+    float TFh = TF*(cosLat*sinA1*(1.0/cosA2));
+    float TFd = TF*(cosLat*cosA1 - sinLat*cosA2);
+    *a1r = (-PZ*cosA1*tanA2 + PA*sinA1*tanA2 + DOh + PDh + TFh);
+    *a2r = (+PZ*sinA1 + PA*cosA1 + DFd + FFd + TFd);
+  }
+
+  static void doSearch(float sf, int p1, int p2, int p3, int p4, int p5, int p6, int p7, int p8, int p9) {
+    float sf1 = arcsecToRad(sf);
+    long _deo_m = -p1 + round(best_deo/sf), _deo_p = p1 + round(best_deo/sf);
+    long _pd_m = -p2 + round(best_pd/sf), _pd_p = p2 + round(best_pd/sf);
+    long _pz_m = -p3 + round(best_pz/sf), _pz_p = p3 + round(best_pz/sf);
+    long _pe_m = -p4 + round(best_pe/sf), _pe_p = p4 + round(best_pe/sf);
+    long _tf_m = -p5 + round(best_tf/sf), _tf_p = p5 + round(best_tf/sf);
+    long _ff_m = -p6 + round(best_ff/sf), _ff_p = p6 + round(best_ff/sf);
+    long _df_m = -p7 + round(best_df/sf), _df_p = p7 + round(best_df/sf);
+    long _od_m = -p8 + round(best_ode/sf), _od_p = p8 + round(best_ode/sf);
+    long _oh_m = -p9 + round(best_ohe/sf), _oh_p = p9 + round(best_ohe/sf);
+
+    for (long _deo = _deo_m; _deo <= _deo_p; _deo++)
+    for (long _pd = _pd_m; _pd <= _pd_p; _pd++)
+    for (long _pz = _pz_m; _pz <= _pz_p; _pz++)
+    for (long _pe = _pe_m; _pe <= _pe_p; _pe++)
+    for (long _df = _df_m; _df <= _df_p; _df++)
+    for (long _ff = _ff_m; _ff <= _ff_p; _ff++)
+    for (long _tf = _tf_m; _tf <= _tf_p; _tf++)
+    for (long _ohe = _oh_m; _ohe <= _oh_p; _ohe++)
+    for (long _ode = _od_m; _ode <= _od_p; _ode++) {
+      float ode = _ode*sf1, odw = -ode, ohe = _ohe*sf1, ohw = ohe;
+      float sum1 = 0.0F, sum2 = 0.0F;
+      for (long l = 0; l < num; l++) {
+        float ma1 = align.mount[l].ax1, ma2 = align.mount[l].ax2;
+        if (align.mount[l].side == -1) { ma1 += ohw; ma2 += odw; } else { ma1 += ohe; ma2 += ode; }
+        float ma1r, ma2r;
+        correct(ma1, ma2, align.mount[l].side, sf1, _deo, _pd, _pz, _pe, _df, _ff, _tf, &ma1r, &ma2r);
+        float d1 = align.actual[l].ax1 - (ma1 - ma1r);
+        if (d1 > Deg180) d1 -= Deg360; else if (d1 < -Deg180) d1 += Deg360;
+        float d2 = align.actual[l].ax2 - (ma2 - ma2r);
+        sum1 += sq(d1*cosf(align.actual[l].ax2));
+        sum2 += sq(d2);
+      }
+      float dist = sqrtf(sq(sqrtf(sum1/(num - 1))) + sq(sqrtf(sum2/(num - 1))));
+      if (dist < best_dist) {
+        best_dist = dist;
+        best_deo = _deo*sf; best_pd = _pd*sf; best_pz = _pz*sf; best_pe = _pe*sf;
+        best_tf = _tf*sf; best_df = _df*sf; best_ff = _ff*sf;
+        if (p8 != 0) best_odw = radToArcsec(odw); else best_odw = best_pe/2.0;
+        if (p8 != 0) best_ode = radToArcsec(ode); else best_ode = -best_pe/2.0;
+        if (p9 != 0) { best_ohw = radToArcsec(ohw); best_ohe = radToArcsec(ohe); }
+      }
+      Y;
+    }
+  }
+
+  // the grid search sequence autoModel() runs on a GEM, in arc-seconds
+  static AlignModel autoModel(int n, double latitude) {
+    cosLat = cosf(latitude); sinLat = sinf(latitude);
+    num = n;
+    best_dist = 3600.0F*180.0F;
+    best_deo = best_pd = best_pz = best_pe = best_tf = best_ff = best_df = best_ode = best_odw = 0.0F;
+    float ohe = 0;
+    for (long l = 0; l < num; l++) {
+      float diff = align.actual[l].ax1 - align.mount[l].ax1;
+      if (diff > Deg180) diff -= Deg360;
+      if (diff < -Deg180) diff += Deg360;
+      ohe += diff;
+    }
+    best_ohe = best_ohw = round(radToArcsec(ohe/num));
+
+    int Do = num > 2 ? 1 : 0, Df = 1;
+    doSearch(16384,0 ,0,1,1,0, 0, 0,1,1);
+    doSearch( 8192,Do,0,1,1,0, 0, 0,1,1);
+    doSearch( 4096,Do,0,1,1,0, 0, 0,1,1);
+    doSearch( 2048,Do,0,1,1,0, 0, 0,1,1);
+    doSearch( 1024,Do,0,1,1,0, 0, 0,1,1);
+    doSearch(  512,Do,0,1,1,0, 0, 0,1,1);
+    if (num > 4) {
+      doSearch(256,Do,1,1,1,0,0,Df,1,1);
+      doSearch(128,Do,1,1,1,1,0,Df,1,1);
+      doSearch( 64,Do,1,1,1,1,0,Df,1,1);
+      doSearch( 32,Do,1,1,1,1,0,Df,1,1);
+      doSearch( 16,Do,1,1,1,1,0,Df,1,1);
+    } else {
+      doSearch(256,Do,0,1,1,0, 0, 0,1,1);
+      doSearch(128,Do,0,1,1,0, 0, 0,1,1);
+      doSearch( 64,Do,0,1,1,0, 0, 0,1,1);
+      doSearch( 32,Do,0,1,1,0, 0, 0,1,1);
+      doSearch( 16,Do,0,1,1,0, 0, 0,1,1);
+    }
+    return { best_ohw, best_odw, best_pe, best_pz, best_deo, best_pd, best_df, best_tf };
+  }
+}
+
+void setUp() {
+  nativeFirmwareBegin();
+  align.init(GEM, degToRad(40.0));
+}
+void tearDown() {}
+
+static void test_three_stars() {
+  makeStars(basicModel, 0);
+  double ms = fit(3);
+  assertModel(basicModel, 2.0F, "3 stars");
+  snprintf(message, sizeof(message), "3 stars fit in %.3f ms, pointing rms %.2f\"", ms, pointingRms(3));
+  TEST_MESSAGE(message);
+}
+
+// five stars is the fewest that bring in the flexure and orthogonality terms
+static void test_five_stars() {
+  makeStars(fullModel, 0);
+  double ms = fit(5);
+  assertModel(fullModel, 2.0F, "5 stars");
+  snprintf(message, sizeof(message), "5 stars fit in %.3f ms, pointing rms %.2f\"", ms, pointingRms(5));
+  TEST_MESSAGE(message);
+}
+
+static void test_nine_stars() {
+  makeStars(fullModel, 0);
+  double ms = fit(9);
+  assertModel(fullModel, 2.0F, "9 stars");
+  snprintf(message, sizeof(message), "9 stars fit in %.3f ms, pointing rms %.2f\"", ms, pointingRms(9));
+  TEST_MESSAGE(message);
+}
+
+// measurement noise of up to 10" on every star, the fit averages it down
+static void test_noisy_stars() {
+  makeStars(fullModel, 10);
+  double ms = fit(STARS);
+  assertModel(fullModel, 20.0F, "noisy stars");
+  double rms = pointingRms(STARS);
+  TEST_ASSERT_TRUE(rms < 10.0);
+  snprintf(message, sizeof(message), "%d noisy stars fit in %.3f ms, pointing rms %.2f\"", STARS, ms, rms);
+  TEST_MESSAGE(message);
+}
+
+// stars added after the align are folded into the fit and end up at the same model as fitting all
+// of them at once
+static void test_added_stars() {
+  makeStars(fullModel, 10);
+  fit(5);
+  for (int i = 5; i < STARS; i++) {
+    Coordinate a = actualStars[i], m = mountStars[i];
+    TEST_ASSERT_EQUAL(CE_NONE, align.addModelStar(&a, &m));
+    nativeFirmwareRun(10);
+  }
+  AlignModel added = align.model;
+  for (int i = 0; i < 8; i++) (&added.ax1Cor)[i] = radToArcsec((&added.ax1Cor)[i]);
+  fit(STARS);
+  assertModel(added, 1.0F, "added stars");
+}
+
+// a cone error past the 4 degrees the least squares fit accepts sends autoModel() to the grid search
+static void gridSearch(int n) {
+  AlignModel cone = fullModel;
+  cone.doCor = 5.0F*3600.0F;
+  makeStars(cone, 10);
+  double ms = fit(n);
+
+  auto t0 = std::chrono::steady_clock::now();
+  AlignModel expected = original::autoModel(n, degToRad(40.0));
+  auto t1 = std::chrono::steady_clock::now();
+  double originalMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+  // the cached search sums in a different order, a near tie can go either way at the finest step
+  snprintf(message, sizeof(message), "%d stars grid search", n);
+  assertModel(expected, 16.0F, message);
+  snprintf(message, sizeof(message), "%d stars grid search in %.2f ms, %.2f ms before the trig was cached", n, ms, originalMs);
+  TEST_MESSAGE(message);
+}
+
+static void test_grid_search_four_stars() { gridSearch(4); }
+static void test_grid_search_nine_stars() { gridSearch(9); }
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_three_stars);
+  RUN_TEST(test_five_stars);
+  RUN_TEST(test_nine_stars);
+  RUN_TEST(test_noisy_stars);
+  RUN_TEST(test_added_stars);
+  RUN_TEST(test_grid_search_four_stars);
+  RUN_TEST(test_grid_search_nine_stars);
+  return UNITY_END();
+}
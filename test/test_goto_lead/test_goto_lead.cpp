@@ -0,0 +1,125 @@
+// -----------------------------------------------------------------------------------
+// Goto lead on an alt-az mount, a tracking goto aims at where the target will be when the axes
+// arrive and lands on it in a single slew, when the led destination is outside the limits the lead
+// is skipped and the goto takes a refine slew onto the moving target instead
+
+#include <unity.h>
+
+#include "src/Common.h"
+#include "NativeFirmware.h"
+#include "src/telescope/mount/Mount.h"
+#include "src/telescope/mount/coordinates/Transform.h"
+#include "src/telescope/mount/goto/Goto.h"
+#include "src/telescope/mount/guide/Guide.h"
+#include "src/telescope/mount/limits/Limits.h"
+#include "src/telescope/mount/site/Site.h"
+
+// arc-seconds from the target the goto may finish
+#define ARRIVAL_MAX 10.0
+
+static char message[200];
+
+typedef struct {
+  int slews;
+  double seconds, error;   // seconds, arc-seconds
+} GotoResult;
+
+static void waitForStop() {
+  for (int i = 0; i < 60000 && (axis1.isSlewing() || axis2.isSlewing()); i++) nativeFirmwareRun(1);
+}
+
+// a target at this altitude and azimuth now, in degrees
+static Coordinate targetAt(double altitude, double azimuth) {
+  Coordinate c;
+  c.a = degToRad(altitude);
+  c.z = degToRad(azimuth);
+  transform.horToEqu(&c);
+  transform.hourAngleToRightAscension(&c);
+  c.pierSide = PIER_SIDE_NONE;
+  return c;
+}
+
+// how far the mount is from the target, in arc-seconds, worked out here rather than by Goto
+static double targetError(Coordinate *target) {
+  Coordinate t = *target;
+  transform.rightAscensionToHourAngle(&t);
+  Coordinate p = mount.getPosition(CR_MOUNT_EQU);
+  double c = sin(t.d)*sin(p.d) + cos(t.d)*cos(p.d)*cos(t.h - p.h);
+  if (c > 1.0) c = 1.0;
+  return radToDeg(acos(c))*3600.0;
+}
+
+// a goto to the target, counting the slews from the pauses between them (sampled every pass of the
+// firmware loop since the goto monitor chains slews within a millisecond), once it's under way the
+// altitude limit is opened out so tracking can carry on past it
+static GotoResult gotoTarget(Coordinate *target) {
+  GotoResult r = { 0, 0.0, 0.0 };
+  TEST_ASSERT_EQUAL(CE_NONE, goTo.request(target, PSS_BEST));
+  limits.settings.altitude.max = degToRadF(89.0F);
+
+  bool slewing = false;
+  unsigned long t0 = millis();
+  while (goTo.state != GS_NONE && millis() - t0 < 600000) {
+    loop();
+    bool s = axis1.isSlewing() || axis2.isSlewing();
+    if (s && !slewing) r.slews++;
+    slewing = s;
+  }
+  r.seconds = (millis() - t0)/1000.0;
+  r.error = targetError(target);
+  return r;
+}
+
+// an alt-az mount at latitude 40 accelerating at 2 degrees per second per second, tracking from a start
+// at altitude 30 and azimuth 100
+void setUp() {
+  nativeFirmwareBegin();
+  guide.stop();
+  waitForStop();
+
+  site.location.latitude = degToRad(40.0);
+  site.updateLocation();
+  transform.mountType = ALTAZM;
+  limits.settings.altitude.min = degToRadF(-2.0F);
+  limits.settings.altitude.max = degToRadF(80.0F);
+  limits.enabled(true);
+  axis1.setSlewAccelerationRate(degToRadF(2.0F));
+  axis2.setSlewAccelerationRate(degToRadF(2.0F));
+  mount.enable(true);
+  mount.tracking(true);
+
+  Coordinate start = targetAt(30.0, 100.0);
+  TEST_ASSERT_EQUAL(CE_NONE, goTo.request(&start, PSS_BEST));
+  while (goTo.state != GS_NONE) nativeFirmwareRun(10);
+}
+
+void tearDown() {}
+
+// led to where the target will be, one slew lands on it
+static void test_lead_applied() {
+  Coordinate target = targetAt(50.0, 200.0);
+  GotoResult r = gotoTarget(&target);
+  snprintf(message, sizeof(message), "led: %d slew(s) in %.2fs, %.1f\" from the target", r.slews, r.seconds, r.error);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_EQUAL_MESSAGE(1, r.slews, message);
+  TEST_ASSERT_TRUE_MESSAGE(r.error < ARRIVAL_MAX, message);
+}
+
+// rising in the east just under the altitude limit, the led destination is past it so the goto
+// heads for the present target and refines from there
+static void test_lead_skipped() {
+  Coordinate target = targetAt(79.98, 120.0);
+  GotoResult r = gotoTarget(&target);
+  snprintf(message, sizeof(message), "lead skipped: %d slew(s) in %.2fs, %.1f\" from the target", r.slews, r.seconds, r.error);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_EQUAL_MESSAGE(2, r.slews, message);
+  TEST_ASSERT_TRUE_MESSAGE(r.error < ARRIVAL_MAX, message);
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_lead_applied);
+  RUN_TEST(test_lead_skipped);
+  return UNITY_END();
+}
@@ -0,0 +1,322 @@
+// -----------------------------------------------------------------------------------
+// Goto path planner, random start and destination pairs on a GEM at several latitudes, every
+// planned path must stay within the horizon, overhead, meridian and axis limits and be no slower
+// than the fixed 120/135 degree waypoints it replaced
+
+#include <unity.h>
+#include <chrono>
+
+#include "src/Common.h"
+#include "NativeFirmware.h"
+#include "src/telescope/mount/Mount.h"
+#include "src/telescope/mount/coordinates/Transform.h"
+#include "src/telescope/mount/goto/GotoPlanner.h"
+#include "src/telescope/mount/limits/Limits.h"
+#include "src/telescope/mount/site/Site.h"
+
+#define PAIRS 400
+
+// the axes slew rate and acceleration, in degrees
+#define SLEW_RATE 5.0
+#define SLEW_ACCEL 2.5
+
+static Coordinate homePosition;
+static Coordinate waypoints[GOTO_WAYPOINTS_MAX];
+static char message[240];
+
+static double rnd(double lo, double hi) { return lo + (hi - lo)*(rand()/(double)RAND_MAX); }
+
+static void setLatitude(double degrees) {
+  site.location.latitude = degToRad(degrees);
+  site.updateLocation();
+  homePosition.h = Deg90;
+  homePosition.d = site.locationEx.latitude.sign*Deg90;
+  homePosition.pierSide = PIER_SIDE_NONE;
+}
+
+// the limits worked out here rather than by the planner, tol in degrees
+static bool within(double a1, double a2, double tol = 0.05) {
+  tol = degToRad(tol);
+  Coordinate c = transform.instrumentToMount(a1, a2);
+  double alt = asin(sin(c.d)*sin(site.location.latitude) + cos(c.d)*cos(site.location.latitude)*cos(c.h));
+  if (alt < limits.settings.altitude.min - tol || alt > limits.settings.altitude.max + tol) return false;
+  if (c.pierSide == PIER_SIDE_EAST && c.h < -limits.settings.pastMeridianE - tol) return false;
+  if (c.pierSide == PIER_SIDE_WEST && c.h > limits.settings.pastMeridianW + tol) return false;
+  if (c.h < axis1.settings.limits.min - tol || c.h > axis1.settings.limits.max + tol) return false;
+  if (c.d < axis2.settings.limits.min - tol || c.d > axis2.settings.limits.max + tol) return false;
+  return true;
+}
+
+// a random position within the limits
+static Coordinate randomPosition() {
+  Coordinate c;
+  double a1, a2;
+  do {
+    c.h = degToRad(rnd(-180.0, 180.0));
+    c.d = asin(rnd(-1.0, 1.0));
+    c.pierSide = rand() % 2 ? PIER_SIDE_EAST : PIER_SIDE_WEST;
+    transform.mountToInstrument(&c, &a1, &a2);
+  } while (!within(a1, a2, -0.05));
+  return c;
+}
+
+// an axis' move stepped through in time, worked out here rather than from the planner or Axis: the
+// acceleration ramps up at the jerk to its limit, holds, ramps down at the peak rate, then cruises and
+// mirrors that to stop, the peak rate is found by bisection so the move covers the distance
+typedef struct {
+  double jerk, tj, ta, tv, seconds, distance;
+  double t, x, v;
+} Move;
+
+// distance to reach rate v and stop again, also sets the jerk and constant acceleration times
+static double rampDistance(Move *m, double v) {
+  double accel = degToRad(SLEW_ACCEL);
+  #if AXIS_JERK_PERCENT != OFF
+    m->tj = fmin(accel/m->jerk, sqrt(v/m->jerk));
+    m->ta = v/(m->jerk*m->tj) - m->tj;
+  #else
+    m->tj = 0.0;
+    m->ta = v/accel;
+  #endif
+  return v*(2.0*m->tj + m->ta);
+}
+
+static void moveBegin(Move *m, double distance) {
+  double rate = degToRad(SLEW_RATE), accel = degToRad(SLEW_ACCEL);
+  m->jerk = accel/((rate/accel)*(AXIS_JERK_PERCENT == OFF ? 0 : AXIS_JERK_PERCENT)/100.0);
+  m->distance = distance;
+  m->t = m->x = m->v = 0.0;
+  m->tj = m->ta = m->tv = m->seconds = 0.0;
+  if (distance <= 0.0) return;
+
+  double peak = rate;
+  if (rampDistance(m, rate) > distance) {
+    double lo = 0.0, hi = rate;
+    for (int i = 0; i < 60; i++) { peak = (lo + hi)/2.0; if (rampDistance(m, peak) > distance) hi = peak; else lo = peak; }
+    peak = lo;
+  }
+  m->tv = (distance - rampDistance(m, peak))/peak;
+  m->seconds = 2.0*(2.0*m->tj + m->ta) + m->tv;
+}
+
+static double moveAccel(Move *m, double t) {
+  double accelTime = 2.0*m->tj + m->ta, sign = 1.0;
+  if (t >= m->seconds) return 0.0;
+  if (t >= accelTime + m->tv) { t = m->seconds - t; sign = -1.0; } else if (t >= accelTime) return 0.0;
+  #if AXIS_JERK_PERCENT != OFF
+    if (t < m->tj) return sign*m->jerk*t;
+    if (t < m->tj + m->ta) return sign*m->jerk*m->tj;
+    return sign*m->jerk*(accelTime - t);
+  #else
+    return sign*degToRad(SLEW_ACCEL);
+  #endif
+}
+
+// advances the move dt seconds, the acceleration is linear within a step so the trapezoid rule is exact
+// for the rate and close for the distance
+static double moveStep(Move *m, double dt) {
+  if (m->t >= m->seconds) return m->distance;
+  double v = m->v + (moveAccel(m, m->t) + moveAccel(m, m->t + dt))*dt/2.0;
+  m->x += (m->v + v)*dt/2.0;
+  m->v = v;
+  m->t += dt;
+  if (m->t >= m->seconds) m->x = m->distance;
+  return m->x;
+}
+
+// a path through the points, each slew with both axes starting together and the shorter move stretched
+// in time to finish with the longer as Goto does, checked every 10ms, returns the slew time or -1 if it
+// leaves the limits
+static float pathTime(Coordinate *points, int count, double tol = 0.05) {
+  const double dt = 0.01;
+  float seconds = 0.0F;
+  for (int p = 1; p < count; p++) {
+    double a1From, a2From, a1To, a2To;
+    transform.mountToInstrument(&points[p - 1], &a1From, &a2From);
+    transform.mountToInstrument(&points[p], &a1To, &a2To);
+    Move m1, m2;
+    moveBegin(&m1, fabs(a1To - a1From));
+    moveBegin(&m2, fabs(a2To - a2From));
+    double slew = fmax(m1.seconds, m2.seconds), s1 = 1.0, s2 = 1.0;
+    #if AXIS_JERK_PERCENT != OFF
+      if (m1.seconds > 0.0) s1 = m1.seconds/slew;
+      if (m2.seconds > 0.0) s2 = m2.seconds/slew;
+    #endif
+    for (double t = 0.0; t < slew + dt; t += dt) {
+      double a1 = a1From + (a1To >= a1From ? 1.0 : -1.0)*moveStep(&m1, dt*s1);
+      double a2 = a2From + (a2To >= a2From ? 1.0 : -1.0)*moveStep(&m2, dt*s2);
+      if (!within(a1, a2, tol)) return -1.0F;
+    }
+    seconds += slew;
+  }
+  return seconds;
+}
+
+// the path the fixed waypoints gave for a meridian flip
+static int fixedPath(Coordinate *start, Coordinate *destination, Coordinate *points) {
+  int n = 0;
+  points[n++] = *start;
+  Coordinate current = *start;
+  transform.equToHor(&current);
+  Coordinate avoid = homePosition;
+  double d60 = degToRad(120), d45 = degToRad(135);
+  if (start->pierSide == PIER_SIDE_EAST) { d60 = Deg180 - d60; d45 = Deg180 - d45; }
+  if (current.a < Deg10 && fabs(start->h) > Deg90) { avoid.h = d60; points[n++] = avoid; } else
+  if (current.a < Deg20 && site.locationEx.latitude.absval < Deg45) {
+    if (site.location.latitude >= 0) {
+      if (current.d <= Deg90 - site.location.latitude) { avoid.h = d45; points[n++] = avoid; }
+    } else {
+      if (current.d >= -Deg90 - site.location.latitude) { avoid.h = d45; points[n++] = avoid; }
+    }
+  }
+  points[n++] = homePosition;
+  points[n++] = *destination;
+  return n;
+}
+
+// the path Goto::waypoint() plans, through home on a meridian flip
+static int plannedPath(Coordinate *start, Coordinate *destination, Coordinate *points, bool viaHome, int *planned) {
+  int n = 0;
+  points[n++] = *start;
+  if (viaHome) {
+    int count = gotoPlanner.plan(start, &homePosition, &points[n], GOTO_WAYPOINTS_MAX - 1);
+    if (count < 0) return -1;
+    if (count > 0) (*planned)++;
+    n += count;
+    points[n++] = homePosition;
+    count = gotoPlanner.plan(&homePosition, destination, &points[n], GOTO_WAYPOINTS_MAX - (n - 1));
+    if (count < 0) return -1;
+    if (count > 0) (*planned)++;
+    n += count;
+  } else {
+    int count = gotoPlanner.plan(start, destination, &points[n], GOTO_WAYPOINTS_MAX);
+    if (count < 0) return -1;
+    if (count > 0) (*planned)++;
+    n += count;
+  }
+  points[n++] = *destination;
+  return n;
+}
+
+static void randomPairs(double latitude) {
+  setLatitude(latitude);
+  srand(1);
+
+  int flips = 0, planned = 0, fixedBlocked = 0, fixedCompared = 0;
+  double newSeconds = 0.0, fixedSeconds = 0.0, planUs = 0.0, planUsMax = 0.0;
+  long checksMax = 0;
+  Coordinate points[GOTO_WAYPOINTS_MAX + 2], fixed[5];
+  for (int k = 0; k < PAIRS; k++) {
+    Coordinate start = randomPosition();
+    Coordinate destination = randomPosition();
+    bool flip = start.pierSide != destination.pierSide;
+
+    // straight to the destination, as with MFLIP_SKIP_HOME ON
+    auto t0 = std::chrono::steady_clock::now();
+    int n = plannedPath(&start, &destination, points, false, &planned);
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    planUs += us;
+    if (us > planUsMax) planUsMax = us;
+    if (gotoPlanner.checks > checksMax) checksMax = gotoPlanner.checks;
+    snprintf(message, sizeof(message), "lat %.0f pair %d: h %.4f d %.4f %c to h %.4f d %.4f %c", latitude, k,
+             radToDeg(start.h), radToDeg(start.d), start.pierSide == PIER_SIDE_EAST ? 'E' : 'W',
+             radToDeg(destination.h), radToDeg(destination.d), destination.pierSide == PIER_SIDE_EAST ? 'E' : 'W');
+    TEST_ASSERT_TRUE_MESSAGE(n > 0, message);
+    TEST_ASSERT_TRUE_MESSAGE(pathTime(points, n) >= 0.0F, message);
+    if (!flip) continue;
+
+    // through home, as Goto does by default for a meridian flip
+    flips++;
+    n = plannedPath(&start, &destination, points, true, &planned);
+    TEST_ASSERT_TRUE_MESSAGE(n > 0, message);
+    float seconds = pathTime(points, n);
+    TEST_ASSERT_TRUE_MESSAGE(seconds >= 0.0F, message);
+
+    float fixedTime = pathTime(fixed, fixedPath(&start, &destination, fixed), 0.001);
+    if (fixedTime < 0.0F) { fixedBlocked++; continue; }
+    TEST_ASSERT_TRUE_MESSAGE(seconds <= fixedTime + 0.01F, message);
+    fixedCompared++;
+    newSeconds += seconds;
+    fixedSeconds += fixedTime;
+  }
+
+  snprintf(message, sizeof(message), "lat %.0f: %d pairs, %d flips, %d plans needed waypoints, plan avg %.0f us max %.0f us "
+           "%ld checks, fixed waypoints left the limits %d times, flip slews %.1fs planned vs %.1fs fixed", latitude, PAIRS,
+           flips, planned, planUs/PAIRS, planUsMax, checksMax, fixedBlocked, newSeconds/fmax(fixedCompared, 1),
+           fixedSeconds/fmax(fixedCompared, 1));
+  TEST_MESSAGE(message);
+}
+
+// a GEM with the default limits, slewing at 5 degrees per second, set before each test as
+// the DDScope plugin sets its own limits once it's running
+void setUp() {
+  transform.mountType = GEM;
+  transform.meridianFlips = true;
+  limits.settings.altitude.min = degToRadF(-10.0F);
+  limits.settings.altitude.max = degToRadF(80.0F);
+  limits.settings.pastMeridianE = degToRadF(15.0F);
+  limits.settings.pastMeridianW = degToRadF(15.0F);
+  limits.enabled(true);
+  axis1.settings.limits.min = degToRadF(-180.0F);
+  axis1.settings.limits.max = degToRadF(180.0F);
+  axis2.settings.limits.min = degToRadF(-90.0F);
+  axis2.settings.limits.max = degToRadF(90.0F);
+  axis1.setFrequencySlew(degToRadF(SLEW_RATE));
+  axis2.setFrequencySlew(degToRadF(SLEW_RATE));
+  axis1.setSlewAccelerationRate(degToRadF(SLEW_ACCEL));
+  axis2.setSlewAccelerationRate(degToRadF(SLEW_ACCEL));
+}
+
+void tearDown() {}
+
+// a slew that doesn't go near a limit needs no waypoints
+static void test_direct_slew() {
+  setLatitude(40.0);
+  Coordinate start, destination;
+  start.h = degToRad(30.0); start.d = degToRad(20.0); start.pierSide = PIER_SIDE_EAST;
+  destination.h = degToRad(60.0); destination.d = degToRad(50.0); destination.pierSide = PIER_SIDE_EAST;
+  TEST_ASSERT_EQUAL(0, gotoPlanner.plan(&start, &destination, waypoints, GOTO_WAYPOINTS_MAX));
+}
+
+// from low under the pole round to near the meridian on the same pier side, straight along the
+// declination circle would pass inside the overhead limit
+static void test_blocked_slew() {
+  setLatitude(52.0);
+  Coordinate start, destination;
+  start.h = degToRad(-174.0); start.d = degToRad(43.6); start.pierSide = PIER_SIDE_WEST;
+  destination.h = degToRad(9.7); destination.d = degToRad(44.1); destination.pierSide = PIER_SIDE_WEST;
+  double a1s, a2s, a1d, a2d;
+  transform.mountToInstrument(&start, &a1s, &a2s);
+  transform.mountToInstrument(&destination, &a1d, &a2d);
+  TEST_ASSERT_TRUE(gotoPlanner.clear(a1s, a2s) && gotoPlanner.clear(a1d, a2d));
+  TEST_ASSERT_FALSE(gotoPlanner.clear(a1s, a2s, a1d, a2d));
+
+  Coordinate points[GOTO_WAYPOINTS_MAX + 2];
+  int planned = 0;
+  int n = plannedPath(&start, &destination, points, false, &planned);
+  TEST_ASSERT_TRUE(n > 2);
+  TEST_ASSERT_TRUE(pathTime(points, n) > 0.0F);
+}
+
+static void test_random_pairs_equator() { randomPairs(0.0); }
+static void test_random_pairs_20n() { randomPairs(20.0); }
+static void test_random_pairs_35n() { randomPairs(35.0); }
+static void test_random_pairs_52n() { randomPairs(52.0); }
+static void test_random_pairs_70n() { randomPairs(70.0); }
+static void test_random_pairs_35s() { randomPairs(-35.0); }
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  nativeFirmwareBegin();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_direct_slew);
+  RUN_TEST(test_blocked_slew);
+  RUN_TEST(test_random_pairs_equator);
+  RUN_TEST(test_random_pairs_20n);
+  RUN_TEST(test_random_pairs_35n);
+  RUN_TEST(test_random_pairs_52n);
+  RUN_TEST(test_random_pairs_70n);
+  RUN_TEST(test_random_pairs_35s);
+  return UNITY_END();
+}
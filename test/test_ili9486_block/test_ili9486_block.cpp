@@ -0,0 +1,140 @@
+// -----------------------------------------------------------------------------------
+// ILI9486 driver block writes, each primitive is one SPI transaction with the address window
+// and the pixels under two chip selects, the bytes on the bus are the window then the pixels
+// big endian, and pushed images land in the mirror capture buffer as drawn
+
+#include <unity.h>
+#include <stdlib.h>
+
+#include "src/Common.h"
+#include "src/plugins/DDScope/display/Display.h"
+#include "src/plugins/DDScope/display/WifiDisplay.h"
+
+// CASET, PASET and RAMWR with their start and end coordinates
+#define WINDOW_BYTES 11
+
+static uint16_t image[64*40];
+static char message[120];
+
+static uint16_t pixel(int x, int y) {
+  const uint8_t *p = uncompressedBuffer + (y*SCREEN_WIDTH + x)*COLOR_DEPTH;
+  return (p[0] << 8) | p[1];
+}
+
+static void begin() {
+  SPI.reset();
+  SPI.capture = true;
+  nativePinFalls[TFT_CS] = 0;
+}
+
+// one transaction, two chip selects (window then pixels), the window and w*h pixels of the color
+static void assertPrimitive(const char *name, int x0, int y0, int x1, int y1, uint16_t color) {
+  snprintf(message, sizeof(message), "%s %d transactions %d chip selects", name, (int)SPI.transactions, (int)nativePinFalls[TFT_CS]);
+  TEST_ASSERT_EQUAL_MESSAGE(1, SPI.transactions, message);
+  TEST_ASSERT_EQUAL_MESSAGE(2, nativePinFalls[TFT_CS], message);
+  TEST_ASSERT_EQUAL_MESSAGE(HIGH, nativePins[TFT_CS], message);
+
+  long pixels = (long)(x1 - x0 + 1)*(y1 - y0 + 1);
+  TEST_ASSERT_EQUAL_MESSAGE(WINDOW_BYTES + pixels*2, SPI.data.size(), message);
+  const uint8_t window[WINDOW_BYTES] = { ILI9486_CASET, (uint8_t)(x0 >> 8), (uint8_t)x0, (uint8_t)(x1 >> 8), (uint8_t)x1,
+                                         ILI9486_PASET, (uint8_t)(y0 >> 8), (uint8_t)y0, (uint8_t)(y1 >> 8), (uint8_t)y1, ILI9486_RAMWR };
+  TEST_ASSERT_EQUAL_MEMORY_MESSAGE(window, SPI.data.data(), WINDOW_BYTES, message);
+  for (long i = 0; i < pixels; i++) {
+    const uint8_t *p = SPI.data.data() + WINDOW_BYTES + i*2;
+    if (p[0] != (color >> 8) || p[1] != (color & 0xFF)) TEST_FAIL_MESSAGE(message);
+  }
+}
+
+void setUp() {
+  digitalWrite(TFT_CS, HIGH);
+  wifiDisplay.enableScreenCapture(true);
+  srand(2);
+  for (unsigned i = 0; i < sizeof(image)/sizeof(image[0]); i++) image[i] = (uint16_t)rand();
+}
+
+void tearDown() {
+  SPI.capture = false;
+  SPI.data.clear();
+  wifiDisplay.enableScreenCapture(false);
+}
+
+static void test_primitives() {
+  begin(); tft.drawPixel(10, 20, 0x1234);
+  assertPrimitive("drawPixel", 10, 20, 10, 20, 0x1234);
+  begin(); tft.drawFastHLine(5, 30, 100, 0xF800);
+  assertPrimitive("drawFastHLine", 5, 30, 104, 30, 0xF800);
+  begin(); tft.drawFastVLine(300, 10, 400, 0x07E0);
+  assertPrimitive("drawFastVLine", 300, 10, 300, 409, 0x07E0);
+  begin(); tft.fillRect(17, 33, 211, 95, 0xABCD);
+  assertPrimitive("fillRect", 17, 33, 227, 127, 0xABCD);
+  // clipped at the screen edge
+  begin(); tft.fillRect(-10, 470, 30, 30, 0x0F0F);
+  assertPrimitive("fillRect clipped", 0, 470, 19, 479, 0x0F0F);
+  begin(); tft.fillScreen(0x0841);
+  assertPrimitive("fillScreen", 0, 0, TFTWIDTH - 1, TFTHEIGHT - 1, 0x0841);
+
+  // and the mirror saw the same
+  TEST_ASSERT_EQUAL_HEX16(0x0841, pixel(10, 20));
+  TEST_ASSERT_EQUAL_HEX16(0x0841, pixel(TFTWIDTH - 1, TFTHEIGHT - 1));
+}
+
+// the pixels go out in buffer transfers of at most SPIBLOCKMAX, not two byte writes each
+static void test_block_transfers() {
+  begin(); tft.fillScreen(0);
+  TEST_ASSERT_TRUE(SPI.calls <= 8 + (TFTWIDTH*TFTHEIGHT + SPIBLOCKMAX - 1)/SPIBLOCKMAX);
+  begin(); tft.pushImage(0, 0, 64, 40, image);
+  TEST_ASSERT_TRUE(SPI.calls <= 8 + (64*40 + SPIBLOCKMAX - 1)/SPIBLOCKMAX);
+}
+
+static void test_push_image() {
+  tft.fillScreen(0);
+  begin(); tft.pushImage(100, 200, 64, 40, image);
+  TEST_ASSERT_EQUAL(1, SPI.transactions);
+  TEST_ASSERT_EQUAL(WINDOW_BYTES + 64*40*2, SPI.data.size());
+  for (int r = 0; r < 40; r++) {
+    for (int c = 0; c < 64; c++) {
+      uint16_t color = image[r*64 + c];
+      const uint8_t *p = SPI.data.data() + WINDOW_BYTES + (r*64 + c)*2;
+      TEST_ASSERT_EQUAL_HEX16(color, (p[0] << 8) | p[1]);
+      TEST_ASSERT_EQUAL_HEX16(color, pixel(100 + c, 200 + r));
+    }
+  }
+  // around it is untouched
+  TEST_ASSERT_EQUAL_HEX16(0, pixel(99, 200));
+  TEST_ASSERT_EQUAL_HEX16(0, pixel(164, 239));
+  TEST_ASSERT_EQUAL_HEX16(0, pixel(100, 240));
+}
+
+// an image over the right and bottom edges sends and captures only the part on the screen
+static void test_push_image_clipped() {
+  tft.fillScreen(0);
+  begin(); tft.pushImage(TFTWIDTH - 24, TFTHEIGHT - 10, 64, 40, image);
+  TEST_ASSERT_EQUAL(1, SPI.transactions);
+  TEST_ASSERT_EQUAL(WINDOW_BYTES + 24*10*2, SPI.data.size());
+  for (int r = 0; r < 10; r++) {
+    for (int c = 0; c < 24; c++) TEST_ASSERT_EQUAL_HEX16(image[r*64 + c], pixel(TFTWIDTH - 24 + c, TFTHEIGHT - 10 + r));
+  }
+
+  // and over the left and top edges
+  tft.fillScreen(0);
+  begin(); tft.pushImage(-30, -5, 64, 40, image);
+  TEST_ASSERT_EQUAL(WINDOW_BYTES + 34*35*2, SPI.data.size());
+  for (int r = 0; r < 35; r++) {
+    for (int c = 0; c < 34; c++) TEST_ASSERT_EQUAL_HEX16(image[(r + 5)*64 + c + 30], pixel(c, r));
+  }
+
+  // entirely off the screen sends nothing
+  begin(); tft.pushImage(TFTWIDTH, 0, 64, 40, image);
+  TEST_ASSERT_EQUAL(0, SPI.transactions);
+  TEST_ASSERT_EQUAL(0, SPI.data.size());
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_primitives);
+  RUN_TEST(test_block_transfers);
+  RUN_TEST(test_push_image);
+  RUN_TEST(test_push_image_clipped);
+  return UNITY_END();
+}
@@ -0,0 +1,167 @@
+// -----------------------------------------------------------------------------------
+// Limits monitor, fast guide slews on a GEM toward the meridian, axis and altitude limits, each
+// must be caught within a few arc-seconds of the limit and the mount brought to a stop
+
+#include <unity.h>
+
+#include "src/Common.h"
+#include "NativeFirmware.h"
+#include "src/telescope/mount/Mount.h"
+#include "src/telescope/mount/coordinates/Transform.h"
+#include "src/telescope/mount/guide/Guide.h"
+#include "src/telescope/mount/goto/Goto.h"
+#include "src/telescope/mount/limits/Limits.h"
+#include "src/telescope/mount/site/Site.h"
+
+// arc-seconds past a limit when the monitor first reports it, polling every 100ms a 6 degree per
+// second slew could be up to 2160" past
+#define OVERSHOOT_MAX 60.0
+
+// Limits::errorCode() values
+#define ERR_ALT_MIN    2
+#define ERR_DEC        4
+#define ERR_UNDER_POLE 6
+#define ERR_MERIDIAN   7
+#define ERR_ALT_MAX    12
+
+typedef struct {
+  const char *name;
+  double h, d;                 // start, degrees on the east side of the pier
+  GuideAction axis1, axis2;    // GA_NONE, GA_FORWARD (increasing) or GA_REVERSE
+  uint8_t error;
+} SlewCase;
+
+static const SlewCase cases[] = {
+  { "meridian east", 30.0,  20.0, GA_REVERSE, GA_NONE,    ERR_MERIDIAN   },
+  { "axis1 max",     60.0,  20.0, GA_FORWARD, GA_NONE,    ERR_UNDER_POLE },
+  { "axis2 min",     0.0,   20.0, GA_NONE,    GA_REVERSE, ERR_DEC        },
+  { "axis2 max",     14.0,  60.0, GA_NONE,    GA_FORWARD, ERR_DEC        },
+  { "altitude min",  30.0,  10.0, GA_FORWARD, GA_REVERSE, ERR_ALT_MIN    },
+  { "altitude max",  40.0,  10.0, GA_REVERSE, GA_FORWARD, ERR_ALT_MAX    },
+};
+
+static char message[160];
+
+// how far past the limits the mount is, in arc-seconds, worked out here rather than by Limits
+static double pastLimits(double *altitude) {
+  Coordinate c = mount.getMountPosition(CR_MOUNT);
+  double lat = site.location.latitude;
+  *altitude = asin(sin(c.d)*sin(lat) + cos(c.d)*cos(lat)*cos(c.h));
+  double past = 0.0;
+  past = fmax(past, -limits.settings.pastMeridianE - c.h);
+  past = fmax(past, c.a1 - axis1.settings.limits.max);
+  past = fmax(past, axis1.settings.limits.min - c.a1);
+  past = fmax(past, c.a2 - axis2.settings.limits.max);
+  past = fmax(past, axis2.settings.limits.min - c.a2);
+  past = fmax(past, *altitude - limits.settings.altitude.max);
+  past = fmax(past, limits.settings.altitude.min - *altitude);
+  return radToDeg(past)*3600.0;
+}
+
+static void waitForStop() {
+  for (int i = 0; i < 60000 && (axis1.isSlewing() || axis2.isSlewing()); i++) nativeFirmwareRun(1);
+}
+
+// the ODrive axes can't be synced far, so each test slews to its start with the axis limits opened out
+static void moveTo(double a1, double a2) {
+  axis1.settings.limits.min = -Deg180;
+  axis1.settings.limits.max = Deg180;
+  axis2.settings.limits.min = -Deg90;
+  axis2.settings.limits.max = Deg90;
+  axis1.setTargetCoordinate(a1);
+  axis2.setTargetCoordinate(a2);
+  TEST_ASSERT_EQUAL(CE_NONE, axis1.autoGoto(degToRadF(5.0F), degToRadF(20.0F)));
+  TEST_ASSERT_EQUAL(CE_NONE, axis2.autoGoto(degToRadF(5.0F), degToRadF(20.0F)));
+  waitForStop();
+  mount.setHome(false);
+}
+
+// a GEM at latitude 40 slewing at 6 degrees per second, accelerating at 4 degrees per second per
+// second, set before each test as the DDScope plugin sets its own limits once it's running
+void setUp() {
+  nativeFirmwareBegin();
+  guide.stop();
+  waitForStop();
+  mount.tracking(false);
+
+  site.location.latitude = degToRad(40.0);
+  site.updateLocation();
+  transform.mountType = GEM;
+  transform.meridianFlips = true;
+  mount.enable(true);
+}
+
+void tearDown() {}
+
+// the limits from the host simulation the monitor was tuned with
+static void setLimits() {
+  limits.settings.altitude.min = degToRadF(-10.0F);
+  limits.settings.altitude.max = degToRadF(80.0F);
+  limits.settings.pastMeridianE = degToRadF(15.0F);
+  limits.settings.pastMeridianW = degToRadF(15.0F);
+  limits.enabled(true);
+  axis1.settings.limits.min = degToRadF(-170.0F);
+  axis1.settings.limits.max = degToRadF(100.0F);
+  axis2.settings.limits.min = degToRadF(-40.0F);
+  axis2.settings.limits.max = degToRadF(88.0F);
+  goTo.rate = degToRadF(6.0F);
+  axis1.setSlewAccelerationRate(degToRadF(4.0F));
+  axis2.setSlewAccelerationRate(degToRadF(4.0F));
+}
+
+static void slewTowardLimit(const SlewCase *c) {
+  Coordinate start;
+  start.h = degToRad(c->h);
+  start.d = degToRad(c->d);
+  start.pierSide = PIER_SIDE_EAST;
+  double a1, a2, altitude;
+  transform.mountToInstrument(&start, &a1, &a2);
+  moveTo(a1, a2);
+  setLimits();
+
+  // let the monitor see the new position before moving
+  nativeFirmwareRun(LIMITS_FULL_CHECK_MS);
+  snprintf(message, sizeof(message), "%s: error %d at the start", c->name, limits.errorCode());
+  TEST_ASSERT_FALSE_MESSAGE(limits.errorCode() == c->error, message);
+
+  if (c->axis1 != GA_NONE) TEST_ASSERT_EQUAL(CE_NONE, guide.startAxis1(c->axis1, GR_MAX, 0));
+  if (c->axis2 != GA_NONE) TEST_ASSERT_EQUAL(CE_NONE, guide.startAxis2(c->axis2, GR_MAX, 0));
+
+  // run the firmware a pass at a time until the monitor reports the limit
+  double past = pastLimits(&altitude);
+  unsigned long t0 = millis();
+  while (limits.errorCode() != c->error && millis() - t0 < 60000) {
+    loop();
+    past = pastLimits(&altitude);
+  }
+  snprintf(message, sizeof(message), "%s: not reported, error %d after %lu ms", c->name, limits.errorCode(), millis() - t0);
+  TEST_ASSERT_EQUAL_MESSAGE(c->error, limits.errorCode(), message);
+
+  snprintf(message, sizeof(message), "%s: reported after %.2fs %.1f\" past the limit (altitude %.2f)", c->name,
+           (millis() - t0)/1000.0, past, radToDeg(altitude));
+  TEST_MESSAGE(message);
+  TEST_ASSERT_TRUE_MESSAGE(past < OVERSHOOT_MAX, message);
+
+  waitForStop();
+  snprintf(message, sizeof(message), "%s: still moving", c->name);
+  TEST_ASSERT_FALSE_MESSAGE(axis1.isSlewing() || axis2.isSlewing(), message);
+}
+
+static void test_meridian_east() { slewTowardLimit(&cases[0]); }
+static void test_axis1_max() { slewTowardLimit(&cases[1]); }
+static void test_axis2_min() { slewTowardLimit(&cases[2]); }
+static void test_axis2_max() { slewTowardLimit(&cases[3]); }
+static void test_altitude_min() { slewTowardLimit(&cases[4]); }
+static void test_altitude_max() { slewTowardLimit(&cases[5]); }
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_meridian_east);
+  RUN_TEST(test_axis1_max);
+  RUN_TEST(test_axis2_min);
+  RUN_TEST(test_axis2_max);
+  RUN_TEST(test_altitude_min);
+  RUN_TEST(test_altitude_max);
+  return UNITY_END();
+}
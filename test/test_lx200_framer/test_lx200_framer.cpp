@@ -0,0 +1,114 @@
+// -----------------------------------------------------------------------------------
+// LX200Handler framer on the ESP32C3 link, a burst of 'L' requested commands is answered in one
+// poll and one write with an ACK then the reply for each, a frame split across polls is
+// completed on a later poll, and a stalled or overlong frame is dropped without upsetting the next
+
+#include <unity.h>
+#include <string>
+
+#include "src/Common.h"
+#include "NativeFirmware.h"
+#include "src/plugins/DDScope/display/Display.h"
+#include "src/plugins/DDScope/lx200/LX200Handler.h"
+
+static char message[200];
+
+// the reply LX200Handler::process() gives for a getter, asked of the display directly
+static std::string reply(const char *cmd) {
+  char r[LX200_REPLY_MAX] = "";
+  display.commandWithReply(cmd, r);
+  size_t len = strlen(r);
+  if (len == 0 || r[len - 1] != '#') strcat(r, "#");
+  return std::string(r);
+}
+
+// one poll with this input, returns what was written
+static std::string poll(const char *in) {
+  SERIAL_ESP32C3.inject(in);
+  SERIAL_ESP32C3.tx.clear();
+  SERIAL_ESP32C3.writes = 0;
+  lx200Handler.lxPoll();
+  return SERIAL_ESP32C3.tx;
+}
+
+// one poll with this input must write exactly the expected
+static void assertPoll(const char *in, const std::string &expected) {
+  std::string out = poll(in);
+  snprintf(message, sizeof(message), "after \"%s\"", in);
+  TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), out.c_str(), message);
+}
+
+void setUp() {
+  nativeFirmwareBegin();
+  SERIAL_ESP32C3.rx.clear();
+  // any partial frame left over times out
+  nativeClock.advance((LX200_FRAME_TIMEOUT_MS + 1)*1000UL);
+  poll("");
+}
+
+void tearDown() {}
+
+static void test_burst() {
+  const char *cmds[] = { ":GR#", ":GD#", ":GA#", ":GZ#", ":GG#", ":Gt#", ":Gg#", ":GR#" };
+  std::string in, expected;
+  for (int i = 0; i < 8; i++) { in += "L"; in += cmds[i]; expected += "K" + reply(cmds[i]); }
+  std::string out = poll(in.c_str());
+  snprintf(message, sizeof(message), "burst of %d bytes answered with \"%s\"", (int)in.size(), out.c_str());
+  TEST_MESSAGE(message);
+  TEST_ASSERT_EQUAL(1, SERIAL_ESP32C3.writes);
+  TEST_ASSERT_EQUAL(0, SERIAL_ESP32C3.available());
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), out.c_str());
+}
+
+// the ACK goes out on the poll the 'L' arrives, the reply on the poll the '#' arrives
+static void test_split_frame() {
+  assertPoll("L:", "K");
+  nativeClock.advance(5000);
+  assertPoll("G", "");
+  TEST_ASSERT_EQUAL(0, SERIAL_ESP32C3.writes);
+  nativeClock.advance(5000);
+  assertPoll("D#L", reply(":GD#") + "K");
+  nativeClock.advance(5000);
+  assertPoll(":GD#", reply(":GD#"));
+}
+
+// a frame that stalls is dropped, its tail is ignored and the next request is answered
+static void test_stalled_frame() {
+  assertPoll("L:G", "K");
+  nativeClock.advance((LX200_FRAME_TIMEOUT_MS + 1)*1000UL);
+  assertPoll("", "");
+  assertPoll("D#", "");
+  assertPoll("L:GR#", "K" + reply(":GR#"));
+}
+
+// a frame longer than LX200_CMD_MAX, or one not starting with ':', is dropped
+static void test_bad_frames() {
+  std::string in = "L:";
+  for (int i = 0; i < LX200_CMD_MAX + 10; i++) in += "G";
+  in += "#";
+  assertPoll(in.c_str(), "K");
+  assertPoll("LGR#", "K");
+  assertPoll("L:GR#", "K" + reply(":GR#"));
+}
+
+// a repeated 'L' before the command is one request
+static void test_repeated_request() {
+  assertPoll("LL:GD#", "KK" + reply(":GD#"));
+}
+
+// an object that isn't in the catalogs, answered without going to the command channel
+static void test_object_not_found() {
+  assertPoll("L:ONNoSuchObject#L:GR#", "K0#K" + reply(":GR#"));
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_burst);
+  RUN_TEST(test_split_frame);
+  RUN_TEST(test_stalled_frame);
+  RUN_TEST(test_bad_frames);
+  RUN_TEST(test_repeated_request);
+  RUN_TEST(test_object_not_found);
+  return UNITY_END();
+}
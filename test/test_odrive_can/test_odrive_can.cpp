@@ -0,0 +1,273 @@
+// -----------------------------------------------------------------------------------
+// ODriveTeensyCAN on the mock CAN bus, replies are cached by axis and command id, a full
+// request queue or receive ring loses nothing already accepted, timestamps age with the clock
+// and Heartbeat() only reports heartbeat frames, streamed setpoints carry a sidereal rate
+// velocity feed-forward
+
+#include <unity.h>
+
+#include "src/Common.h"
+#include "FlexCAN_T4.h"
+#include "src/plugins/DDScope/ODriveTeensyCAN/ODriveTeensyCAN.h"
+
+#define CMD_HEARTBEAT  ODriveTeensyCAN::CMD_ID_ODRIVE_HEARTBEAT_MESSAGE
+#define CMD_ESTIMATES  ODriveTeensyCAN::CMD_ID_GET_ENCODER_ESTIMATES
+#define CMD_IQ         ODriveTeensyCAN::CMD_ID_GET_IQ
+#define CMD_VBUS       ODriveTeensyCAN::CMD_ID_GET_VBUS_VOLTAGE_CURRENT
+#define CMD_INPUT_POS  ODriveTeensyCAN::CMD_ID_SET_INPUT_POS
+#define CMD_INPUT_VEL  ODriveTeensyCAN::CMD_ID_SET_INPUT_VEL
+
+// one turn per sidereal day in turns/s, a direct drive axis tracking
+#define SIDEREAL_TURNS (1.0F/86164.09F)
+
+static char message[120];
+
+// a reply from the ODrive with two floats
+static void reply(int axis_id, int cmd_id, float a, float b) {
+  CAN_message_t msg;
+  msg.id = (axis_id << 5) + cmd_id;
+  msg.len = 8;
+  memcpy(msg.buf, &a, 4);
+  memcpy(msg.buf + 4, &b, 4);
+  nativeCan.rx.push_back(msg);
+}
+
+// the heartbeat the ODrive broadcasts
+static void heartbeat(int axis_id, uint32_t axisError, uint8_t state, uint8_t controllerFlags) {
+  CAN_message_t msg;
+  msg.id = (axis_id << 5) + CMD_HEARTBEAT;
+  msg.len = 8;
+  memcpy(msg.buf, &axisError, 4);
+  msg.buf[4] = state;
+  msg.buf[7] = controllerFlags;
+  nativeCan.rx.push_back(msg);
+}
+
+// what the ODrive firmware does with the setpoint frames on the bus, Set_Input_Pos has the velocity
+// feed-forward as an int16_t in 0.001 turn/s and Set_Input_Vel has it as a float, the last one wins
+typedef struct {
+  float position, velocity;
+  int frames;
+} ODriveInput;
+
+static ODriveInput odriveInput(int axis_id) {
+  ODriveInput in = { 0.0F, 0.0F, 0 };
+  for (const CAN_message_t &msg : nativeCan.tx) {
+    if ((int)(msg.id >> 5) != axis_id) continue;
+    if ((msg.id & 0x1F) == CMD_INPUT_POS) {
+      int16_t vel_ff;
+      memcpy(&in.position, msg.buf, 4);
+      memcpy(&vel_ff, msg.buf + 4, 2);
+      in.velocity = vel_ff*0.001F;
+      in.frames++;
+    } else if ((msg.id & 0x1F) == CMD_INPUT_VEL) {
+      memcpy(&in.velocity, msg.buf, 4);
+      in.frames++;
+    }
+  }
+  return in;
+}
+
+// a driver that has already sent its first periodic requests, with the clock held so no more
+// come due until a test moves it on
+static ODriveTeensyCAN *driver() {
+  static ODriveTeensyCAN *odrive = NULL;
+  if (odrive == NULL) odrive = new ODriveTeensyCAN(250000);
+  nativeClock.hold(1);
+  nativeClock.advance(ODRIVE_CAN_VBUS_MS*1000UL);
+  odrive->poll();
+  while (odrive->Heartbeat() >= 0) {}
+  nativeCan.reset();
+  return odrive;
+}
+
+void setUp() {}
+void tearDown() { nativeCan.reset(); }
+
+// each reply lands under its own axis and command id, frames for other node ids are ignored
+static void test_reply_dispatch() {
+  ODriveTeensyCAN *odrive = driver();
+  reply(0, CMD_ESTIMATES, 1.25F, 0.5F);
+  reply(1, CMD_ESTIMATES, -7.75F, -0.25F);
+  reply(1, CMD_IQ, 0.0F, 3.5F);
+  reply(0, CMD_VBUS, 24.1F, 0.0F);
+  reply(5, CMD_ESTIMATES, 99.0F, 99.0F);
+  heartbeat(1, 0x42, 8, 0x05);
+  odrive->poll();
+
+  TEST_ASSERT_EQUAL_FLOAT(1.25F, odrive->LatestPosition(0));
+  TEST_ASSERT_EQUAL_FLOAT(0.5F, odrive->LatestVelocity(0));
+  TEST_ASSERT_EQUAL_FLOAT(-7.75F, odrive->LatestPosition(1));
+  TEST_ASSERT_EQUAL_FLOAT(-0.25F, odrive->LatestVelocity(1));
+  TEST_ASSERT_EQUAL_FLOAT(3.5F, odrive->LatestIqMeasured(1));
+  TEST_ASSERT_EQUAL_FLOAT(24.1F, odrive->LatestVbusVoltage());
+  TEST_ASSERT_EQUAL_HEX32(0x42, odrive->GetAxisError(1));
+  TEST_ASSERT_EQUAL(8, odrive->GetCurrentState(1));
+  TEST_ASSERT_EQUAL(0x05, odrive->GetControllerFlags(1));
+  TEST_ASSERT_EQUAL_HEX32(0, odrive->GetAxisError(0));
+  TEST_ASSERT_EQUAL(0, nativeCan.rx.size());
+}
+
+// a blocking getter takes its own reply and still caches the frames that arrive before it
+static void test_blocking_get_keeps_other_replies() {
+  ODriveTeensyCAN *odrive = driver();
+  reply(1, CMD_IQ, 0.0F, 1.0F);
+  reply(0, CMD_ESTIMATES, 2.0F, 0.0F);
+  reply(1, CMD_ESTIMATES, 7.5F, 0.0F);
+  TEST_ASSERT_EQUAL_FLOAT(7.5F, odrive->GetPosition(1));
+  TEST_ASSERT_EQUAL_FLOAT(1.0F, odrive->LatestIqMeasured(1));
+  TEST_ASSERT_EQUAL_FLOAT(2.0F, odrive->LatestPosition(0));
+
+  // the remote request went out for axis 1
+  TEST_ASSERT_EQUAL(1, nativeCan.tx.size());
+  TEST_ASSERT_EQUAL_HEX32((1 << 5) + CMD_ESTIMATES, nativeCan.tx.front().id);
+  TEST_ASSERT_TRUE(nativeCan.tx.front().flags.remote);
+
+  // and with no reply it gives up after the timeout
+  unsigned long start = millis();
+  odrive->GetPosition(0);
+  TEST_ASSERT_TRUE(millis() - start >= 5);
+}
+
+// requests wait for free transmit mailboxes and go out in order, one entry per CAN id
+static void test_request_queue_overflow() {
+  ODriveTeensyCAN *odrive = driver();
+  nativeCan.txMailboxes = 0;
+  for (int i = 0; i < ODRIVE_CAN_TX_QUEUE; i++) {
+    TEST_ASSERT_TRUE(odrive->request(i % ODRIVE_CAN_AXES, 0x03 + i/ODRIVE_CAN_AXES));
+  }
+  TEST_ASSERT_TRUE(odrive->request(0, 0x03));
+  TEST_ASSERT_FALSE(odrive->request(1, CMD_VBUS));
+  TEST_ASSERT_FALSE(odrive->request(ODRIVE_CAN_AXES, CMD_IQ));
+  TEST_ASSERT_FALSE(odrive->request(0, ODRIVE_CAN_CMDS));
+
+  odrive->poll();
+  TEST_ASSERT_EQUAL(0, nativeCan.tx.size());
+
+  nativeCan.txMailboxes = 3;
+  odrive->poll();
+  TEST_ASSERT_EQUAL(3, nativeCan.tx.size());
+  nativeCan.tx.clear();
+  nativeCan.txMailboxes = 16;
+  odrive->poll();
+  TEST_ASSERT_EQUAL(ODRIVE_CAN_TX_QUEUE - 3, nativeCan.tx.size());
+  nativeCan.tx.clear();
+
+  // all sent in the order queued, now the queue has room again
+  TEST_ASSERT_EQUAL(ODRIVE_CAN_TX_QUEUE, nativeCan.writes);
+  TEST_ASSERT_TRUE(odrive->request(1, CMD_VBUS));
+  odrive->poll();
+  TEST_ASSERT_EQUAL(1, nativeCan.tx.size());
+  TEST_ASSERT_EQUAL_HEX32((1 << 5) + CMD_VBUS, nativeCan.tx.front().id);
+}
+
+// more frames than the receive ring holds stay with the controller until the next poll
+static void test_receive_ring_overflow() {
+  ODriveTeensyCAN *odrive = driver();
+  int frames = ODRIVE_CAN_RX_RING + 8;
+  for (int i = 0; i < frames; i++) reply(0, CMD_ESTIMATES, (float)i, 0.0F);
+  odrive->poll();
+  TEST_ASSERT_EQUAL(frames - ODRIVE_CAN_RX_RING, nativeCan.rx.size());
+  TEST_ASSERT_EQUAL_FLOAT((float)(ODRIVE_CAN_RX_RING - 1), odrive->LatestPosition(0));
+  odrive->poll();
+  TEST_ASSERT_EQUAL(0, nativeCan.rx.size());
+  TEST_ASSERT_EQUAL_FLOAT((float)(frames - 1), odrive->LatestPosition(0));
+}
+
+// each value carries the time its frame arrived, values never received read 0 with no time
+static void test_stale_timestamps() {
+  ODriveTeensyCAN *odrive = driver();
+  unsigned long time;
+  TEST_ASSERT_EQUAL_FLOAT(0.0F, odrive->LatestIqMeasured(0, &time));
+  TEST_ASSERT_EQUAL(0, time);
+  TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFF, odrive->age(0, CMD_IQ));
+  TEST_ASSERT_FALSE(odrive->latest(0, CMD_IQ, NULL));
+
+  reply(0, CMD_IQ, 0.0F, 2.0F);
+  odrive->poll();
+  unsigned long arrived = millis();
+  nativeClock.advance(250*1000UL);
+  TEST_ASSERT_EQUAL_FLOAT(2.0F, odrive->LatestIqMeasured(0, &time));
+  TEST_ASSERT_UINT32_WITHIN(1, arrived, time);
+  snprintf(message, sizeof(message), "age %lu ms", odrive->age(0, CMD_IQ));
+  TEST_ASSERT_UINT32_WITHIN_MESSAGE(1, 250, odrive->age(0, CMD_IQ), message);
+
+  // a stale value is still there until a new frame replaces it
+  TEST_ASSERT_EQUAL_FLOAT(2.0F, odrive->LatestIqMeasured(0));
+  reply(0, CMD_IQ, 0.0F, 2.5F);
+  odrive->poll();
+  TEST_ASSERT_EQUAL_FLOAT(2.5F, odrive->LatestIqMeasured(0, &time));
+  TEST_ASSERT_UINT32_WITHIN(1, millis(), time);
+  TEST_ASSERT_UINT32_WITHIN(1, 0, odrive->age(0, CMD_IQ));
+
+  // the arrival count wraps without reading as never received
+  for (int i = 0; i < 256; i++) { reply(0, CMD_IQ, 0.0F, 3.0F); odrive->poll(); }
+  TEST_ASSERT_TRUE(odrive->latest(0, CMD_IQ, NULL));
+  TEST_ASSERT_EQUAL_FLOAT(3.0F, odrive->LatestIqMeasured(0));
+}
+
+// Heartbeat() used to read any frame off the bus and return its node id, now other frames go to
+// the telemetry and it reports the axis of the latest heartbeat once, or -1 if none came
+static void test_heartbeat() {
+  ODriveTeensyCAN *odrive = driver();
+  TEST_ASSERT_EQUAL(-1, odrive->Heartbeat());
+
+  reply(1, CMD_ESTIMATES, 1.0F, 0.0F);
+  TEST_ASSERT_EQUAL(-1, odrive->Heartbeat());
+  TEST_ASSERT_EQUAL_FLOAT(1.0F, odrive->LatestPosition(1));
+
+  heartbeat(1, 0, 8, 0);
+  TEST_ASSERT_EQUAL(1, odrive->Heartbeat());
+  TEST_ASSERT_EQUAL(-1, odrive->Heartbeat());
+
+  heartbeat(0, 0, 1, 0);
+  heartbeat(1, 0, 8, 0);
+  odrive->poll();
+  TEST_ASSERT_EQUAL(1, odrive->Heartbeat());
+  TEST_ASSERT_EQUAL(1, odrive->GetCurrentState(0));
+}
+
+// the Set_Input_Pos feed-forward alone would round a sidereal rate to 0, the setpoint reaches the ODrive
+// with the full rate and a frame that doesn't get a mailbox goes on the next poll
+static void test_stream_sidereal_feedforward() {
+  ODriveTeensyCAN *odrive = driver();
+  odrive->stream(0, 12.5F, SIDEREAL_TURNS);
+  odrive->stream(1, -3.25F, -2.5F);
+  nativeCan.txMailboxes = 3;
+  odrive->poll();
+
+  ODriveInput in = odriveInput(0);
+  snprintf(message, sizeof(message), "axis 0 velocity %.4e turns/s from %d frame(s)", in.velocity, in.frames);
+  TEST_ASSERT_EQUAL_MESSAGE(2, in.frames, message);
+  TEST_ASSERT_EQUAL_FLOAT(12.5F, in.position);
+  TEST_ASSERT_FLOAT_WITHIN_MESSAGE(SIDEREAL_TURNS*1.0e-4F, SIDEREAL_TURNS, in.velocity, message);
+
+  // axis 1 got its position, the rest is still pending
+  in = odriveInput(1);
+  TEST_ASSERT_EQUAL(1, in.frames);
+  TEST_ASSERT_EQUAL_FLOAT(-3.25F, in.position);
+  TEST_ASSERT_EQUAL_FLOAT(-2.5F, in.velocity);
+  TEST_ASSERT_FALSE(odrive->streamPending(0));
+  TEST_ASSERT_TRUE(odrive->streamPending(1));
+
+  nativeCan.txMailboxes = 16;
+  odrive->poll();
+  in = odriveInput(1);
+  TEST_ASSERT_EQUAL(2, in.frames);
+  TEST_ASSERT_EQUAL_FLOAT(-2.5F, in.velocity);
+  TEST_ASSERT_FALSE(odrive->streamPending(1));
+  TEST_ASSERT_EQUAL(4, nativeCan.writes);
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_reply_dispatch);
+  RUN_TEST(test_blocking_get_keeps_other_replies);
+  RUN_TEST(test_request_queue_overflow);
+  RUN_TEST(test_receive_ring_overflow);
+  RUN_TEST(test_stale_timestamps);
+  RUN_TEST(test_heartbeat);
+  RUN_TEST(test_stream_sidereal_feedforward);
+  return UNITY_END();
+}
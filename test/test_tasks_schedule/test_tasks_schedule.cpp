@@ -0,0 +1,164 @@
+// -----------------------------------------------------------------------------------
+// OnTask dispatch, tasks run at their periods, follow period changes, immediate() and remove(),
+// a yield() runs one task, and a yield() from inside a task only runs higher priority tasks. The same suite runs against
+// the heap scheduler in the native_bench_heap environment (TASKS_SCHEDULER_HEAP)
+
+#include <unity.h>
+
+#include "src/Common.h"
+#include "src/lib/tasks/OnTask.h"
+
+// microseconds of held time between yield() calls
+#define STEP_MICROS 10
+
+static volatile long runsFast = 0, runsMs = 0, runsSlow = 0, runsRare = 0, runsNested = 0;
+static volatile int nestedLowest = -1;
+static volatile bool nesting = false;
+static uint8_t hFast, hMs, hSlow, hRare;
+static char message[120];
+
+// the lowest priority (highest level) that ran while a priority 4 task was yielding
+static void ran(int priority) {
+  if (!nesting) return;
+  runsNested++;
+  if (priority > nestedLowest) nestedLowest = priority;
+}
+
+static void fast() { runsFast++; ran(2); }
+static void ms() { runsMs++; ran(3); }
+static void slow() { runsSlow++; ran(5); }
+static void rare() { runsRare++; ran(1); }
+
+// yields for a span of held time
+static void run(unsigned long micros) {
+  for (unsigned long t = 0; t < micros; t += STEP_MICROS) { nativeClock.advance(STEP_MICROS); tasks.yield(); }
+}
+
+static void resetRuns() { runsFast = 0; runsMs = 0; runsSlow = 0; runsRare = 0; runsNested = 0; }
+
+void setUp() {
+  nativeClock.hold(0);
+  hFast = tasks.add(0, 0, true, 2, fast, "Fast");
+  tasks.setPeriodMicros(hFast, 250);
+  hMs = tasks.add(1, 0, true, 3, ms, "Ms");
+  hSlow = tasks.add(0, 0, true, 5, slow, "Slow");
+  tasks.setPeriodMicros(hSlow, 10000);
+  hRare = tasks.add(100, 0, true, 1, rare, "Rare");
+  TEST_ASSERT_TRUE(hFast && hMs && hSlow && hRare);
+  run(1000);
+  resetRuns();
+}
+
+void tearDown() {
+  tasks.remove(hFast);
+  tasks.remove(hMs);
+  tasks.remove(hSlow);
+  tasks.remove(hRare);
+}
+
+static void test_periods() {
+  run(1000000);
+  snprintf(message, sizeof(message), "in 1s fast %ld, ms %ld, slow %ld, rare %ld", runsFast, runsMs, runsSlow, runsRare);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_INT_WITHIN(2, 4000, runsFast);
+  TEST_ASSERT_INT_WITHIN(2, 1000, runsMs);
+  TEST_ASSERT_INT_WITHIN(1, 100, runsSlow);
+  TEST_ASSERT_INT_WITHIN(1, 10, runsRare);
+}
+
+static void test_period_change() {
+  run(100000);
+  tasks.setPeriod(hSlow, 5);
+  tasks.setPeriodMicros(hFast, 1000);
+  resetRuns();
+  run(1000000);
+  TEST_ASSERT_INT_WITHIN(2, 1000, runsFast);
+  TEST_ASSERT_INT_WITHIN(1, 200, runsSlow);
+  TEST_ASSERT_INT_WITHIN(2, 1000, runsMs);
+
+  // a period of 0 stops the task once it has run on the period it had
+  tasks.setPeriod(hSlow, 0);
+  run(5000);
+  resetRuns();
+  run(100000);
+  TEST_ASSERT_EQUAL(0, runsSlow);
+}
+
+static void test_immediate() {
+  run(10000);
+  TEST_ASSERT_EQUAL(0, runsRare);
+  // a millisecond task runs at the next tick
+  tasks.immediate(hRare);
+  run(1000);
+  TEST_ASSERT_EQUAL(1, runsRare);
+  run(10000);
+  TEST_ASSERT_EQUAL(1, runsRare);
+}
+
+static void test_remove() {
+  tasks.remove(hMs);
+  run(100000);
+  TEST_ASSERT_EQUAL(0, runsMs);
+  TEST_ASSERT_INT_WITHIN(2, 400, runsFast);
+  hMs = tasks.add(1, 0, true, 3, ms, "Ms");
+  TEST_ASSERT_TRUE(hMs);
+  resetRuns();
+  run(100000);
+  TEST_ASSERT_INT_WITHIN(2, 100, runsMs);
+}
+
+// with several tasks overdue at once a yield() runs only the highest priority one, the others
+// follow one per yield() in priority order
+static void test_one_task_per_yield() {
+  nativeClock.advance(20000);
+  tasks.yield();
+  TEST_ASSERT_EQUAL(1, runsFast + runsMs + runsSlow + runsRare);
+  TEST_ASSERT_EQUAL(1, runsFast);
+
+  // fast moved below ms and slow runs once they have caught up
+  tasks.setPriority(hFast, 6);
+  run(1000);
+  resetRuns();
+  nativeClock.advance(20000);
+  long yields = 0;
+  while (runsFast == 0 && yields < 100) {
+    tasks.yield();
+    yields++;
+    TEST_ASSERT_EQUAL(yields, runsFast + runsMs + runsSlow + runsRare);
+  }
+  snprintf(message, sizeof(message), "fast ran after ms %ld and slow %ld", runsMs, runsSlow);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_EQUAL(1, runsFast);
+  TEST_ASSERT_TRUE(runsMs > 0 && runsSlow > 0);
+}
+
+// a priority 4 task that yields for 50ms
+static void blocking() {
+  nesting = true;
+  run(50000);
+  nesting = false;
+}
+
+static void test_nested_yield() {
+  uint8_t h = tasks.add(20, 0, false, 4, blocking, "Block");
+  TEST_ASSERT_TRUE(h);
+  nestedLowest = -1;
+  run(100000);
+  tasks.remove(h);
+  snprintf(message, sizeof(message), "%ld runs while yielding, lowest priority level %d", runsNested, nestedLowest);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_GREATER_THAN(100, runsNested);
+  TEST_ASSERT_EQUAL(3, nestedLowest);
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_periods);
+  RUN_TEST(test_period_change);
+  RUN_TEST(test_immediate);
+  RUN_TEST(test_remove);
+  RUN_TEST(test_one_task_per_yield);
+  RUN_TEST(test_nested_yield);
+  return UNITY_END();
+}
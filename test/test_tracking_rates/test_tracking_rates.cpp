@@ -0,0 +1,234 @@
+// -----------------------------------------------------------------------------------
+// Tracking rates worked out analytically by Mount::poll() match the finite difference it used to
+// take, hour angle ahead and behind carried through refraction and the pointing model, over the sky
+// on GEM and alt-az mounts, also straight after the mount moves or the model changes
+
+#include <unity.h>
+
+#include "src/Common.h"
+#include "NativeFirmware.h"
+#include "FlexCAN_T4.h"
+#include "src/telescope/mount/Mount.h"
+#include "src/telescope/mount/coordinates/Transform.h"
+#include "src/telescope/mount/guide/Guide.h"
+#include "src/telescope/mount/limits/Limits.h"
+#include "src/telescope/mount/site/Site.h"
+#include "src/plugins/DDScope/ODriveTeensyCAN/ODriveTeensyCAN.h"
+
+// hour angle step of the finite difference, 1 arc-minute as before, the pointing model works in floats
+// which resolve about 1/10 arc-second near an axis coordinate of 360 degrees, a few parts in 10000 of
+// 1 arc-minute, so the difference through the model is taken over 15 arc-minutes
+#define DIFF_RANGE       2.908882086657216e-4
+#define DIFF_RANGE_MODEL 0.004363323129985824
+// largest difference allowed between the rates, relative to the sidereal rate or the rate itself where faster
+#define RATE_MAX         0.000002
+#define RATE_MAX_MODEL   0.0003
+
+static char message[200];
+
+// arc-seconds, cone, polar axis, index, dec axis orthogonality, flexure and tube flex terms
+static const AlignModel testModel = { 600.0F, -300.0F, 1200.0F, -900.0F, 240.0F, 120.0F, 90.0F, 60.0F };
+
+static AlignModel toRadians(const AlignModel &m) {
+  AlignModel r;
+  r.ax1Cor = arcsecToRad(m.ax1Cor); r.ax2Cor = arcsecToRad(m.ax2Cor);
+  r.altCor = arcsecToRad(m.altCor); r.azmCor = arcsecToRad(m.azmCor);
+  r.doCor = arcsecToRad(m.doCor); r.pdCor = arcsecToRad(m.pdCor);
+  r.dfCor = arcsecToRad(m.dfCor); r.tfCor = arcsecToRad(m.tfCor);
+  return r;
+}
+
+static void waitForStop() {
+  for (int i = 0; i < 60000 && (axis1.isSlewing() || axis2.isSlewing()); i++) nativeFirmwareRun(1);
+}
+
+// a mount of this type with the given rate compensation, the model is any fitted model swapped
+// for the one given so it's ready for use
+static void mountSetup(int8_t mountType, RateCompensation rc, const AlignModel &model) {
+  transform.mountType = mountType;
+  transform.align.init(mountType, site.location.latitude);
+  for (int i = 0; i < 3; i++) {
+    transform.align.actual[i] = transform.align.mount[i] = { (float)degToRad(i*30.0 - 30.0), (float)degToRad(20.0), 0.0F, 0.0F, 1 };
+  }
+  transform.align.autoModel(3);
+  transform.align.model = toRadians(model);
+  mount.settings.rc = rc;
+}
+
+// the ODrive's answer to the next encoder position request for this mount axis, radians as absolute
+// encoder turns
+static void encoderReply(int axisNumber, double position) {
+  #if ODRIVE_SWAP_AXES == ON
+    int axis_id = 2 - axisNumber;
+  #else
+    int axis_id = axisNumber - 1;
+  #endif
+  CAN_message_t msg;
+  msg.id = (axis_id << 5) + ODriveTeensyCAN::CMD_ID_GET_ENCODER_ESTIMATES;
+  msg.len = 8;
+  float turns = position/(2.0*M_PI);
+  float velocity = 0.0F;
+  memcpy(msg.buf, &turns, 4);
+  memcpy(msg.buf + 4, &velocity, 4);
+  nativeCan.rx.push_back(msg);
+}
+
+// puts the mount at this altitude and azimuth, in degrees, by resetting the axes to absolute encoders
+// that read there (a sync moves the native config's ODrive axes 80 arc-seconds at most), false if too
+// near the pole
+static bool moveTo(double altitude, double azimuth) {
+  Coordinate c = {};
+  c.a = degToRad(altitude);
+  c.z = degToRad(azimuth);
+  transform.horToEqu(&c);
+  if (fabs(c.d) > degToRad(80.0)) return false;
+  c.pierSide = transform.mountType != ALTAZM && c.h < 0.0 ? PIER_SIDE_WEST : PIER_SIDE_EAST;
+  double a1, a2;
+  transform.mountToInstrument(&c, &a1, &a2);
+
+  mount.tracking(false);
+  nativeFirmwareRun(20);
+  encoderReply(1, a1);
+  TEST_ASSERT_EQUAL(CE_NONE, axis1.resetPosition(a1));
+  encoderReply(2, a2);
+  TEST_ASSERT_EQUAL(CE_NONE, axis2.resetPosition(a2));
+  mount.tracking(true);
+  return true;
+}
+
+// the rates as Mount::poll() took them before, by finite difference at the present position
+static void differenceRates(double *rate1, double *rate2) {
+  Coordinate c = transform.instrumentToMount(axis1.getInstrumentCoordinate(), axis2.getInstrumentCoordinate());
+  if (transform.mountType == ALTAZM) transform.horToEqu(&c); else transform.equToHor(&c);
+  transform.mountToTopocentric(&c);
+  if (transform.mountType == ALTAZM) transform.horToEqu(&c);
+
+  bool model = mount.settings.rc == RC_MODEL || mount.settings.rc == RC_MODEL_DUAL;
+  double range = model ? DIFF_RANGE_MODEL : DIFF_RANGE;
+  Coordinate ahead = c;
+  Coordinate behind = c;
+  ahead.h += range;
+  behind.h -= range;
+  if (transform.mountType == ALTAZM) {
+    transform.equToHor(&ahead);
+    transform.equToHor(&behind);
+  }
+  transform.topocentricToObservedPlace(&ahead);
+  transform.topocentricToObservedPlace(&behind);
+  if (model) {
+    transform.observedPlaceToMount(&ahead);
+    transform.observedPlaceToMount(&behind);
+  } else {
+    ahead.a1 = transform.mountType == ALTAZM ? ahead.z : ahead.h;
+    ahead.a2 = transform.mountType == ALTAZM ? ahead.a : ahead.d;
+    behind.a1 = transform.mountType == ALTAZM ? behind.z : behind.h;
+    behind.a2 = transform.mountType == ALTAZM ? behind.a : behind.d;
+  }
+
+  double d1 = ahead.a1 - behind.a1;
+  if (d1 > Deg180) d1 -= Deg360; else if (d1 < -Deg180) d1 += Deg360;
+  *rate1 = d1/(2.0*range);
+  *rate2 = (ahead.a2 - behind.a2)/(2.0*range);
+  if (c.pierSide == PIER_SIDE_WEST) *rate2 = -*rate2;
+}
+
+// largest difference between the rates here and the finite difference, relative to the sidereal rate
+// or the rate itself where faster
+static double compareRates(const char *label, double altitude, double azimuth) {
+  mount.poll();
+  double rate1, rate2;
+  differenceRates(&rate1, &rate2);
+  double e1 = fabs(mount.getTrackingRateAxis1() - rate1)/fmax(1.0, fabs(rate1));
+  double e2 = fabs(mount.getTrackingRateAxis2() - rate2)/fmax(1.0, fabs(rate2));
+  double e = e1 > e2 ? e1 : e2;
+  bool model = mount.settings.rc == RC_MODEL || mount.settings.rc == RC_MODEL_DUAL;
+  if (e > (model ? RATE_MAX_MODEL : RATE_MAX)) {
+    snprintf(message, sizeof(message), "%s at alt %.0f azm %.0f: axis1 %.6f vs %.6f, axis2 %.6f vs %.6f",
+      label, altitude, azimuth, mount.getTrackingRateAxis1(), rate1, mount.getTrackingRateAxis2(), rate2);
+    TEST_FAIL_MESSAGE(message);
+  }
+  return e;
+}
+
+// moves over the sky from azimuth 0 to 330 and altitude 15 to 75 comparing the rates at each,
+// each move is further than stale pointing model derivatives could follow
+static void compareSky(const char *label) {
+  double worst = 0.0;
+  int points = 0;
+  for (int a = 15; a <= 75; a += 15) {
+    for (int z = 0; z < 360; z += 30) {
+      if (!moveTo(a, z)) continue;
+      double e = compareRates(label, a, z);
+      if (e > worst) worst = e;
+      points++;
+    }
+  }
+  snprintf(message, sizeof(message), "%s: %d positions, largest rate difference %.2e", label, points, worst);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_TRUE_MESSAGE(points > 40, message);
+}
+
+// a mount at latitude 40 with the limits opened out
+void setUp() {
+  nativeFirmwareBegin();
+  guide.stop();
+  waitForStop();
+
+  site.location.latitude = degToRad(40.0);
+  site.updateLocation();
+  limits.settings.altitude.min = degToRadF(-10.0F);
+  limits.settings.altitude.max = degToRadF(89.0F);
+  mount.enable(true);
+  mount.tracking(true);
+}
+
+void tearDown() {
+  mount.settings.rc = RC_DEFAULT;
+  transform.mountType = MOUNT_SUBTYPE;
+  transform.align.init(transform.mountType, site.location.latitude);
+}
+
+// on a GEM the dual axis compensations give a rate for each axis
+static void test_gem_refraction() {
+  mountSetup(GEM, RC_REFRACTION_DUAL, {});
+  compareSky("GEM refraction");
+}
+
+static void test_gem_model() {
+  mountSetup(GEM, RC_MODEL_DUAL, testModel);
+  compareSky("GEM model");
+}
+
+static void test_altazm_refraction() {
+  mountSetup(ALTAZM, RC_REFRACTION, {});
+  compareSky("ALTAZM refraction");
+}
+
+static void test_altazm_model() {
+  mountSetup(ALTAZM, RC_MODEL, testModel);
+  compareSky("ALTAZM model");
+}
+
+// a new model takes effect at the next poll, not up to a second later
+static void test_model_change() {
+  mountSetup(GEM, RC_MODEL_DUAL, {});
+  TEST_ASSERT_TRUE(moveTo(45.0, 120.0));
+  compareRates("GEM no model", 45.0, 120.0);
+
+  AlignModel model = testModel;
+  model.altCor = 3600.0F;
+  model.azmCor = -3600.0F;
+  transform.align.model = toRadians(model);
+  compareRates("GEM changed model", 45.0, 120.0);
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_gem_refraction);
+  RUN_TEST(test_gem_model);
+  RUN_TEST(test_altazm_refraction);
+  RUN_TEST(test_altazm_model);
+  RUN_TEST(test_model_change);
+  return UNITY_END();
+}
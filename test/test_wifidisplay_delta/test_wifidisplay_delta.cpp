@@ -0,0 +1,115 @@
+// -----------------------------------------------------------------------------------
+// WifiDisplay delta frames, draws through the TFT driver with capture on then decodes each
+// frame the way the web client does and checks the client's copy matches the capture buffer
+
+#include <unity.h>
+#include <stdlib.h>
+#include <miniz.h>
+
+#include "src/Common.h"
+#include "src/plugins/DDScope/display/Display.h"
+#include "src/plugins/DDScope/display/WifiDisplay.h"
+
+static uint8_t client[UNCOMPRESSED_BUFFER_SIZE];
+static uint8_t inflated[SEND_BUFFER_SIZE];
+
+// raw inflate of compressedBuffer, returns the inflated size
+static size_t inflateFrame(size_t size) {
+  mz_stream s;
+  memset(&s, 0, sizeof(s));
+  TEST_ASSERT_EQUAL(MZ_OK, mz_inflateInit2(&s, -MZ_DEFAULT_WINDOW_BITS));
+  s.next_in = compressedBuffer;
+  s.avail_in = size;
+  s.next_out = inflated;
+  s.avail_out = sizeof(inflated);
+  TEST_ASSERT_EQUAL(MZ_STREAM_END, mz_inflate(&s, MZ_FINISH));
+  size_t n = s.total_out;
+  mz_inflateEnd(&s);
+  return n;
+}
+
+// [count:2] then count times [x:2][y:2][w:2][h:2][w*h pixels]
+static void applyDelta(const uint8_t *b, size_t len) {
+  int count = b[0] | b[1] << 8;
+  size_t p = 2;
+  for (int k = 0; k < count; k++) {
+    int v[4];
+    for (int i = 0; i < 4; i++) { v[i] = b[p] | b[p + 1] << 8; p += 2; }
+    TEST_ASSERT_TRUE(v[0] + v[2] <= SCREEN_WIDTH && v[1] + v[3] <= SCREEN_HEIGHT);
+    for (int r = 0; r < v[3]; r++) {
+      memcpy(client + ((v[1] + r)*SCREEN_WIDTH + v[0])*COLOR_DEPTH, b + p, v[2]*COLOR_DEPTH);
+      p += v[2]*COLOR_DEPTH;
+    }
+  }
+  TEST_ASSERT_EQUAL(len, p);
+}
+
+static void randomRects(int count) {
+  for (int k = 0; k < count; k++) {
+    int x = rand() % 300, y = rand() % 460;
+    tft.fillRect(x, y, rand() % 20 + 1, rand() % 20 + 1, (uint16_t)rand());
+  }
+}
+
+void setUp() {
+  srand(1);
+  memset(uncompressedBuffer, 0, UNCOMPRESSED_BUFFER_SIZE);
+  memset(client, 0, sizeof(client));
+  wifiDisplay.clearDirty();
+  wifiDisplay.enableScreenCapture(true);
+}
+
+void tearDown() {
+  wifiDisplay.enableScreenCapture(false);
+  wifiDisplay.clearDirty();
+}
+
+static void test_delta_round_trip() {
+  for (int frame = 0; frame < 100; frame++) {
+    randomRects(rand() % 40);
+    size_t len = wifiDisplay.buildDelta();
+    size_t size = wifiDisplay.compressWithDeflate(sendBuffer, len);
+    TEST_ASSERT_TRUE(size > 0);
+    TEST_ASSERT_EQUAL(len, inflateFrame(size));
+    applyDelta(inflated, len);
+    wifiDisplay.clearDirty();
+    TEST_ASSERT_EQUAL_MEMORY(uncompressedBuffer, client, UNCOMPRESSED_BUFFER_SIZE);
+  }
+}
+
+static void test_full_frame_round_trip() {
+  randomRects(200);
+  size_t size = wifiDisplay.compressWithDeflate();
+  TEST_ASSERT_TRUE(size > 0);
+  TEST_ASSERT_EQUAL(UNCOMPRESSED_BUFFER_SIZE, inflateFrame(size));
+  TEST_ASSERT_EQUAL_MEMORY(uncompressedBuffer, inflated, UNCOMPRESSED_BUFFER_SIZE);
+}
+
+// drawing the same pixels again doesn't dirty anything so no delta is sent
+static void test_redraw_marks_nothing() {
+  tft.fillRect(40, 40, 100, 60, 0x1234);
+  TEST_ASSERT_TRUE(wifiDisplay.dirtyCount() > 0);
+  wifiDisplay.clearDirty();
+  tft.fillRect(40, 40, 100, 60, 0x1234);
+  TEST_ASSERT_EQUAL(0, wifiDisplay.dirtyCount());
+  TEST_ASSERT_EQUAL(2, wifiDisplay.buildDelta());
+}
+
+// delta frames are opt in, the status update sends full frames unless the client can take deltas
+static void test_update_frame_type() {
+#ifdef ENABLE_TFT_MIRROR_DELTA
+  TEST_ASSERT_EQUAL(FRAME_TYPE_DLT, FRAME_TYPE_UPDATE);
+#else
+  TEST_ASSERT_EQUAL(FRAME_TYPE_DEF, FRAME_TYPE_UPDATE);
+#endif
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_delta_round_trip);
+  RUN_TEST(test_full_frame_round_trip);
+  RUN_TEST(test_redraw_marks_nothing);
+  RUN_TEST(test_update_frame_type);
+  return UNITY_END();
+}
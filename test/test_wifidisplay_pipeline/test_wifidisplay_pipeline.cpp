@@ -0,0 +1,217 @@
+// -----------------------------------------------------------------------------------
+// WifiDisplay frame pipeline, framePoll() deflates and sends a frame a slice per call, the frame
+// that reaches the ESP32 is the snapshot taken when it was requested even if the capture buffer
+// changes meanwhile, requests made while busy are kept (a full frame wins over a delta) and a
+// missing ACK drops the frame
+
+#include <unity.h>
+#include <chrono>
+#include <stdlib.h>
+#include <miniz.h>
+
+#include "src/Common.h"
+#include "src/plugins/DDScope/display/Display.h"
+#include "src/plugins/DDScope/display/UsbBridge.h"
+#include "src/plugins/DDScope/display/WifiDisplay.h"
+
+#define ACK 0x06
+
+static uint8_t snapshot[UNCOMPRESSED_BUFFER_SIZE];
+static uint8_t inflated[SEND_BUFFER_SIZE];
+static char message[160];
+
+// a screen that looks like the DDScope ones, a plain background with buttons and some text
+static void drawScreen(uint8_t seed) {
+  for (int y = 0; y < SCREEN_HEIGHT; y++) {
+    for (int x = 0; x < SCREEN_WIDTH; x++) {
+      uint16_t c = 0x0841;
+      if (y >= 60 && y < 420 && (y/40) % 2 == 0 && x >= 20 && x < 300) c = 0x3186;
+      if (y >= 60 && y < 420 && (y % 40) >= 12 && (y % 40) < 24 && (x % 8) < 5 && ((x*7 + y*3 + seed) % 11) < 4) c = 0xFFFF;
+      uncompressedBuffer[(y*SCREEN_WIDTH + x)*COLOR_DEPTH] = c >> 8;
+      uncompressedBuffer[(y*SCREEN_WIDTH + x)*COLOR_DEPTH + 1] = c & 0xFF;
+    }
+  }
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point t0) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+typedef struct FrameStats {
+  int compressPolls;
+  int sendPolls;
+  double longestPollMs;
+  uint8_t type;
+  size_t size;
+} FrameStats;
+
+// polls until the 'Z' request, ACKs it, polls until the whole frame is out then checks the header
+static void receiveFrame(FrameStats *stats) {
+  memset(stats, 0, sizeof(FrameStats));
+  for (int i = 0; i < 1000 && SERIAL_ESP32S3.tx.find('Z') == std::string::npos; i++) {
+    auto t0 = std::chrono::steady_clock::now();
+    wifiDisplay.framePoll();
+    double ms = elapsedMs(t0);
+    if (ms > stats->longestPollMs) stats->longestPollMs = ms;
+    stats->compressPolls++;
+  }
+  TEST_ASSERT_EQUAL_STRING("Z", SERIAL_ESP32S3.tx.c_str());
+  SERIAL_ESP32S3.tx.clear();
+
+  uint8_t ack = ACK;
+  SERIAL_ESP32S3.inject(&ack, 1);
+  wifiDisplay.framePoll();
+  TEST_ASSERT_EQUAL(5, SERIAL_ESP32S3.tx.size());
+  const uint8_t *h = (const uint8_t *)SERIAL_ESP32S3.tx.data();
+  stats->type = h[0];
+  stats->size = h[1] | h[2] << 8 | h[3] << 16 | (size_t)h[4] << 24;
+
+  size_t last = 0;
+  do {
+    last = SERIAL_ESP32S3.tx.size();
+    auto t0 = std::chrono::steady_clock::now();
+    wifiDisplay.framePoll();
+    double ms = elapsedMs(t0);
+    if (ms > stats->longestPollMs) stats->longestPollMs = ms;
+    if (SERIAL_ESP32S3.tx.size() > last) stats->sendPolls++;
+  } while (SERIAL_ESP32S3.tx.size() > last);
+  TEST_ASSERT_EQUAL(5 + stats->size, SERIAL_ESP32S3.tx.size());
+}
+
+// raw inflate of the payload just received, returns the inflated size
+static size_t inflatePayload(const FrameStats *stats) {
+  mz_stream s;
+  memset(&s, 0, sizeof(s));
+  TEST_ASSERT_EQUAL(MZ_OK, mz_inflateInit2(&s, -MZ_DEFAULT_WINDOW_BITS));
+  s.next_in = (const uint8_t *)SERIAL_ESP32S3.tx.data() + 5;
+  s.avail_in = stats->size;
+  s.next_out = inflated;
+  s.avail_out = sizeof(inflated);
+  TEST_ASSERT_EQUAL(MZ_STREAM_END, mz_inflate(&s, MZ_FINISH));
+  size_t n = s.total_out;
+  mz_inflateEnd(&s);
+  return n;
+}
+
+void setUp() {
+  static bool connected = false;
+  nativeClock.hold();
+  if (!connected) {
+    // the ESP32 reports its IP address then a web client connecting
+    SERIAL_ESP32S3.inject("I10.0.0.5\n");
+    wifiDisplay.espPoll();
+    SERIAL_ESP32S3.inject("C");
+    wifiDisplay.espPoll();
+    connected = true;
+  }
+  SERIAL_ESP32S3.rx.clear();
+  SERIAL_ESP32S3.tx.clear();
+  wifiDisplay.clearDirty();
+}
+
+void tearDown() {}
+
+static void test_full_frame_slices() {
+  drawScreen(0);
+  memcpy(snapshot, uncompressedBuffer, UNCOMPRESSED_BUFFER_SIZE);
+  wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
+
+  // the capture carries on while the frame is in flight
+  drawScreen(5);
+
+  FrameStats stats;
+  receiveFrame(&stats);
+  TEST_ASSERT_EQUAL(FRAME_TYPE_DEF, stats.type);
+  TEST_ASSERT_EQUAL((UNCOMPRESSED_BUFFER_SIZE + FRAME_SLICE_BYTES - 1)/FRAME_SLICE_BYTES, stats.compressPolls);
+  TEST_ASSERT_EQUAL((stats.size + FRAME_SLICE_CHUNKS*64 - 1)/(FRAME_SLICE_CHUNKS*64), stats.sendPolls);
+  TEST_ASSERT_EQUAL(UNCOMPRESSED_BUFFER_SIZE, inflatePayload(&stats));
+  TEST_ASSERT_EQUAL_MEMORY(snapshot, inflated, UNCOMPRESSED_BUFFER_SIZE);
+
+  // the whole frame deflated in one call, as sendFrameToEsp() did before the pipeline
+  auto t0 = std::chrono::steady_clock::now();
+  size_t size = wifiDisplay.compressWithDeflate(snapshot, UNCOMPRESSED_BUFFER_SIZE);
+  double blockingMs = elapsedMs(t0);
+  TEST_ASSERT_EQUAL(stats.size, size);
+
+  snprintf(message, sizeof(message), "%u bytes in %d + %d polls, longest poll %.2f ms, deflate in one call %.2f ms",
+           (unsigned)stats.size, stats.compressPolls, stats.sendPolls, stats.longestPollMs, blockingMs);
+  TEST_MESSAGE(message);
+}
+
+// a delta then a full frame requested while busy, the full frame is what's sent next
+static void test_pending_full_frame_wins() {
+  drawScreen(1);
+  wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
+  drawScreen(2);
+  wifiDisplay.markDirty(0, 0);
+  wifiDisplay.sendFrameToEsp(FRAME_TYPE_DLT);
+  wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
+  wifiDisplay.sendFrameToEsp(FRAME_TYPE_DLT);
+
+  FrameStats stats;
+  receiveFrame(&stats);
+  SERIAL_ESP32S3.tx.clear();
+  memcpy(snapshot, uncompressedBuffer, UNCOMPRESSED_BUFFER_SIZE);
+
+  // the pending request starts when the pipeline is idle
+  wifiDisplay.framePoll();
+  receiveFrame(&stats);
+  TEST_ASSERT_EQUAL(FRAME_TYPE_DEF, stats.type);
+  TEST_ASSERT_EQUAL(UNCOMPRESSED_BUFFER_SIZE, inflatePayload(&stats));
+  TEST_ASSERT_EQUAL_MEMORY(snapshot, inflated, UNCOMPRESSED_BUFFER_SIZE);
+
+  // and nothing else is queued
+  SERIAL_ESP32S3.tx.clear();
+  for (int i = 0; i < 100; i++) wifiDisplay.framePoll();
+  TEST_ASSERT_EQUAL(0, SERIAL_ESP32S3.tx.size());
+}
+
+// a delta goes out as tiles once the client has a full frame
+static void test_delta_frame() {
+  drawScreen(3);
+  wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
+  FrameStats stats;
+  receiveFrame(&stats);
+  SERIAL_ESP32S3.tx.clear();
+
+  wifiDisplay.markDirty(40, 100);
+  wifiDisplay.markDirty(56, 100);
+  wifiDisplay.sendFrameToEsp(FRAME_TYPE_DLT);
+  receiveFrame(&stats);
+  TEST_ASSERT_EQUAL(FRAME_TYPE_DLT, stats.type);
+  // one rectangle two tiles wide
+  TEST_ASSERT_EQUAL(2 + 8 + 2*MIRROR_TILE*MIRROR_TILE*COLOR_DEPTH, inflatePayload(&stats));
+  TEST_ASSERT_EQUAL(1, inflated[0] | inflated[1] << 8);
+}
+
+// without an ACK the frame is dropped and the next one is a full frame since the client missed one
+static void test_missing_ack() {
+  drawScreen(4);
+  wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
+  FrameStats stats;
+  receiveFrame(&stats);
+  SERIAL_ESP32S3.tx.clear();
+
+  wifiDisplay.markDirty(0, 0);
+  wifiDisplay.sendFrameToEsp(FRAME_TYPE_DLT);
+  for (int i = 0; i < 100 && SERIAL_ESP32S3.tx.empty(); i++) wifiDisplay.framePoll();
+  TEST_ASSERT_EQUAL_STRING("Z", SERIAL_ESP32S3.tx.c_str());
+  nativeClock.advance(25000);
+  wifiDisplay.framePoll();
+  SERIAL_ESP32S3.tx.clear();
+
+  wifiDisplay.markDirty(0, 0);
+  wifiDisplay.sendFrameToEsp(FRAME_TYPE_DLT);
+  receiveFrame(&stats);
+  TEST_ASSERT_EQUAL(FRAME_TYPE_DEF, stats.type);
+}
+
+int main(int argc, char **argv) {
+  (void)argc; (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_full_frame_slices);
+  RUN_TEST(test_pending_full_frame_wins);
+  RUN_TEST(test_delta_frame);
+  RUN_TEST(test_missing_ack);
+  return UNITY_END();
+}